@@ -0,0 +1,1641 @@
+/* --- Módulo Python (CPython) da biblioteca --- */
+
+/*
+Expõe Graph, os geradores e as funções estruturais e espectrais para
+Python sem passar por arquivos de texto. Compile com `make python`
+(gera python/graphs*.so) e use com PYTHONPATH=python.
+
+Nada é copiado na volta: Graph e os vetores que as funções devolvem
+(graphs.Array) exportam o próprio buffer pelo buffer protocol, então
+numpy.asarray(g) é uma view de g->A e numpy.asarray(g.spec_adj()) é
+uma view do vetor que o LAPACK preencheu. A view de g é somente
+leitura; para escrever direto em g->A use g.writable(), que devolve um
+Array gravável sobre a mesma memória. Soltar uma view gravável dele
+(del, memoryview.release() ou o fim de um with) chama
+graph_invalidate; antes disso, como em C, quem escreveu deve chamar
+g.invalidate() antes de consultar o grafo de novo. Na ida, Graph.from_array e matrix_spec
+leem qualquer buffer C-contíguo de float64 (uma cópia, para a
+memória do grafo vir de graph_mem_matrix).
+
+As contas longas (espectros, distâncias, geradores...) soltam o GIL,
+então várias threads Python rodam lotes ao mesmo tempo. Enquanto uma
+conta roda sem o GIL o grafo fica marcado como ocupado, e add_edge,
+remove_edge e invalidate levantam RuntimeError (e as views de
+g.writable() são recusadas com BufferError) em vez de mexer em A embaixo dela.
+Escrever por uma view gravável aberta antes da conta continua sendo
+uma corrida: mantenha essas views curtas. Leituras simultâneas do mesmo grafo são seguras (o
+cache tem trava própria).
+
+Parâmetros inválidos viram exceções antes de chegar às funções que
+chamam die. O argumento seed dos geradores densos é opcional: None
+usa rand(), como as versões sem _r.
+*/
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <math.h>
+#include <string.h>
+#include "../src/graphs.h"
+#include "../src/eig.h"
+#include "../src/families.h"
+#include "../src/components.h"
+#include "../src/distance.h"
+#include "../src/spanning.h"
+#include "../src/lapsolve.h"
+#include "../src/paths.h"
+#include "../src/generators.h"
+#include "../src/batch.h"
+
+
+/* --- Array: vetor/matriz devolvido às funções Python --- */
+
+/*data é de owner (que fica vivo enquanto o Array existir) ou, se
+owner for NULL, do próprio Array (free no fim)*/
+typedef struct {
+	PyObject_HEAD
+	void* data;
+	PyObject* owner;
+	const char* format;		/* "d" (double) ou "N" (size_t)*/
+	Py_ssize_t itemsize;
+	int ndim;
+	int readonly;
+	int graph_view;			/* owner é um Graph e data é g->A
+							(Graph.writable())*/
+	Py_ssize_t shape[3];
+	Py_ssize_t strides[3];
+} ArrayObject;
+
+static PyTypeObject ArrayType;
+
+/*Definidas com Graph, mais abaixo*/
+static int graph_owner_check_idle(PyObject* owner);
+static void graph_owner_invalidate(PyObject* owner);
+
+/*Preenche view com um buffer C-contíguo*/
+static int fill_view(Py_buffer* view, PyObject* obj, void* buf,
+	const char* format, Py_ssize_t itemsize, int ndim, Py_ssize_t* shape,
+	Py_ssize_t* strides, int readonly, int flags) {
+	if (readonly && (flags & PyBUF_WRITABLE)) {
+		PyErr_SetString(PyExc_BufferError, "buffer somente leitura");
+
+		return -1;
+	}
+
+	Py_ssize_t len = itemsize;
+
+	for (int i = 0; i < ndim; i++) {
+		len *= shape[i];
+	}
+
+	view->buf = buf;
+	view->obj = Py_NewRef(obj);
+	view->len = len;
+	view->itemsize = itemsize;
+	view->readonly = readonly;
+	view->ndim = ndim;
+	view->format = (flags & PyBUF_FORMAT) ? (char*) format : NULL;
+	view->shape = (flags & PyBUF_ND) ? shape : NULL;
+	view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? strides : NULL;
+	view->suboffsets = NULL;
+	view->internal = NULL;
+
+	return 0;
+}
+
+/*Array com rows x cols (x depth) elementos. data == NULL aloca*/
+static ArrayObject* array_new(const char* format, int ndim,
+	const Py_ssize_t* shape, void* data, PyObject* owner) {
+	ArrayObject* a = PyObject_New(ArrayObject, &ArrayType);
+
+	if (!a) {
+		return NULL;
+	}
+
+	a->format = format;
+	a->itemsize = format[0] == 'd' ? sizeof(double) : sizeof(size_t);
+	a->ndim = ndim;
+	a->readonly = owner != NULL;
+	a->graph_view = 0;
+	a->owner = Py_XNewRef(owner);
+	a->data = data;
+
+	Py_ssize_t count = 1;
+
+	for (int i = ndim - 1; i >= 0; i--) {
+		a->shape[i] = shape[i];
+		a->strides[i] = count * a->itemsize;
+		count *= shape[i];
+	}
+
+	if (!data) {
+		a->data = malloc((size_t) count * a->itemsize + 1);
+
+		if (!a->data) {
+			Py_DECREF(a);
+
+			return (ArrayObject*) PyErr_NoMemory();
+		}
+	}
+
+	return a;
+}
+
+static ArrayObject* vector_new(const char* format, size_t n) {
+	Py_ssize_t shape[] = {(Py_ssize_t) n};
+
+	return array_new(format, 1, shape, NULL, NULL);
+}
+
+static ArrayObject* matrix_new(size_t rows, size_t cols) {
+	Py_ssize_t shape[] = {(Py_ssize_t) rows, (Py_ssize_t) cols};
+
+	return array_new("d", 2, shape, NULL, NULL);
+}
+
+static void array_dealloc(ArrayObject* a) {
+	if (a->owner) {
+		Py_DECREF(a->owner);
+	} else {
+		free(a->data);
+	}
+
+	Py_TYPE(a)->tp_free((PyObject*) a);
+}
+
+static int array_getbuffer(ArrayObject* a, Py_buffer* view, int flags) {
+	/*a view sai gravável mesmo sem PyBUF_WRITABLE (memoryview não pede)*/
+	if (a->graph_view && graph_owner_check_idle(a->owner) < 0) {
+		return -1;
+	}
+
+	return fill_view(view, (PyObject*) a, a->data, a->format, a->itemsize,
+		a->ndim, a->shape, a->strides, a->readonly, flags);
+}
+
+/*Uma view gravável de g->A pode ter mudado o grafo*/
+static void array_releasebuffer(ArrayObject* a, Py_buffer* view) {
+	if (a->graph_view && !view->readonly) {
+		graph_owner_invalidate(a->owner);
+	}
+}
+
+static Py_ssize_t array_len(ArrayObject* a) {
+	return a->shape[0];
+}
+
+static PyObject* array_get_shape(ArrayObject* a, void* closure) {
+	(void) closure;
+	PyObject* t = PyTuple_New(a->ndim);
+
+	for (int i = 0; t && i < a->ndim; i++) {
+		PyTuple_SET_ITEM(t, i, PyLong_FromSsize_t(a->shape[i]));
+	}
+
+	return t;
+}
+
+/*a.tolist() sem numpy (pela memoryview)*/
+static PyObject* array_tolist(ArrayObject* a, PyObject* unused) {
+	(void) unused;
+	PyObject* mv = PyMemoryView_FromObject((PyObject*) a);
+
+	if (!mv) {
+		return NULL;
+	}
+
+	PyObject* list = PyObject_CallMethod(mv, "tolist", NULL);
+	Py_DECREF(mv);
+
+	return list;
+}
+
+static PyBufferProcs array_as_buffer = {
+	.bf_getbuffer = (getbufferproc) array_getbuffer,
+	.bf_releasebuffer = (releasebufferproc) array_releasebuffer,
+};
+
+static PySequenceMethods array_as_sequence = {
+	.sq_length = (lenfunc) array_len,
+};
+
+static PyGetSetDef array_getset[] = {
+	{"shape", (getter) array_get_shape, NULL, "dimensões", NULL},
+	{NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyMethodDef array_methods[] = {
+	{"tolist", (PyCFunction) array_tolist, METH_NOARGS,
+		"cópia como lista (de listas)"},
+	{NULL, NULL, 0, NULL}
+};
+
+static PyTypeObject ArrayType = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	.tp_name = "graphs.Array",
+	.tp_basicsize = sizeof(ArrayObject),
+	.tp_dealloc = (destructor) array_dealloc,
+	.tp_as_sequence = &array_as_sequence,
+	.tp_as_buffer = &array_as_buffer,
+	.tp_flags = Py_TPFLAGS_DEFAULT,
+	.tp_doc = "Vetor ou matriz de double (ou size_t) exportado pelo buffer "
+		"protocol: use numpy.asarray(a) ou memoryview(a), sem cópia",
+	.tp_methods = array_methods,
+	.tp_getset = array_getset,
+};
+
+
+/*Lê um buffer C-contíguo de float64 com ndim dimensões*/
+static int get_doubles(PyObject* obj, Py_buffer* view, int ndim) {
+	if (PyObject_GetBuffer(obj, view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0) {
+		return -1;
+	}
+
+	const char* f = view->format;
+
+	if (f[0] == '@' || f[0] == '=' || f[0] == '<') {
+		f++;
+	}
+
+	if (strcmp(f, "d") != 0 || view->ndim != ndim) {
+		/*o formato de PyErr_Format tem que ser ASCII*/
+		PyErr_Format(PyExc_TypeError, "esperava um buffer float64 com %d %s",
+			ndim, "dimensões (numpy.asarray(x, dtype=float))");
+		PyBuffer_Release(view);
+
+		return -1;
+	}
+
+	return 0;
+}
+
+/*seed opcional: None (rng = NULL, usa rand()) ou inteiro*/
+static int get_rng(PyObject* seed, Rng* rng, Rng** out) {
+	*out = NULL;
+
+	if (seed == NULL || seed == Py_None) {
+		return 0;
+	}
+
+	unsigned long long s = PyLong_AsUnsignedLongLongMask(seed);
+
+	if (PyErr_Occurred()) {
+		return -1;
+	}
+
+	rng_seed(rng, s);
+	*out = rng;
+
+	return 0;
+}
+
+
+/* --- CSR --- */
+
+typedef struct {
+	PyObject_HEAD
+	GraphCSR* g;
+} CSRObject;
+
+static PyTypeObject CSRType;
+
+static PyObject* csr_wrap(GraphCSR* g) {
+	if (!g) {
+		PyErr_SetString(PyExc_ValueError, "parâmetros inválidos");
+
+		return NULL;
+	}
+
+	CSRObject* self = PyObject_New(CSRObject, &CSRType);
+
+	if (!self) {
+		graph_csr_free(g);
+
+		return NULL;
+	}
+
+	self->g = g;
+
+	return (PyObject*) self;
+}
+
+static void csr_dealloc(CSRObject* self) {
+	graph_csr_free(self->g);
+	Py_TYPE(self)->tp_free((PyObject*) self);
+}
+
+static PyObject* csr_get_n(CSRObject* self, void* closure) {
+	(void) closure;
+
+	return PyLong_FromSize_t(self->g->n);
+}
+
+static PyObject* csr_get_directed(CSRObject* self, void* closure) {
+	(void) closure;
+
+	return PyBool_FromLong(self->g->directed);
+}
+
+/*rowptr, col e w como views (somente leitura: mexer nos índices
+quebraria as buscas)*/
+static PyObject* csr_view(CSRObject* self, const char* format, void* data,
+	size_t len) {
+	Py_ssize_t shape[] = {(Py_ssize_t) len};
+
+	return (PyObject*) array_new(format, 1, shape, data, (PyObject*) self);
+}
+
+static PyObject* csr_get_rowptr(CSRObject* self, void* closure) {
+	(void) closure;
+
+	return csr_view(self, "N", self->g->rowptr, self->g->n + 1);
+}
+
+static PyObject* csr_get_col(CSRObject* self, void* closure) {
+	(void) closure;
+
+	return csr_view(self, "N", self->g->col, self->g->rowptr[self->g->n]);
+}
+
+static PyObject* csr_get_weights(CSRObject* self, void* closure) {
+	(void) closure;
+
+	if (!self->g->w) {
+		Py_RETURN_NONE;
+	}
+
+	return csr_view(self, "d", self->g->w, self->g->rowptr[self->g->n]);
+}
+
+static PyObject* csr_sssp(CSRObject* self, PyObject* args) {
+	Py_ssize_t src;
+
+	if (!PyArg_ParseTuple(args, "n", &src)) {
+		return NULL;
+	}
+
+	if (src < 0 || (size_t) src >= self->g->n) {
+		PyErr_SetString(PyExc_IndexError, "vértice fora do intervalo");
+
+		return NULL;
+	}
+
+	ArrayObject* dist = vector_new("d", self->g->n);
+	int err;
+
+	if (!dist) {
+		return NULL;
+	}
+
+	Py_BEGIN_ALLOW_THREADS
+	err = graph_sssp(self->g, (size_t) src, dist->data);
+	Py_END_ALLOW_THREADS
+
+	if (err != 0) {
+		Py_DECREF(dist);
+		PyErr_SetString(PyExc_ValueError, "ciclo negativo alcançável");
+
+		return NULL;
+	}
+
+	return (PyObject*) dist;
+}
+
+static PyGetSetDef csr_getset[] = {
+	{"n", (getter) csr_get_n, NULL, "número de vértices", NULL},
+	{"directed", (getter) csr_get_directed, NULL, "direcionado?", NULL},
+	{"rowptr", (getter) csr_get_rowptr, NULL, "n + 1 posições", NULL},
+	{"col", (getter) csr_get_col, NULL, "vizinhos, linha a linha", NULL},
+	{"weights", (getter) csr_get_weights, NULL, "pesos (ou None)", NULL},
+	{NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyMethodDef csr_methods[] = {
+	{"sssp", (PyCFunction) csr_sssp, METH_VARARGS,
+		"sssp(src): distâncias (ponderadas) a partir de src"},
+	{NULL, NULL, 0, NULL}
+};
+
+static PyTypeObject CSRType = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	.tp_name = "graphs.CSR",
+	.tp_basicsize = sizeof(CSRObject),
+	.tp_dealloc = (destructor) csr_dealloc,
+	.tp_flags = Py_TPFLAGS_DEFAULT,
+	.tp_doc = "Grafo esparso (GraphCSR), somente leitura",
+	.tp_methods = csr_methods,
+	.tp_getset = csr_getset,
+};
+
+
+/* --- Graph --- */
+
+typedef struct {
+	PyObject_HEAD
+	Graph* g;
+	int busy;				/* contas rodando sem o GIL*/
+	Py_ssize_t shape[2];
+	Py_ssize_t strides[2];
+} GraphObject;
+
+static PyTypeObject GraphType;
+
+static PyObject* graph_wrap(PyTypeObject* type, Graph* g) {
+	if (!g) {
+		PyErr_SetString(PyExc_ValueError, "parâmetros inválidos");
+
+		return NULL;
+	}
+
+	GraphObject* self = (GraphObject*) type->tp_alloc(type, 0);
+
+	if (!self) {
+		graph_free(g);
+
+		return NULL;
+	}
+
+	self->g = g;
+	self->shape[0] = self->shape[1] = (Py_ssize_t) g->n;
+	self->strides[0] = (Py_ssize_t) (g->n * sizeof(double));
+	self->strides[1] = sizeof(double);
+
+	return (PyObject*) self;
+}
+
+/*Roda stmt sem o GIL com o grafo marcado como ocupado*/
+#define UNLOCKED(self, stmt) do { \
+		(self)->busy++; \
+		Py_BEGIN_ALLOW_THREADS \
+		stmt; \
+		Py_END_ALLOW_THREADS \
+		(self)->busy--; \
+	} while (0)
+
+static int check_idle(GraphObject* self) {
+	if (self->busy) {
+		PyErr_SetString(PyExc_RuntimeError, "grafo em uso por outra thread");
+
+		return -1;
+	}
+
+	return 0;
+}
+
+static int graph_owner_check_idle(PyObject* owner) {
+	if (((GraphObject*) owner)->busy) {
+		PyErr_SetString(PyExc_BufferError, "grafo em uso por outra thread");
+
+		return -1;
+	}
+
+	return 0;
+}
+
+static void graph_owner_invalidate(PyObject* owner) {
+	graph_invalidate(((GraphObject*) owner)->g);
+}
+
+static int check_vertex(GraphObject* self, Py_ssize_t u) {
+	if (u < 0 || (size_t) u >= self->g->n) {
+		PyErr_SetString(PyExc_IndexError, "vértice fora do intervalo");
+
+		return -1;
+	}
+
+	return 0;
+}
+
+static PyObject* graph_py_new(PyTypeObject* type, PyObject* args,
+	PyObject* kwds) {
+	static char* kwlist[] = {"n", "directed", NULL};
+	Py_ssize_t n;
+	int directed = 0;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "n|p", kwlist, &n,
+		&directed)) {
+		return NULL;
+	}
+
+	if (n < 0) {
+		PyErr_SetString(PyExc_ValueError, "n < 0");
+
+		return NULL;
+	}
+
+	return graph_wrap(type, graph_new((size_t) n, directed));
+}
+
+static void graph_dealloc(GraphObject* self) {
+	graph_free(self->g);
+	Py_TYPE(self)->tp_free((PyObject*) self);
+}
+
+/*A inteira, n x n, somente leitura (para escrever: g.writable())*/
+static int graph_getbuffer(GraphObject* self, Py_buffer* view, int flags) {
+	return fill_view(view, (PyObject*) self, self->g->A, "d", sizeof(double),
+		2, self->shape, self->strides, 1, flags);
+}
+
+/*Graph.from_array(a, directed=None): cópia de uma matriz n x n.
+directed = None decide pela simetria de a*/
+static PyObject* graph_from_array(PyTypeObject* type, PyObject* args,
+	PyObject* kwds) {
+	static char* kwlist[] = {"a", "directed", NULL};
+	PyObject *obj, *dir = Py_None;
+	Py_buffer v;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &obj, &dir)
+		|| get_doubles(obj, &v, 2) < 0) {
+		return NULL;
+	}
+
+	size_t n = (size_t) v.shape[0];
+	const double* A = v.buf;
+
+	if (v.shape[0] != v.shape[1]) {
+		PyBuffer_Release(&v);
+		PyErr_SetString(PyExc_ValueError, "a matriz deve ser quadrada");
+
+		return NULL;
+	}
+
+	bool directed = false;
+
+	if (dir == Py_None) {
+		for (size_t i = 0; i < n && !directed; i++) {
+			for (size_t j = i + 1; j < n; j++) {
+				if (A[IDX(i, j, n)] != A[IDX(j, i, n)]) {
+					directed = true;
+					break;
+				}
+			}
+		}
+	} else {
+		directed = PyObject_IsTrue(dir);
+	}
+
+	Graph* g = graph_new(n, directed);
+	memcpy(g->A, A, n * n * sizeof(double));
+	PyBuffer_Release(&v);
+
+	return graph_wrap(type, g);
+}
+
+static PyObject* graph_get_n(GraphObject* self, void* closure) {
+	(void) closure;
+
+	return PyLong_FromSize_t(self->g->n);
+}
+
+static PyObject* graph_get_directed(GraphObject* self, void* closure) {
+	(void) closure;
+
+	return PyBool_FromLong(self->g->directed);
+}
+
+static PyObject* graph_get_version(GraphObject* self, void* closure) {
+	(void) closure;
+
+	return PyLong_FromUnsignedLongLong(graph_version(self->g));
+}
+
+static PyObject* graph_py_add_edge(GraphObject* self, PyObject* args) {
+	Py_ssize_t u, v;
+	double w = 1.0;
+
+	if (!PyArg_ParseTuple(args, "nn|d", &u, &v, &w) || check_idle(self) < 0
+		|| check_vertex(self, u) < 0 || check_vertex(self, v) < 0) {
+		return NULL;
+	}
+
+	graph_add_edge(self->g, (size_t) u, (size_t) v, w);
+
+	Py_RETURN_NONE;
+}
+
+static PyObject* graph_py_remove_edge(GraphObject* self, PyObject* args) {
+	Py_ssize_t u, v;
+
+	if (!PyArg_ParseTuple(args, "nn", &u, &v) || check_idle(self) < 0
+		|| check_vertex(self, u) < 0 || check_vertex(self, v) < 0) {
+		return NULL;
+	}
+
+	graph_remove_edge(self->g, (size_t) u, (size_t) v);
+
+	Py_RETURN_NONE;
+}
+
+static PyObject* graph_py_get(GraphObject* self, PyObject* args) {
+	Py_ssize_t u, v;
+
+	if (!PyArg_ParseTuple(args, "nn", &u, &v) || check_vertex(self, u) < 0
+		|| check_vertex(self, v) < 0) {
+		return NULL;
+	}
+
+	return PyFloat_FromDouble(graph_get(self->g, (size_t) u, (size_t) v));
+}
+
+static PyObject* graph_py_invalidate(GraphObject* self, PyObject* unused) {
+	(void) unused;
+
+	if (check_idle(self) < 0) {
+		return NULL;
+	}
+
+	graph_invalidate(self->g);
+
+	Py_RETURN_NONE;
+}
+
+/*Array gravável sobre g->A (veja o topo do arquivo)*/
+static PyObject* graph_py_writable(GraphObject* self, PyObject* unused) {
+	(void) unused;
+	ArrayObject* a = array_new("d", 2, self->shape, self->g->A,
+		(PyObject*) self);
+
+	if (a) {
+		a->readonly = 0;
+		a->graph_view = 1;
+	}
+
+	return (PyObject*) a;
+}
+
+static PyObject* graph_py_num_edges(GraphObject* self, PyObject* unused) {
+	(void) unused;
+	size_t m;
+	UNLOCKED(self, m = graph_num_edges(self->g));
+
+	return PyLong_FromSize_t(m);
+}
+
+static PyObject* graph_py_is_connected(GraphObject* self, PyObject* unused) {
+	(void) unused;
+	bool c;
+	UNLOCKED(self, c = graph_is_connected(self->g));
+
+	return PyBool_FromLong(c);
+}
+
+static PyObject* graph_py_diameter(GraphObject* self, PyObject* unused) {
+	(void) unused;
+	int d;
+	UNLOCKED(self, d = graph_diameter(self->g));
+
+	return PyLong_FromLong(d);
+}
+
+static PyObject* graph_py_wiener_index(GraphObject* self, PyObject* unused) {
+	(void) unused;
+	double w;
+	UNLOCKED(self, w = graph_wiener_index(self->g));
+
+	return PyFloat_FromDouble(w);
+}
+
+static PyObject* graph_py_log_spanning_trees(GraphObject* self,
+	PyObject* unused) {
+	(void) unused;
+	double t;
+	UNLOCKED(self, t = graph_log_spanning_trees(self->g));
+
+	return PyFloat_FromDouble(t);
+}
+
+static PyObject* graph_py_kirchhoff_index(GraphObject* self,
+	PyObject* unused) {
+	(void) unused;
+	double k;
+	UNLOCKED(self, k = graph_kirchhoff_index(self->g));
+
+	return PyFloat_FromDouble(k);
+}
+
+static PyObject* graph_py_effective_resistance(GraphObject* self,
+	PyObject* args) {
+	Py_ssize_t u, v;
+	double r;
+
+	if (!PyArg_ParseTuple(args, "nn", &u, &v) || check_vertex(self, u) < 0
+		|| check_vertex(self, v) < 0) {
+		return NULL;
+	}
+
+	UNLOCKED(self, r = graph_effective_resistance(self->g, (size_t) u,
+		(size_t) v));
+
+	return PyFloat_FromDouble(r);
+}
+
+/*Vetores e matrizes: cada um em um Array novo, preenchido sem o GIL*/
+static PyObject* graph_py_degree(GraphObject* self, PyObject* unused) {
+	(void) unused;
+	ArrayObject* d = vector_new("d", self->g->n);
+
+	if (d) {
+		UNLOCKED(self, graph_degree(self->g, d->data, NULL));
+	}
+
+	return (PyObject*) d;
+}
+
+static PyObject* graph_py_in_degree(GraphObject* self, PyObject* unused) {
+	(void) unused;
+	ArrayObject* d = vector_new("d", self->g->n);
+
+	if (d) {
+		UNLOCKED(self, graph_degree(self->g, NULL, d->data));
+	}
+
+	return (PyObject*) d;
+}
+
+static PyObject* graph_py_transmission(GraphObject* self, PyObject* unused) {
+	(void) unused;
+	ArrayObject* t = vector_new("d", self->g->n);
+
+	if (t) {
+		UNLOCKED(self, graph_transmission(self->g, t->data));
+	}
+
+	return (PyObject*) t;
+}
+
+static PyObject* graph_py_laplacian(GraphObject* self, PyObject* unused) {
+	(void) unused;
+	ArrayObject* L = matrix_new(self->g->n, self->g->n);
+
+	if (L) {
+		UNLOCKED(self, graph_laplacian(self->g, L->data));
+	}
+
+	return (PyObject*) L;
+}
+
+static PyObject* graph_py_normalized_laplacian(GraphObject* self,
+	PyObject* unused) {
+	(void) unused;
+	ArrayObject* L = matrix_new(self->g->n, self->g->n);
+
+	if (L) {
+		UNLOCKED(self, graph_normalized_laplacian(self->g, L->data));
+	}
+
+	return (PyObject*) L;
+}
+
+static PyObject* graph_py_distance_matrix(GraphObject* self,
+	PyObject* unused) {
+	(void) unused;
+	ArrayObject* D = matrix_new(self->g->n, self->g->n);
+
+	if (D) {
+		UNLOCKED(self, graph_distance_matrix(self->g, D->data));
+	}
+
+	return (PyObject*) D;
+}
+
+/*(c, label): número de componentes e a componente de cada vértice*/
+static PyObject* graph_py_components(GraphObject* self, PyObject* unused) {
+	(void) unused;
+	ArrayObject* label = vector_new("N", self->g->n);
+	size_t c;
+
+	if (!label) {
+		return NULL;
+	}
+
+	UNLOCKED(self, c = graph_components(self->g, label->data));
+
+	return Py_BuildValue("(nN)", (Py_ssize_t) c, label);
+}
+
+/*Espectros: o int de erro vira ValueError (-1: espectro complexo ou
+grafo inválido para a matriz pedida) ou RuntimeError (LAPACK)*/
+static PyObject* spec_result(ArrayObject* x, int err) {
+	if (err == 0) {
+		return (PyObject*) x;
+	}
+
+	Py_DECREF(x);
+
+	if (err < 0) {
+		PyErr_SetString(PyExc_ValueError, "espectro indefinido para este grafo "
+			"(direcionado não simétrico ou desconexo)");
+	} else {
+		PyErr_Format(PyExc_RuntimeError, "LAPACK retornou info = %d", err);
+	}
+
+	return NULL;
+}
+
+#define SPEC_METHOD(name, fn) \
+	static PyObject* name(GraphObject* self, PyObject* unused) { \
+		(void) unused; \
+		ArrayObject* x = vector_new("d", self->g->n); \
+		int err; \
+		if (!x) { \
+			return NULL; \
+		} \
+		UNLOCKED(self, err = fn(self->g, x->data)); \
+		return spec_result(x, err); \
+	}
+
+SPEC_METHOD(graph_py_spec_adj, graph_spec_adj)
+SPEC_METHOD(graph_py_spec_lap, graph_spec_lap)
+SPEC_METHOD(graph_py_spec_distance, graph_spec_distance)
+SPEC_METHOD(graph_py_spec_distance_laplacian, graph_spec_distance_laplacian)
+
+static PyObject* graph_py_csr(GraphObject* self, PyObject* unused) {
+	(void) unused;
+	GraphCSR* c;
+	UNLOCKED(self, c = graph_csr_from_graph(self->g));
+
+	return csr_wrap(c);
+}
+
+/*sparsify(eps, how="resistance", seed=None)*/
+static PyObject* graph_py_sparsify(GraphObject* self, PyObject* args,
+	PyObject* kwds) {
+	static char* kwlist[] = {"eps", "how", "seed", NULL};
+	double eps;
+	const char* how = "resistance";
+	PyObject* seed = Py_None;
+	Rng rng, *r;
+	GraphSparsifier s;
+	GraphCSR* h;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "d|sO", kwlist, &eps, &how,
+		&seed) || get_rng(seed, &rng, &r) < 0) {
+		return NULL;
+	}
+
+	if (strcmp(how, "resistance") == 0) {
+		s = GRAPH_SPARSIFY_RESISTANCE;
+	} else if (strcmp(how, "degree") == 0) {
+		s = GRAPH_SPARSIFY_DEGREE;
+	} else {
+		PyErr_SetString(PyExc_ValueError, "how deve ser 'resistance' ou "
+			"'degree'");
+
+		return NULL;
+	}
+
+	UNLOCKED(self, h = graph_sparsify_r(self->g, eps, s, r));
+
+	return csr_wrap(h);
+}
+
+static PyGetSetDef graph_getset[] = {
+	{"n", (getter) graph_get_n, NULL, "número de vértices", NULL},
+	{"directed", (getter) graph_get_directed, NULL, "direcionado?", NULL},
+	{"version", (getter) graph_get_version, NULL, "n° de modificações", NULL},
+	{NULL, NULL, NULL, NULL, NULL}
+};
+
+#define NOARGS(name, fn, doc) {name, (PyCFunction) fn, METH_NOARGS, doc}
+
+static PyMethodDef graph_methods[] = {
+	{"from_array", (PyCFunction) (void (*)(void)) graph_from_array,
+		METH_VARARGS | METH_KEYWORDS | METH_CLASS,
+		"from_array(a, directed=None): grafo com A = cópia de a (n x n)"},
+	{"add_edge", (PyCFunction) graph_py_add_edge, METH_VARARGS,
+		"add_edge(u, v, w=1.0)"},
+	{"remove_edge", (PyCFunction) graph_py_remove_edge, METH_VARARGS,
+		"remove_edge(u, v)"},
+	{"get", (PyCFunction) graph_py_get, METH_VARARGS, "get(u, v): A[u, v]"},
+	NOARGS("invalidate", graph_py_invalidate,
+		"descarta o cache (depois de escrever em A pela view)"),
+	NOARGS("writable", graph_py_writable,
+		"Array gravável sobre A; soltar a view chama invalidate()"),
+	NOARGS("num_edges", graph_py_num_edges, "número de arestas"),
+	NOARGS("is_connected", graph_py_is_connected, "g é conexo?"),
+	NOARGS("diameter", graph_py_diameter, "diâmetro (em arestas)"),
+	NOARGS("wiener_index", graph_py_wiener_index, "índice de Wiener"),
+	NOARGS("log_spanning_trees", graph_py_log_spanning_trees,
+		"log do número de árvores geradoras"),
+	NOARGS("kirchhoff_index", graph_py_kirchhoff_index,
+		"índice de Kirchhoff"),
+	{"effective_resistance", (PyCFunction) graph_py_effective_resistance,
+		METH_VARARGS, "effective_resistance(u, v)"},
+	NOARGS("degree", graph_py_degree, "graus (de saída)"),
+	NOARGS("in_degree", graph_py_in_degree, "graus de entrada"),
+	NOARGS("transmission", graph_py_transmission, "transmissões"),
+	NOARGS("laplacian", graph_py_laplacian, "L = D - A"),
+	NOARGS("normalized_laplacian", graph_py_normalized_laplacian,
+		"laplaciana normalizada"),
+	NOARGS("distance_matrix", graph_py_distance_matrix,
+		"matriz de distâncias"),
+	NOARGS("components", graph_py_components,
+		"(c, label): componentes conexas"),
+	NOARGS("spec_adj", graph_py_spec_adj, "espectro de A (crescente)"),
+	NOARGS("spec_lap", graph_py_spec_lap, "espectro de L (crescente)"),
+	NOARGS("spec_distance", graph_py_spec_distance,
+		"espectro da matriz de distâncias"),
+	NOARGS("spec_distance_laplacian", graph_py_spec_distance_laplacian,
+		"espectro da laplaciana de distâncias"),
+	NOARGS("csr", graph_py_csr, "representação esparsa (CSR)"),
+	{"sparsify", (PyCFunction) (void (*)(void)) graph_py_sparsify,
+		METH_VARARGS | METH_KEYWORDS,
+		"sparsify(eps, how='resistance', seed=None): esparsificador (CSR)"},
+	{NULL, NULL, 0, NULL}
+};
+
+static PyBufferProcs graph_as_buffer = {
+	.bf_getbuffer = (getbufferproc) graph_getbuffer,
+};
+
+static PyTypeObject GraphType = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	.tp_name = "graphs.Graph",
+	.tp_basicsize = sizeof(GraphObject),
+	.tp_dealloc = (destructor) graph_dealloc,
+	.tp_as_buffer = &graph_as_buffer,
+	.tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+	.tp_doc = "Graph(n, directed=False). O buffer do grafo é a própria "
+		"matriz de adjacência, somente leitura: numpy.asarray(g) não "
+		"copia. Para escrever em A use g.writable()",
+	.tp_methods = graph_methods,
+	.tp_getset = graph_getset,
+	.tp_new = graph_py_new,
+};
+
+
+/* --- Geradores --- */
+
+/*Geradores densos: seed None usa rand()*/
+static PyObject* py_random(PyObject* m, PyObject* args, PyObject* kwds) {
+	(void) m;
+	static char* kwlist[] = {"n", "p", "seed", NULL};
+	Py_ssize_t n;
+	double p;
+	PyObject* seed = Py_None;
+	Rng rng, *r;
+	Graph* g;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "nd|O", kwlist, &n, &p,
+		&seed) || get_rng(seed, &rng, &r) < 0) {
+		return NULL;
+	}
+
+	if (n < 0 || !(p >= 0.0 && p <= 1.0)) {
+		PyErr_SetString(PyExc_ValueError, "n < 0 ou p fora de [0, 1]");
+
+		return NULL;
+	}
+
+	Py_BEGIN_ALLOW_THREADS
+	g = graph_random_r((size_t) n, p, r);
+	Py_END_ALLOW_THREADS
+
+	return graph_wrap(&GraphType, g);
+}
+
+static PyObject* py_random_connected(PyObject* m, PyObject* args,
+	PyObject* kwds) {
+	(void) m;
+	static char* kwlist[] = {"n", "p", "seed", NULL};
+	int n;
+	double p;
+	PyObject* seed = Py_None;
+	Rng rng, *r;
+	Graph* g;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "id|O", kwlist, &n, &p,
+		&seed) || get_rng(seed, &rng, &r) < 0) {
+		return NULL;
+	}
+
+	if (n < 0) {
+		PyErr_SetString(PyExc_ValueError, "n < 0");
+
+		return NULL;
+	}
+
+	Py_BEGIN_ALLOW_THREADS
+	g = graph_random_connected_r(n, p, r);
+	Py_END_ALLOW_THREADS
+
+	return graph_wrap(&GraphType, g);
+}
+
+static PyObject* py_random_regular(PyObject* m, PyObject* args,
+	PyObject* kwds) {
+	(void) m;
+	static char* kwlist[] = {"n", "k", "seed", NULL};
+	Py_ssize_t n, k;
+	PyObject* seed = Py_None;
+	Rng rng, *r;
+	Graph* g;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "nn|O", kwlist, &n, &k,
+		&seed) || get_rng(seed, &rng, &r) < 0) {
+		return NULL;
+	}
+
+	if (n < 0 || k < 0) {
+		PyErr_SetString(PyExc_ValueError, "n < 0 ou k < 0");
+
+		return NULL;
+	}
+
+	Py_BEGIN_ALLOW_THREADS
+	g = graph_random_regular_r((size_t) n, (size_t) k, r);
+	Py_END_ALLOW_THREADS
+
+	return graph_wrap(&GraphType, g);
+}
+
+static PyObject* py_random_bipartite(PyObject* m, PyObject* args,
+	PyObject* kwds) {
+	(void) m;
+	static char* kwlist[] = {"n1", "n2", "p", "seed", NULL};
+	Py_ssize_t n1, n2;
+	double p;
+	PyObject* seed = Py_None;
+	Rng rng, *r;
+	Graph* g;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "nnd|O", kwlist, &n1, &n2,
+		&p, &seed) || get_rng(seed, &rng, &r) < 0) {
+		return NULL;
+	}
+
+	if (n1 < 0 || n2 < 0) {
+		PyErr_SetString(PyExc_ValueError, "n1 < 0 ou n2 < 0");
+
+		return NULL;
+	}
+
+	Py_BEGIN_ALLOW_THREADS
+	g = graph_random_bipartite_r((size_t) n1, (size_t) n2, p, r);
+	Py_END_ALLOW_THREADS
+
+	return graph_wrap(&GraphType, g);
+}
+
+/*Famílias (families.h)*/
+static PyObject* py_complete(PyObject* m, PyObject* args) {
+	(void) m;
+	Py_ssize_t n;
+
+	if (!PyArg_ParseTuple(args, "n", &n)) {
+		return NULL;
+	}
+
+	if (n < 0) {
+		PyErr_SetString(PyExc_ValueError, "n < 0");
+
+		return NULL;
+	}
+
+	return graph_wrap(&GraphType, graph_kn((size_t) n));
+}
+
+static PyObject* py_cycle(PyObject* m, PyObject* args) {
+	(void) m;
+	Py_ssize_t n;
+
+	if (!PyArg_ParseTuple(args, "n", &n)) {
+		return NULL;
+	}
+
+	if (n < 3) {
+		PyErr_SetString(PyExc_ValueError, "n < 3");
+
+		return NULL;
+	}
+
+	return graph_wrap(&GraphType, graph_cycle((size_t) n));
+}
+
+static PyObject* py_path(PyObject* m, PyObject* args) {
+	(void) m;
+	Py_ssize_t n;
+
+	if (!PyArg_ParseTuple(args, "n", &n)) {
+		return NULL;
+	}
+
+	if (n < 0) {
+		PyErr_SetString(PyExc_ValueError, "n < 0");
+
+		return NULL;
+	}
+
+	return graph_wrap(&GraphType, graph_path((size_t) n));
+}
+
+static PyObject* py_complete_bipartite(PyObject* m, PyObject* args) {
+	(void) m;
+	Py_ssize_t a, b;
+
+	if (!PyArg_ParseTuple(args, "nn", &a, &b)) {
+		return NULL;
+	}
+
+	if (a < 0 || b < 0) {
+		PyErr_SetString(PyExc_ValueError, "a < 0 ou b < 0");
+
+		return NULL;
+	}
+
+	return graph_wrap(&GraphType, graph_complete_bipartite((size_t) a,
+		(size_t) b));
+}
+
+static PyObject* py_hypercube(PyObject* m, PyObject* args) {
+	(void) m;
+	Py_ssize_t d;
+
+	if (!PyArg_ParseTuple(args, "n", &d)) {
+		return NULL;
+	}
+
+	if (d < 0 || (size_t) d >= 8 * sizeof(size_t) / 2) {
+		PyErr_SetString(PyExc_ValueError, "d fora do intervalo");
+
+		return NULL;
+	}
+
+	return graph_wrap(&GraphType, graph_hypercube((size_t) d));
+}
+
+/*Lista de inteiros >= 0 em size_t (free-after-use)*/
+static size_t* get_sizes(PyObject* seq, size_t* k) {
+	PyObject* fast = PySequence_Fast(seq, "esperava uma sequência de inteiros");
+
+	if (!fast) {
+		return NULL;
+	}
+
+	*k = (size_t) PySequence_Fast_GET_SIZE(fast);
+	size_t* s = malloc(*k * sizeof(size_t) + 1);
+
+	if (!s) {
+		Py_DECREF(fast);
+
+		return (size_t*) PyErr_NoMemory();
+	}
+
+	for (size_t i = 0; i < *k; i++) {
+		s[i] = PyLong_AsSize_t(PySequence_Fast_GET_ITEM(fast, i));
+
+		if (PyErr_Occurred()) {
+			free(s);
+			Py_DECREF(fast);
+
+			return NULL;
+		}
+	}
+
+	Py_DECREF(fast);
+
+	return s;
+}
+
+static PyObject* py_circulant(PyObject* m, PyObject* args) {
+	(void) m;
+	Py_ssize_t n;
+	PyObject* seq;
+	size_t k;
+
+	if (!PyArg_ParseTuple(args, "nO", &n, &seq)) {
+		return NULL;
+	}
+
+	size_t* S = get_sizes(seq, &k);
+
+	if (!S) {
+		return NULL;
+	}
+
+	for (size_t i = 0; i < k; i++) {
+		if (n <= 0 || S[i] % (size_t) n == 0) {
+			free(S);
+			PyErr_SetString(PyExc_ValueError, "S não pode conter 0 (mod n)");
+
+			return NULL;
+		}
+	}
+
+	Graph* g = graph_circulant((size_t) n, S, k);
+	free(S);
+
+	return graph_wrap(&GraphType, g);
+}
+
+/*Geradores esparsos (generators.h): seed é obrigatória na API C e
+aqui tem padrão 0*/
+static PyObject* py_ba(PyObject* m, PyObject* args, PyObject* kwds) {
+	(void) m;
+	static char* kwlist[] = {"n", "m", "seed", NULL};
+	Py_ssize_t n, k;
+	unsigned long long seed = 0;
+	GraphCSR* g;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "nn|K", kwlist, &n, &k,
+		&seed)) {
+		return NULL;
+	}
+
+	if (n < 0 || k < 0) {
+		PyErr_SetString(PyExc_ValueError, "n < 0 ou m < 0");
+
+		return NULL;
+	}
+
+	Py_BEGIN_ALLOW_THREADS
+	g = graph_csr_random_ba((size_t) n, (size_t) k, seed);
+	Py_END_ALLOW_THREADS
+
+	return csr_wrap(g);
+}
+
+static PyObject* py_chung_lu(PyObject* m, PyObject* args, PyObject* kwds) {
+	(void) m;
+	static char* kwlist[] = {"w", "seed", NULL};
+	PyObject* obj;
+	unsigned long long seed = 0;
+	Py_buffer v;
+	GraphCSR* g;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|K", kwlist, &obj, &seed)
+		|| get_doubles(obj, &v, 1) < 0) {
+		return NULL;
+	}
+
+	Py_BEGIN_ALLOW_THREADS
+	g = graph_csr_random_chung_lu((size_t) v.shape[0], v.buf, seed);
+	Py_END_ALLOW_THREADS
+
+	PyBuffer_Release(&v);
+
+	return csr_wrap(g);
+}
+
+static PyObject* py_powerlaw_weights(PyObject* m, PyObject* args) {
+	(void) m;
+	Py_ssize_t n;
+	double gamma, avg;
+
+	if (!PyArg_ParseTuple(args, "ndd", &n, &gamma, &avg)) {
+		return NULL;
+	}
+
+	if (n < 0 || !(gamma > 2.0)) {
+		PyErr_SetString(PyExc_ValueError, "n < 0 ou gamma <= 2");
+
+		return NULL;
+	}
+
+	ArrayObject* w = vector_new("d", (size_t) n);
+
+	if (w) {
+		graph_powerlaw_weights((size_t) n, gamma, avg, w->data);
+	}
+
+	return (PyObject*) w;
+}
+
+static PyObject* py_rmat(PyObject* m, PyObject* args, PyObject* kwds) {
+	(void) m;
+	static char* kwlist[] = {"scale", "edge_factor", "a", "b", "c", "seed",
+		NULL};
+	unsigned int scale;
+	Py_ssize_t ef;
+	double a = 0.57, b = 0.19, c = 0.19;
+	unsigned long long seed = 0;
+	GraphCSR* g;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "In|dddK", kwlist, &scale,
+		&ef, &a, &b, &c, &seed)) {
+		return NULL;
+	}
+
+	if (ef < 0) {
+		PyErr_SetString(PyExc_ValueError, "edge_factor < 0");
+
+		return NULL;
+	}
+
+	Py_BEGIN_ALLOW_THREADS
+	g = graph_csr_random_rmat(scale, (size_t) ef, a, b, c, seed);
+	Py_END_ALLOW_THREADS
+
+	return csr_wrap(g);
+}
+
+/*sbm(sizes, P, seed=0) -> (CSR, label)*/
+static PyObject* py_sbm(PyObject* m, PyObject* args, PyObject* kwds) {
+	(void) m;
+	static char* kwlist[] = {"sizes", "P", "seed", NULL};
+	PyObject *seq, *obj;
+	unsigned long long seed = 0;
+	Py_buffer v;
+	size_t k, n = 0;
+	GraphCSR* g = NULL;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|K", kwlist, &seq, &obj,
+		&seed)) {
+		return NULL;
+	}
+
+	size_t* sizes = get_sizes(seq, &k);
+
+	if (!sizes) {
+		return NULL;
+	}
+
+	if (get_doubles(obj, &v, 2) < 0) {
+		free(sizes);
+
+		return NULL;
+	}
+
+	if ((size_t) v.shape[0] != k || (size_t) v.shape[1] != k) {
+		free(sizes);
+		PyBuffer_Release(&v);
+		PyErr_SetString(PyExc_ValueError, "P deve ser k x k");
+
+		return NULL;
+	}
+
+	for (size_t i = 0; i < k; i++) {
+		n += sizes[i];
+	}
+
+	ArrayObject* label = vector_new("N", n);
+
+	if (label) {
+		Py_BEGIN_ALLOW_THREADS
+		g = graph_csr_random_sbm(k, sizes, v.buf, seed, label->data);
+		Py_END_ALLOW_THREADS
+	}
+
+	free(sizes);
+	PyBuffer_Release(&v);
+
+	if (!label) {
+		return NULL;
+	}
+
+	PyObject* csr = csr_wrap(g);
+
+	if (!csr) {
+		Py_DECREF(label);
+
+		return NULL;
+	}
+
+	return Py_BuildValue("(NN)", csr, label);
+}
+
+
+/* --- Espectros de matrizes e em lote --- */
+
+static PyObject* py_matrix_spec(PyObject* m, PyObject* args) {
+	(void) m;
+	PyObject* obj;
+	Py_buffer v;
+	int err;
+
+	if (!PyArg_ParseTuple(args, "O", &obj) || get_doubles(obj, &v, 2) < 0) {
+		return NULL;
+	}
+
+	if (v.shape[0] != v.shape[1]) {
+		PyBuffer_Release(&v);
+		PyErr_SetString(PyExc_ValueError, "a matriz deve ser quadrada");
+
+		return NULL;
+	}
+
+	ArrayObject* x = vector_new("d", (size_t) v.shape[0]);
+
+	if (!x) {
+		PyBuffer_Release(&v);
+
+		return NULL;
+	}
+
+	Py_BEGIN_ALLOW_THREADS
+	err = matrix_spec(v.buf, (size_t) v.shape[0], x->data);
+	Py_END_ALLOW_THREADS
+
+	PyBuffer_Release(&v);
+
+	return spec_result(x, err);
+}
+
+/*matrix_spec_batch(a): a é count x n x n; devolve count x n*/
+static PyObject* py_matrix_spec_batch(PyObject* m, PyObject* args) {
+	(void) m;
+	PyObject* obj;
+	Py_buffer v;
+
+	if (!PyArg_ParseTuple(args, "O", &obj) || get_doubles(obj, &v, 3) < 0) {
+		return NULL;
+	}
+
+	size_t count = (size_t) v.shape[0], n = (size_t) v.shape[1];
+
+	if (v.shape[1] != v.shape[2] || n > BATCH_MAX_N) {
+		PyBuffer_Release(&v);
+		PyErr_Format(PyExc_ValueError, "esperava count x n x n com n <= %d",
+			BATCH_MAX_N);
+
+		return NULL;
+	}
+
+	ArrayObject* w = matrix_new(count, n);
+	int err = 0;
+
+	if (!w) {
+		PyBuffer_Release(&v);
+
+		return NULL;
+	}
+
+	Py_BEGIN_ALLOW_THREADS
+	err = matrix_spec_batch(v.buf, n, count, w->data);
+	Py_END_ALLOW_THREADS
+
+	PyBuffer_Release(&v);
+
+	return spec_result(w, err);
+}
+
+/*Espectros de uma lista de grafos com o mesmo n (count x n). Até
+BATCH_MAX_N vértices vai pelo lote vetorizado (batch.h); acima disso,
+um graph_spec_* por grafo, ainda sem o GIL*/
+static PyObject* spec_list(PyObject* seq, bool lap) {
+	PyObject* fast = PySequence_Fast(seq, "esperava uma lista de Graph");
+
+	if (!fast) {
+		return NULL;
+	}
+
+	size_t count = (size_t) PySequence_Fast_GET_SIZE(fast), n = 0;
+	PyObject** items = PySequence_Fast_ITEMS(fast);
+	Graph** g = malloc(count * sizeof(Graph*) + 1);
+
+	if (!g) {
+		Py_DECREF(fast);
+
+		return PyErr_NoMemory();
+	}
+
+	for (size_t k = 0; k < count; k++) {
+		if (!PyObject_TypeCheck(items[k], &GraphType)) {
+			PyErr_SetString(PyExc_TypeError, "esperava uma lista de Graph");
+			goto fail;
+		}
+
+		g[k] = ((GraphObject*) items[k])->g;
+
+		if (g[k]->n != g[0]->n) {
+			PyErr_SetString(PyExc_ValueError, "os grafos devem ter o mesmo n");
+			goto fail;
+		}
+
+		n = g[k]->n;
+	}
+
+	ArrayObject* w = matrix_new(count, n);
+	int err = 0;
+
+	if (!w) {
+		goto fail;
+	}
+
+	for (size_t k = 0; k < count; k++) {
+		((GraphObject*) items[k])->busy++;
+	}
+
+	Py_BEGIN_ALLOW_THREADS
+
+	if (n <= BATCH_MAX_N) {
+		err = lap ? graph_spec_lap_batch(g, count, w->data)
+			: graph_spec_adj_batch(g, count, w->data);
+	} else {
+		for (size_t k = 0; k < count && err == 0; k++) {
+			double* x = (double*) w->data + k * n;
+			err = lap ? graph_spec_lap(g[k], x) : graph_spec_adj(g[k], x);
+		}
+	}
+
+	Py_END_ALLOW_THREADS
+
+	for (size_t k = 0; k < count; k++) {
+		((GraphObject*) items[k])->busy--;
+	}
+
+	free(g);
+	Py_DECREF(fast);
+
+	return spec_result(w, err);
+
+fail:
+	free(g);
+	Py_DECREF(fast);
+
+	return NULL;
+}
+
+static PyObject* py_spec_adj_batch(PyObject* m, PyObject* seq) {
+	(void) m;
+
+	return spec_list(seq, false);
+}
+
+static PyObject* py_spec_lap_batch(PyObject* m, PyObject* seq) {
+	(void) m;
+
+	return spec_list(seq, true);
+}
+
+static PyObject* py_num_threads(PyObject* m, PyObject* unused) {
+	(void) m;
+	(void) unused;
+
+	return PyLong_FromSize_t(graph_num_threads());
+}
+
+
+/* --- Módulo --- */
+
+#define KWARGS(name, fn, doc) \
+	{name, (PyCFunction) (void (*)(void)) fn, METH_VARARGS | METH_KEYWORDS, doc}
+
+static PyMethodDef module_methods[] = {
+	KWARGS("random", py_random, "random(n, p, seed=None): G(n, p)"),
+	KWARGS("random_connected", py_random_connected,
+		"random_connected(n, p, seed=None)"),
+	KWARGS("random_regular", py_random_regular,
+		"random_regular(n, k, seed=None)"),
+	KWARGS("random_bipartite", py_random_bipartite,
+		"random_bipartite(n1, n2, p, seed=None)"),
+	{"complete", py_complete, METH_VARARGS, "complete(n): K_n"},
+	{"cycle", py_cycle, METH_VARARGS, "cycle(n): C_n"},
+	{"path", py_path, METH_VARARGS, "path(n): P_n"},
+	{"complete_bipartite", py_complete_bipartite, METH_VARARGS,
+		"complete_bipartite(a, b): K_{a,b}"},
+	{"hypercube", py_hypercube, METH_VARARGS, "hypercube(d): Q_d"},
+	{"circulant", py_circulant, METH_VARARGS,
+		"circulant(n, S): circulante com conexões S"},
+	KWARGS("ba", py_ba, "ba(n, m, seed=0): Barabási-Albert (CSR)"),
+	KWARGS("chung_lu", py_chung_lu,
+		"chung_lu(w, seed=0): Chung-Lu com graus esperados w (CSR)"),
+	{"powerlaw_weights", py_powerlaw_weights, METH_VARARGS,
+		"powerlaw_weights(n, gamma, avg_degree)"},
+	KWARGS("rmat", py_rmat,
+		"rmat(scale, edge_factor, a=0.57, b=0.19, c=0.19, seed=0) (CSR)"),
+	KWARGS("sbm", py_sbm, "sbm(sizes, P, seed=0) -> (CSR, label)"),
+	{"matrix_spec", py_matrix_spec, METH_VARARGS,
+		"matrix_spec(a): espectro de uma matriz simétrica n x n"},
+	{"matrix_spec_batch", py_matrix_spec_batch, METH_VARARGS,
+		"matrix_spec_batch(a): espectros de count matrizes n x n (n <= 32)"},
+	{"spec_adj_batch", py_spec_adj_batch, METH_O,
+		"spec_adj_batch(graphs): espectros de A, count x n"},
+	{"spec_lap_batch", py_spec_lap_batch, METH_O,
+		"spec_lap_batch(graphs): espectros de L, count x n"},
+	{"num_threads", py_num_threads, METH_NOARGS,
+		"threads usadas pelas rotinas paralelas"},
+	{NULL, NULL, 0, NULL}
+};
+
+static struct PyModuleDef graphs_module = {
+	PyModuleDef_HEAD_INIT,
+	.m_name = "graphs",
+	.m_doc = "Grafos e espectros (veja python/graphsmodule.c)",
+	.m_size = -1,
+	.m_methods = module_methods,
+};
+
+PyMODINIT_FUNC PyInit_graphs(void) {
+	if (PyType_Ready(&ArrayType) < 0 || PyType_Ready(&CSRType) < 0
+		|| PyType_Ready(&GraphType) < 0) {
+		return NULL;
+	}
+
+	PyObject* m = PyModule_Create(&graphs_module);
+
+	if (!m) {
+		return NULL;
+	}
+
+	if (PyModule_AddObjectRef(m, "Graph", (PyObject*) &GraphType) < 0
+		|| PyModule_AddObjectRef(m, "CSR", (PyObject*) &CSRType) < 0
+		|| PyModule_AddObjectRef(m, "Array", (PyObject*) &ArrayType) < 0
+		|| PyModule_AddIntConstant(m, "BATCH_MAX_N", BATCH_MAX_N) < 0) {
+		Py_DECREF(m);
+
+		return NULL;
+	}
+
+	return m;
+}
@@ -0,0 +1,472 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <lapacke.h>
+#include "analyze.h"
+#include "eig.h"
+#include "cache.h"
+#include "families.h"
+#include "components.h"
+#include "bipartite.h"
+#include "mem.h"
+
+/*Linhas por bloco na comparação A[i][j] x A[j][i]*/
+#define SYM_BLOCK 32
+
+
+/* --- Union-find com paridade --- */
+
+/*par[v] = paridade do caminho v -> parent[v]; numa aresta u-v as
+paridades até a raiz têm de ser diferentes (2-coloração)*/
+typedef struct {
+	size_t* parent;
+	size_t* size;
+	unsigned char* par;
+	bool bipartite;
+} ParityUF;
+
+static size_t uf_find(ParityUF* uf, size_t v, unsigned* parity) {
+	size_t r = v;
+	unsigned acc = 0;
+
+	while (uf->parent[r] != r) {
+		acc ^= uf->par[r];
+		r = uf->parent[r];
+	}
+
+	/*compressão: cada vértice do caminho aponta direto para a raiz*/
+	size_t u = v;
+	unsigned pu = acc;
+
+	while (u != r) {
+		size_t next = uf->parent[u];
+		unsigned pn = pu ^ uf->par[u];
+		uf->parent[u] = r;
+		uf->par[u] = (unsigned char) pu;
+		u = next;
+		pu = pn;
+	}
+
+	*parity = acc;
+
+	return r;
+}
+
+static void uf_edge(ParityUF* uf, size_t u, size_t v) {
+	unsigned pu, pv;
+	size_t ru = uf_find(uf, u, &pu);
+	size_t rv = uf_find(uf, v, &pv);
+
+	if (ru == rv) {
+		if (pu == pv) {
+			uf->bipartite = false;
+		}
+
+		return;
+	}
+
+	if (uf->size[ru] < uf->size[rv]) {
+		size_t t = ru;
+		ru = rv;
+		rv = t;
+	}
+
+	uf->parent[rv] = ru;
+	uf->par[rv] = (unsigned char) (pu ^ pv ^ 1u);
+	uf->size[ru] += uf->size[rv];
+}
+
+
+/* --- Diâmetro --- */
+
+typedef struct {
+	size_t n;
+	const size_t* rowptr;
+	const size_t* col;
+	size_t first, step;		/* Origens first, first + step, ...*/
+	int result;
+} DiamJob;
+
+static void* diam_worker(void* arg) {
+	DiamJob* j = arg;
+	size_t n = j->n;
+	size_t* dist = malloc(n * sizeof(size_t));
+	size_t* queue = malloc(n * sizeof(size_t));
+
+	if (!dist || !queue) {
+		die("malloc error (dist || queue)");
+	}
+
+	j->result = 0;
+
+	for (size_t s = j->first; s < n; s += j->step) {
+		for (size_t v = 0; v < n; v++) {
+			dist[v] = SIZE_MAX;
+		}
+
+		size_t head = 0, tail = 0;
+		dist[s] = 0;
+		queue[tail++] = s;
+
+		while (head < tail) {
+			size_t u = queue[head++];
+
+			for (size_t e = j->rowptr[u]; e < j->rowptr[u + 1]; e++) {
+				size_t v = j->col[e];
+
+				if (dist[v] == SIZE_MAX) {
+					dist[v] = dist[u] + 1;
+					queue[tail++] = v;
+				}
+			}
+		}
+
+		/*o último da fila é o mais distante*/
+		if ((int) dist[queue[tail - 1]] > j->result) {
+			j->result = (int) dist[queue[tail - 1]];
+		}
+	}
+
+	free(dist);
+	free(queue);
+
+	return NULL;
+}
+
+static int csr_diameter(size_t n, const size_t* rowptr, const size_t* col) {
+	size_t nt = graph_num_threads();
+
+	if (nt > n) {
+		nt = n ? n : 1;
+	}
+
+	DiamJob* jobs = malloc(nt * sizeof(DiamJob));
+	pthread_t* th = malloc(nt * sizeof(pthread_t));
+
+	if (!jobs || !th) {
+		die("malloc error (jobs || th)");
+	}
+
+	for (size_t t = 0; t < nt; t++) {
+		jobs[t] = (DiamJob) {n, rowptr, col, t, nt, 0};
+	}
+
+	if (nt == 1) {
+		diam_worker(&jobs[0]);
+	} else {
+		for (size_t t = 0; t < nt; t++) {
+			if (pthread_create(&th[t], NULL, diam_worker, &jobs[t]) != 0) {
+				die("pthread_create");
+			}
+		}
+
+		for (size_t t = 0; t < nt; t++) {
+			pthread_join(th[t], NULL);
+		}
+	}
+
+	int d = 0;
+
+	for (size_t t = 0; t < nt; t++) {
+		d = jobs[t].result > d ? jobs[t].result : d;
+	}
+
+	free(jobs);
+	free(th);
+
+	return d;
+}
+
+
+/* --- Análise --- */
+
+static void* alloc_or_die(size_t count, size_t size) {
+	void* p = malloc((count ? count : 1) * size);
+
+	if (!p) {
+		die("malloc error (graph_analyze)");
+	}
+
+	return p;
+}
+
+int graph_analyze(const Graph* g, unsigned flags, GraphReport* r) {
+	size_t n = g->n;
+
+	memset(r, 0, sizeof(GraphReport));
+	r->n = n;
+	r->symmetric = true;
+	r->diameter = -1;
+
+	/*espectros que já saem de família ou cache não precisam de nada
+	da passada*/
+	bool adj_done = false, lap_done = false;
+
+	if (flags & GRAPH_ANALYZE_SPEC_ADJ) {
+		r->spec_adj = alloc_or_die(n, sizeof(double));
+		adj_done = graph_family_spec(g, r->spec_adj, false)
+			|| graph_cache_get_vec(g, GRAPH_CACHE_SPEC_ADJ, r->spec_adj, n);
+	}
+
+	if (flags & GRAPH_ANALYZE_SPEC_LAP) {
+		r->spec_lap = alloc_or_die(n, sizeof(double));
+		lap_done = graph_family_spec(g, r->spec_lap, true)
+			|| graph_cache_get_vec(g, GRAPH_CACHE_SPEC_LAP, r->spec_lap, n);
+	}
+
+	bool keep_L = flags & GRAPH_ANALYZE_LAPLACIAN;
+	bool need_L = keep_L || ((flags & GRAPH_ANALYZE_SPEC_LAP) && !lap_done);
+	bool need_csr = flags & GRAPH_ANALYZE_DIAMETER;
+
+	double* deg_out = calloc(n + 1, sizeof(double));
+	double* deg_in = calloc(n + 1, sizeof(double));
+	ParityUF uf = {alloc_or_die(n, sizeof(size_t)),
+		alloc_or_die(n, sizeof(size_t)), calloc(n + 1, 1), true};
+	double* L = need_L ? graph_mem_alloc(n * n * sizeof(double)) : NULL;
+	size_t* rowptr = need_csr ? alloc_or_die(n + 1, sizeof(size_t)) : NULL;
+	size_t cap = need_csr ? 4 * n + 16 : 0, nnz = 0;
+	size_t* col = need_csr ? alloc_or_die(cap, sizeof(size_t)) : NULL;
+
+	if (!deg_out || !deg_in || !uf.par) {
+		die("malloc error (graph_analyze)");
+	}
+
+	for (size_t v = 0; v < n; v++) {
+		uf.parent[v] = v;
+		uf.size[v] = 1;
+	}
+
+	/*a passada: blocos de SYM_BLOCK linhas; cada linha é lida uma vez
+	por inteiro e, para a simetria, o pedaço A[j][i0..i1) das linhas
+	seguintes (contíguo) é comparado com a coluna j do bloco*/
+	size_t nonzero = 0;
+
+	if (rowptr) {
+		rowptr[0] = 0;
+	}
+
+	for (size_t i0 = 0; i0 < n; i0 += SYM_BLOCK) {
+		size_t i1 = i0 + SYM_BLOCK < n ? i0 + SYM_BLOCK : n;
+
+		for (size_t i = i0; i < i1; i++) {
+			const double* row = &g->A[IDX(i, 0, n)];
+			double* lrow = L ? &L[IDX(i, 0, n)] : NULL;
+			double s = 0.0;
+
+			for (size_t j = 0; j < n; j++) {
+				double a = row[j];
+
+				if (lrow) {
+					lrow[j] = -a;
+				}
+
+				if (a == 0.0) {
+					continue;
+				}
+
+				s += a;
+				deg_in[j] += a;
+				nonzero++;
+
+				if (j == i) {
+					r->self_loops++;
+					uf.bipartite = false;
+				} else {
+					uf_edge(&uf, i, j);
+				}
+
+				if (col) {
+					if (nnz == cap) {
+						cap *= 2;
+						col = realloc(col, cap * sizeof(size_t));
+
+						if (!col) {
+							die("malloc error (col)");
+						}
+					}
+
+					col[nnz++] = j;
+				}
+			}
+
+			deg_out[i] = s;
+			r->total_weight += s;
+
+			if (lrow) {
+				lrow[i] += s;
+			}
+
+			if (rowptr) {
+				rowptr[i + 1] = nnz;
+			}
+		}
+
+		for (size_t j = i0; j < n && r->symmetric; j++) {
+			const double* tcol = &g->A[IDX(j, i0, n)];
+
+			for (size_t i = i0; i < i1 && i < j; i++) {
+				if (g->A[IDX(i, j, n)] != tcol[i - i0]) {
+					r->symmetric = false;
+					break;
+				}
+			}
+		}
+	}
+
+	r->num_edges = g->directed ? nonzero : nonzero / 2;
+	r->bipartite = uf.bipartite;
+	r->min_degree = n ? INFINITY : 0.0;
+
+	for (size_t v = 0; v < n; v++) {
+		r->min_degree = deg_out[v] < r->min_degree ? deg_out[v]
+			: r->min_degree;
+		r->max_degree = deg_out[v] > r->max_degree ? deg_out[v]
+			: r->max_degree;
+	}
+
+	/*componentes numeradas na ordem do menor vértice; o menor vértice
+	de cada uma fica do lado false, como em graph_bipartition*/
+	size_t* comp = alloc_or_die(n, sizeof(size_t));
+	size_t* root_label = alloc_or_die(n, sizeof(size_t));
+	unsigned char* first_par = alloc_or_die(n, 1);
+	bool* side = alloc_or_die(n, sizeof(bool));
+
+	for (size_t v = 0; v < n; v++) {
+		root_label[v] = SIZE_MAX;
+	}
+
+	for (size_t v = 0; v < n; v++) {
+		unsigned p;
+		size_t root = uf_find(&uf, v, &p);
+
+		if (root_label[root] == SIZE_MAX) {
+			first_par[r->ncomponents] = (unsigned char) p;
+			root_label[root] = r->ncomponents++;
+		}
+
+		comp[v] = root_label[root];
+		side[v] = p != first_par[comp[v]];
+	}
+
+	r->connected = r->ncomponents <= 1;
+	free(root_label);
+	free(first_par);
+	free(uf.parent);
+	free(uf.size);
+	free(uf.par);
+
+	graph_cache_put_scalar(g, GRAPH_CACHE_NUM_EDGES, (double) r->num_edges);
+
+	if (!g->directed) {
+		graph_cache_put_scalar(g, GRAPH_CACHE_CONNECTED, r->connected);
+	}
+
+	if (need_csr) {
+		double cached;
+
+		if (graph_cache_get_scalar(g, GRAPH_CACHE_DIAMETER, &cached)) {
+			r->diameter = (int) cached;
+		} else {
+			r->diameter = csr_diameter(n, rowptr, col);
+			graph_cache_put_scalar(g, GRAPH_CACHE_DIAMETER, r->diameter);
+		}
+	}
+
+	free(rowptr);
+	free(col);
+
+	/*espectros, com as componentes e a bipartição da passada*/
+	int info = 0;
+	bool blocks = !g->directed && r->ncomponents > 1;
+
+	if (r->spec_adj && !adj_done && n > 0) {
+		int e;
+
+		if (g->directed && !r->symmetric) {
+			e = -1;
+		} else if (!g->directed && r->bipartite) {
+			e = graph_spec_bipartite(g, side, r->spec_adj);
+		} else if (blocks) {
+			e = matrix_spec_blocks(g->A, n, comp, r->ncomponents, r->spec_adj);
+		} else {
+			e = matrix_spec(g->A, n, r->spec_adj);
+		}
+
+		if (e == 0) {
+			graph_cache_put_vec(g, GRAPH_CACHE_SPEC_ADJ, r->spec_adj, n);
+		} else {
+			free(r->spec_adj);
+			r->spec_adj = NULL;
+			info = e;
+		}
+	}
+
+	if (r->spec_lap && !lap_done && n > 0) {
+		int e;
+
+		if (g->directed && !r->symmetric) {
+			e = -1;
+		} else if (blocks) {
+			e = matrix_spec_blocks(L, n, comp, r->ncomponents, r->spec_lap);
+		} else if (keep_L) {
+			e = matrix_spec(L, n, r->spec_lap);
+		} else {
+			/*L é nossa: o dsyev pode destruí-la*/
+			e = LAPACKE_dsyev(LAPACK_ROW_MAJOR, 'N', 'U', (int) n, L,
+				(int) n, r->spec_lap);
+		}
+
+		if (e == 0) {
+			graph_cache_put_vec(g, GRAPH_CACHE_SPEC_LAP, r->spec_lap, n);
+		} else {
+			free(r->spec_lap);
+			r->spec_lap = NULL;
+			info = info ? info : e;
+		}
+	}
+
+	if (keep_L) {
+		r->L = L;
+	} else {
+		graph_mem_free(L);
+	}
+
+	if (flags & GRAPH_ANALYZE_DEGREES) {
+		if (!g->directed) {
+			/*sem direção deg_in = deg_out (como em graph_degree)*/
+			memcpy(deg_in, deg_out, n * sizeof(double));
+		}
+
+		r->deg_out = deg_out;
+		r->deg_in = deg_in;
+	} else {
+		free(deg_out);
+		free(deg_in);
+	}
+
+	if (flags & GRAPH_ANALYZE_COMPONENTS) {
+		r->component = comp;
+	} else {
+		free(comp);
+	}
+
+	if ((flags & GRAPH_ANALYZE_BIPARTITE) && r->bipartite) {
+		r->side = side;
+	} else {
+		free(side);
+	}
+
+	return info;
+}
+
+void graph_report_free(GraphReport* r) {
+	free(r->deg_out);
+	free(r->deg_in);
+	free(r->component);
+	free(r->side);
+	graph_mem_free(r->L);
+	free(r->spec_adj);
+	free(r->spec_lap);
+	memset(r, 0, sizeof(GraphReport));
+}
@@ -0,0 +1,74 @@
+#ifndef ANALYZE_H
+#define ANALYZE_H
+
+/* --- Análise de um grafo numa chamada só --- */
+
+/*
+Chamar graph_num_edges, graph_degree, graph_is_connected,
+graph_laplacian, graph_spec_adj, graph_spec_lap e graph_diameter em
+sequência varre a matriz n x n umas dez vezes (cada função faz a sua
+passada e as suas alocações). graph_analyze faz:
+
+1. uma única passada por g->A, linha a linha, que calcula graus,
+   n° de arestas, laços e simetria, junta as componentes e testa a
+   bipartição (union-find com paridade), monta as listas de vizinhos
+   (para as BFS do diâmetro) e, se for pedida, a laplaciana;
+2. o diâmetro por BFS nas listas de vizinhos, O(n m) em vez de O(n³),
+   com as origens divididas entre graph_num_threads() threads;
+3. os espectros reaproveitando o que a passada já achou: bipartido vai
+   para a SVD (bipartite.h), desconexo para os blocos (components.h),
+   e a laplaciana da passada é diagonalizada no próprio buffer.
+
+Os resultados também vão para o cache do grafo (cache.h), então
+chamadas posteriores de graph_spec_adj etc. saem de graça.
+*/
+
+#include "graphs.h"
+
+typedef enum {
+	GRAPH_ANALYZE_DEGREES = 1u << 0,	/* deg_out, deg_in*/
+	GRAPH_ANALYZE_COMPONENTS = 1u << 1,	/* component (rótulos)*/
+	GRAPH_ANALYZE_BIPARTITE = 1u << 2,	/* side*/
+	GRAPH_ANALYZE_DIAMETER = 1u << 3,
+	GRAPH_ANALYZE_LAPLACIAN = 1u << 4,	/* L*/
+	GRAPH_ANALYZE_SPEC_ADJ = 1u << 5,
+	GRAPH_ANALYZE_SPEC_LAP = 1u << 6,
+	GRAPH_ANALYZE_ALL = (1u << 7) - 1
+} GraphAnalyzeFlags;
+
+
+/*Os escalares são sempre preenchidos; os vetores só com a flag
+correspondente (senão ficam NULL). Libere com graph_report_free*/
+typedef struct {
+	size_t n;
+	size_t num_edges;			/* Igual a graph_num_edges*/
+	size_t self_loops;
+	bool symmetric;				/* A == Aᵀ*/
+	double min_degree;			/* Grau de saída*/
+	double max_degree;
+	double total_weight;		/* Σ A[i][j]*/
+
+	size_t ncomponents;			/* Fracamente conexas, se direcionado*/
+	bool connected;				/* ncomponents <= 1*/
+	bool bipartite;				/* Como não direcionado; laço não é*/
+	int diameter;				/* Igual a graph_diameter (-1 sem a flag)*/
+
+	double* deg_out;			/* n*/
+	double* deg_in;				/* n*/
+	size_t* component;			/* n, mesma numeração de graph_components*/
+	bool* side;					/* n, só se bipartite*/
+	double* L;					/* n x n*/
+	double* spec_adj;			/* n, ordem crescente*/
+	double* spec_lap;			/* n*/
+} GraphReport;
+
+
+/*Calcula o que flags pede. Retorna 0 ou o primeiro info != 0 do
+LAPACK (os espectros que falharam ficam NULL). Como graph_spec_adj,
+os espectros de um grafo direcionado não simétrico dão -1 (digraph.h)*/
+int graph_analyze(const Graph* g, unsigned flags, GraphReport* r);
+
+
+void graph_report_free(GraphReport* r);
+
+#endif
@@ -0,0 +1,204 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "batch.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86_PATHS 1
+#endif
+
+/* --- Kernels --- */
+
+#define FOR_EACH_N(X) \
+	X(1)  X(2)  X(3)  X(4)  X(5)  X(6)  X(7)  X(8) \
+	X(9)  X(10) X(11) X(12) X(13) X(14) X(15) X(16) \
+	X(17) X(18) X(19) X(20) X(21) X(22) X(23) X(24) \
+	X(25) X(26) X(27) X(28) X(29) X(30) X(31) X(32)
+
+/*Um alvo: matrizes por chamada, pistas por vetor e um kernel por n
+(a: grupos de n x n x lanes intercalados, alinhada a 64 bytes;
+w: batch x n; retorna um bit por matriz que não convergiu)*/
+typedef struct {
+	size_t batch, lanes;
+	unsigned (*kernel[BATCH_MAX_N + 1])(double* a, double* w);
+} BatchIsa;
+
+#ifdef HAVE_X86_PATHS
+#define LANES 8
+#define SUFFIX _avx512
+#define TARGET __attribute__((target("avx512f")))
+#define SQRT_T __m512d
+#define SQRT_FN _mm512_sqrt_pd
+#define MASK_T __mmask8
+#define VEQ(a, b) _mm512_cmp_pd_mask((__m512d) (a), (__m512d) (b), _CMP_EQ_OQ)
+#define VGT(a, b) _mm512_cmp_pd_mask((__m512d) (a), (__m512d) (b), _CMP_GT_OQ)
+#define VBLEND(m, a, b) \
+	((VD) _mm512_mask_blend_pd((m), (__m512d) (b), (__m512d) (a)))
+#define VBITS(m) ((int) (m))
+#include "batch_kernel.h"
+
+#define LANES 4
+#define SUFFIX _avx2
+#define TARGET __attribute__((target("avx2,fma")))
+#define SQRT_T __m256d
+#define SQRT_FN _mm256_sqrt_pd
+#define MASK_T __m256i
+#define VEQ(a, b) \
+	((__m256i) _mm256_cmp_pd((__m256d) (a), (__m256d) (b), _CMP_EQ_OQ))
+#define VGT(a, b) \
+	((__m256i) _mm256_cmp_pd((__m256d) (a), (__m256d) (b), _CMP_GT_OQ))
+#define VBLEND(m, a, b) \
+	((VD) _mm256_blendv_pd((__m256d) (b), (__m256d) (a), (__m256d) (m)))
+#define VBITS(m) _mm256_movemask_pd((__m256d) (m))
+#include "batch_kernel.h"
+
+#define LANES 2
+#define SUFFIX _sse2
+#define TARGET
+#define SQRT_T __m128d
+#define SQRT_FN _mm_sqrt_pd
+#define MASK_T __m128i
+#define VEQ(a, b) ((__m128i) _mm_cmpeq_pd((__m128d) (a), (__m128d) (b)))
+#define VGT(a, b) ((__m128i) _mm_cmpgt_pd((__m128d) (a), (__m128d) (b)))
+#define VBLEND(m, a, b) \
+	((VD) _mm_or_pd(_mm_and_pd((__m128d) (m), (__m128d) (a)), \
+		_mm_andnot_pd((__m128d) (m), (__m128d) (b))))
+#define VBITS(m) _mm_movemask_pd((__m128d) (m))
+#include "batch_kernel.h"
+
+static const BatchIsa* active = &isa_sse2;
+#else
+#define LANES 2
+#define SUFFIX _generic
+#define TARGET
+#include "batch_kernel.h"
+
+static const BatchIsa* active = &isa_generic;
+#endif
+
+static pthread_once_t batch_once = PTHREAD_ONCE_INIT;
+
+static void batch_init(void) {
+#ifdef HAVE_X86_PATHS
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("avx512f")) {
+		active = &isa_avx512;
+	} else if (__builtin_cpu_supports("avx2")
+		&& __builtin_cpu_supports("fma")) {
+		active = &isa_avx2;
+	}
+#endif
+}
+
+
+/* --- Interface --- */
+
+/*Espectros das matrizes A[k] (A != NULL) ou das de adjacência ou
+laplacianas de g[k], intercaladas direto no buffer do kernel. Retorna
+0 ou k + 1, k a primeira matriz que não convergiu*/
+static int spec_groups(const double* A, Graph* const* g, bool lap, size_t n,
+	size_t count, double* w) {
+	pthread_once(&batch_once, batch_init);
+
+	size_t nn = n * n, B = active->batch, L = active->lanes;
+	void* buf = NULL;
+	double* wl = malloc(B * n * sizeof(double));
+	double* Lk = lap ? malloc(nn * sizeof(double)) : NULL;
+
+	if (posix_memalign(&buf, 64, nn * B * sizeof(double)) != 0 || !wl
+		|| (lap && !Lk)) {
+		die("malloc error (matrix_spec_batch)");
+	}
+
+	double* a = buf;
+	int info = 0;
+
+	for (size_t first = 0; first < count; first += B) {
+		size_t got = count - first < B ? count - first : B;
+
+		/*matriz k: grupo k / L, pista k % L; as que faltam ficam
+		zeradas e convergem já*/
+		memset(a, 0, nn * B * sizeof(double));
+
+		for (size_t k = 0; k < got; k++) {
+			const double* M = A ? &A[(first + k) * nn] : g[first + k]->A;
+			double* ak = &a[(k / L) * nn * L + k % L];
+
+			if (lap) {
+				graph_laplacian(g[first + k], Lk);
+				M = Lk;
+			}
+
+			for (size_t e = 0; e < nn; e++) {
+				ak[e * L] = M[e];
+			}
+		}
+
+		unsigned failed = active->kernel[n](a, wl);
+
+		if (failed != 0 && info == 0) {
+			info = (int) (first + (size_t) __builtin_ctz(failed)) + 1;
+		}
+
+		memcpy(&w[first * n], wl, got * n * sizeof(double));
+	}
+
+	free(a);
+	free(wl);
+	free(Lk);
+
+	return info;
+}
+
+int matrix_spec_batch(const double* A, size_t n, size_t count, double* w) {
+	if (n == 0 || count == 0) {
+		return 0;
+	}
+
+	if (n > BATCH_MAX_N) {
+		die("matrix_spec_batch: n > BATCH_MAX_N");
+	}
+
+	return spec_groups(A, NULL, false, n, count, w);
+}
+
+/*Mesmas regras de graph_spec_adj: direcionado só se A for simétrica*/
+static int spec_batch(Graph* const* g, size_t count, bool lap, double* w) {
+	if (count == 0 || g[0]->n == 0) {
+		return 0;
+	}
+
+	size_t n = g[0]->n;
+
+	if (n > BATCH_MAX_N) {
+		return -1;
+	}
+
+	for (size_t k = 0; k < count; k++) {
+		if (g[k]->n != n) {
+			return -1;
+		}
+
+		for (size_t i = 0; i < n && g[k]->directed; i++) {
+			for (size_t j = i + 1; j < n; j++) {
+				if (g[k]->A[IDX(i, j, n)] != g[k]->A[IDX(j, i, n)]) {
+					return -1;
+				}
+			}
+		}
+	}
+
+	return spec_groups(NULL, g, lap, n, count, w);
+}
+
+int graph_spec_adj_batch(Graph* const* g, size_t count, double* w) {
+	return spec_batch(g, count, false, w);
+}
+
+int graph_spec_lap_batch(Graph* const* g, size_t count, double* w) {
+	return spec_batch(g, count, true, w);
+}
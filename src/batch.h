@@ -0,0 +1,48 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+/* --- Espectro em lote de muitas matrizes pequenas --- */
+
+/*
+Enumerações e Monte Carlo calculam o espectro de milhões de grafos
+com n <= 32. Nesse tamanho quem domina é o custo fixo de cada
+chamada (as cópias de graph_spec_adj, a chamada ao LAPACK) e os
+laços escalares do dsyev, não a conta em si.
+
+Aqui as matrizes são processadas em grupos: o grupo é guardado
+intercalado (elemento (i, j) de cada matriz em sequência, uma por
+pista do vetor) e cada passo roda em todas de uma vez. O espectro sai
+de uma redução de Householder à forma tridiagonal seguida de QL
+implícito (tred2 + tqli, sem autovetores); no QL cada pista tem a sua
+própria deflação, então as pistas que já convergiram só esperam as
+outras. Os vetores são os da extensão vector_size do GCC, com a
+largura de cada alvo: 8 pistas com AVX-512, 4 com AVX2 + FMA e 2 no
+resto (SSE2), escolhido em tempo de execução, e há um kernel por n (1
+a BATCH_MAX_N) com os laços de tamanho fixo. As pistas que sobram no
+último grupo são preenchidas com zeros.
+
+A precisão é a do dsyev (erro da ordem de ε ||A||).
+*/
+
+#include <stddef.h>
+#include "graphs.h"
+
+#define BATCH_MAX_N 32
+
+
+/*Espectros de count matrizes simétricas n x n (n <= BATCH_MAX_N)
+guardadas em sequência em A (row-major). w recebe count x n valores:
+a linha k é o espectro da matriz k em ordem crescente. Retorna 0, ou
+k + 1 se o QL da matriz k (a primeira) não convergiu, como o info > 0
+do LAPACK; as outras linhas continuam válidas*/
+int matrix_spec_batch(const double* A, size_t n, size_t count, double* w);
+
+
+/*Espectros das matrizes de adjacência (ou laplacianas) de count grafos
+com o mesmo n, na mesma disposição de matrix_spec_batch. Retorna -1 se
+algum grafo tiver outro n, n > BATCH_MAX_N ou A não for simétrica, e
+k + 1 se o grafo k não convergiu*/
+int graph_spec_adj_batch(Graph* const* g, size_t count, double* w);
+int graph_spec_lap_batch(Graph* const* g, size_t count, double* w);
+
+#endif
@@ -0,0 +1,339 @@
+/* --- Kernels de matrix_spec_batch para um alvo --- */
+
+/*
+Sem include guard: batch.c inclui este arquivo uma vez por alvo, com
+LANES (pistas por vetor), SUFFIX (sufixo dos nomes), TARGET (atributo
+target do GCC, ou vazio) e, se houver instrução de raiz vetorial,
+SQRT_T e SQRT_FN definidos. Cada alvo tem a sua largura: vetores mais
+largos que o registro o GCC quebra em pedaços que passam pela pilha.
+
+Comparações e seleções também vêm do alvo: MASK_T (tipo da máscara),
+VEQ, VGT (máscara de a == b, a > b), VBLEND(m, a, b) (a onde m, b
+fora) e VBITS (um bit por pista). Sem elas, cada pista é comparada em
+escalar. Nada de comparar vetores do vector_size direto: o GCC 12
+aborta (gimple_expand_vec_cond_expr) ao expandir a máscara em -O1.
+
+Vetores só como variáveis locais e por ponteiro: passar por valor
+muda a ABI conforme o alvo (-Wpsabi).
+*/
+
+#define CAT_(a, b) a##b
+#define CAT(a, b) CAT_(a, b)
+#define FN(name) CAT(name, SUFFIX)
+#define VD FN(vd)
+#define VI FN(vi)
+#define KFN static inline __attribute__((always_inline)) TARGET
+
+typedef double VD __attribute__((vector_size(LANES * sizeof(double))));
+typedef int64_t VI __attribute__((vector_size(LANES * sizeof(int64_t))));
+
+#ifndef VEQ
+#define MASK_T VI
+#define LANE_CMP(a, op, b) ({ \
+		VD a_ = (a), b_ = (b); \
+		VI m_ = {0}; \
+		for (int l_ = 0; l_ < LANES; l_++) { \
+			m_[l_] = a_[l_] op b_[l_] ? -1 : 0; \
+		} \
+		m_; \
+	})
+#define VEQ(a, b) LANE_CMP(a, ==, b)
+#define VGT(a, b) LANE_CMP(a, >, b)
+#define VBLEND(m, a, b) ((VD) (((VI) (a) & (m)) | ((VI) (b) & ~(m))))
+#define VBITS(m) ({ \
+		VI m_ = (m); \
+		int b_ = 0; \
+		for (int l_ = 0; l_ < LANES; l_++) { \
+			b_ |= (m_[l_] != 0) << l_; \
+		} \
+		b_; \
+	})
+#endif
+
+/*x (double) em todas as pistas*/
+#define SPLAT(x) (((VD) {0}) + (double) (x))
+
+/*Raiz em cada pista. sqrt() escalar não vetoriza (errno) e não há
+raiz genérica para vector_size*/
+KFN void FN(vsqrt)(VD* x) {
+#ifdef SQRT_T
+	union {
+		VD v;
+		SQRT_T h;
+	} u = {*x};
+
+	u.h = SQRT_FN(u.h);
+	*x = u.v;
+#else
+	for (int l = 0; l < LANES; l++) {
+		(*x)[l] = sqrt((*x)[l]);
+	}
+#endif
+}
+
+/*Householder: leva as LANES matrizes intercaladas de a (N x N vetores,
+destruída) à forma tridiagonal, diagonal d e subdiagonal e
+(e[N - 1] = 0). Como tred2 do Numerical Recipes sem acumular as
+transformações: v = x - α e₁, h = vᵀv / 2, p = A v / h,
+q = p - (vᵀp / 2h) v, A -= v qᵀ + q vᵀ. Colunas já nulas (σ = 0) dão
+h = 0 e v = 0; somar 1 a h nessas pistas evita 0/0 sem desvio*/
+KFN void FN(tridiagonalize)(VD* a, size_t N, VD* d, VD* e) {
+	const VD one = (VD) {0} + 1.0, neg0 = -((VD) {0});
+	VD v[BATCH_MAX_N], q[BATCH_MAX_N];
+
+	for (size_t k = 0; k + 2 < N; k++) {
+		VD sigma = {0};
+
+		for (size_t i = k + 1; i < N; i++) {
+			v[i] = a[i * N + k];
+			sigma += v[i] * v[i];
+		}
+
+		/*α = -sgn(x₀) σ*/
+		VD x0 = v[k + 1], h = sigma;
+		FN(vsqrt)(&sigma);
+		VD alpha = (VD) ((VI) sigma ^ ((VI) x0 & (VI) neg0) ^ (VI) neg0);
+		h -= x0 * alpha;
+		h += VBLEND(VEQ(h, SPLAT(0)), one, SPLAT(0));
+		v[k + 1] = x0 - alpha;
+		VD beta = 1.0 / h, K = {0};
+
+		for (size_t i = k + 1; i < N; i++) {
+			VD pi = {0};
+
+			for (size_t j = k + 1; j < N; j++) {
+				pi += a[i * N + j] * v[j];
+			}
+
+			q[i] = beta * pi;
+			K += q[i] * v[i];
+		}
+
+		K *= 0.5 * beta;
+
+		for (size_t i = k + 1; i < N; i++) {
+			q[i] -= K * v[i];
+		}
+
+		for (size_t i = k + 1; i < N; i++) {
+			for (size_t j = k + 1; j < N; j++) {
+				a[i * N + j] -= v[i] * q[j] + q[i] * v[j];
+			}
+		}
+
+		d[k] = a[k * N + k];
+		e[k] = alpha;
+	}
+
+	for (size_t k = N >= 2 ? N - 2 : 0; k < N; k++) {
+		d[k] = a[k * N + k];
+		e[k] = k + 1 < N ? a[(k + 1) * N + k] : (VD) {0};
+	}
+}
+
+/*QL implícito com deslocamento de Wilkinson nas tridiagonais (d, e)
+de GROUPS grupos, como tqli do Numerical Recipes, com todas as pistas
+andando juntas. Cada pista tem o seu m (primeiro e[m] desprezível a
+partir de l, guardado em double); a varredura vai do maior m - 1 até l e cada pista
+só muda de estado entre o seu m - 1 e l, começando a cadeia
+(g, s, c, p) em i = m - 1. Pistas em que e[l] já é desprezível ficam
+paradas até as outras terminarem. Retorna um bit por matriz (grupo h,
+pista l: bit h * LANES + l) que não convergiu em BATCH_MAX_ITER
+varreduras para algum l.
+
+Cada passo é uma cadeia raiz -> divisão -> produtos; com dois grupos
+independentes no mesmo laço as duas cadeias se sobrepõem no pipeline*/
+#define GROUPS 2
+#define EACH(h) _Pragma("GCC unroll 2") for (int h = 0; h < GROUPS; h++)
+#define BATCH_MAX_ITER 64
+
+KFN unsigned FN(tridiag_ql)(VD (*d)[BATCH_MAX_N], VD (*e)[BATCH_MAX_N],
+	size_t N) {
+	const VD one = SPLAT(1), neg0 = -((VD) {0}), zero = {0};
+	const VD absmask = (VD) ~(VI) neg0;
+	unsigned failed = 0;
+
+	for (size_t l = 0; l < N; l++) {
+		for (int iter = 0;; iter++) {
+			VD m[GROUPS];
+			MASK_T active[GROUPS];
+			bool any = false;
+			double mmax = (double) l;
+
+			EACH(h) {
+				MASK_T found = {0};
+				m[h] = SPLAT(N - 1);
+
+				for (size_t mm = l; mm + 1 < N; mm++) {
+					VD dd = (VD) ((VI) d[h][mm] & (VI) absmask)
+						+ (VD) ((VI) d[h][mm + 1] & (VI) absmask);
+					MASK_T small = VEQ((VD) ((VI) e[h][mm] & (VI) absmask) + dd,
+						dd);
+					MASK_T first = small & ~found;
+					m[h] = VBLEND(first, SPLAT(mm), m[h]);
+					found |= small;
+				}
+
+				active[h] = ~VEQ(m[h], SPLAT(l));
+				any |= VBITS(active[h]) != 0;
+
+				for (int ln = 0; ln < LANES; ln++) {
+					mmax = fmax(m[h][ln], mmax);
+				}
+			}
+
+			if (!any) {
+				break;
+			}
+
+			if (iter == BATCH_MAX_ITER) {
+				EACH(h) {
+					failed |= (unsigned) VBITS(active[h]) << (h * LANES);
+				}
+
+				break;
+			}
+
+			/*deslocamento: g = d[m] - d[l] + e[l] / (g0 + sgn(g0) r0)*/
+			VD shift[GROUPS], s[GROUPS], c[GROUPS], p[GROUPS], g[GROUPS];
+			MASK_T broke[GROUPS];
+
+			EACH(h) {
+				VD g0 = (d[h][l + 1] - d[h][l]) / (2.0 * e[h][l]);
+				VD r0 = g0 * g0 + 1.0;
+				FN(vsqrt)(&r0);
+				shift[h] = e[h][l] / (g0 + (VD) (((VI) r0 & (VI) absmask)
+					| ((VI) g0 & (VI) neg0))) - d[h][l];
+				s[h] = c[h] = one;
+				p[h] = g[h] = zero;
+				broke[h] = (MASK_T) {0};
+			}
+
+			for (int64_t i = (int64_t) mmax - 1; i >= (int64_t) l; i--) {
+				EACH(h) {
+					MASK_T start = active[h] & VEQ(m[h], SPLAT(i + 1));
+					g[h] = VBLEND(start, d[h][i + 1] + shift[h], g[h]);
+					s[h] = VBLEND(start, one, s[h]);
+					c[h] = VBLEND(start, one, c[h]);
+					p[h] = VBLEND(start, zero, p[h]);
+
+					MASK_T on = active[h] & VGT(m[h], SPLAT(i)) & ~broke[h];
+					VD f = s[h] * e[h][i], b = c[h] * e[h][i];
+					VD r = f * f + g[h] * g[h];
+					FN(vsqrt)(&r);
+
+					/*r = 0: a cadeia da pista acaba aqui (raro)*/
+					MASK_T stop = on & VEQ(r, zero);
+
+					if (VBITS(stop) != 0) {
+						d[h][i + 1] = VBLEND(stop, d[h][i + 1] - p[h], d[h][i + 1]);
+
+						for (size_t j = (size_t) i + 1; j < N; j++) {
+							e[h][j] = VBLEND(stop & VEQ(m[h], SPLAT(j)), zero,
+								e[h][j]);
+						}
+
+						broke[h] |= stop;
+						on &= ~stop;
+					}
+
+					VD inv = 1.0 / r;
+					VD sn = f * inv, cn = g[h] * inv;
+					VD gn = d[h][i + 1] - p[h];
+					VD rn = (d[h][i] - gn) * sn + 2.0 * cn * b;
+					VD pn = sn * rn;
+
+					e[h][i + 1] = VBLEND(on, r, e[h][i + 1]);
+					d[h][i + 1] = VBLEND(on, gn + pn, d[h][i + 1]);
+					s[h] = VBLEND(on, sn, s[h]);
+					c[h] = VBLEND(on, cn, c[h]);
+					p[h] = VBLEND(on, pn, p[h]);
+					g[h] = VBLEND(on, cn * rn - b, g[h]);
+				}
+			}
+
+			EACH(h) {
+				MASK_T fin = active[h] & ~broke[h];
+				d[h][l] = VBLEND(fin, d[h][l] - p[h], d[h][l]);
+				e[h][l] = VBLEND(fin, g[h], e[h][l]);
+
+				for (size_t j = l + 1; j < N; j++) {
+					e[h][j] = VBLEND(fin & VEQ(m[h], SPLAT(j)), zero, e[h][j]);
+				}
+			}
+		}
+	}
+
+	return failed;
+}
+
+/*Espectro das GROUPS x LANES matrizes intercaladas em a (grupo após
+grupo); w recebe GROUPS x LANES x N autovalores (a linha k é a matriz
+k, crescente). Retorna os bits das matrizes que não convergiram*/
+KFN unsigned FN(eig_batch)(double* A, size_t N, double* w) {
+	VD* a = (VD*) A;
+	VD d[GROUPS][BATCH_MAX_N], e[GROUPS][BATCH_MAX_N];
+
+	EACH(h) {
+		FN(tridiagonalize)(&a[h * N * N], N, d[h], e[h]);
+	}
+
+	unsigned failed = FN(tridiag_ql)(d, e, N);
+
+	EACH(h) {
+		for (int l = 0; l < LANES; l++) {
+			double* wl = &w[(h * LANES + l) * N];
+
+			for (size_t i = 0; i < N; i++) {
+				double x = d[h][i][l];
+				size_t j = i;
+
+				while (j > 0 && wl[j - 1] > x) {
+					wl[j] = wl[j - 1];
+					j--;
+				}
+
+				wl[j] = x;
+			}
+		}
+	}
+
+	return failed;
+}
+
+/*Um kernel por n, com os laços de tamanho fixo*/
+#define KERNEL(N) \
+	TARGET static unsigned FN(CAT(eig_, N))(double* a, double* w) { \
+		return FN(eig_batch)(a, N, w); \
+	}
+#define ENTRY(N) FN(CAT(eig_, N)),
+
+FOR_EACH_N(KERNEL)
+
+static const BatchIsa FN(isa) = {
+	GROUPS * LANES, LANES, {NULL, FOR_EACH_N(ENTRY)}
+};
+
+#undef KERNEL
+#undef EACH
+#undef GROUPS
+#undef ENTRY
+#undef BATCH_MAX_ITER
+#undef SPLAT
+#undef LANE_CMP
+#undef MASK_T
+#undef VEQ
+#undef VGT
+#undef VBLEND
+#undef VBITS
+#undef KFN
+#undef VI
+#undef VD
+#undef FN
+#undef CAT
+#undef CAT_
+#undef LANES
+#undef SUFFIX
+#undef TARGET
+#undef SQRT_T
+#undef SQRT_FN
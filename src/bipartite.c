@@ -0,0 +1,144 @@
+#include <stdlib.h>
+#include <lapacke.h>
+#include "bipartite.h"
+#include "families.h"
+
+bool graph_bipartition(const Graph* g, bool* side) {
+	size_t n = g->n;
+	size_t n1;
+
+	/*partição conhecida pelo gerador*/
+	if (graph_family_bipartition(g, &n1)) {
+		for (size_t v = 0; v < n; v++) {
+			side[v] = v >= n1;
+		}
+
+		return true;
+	}
+
+	size_t* queue = malloc((n + 1) * sizeof(size_t));
+	bool* seen = calloc(n + 1, sizeof(bool));
+
+	if (!queue || !seen) {
+		die("malloc error (queue || seen)");
+	}
+
+	bool ok = true;
+
+	for (size_t s = 0; s < n && ok; s++) {
+		if (seen[s]) {
+			continue;
+		}
+
+		size_t head = 0, tail = 0;
+		queue[tail++] = s;
+		seen[s] = true;
+		side[s] = false;
+
+		while (head < tail && ok) {
+			size_t u = queue[head++];
+
+			for (size_t v = 0; v < n; v++) {
+				bool adj = g->A[IDX(u, v, n)] != 0.0
+					|| (g->directed && g->A[IDX(v, u, n)] != 0.0);
+
+				if (!adj) {
+					continue;
+				}
+
+				if (!seen[v]) {
+					seen[v] = true;
+					side[v] = !side[u];
+					queue[tail++] = v;
+				} else if (side[v] == side[u]) {
+					ok = false;
+					break;
+				}
+			}
+		}
+	}
+
+	free(queue);
+	free(seen);
+
+	return ok;
+}
+
+int graph_spec_bipartite(const Graph* g, const bool* side, double* x) {
+	size_t n = g->n;
+
+	if (g->directed) {
+		return -1;
+	}
+
+	size_t* xs = malloc((n + 1) * sizeof(size_t));
+	size_t* ys = malloc((n + 1) * sizeof(size_t));
+
+	if (!xs || !ys) {
+		die("malloc error (xs || ys)");
+	}
+
+	size_t n1 = 0, n2 = 0;
+
+	for (size_t v = 0; v < n; v++) {
+		if (side[v]) {
+			ys[n2++] = v;
+		} else {
+			xs[n1++] = v;
+		}
+	}
+
+	/*confere que não há arestas dentro de X nem dentro de Y*/
+	for (size_t u = 0; u < n; u++) {
+		for (size_t v = u; v < n; v++) {
+			if (side[u] == side[v] && g->A[IDX(u, v, n)] != 0.0) {
+				free(xs);
+				free(ys);
+				return -1;
+			}
+		}
+	}
+
+	size_t k = n1 < n2 ? n1 : n2;
+	int info = 0;
+
+	if (k > 0) {
+		double* B = malloc(n1 * n2 * sizeof(double));
+		double* s = malloc(k * sizeof(double));
+
+		if (!B || !s) {
+			die("malloc error (B || s)");
+		}
+
+		for (size_t i = 0; i < n1; i++) {
+			for (size_t j = 0; j < n2; j++) {
+				B[IDX(i, j, n2)] = g->A[IDX(xs[i], ys[j], n)];
+			}
+		}
+
+		info = LAPACKE_dgesdd(LAPACK_ROW_MAJOR, 'N', (int) n1, (int) n2, B,
+			(int) n2, s, NULL, 1, NULL, 1);
+
+		/*s vem em ordem decrescente, então x já sai ordenado*/
+		if (info == 0) {
+			for (size_t i = 0; i < k; i++) {
+				x[i] = -s[i];
+				x[n - 1 - i] = s[i];
+			}
+		}
+
+		free(B);
+		free(s);
+	}
+
+	if (info == 0) {
+		for (size_t i = k; i < n - k; i++) {
+			x[i] = 0.0;
+		}
+	}
+
+	free(xs);
+	free(ys);
+
+	return info;
+}
@@ -0,0 +1,38 @@
+#ifndef BIPARTITE_H
+#define BIPARTITE_H
+
+/* --- Grafos bipartidos --- */
+
+/*
+Se os vértices de g se dividem em X (n1 vértices) e Y (n2 vértices)
+sem arestas dentro de X ou de Y, a matriz de adjacência (permutada) é
+
+	[ 0   B ]
+	[ Bᵀ  0 ]
+
+com B de tamanho n1 x n2, e os autovalores são ±σ_i(B) mais |n1 - n2|
+zeros. graph_spec_adj usa isso para grafos não direcionados: a SVD
+(dgesdd, só valores singulares) de B custa bem menos que o dsyev na
+matriz inteira (até 8x para n1 = n2) e usa 1/4 da memória.
+
+A partição vem da marca de família (graph_random_bipartite e
+graph_complete_bipartite, veja families.h) ou de uma 2-coloração por
+BFS, O(n²) na matriz densa (linear no tamanho da matriz).
+*/
+
+#include "graphs.h"
+
+
+/*Tenta 2-colorir g (como não direcionado). Se conseguir, coloca em
+side[v] o lado de v (false = X, true = Y) e retorna true. Laços
+tornam o grafo não bipartido*/
+bool graph_bipartition(const Graph* g, bool* side);
+
+
+/*Espectro da adjacência de g a partir da SVD do bloco B dado pela
+partição side. x deve ter espaço para n doubles (ordem crescente).
+Retorna -1 se side não for uma bipartição válida de g (ou g for
+direcionado) e o info do LAPACK se > 0*/
+int graph_spec_bipartite(const Graph* g, const bool* side, double* x);
+
+#endif
@@ -0,0 +1,182 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "cache.h"
+
+typedef struct {
+	bool valid;
+	uint64_t version;
+	double scalar;
+	double* vec;
+	size_t len;
+} CacheEntry;
+
+struct GraphCache {
+	pthread_mutex_t lock;
+	CacheEntry e[GRAPH_CACHE_NKEYS];
+};
+
+static atomic_size_t cache_bytes = 0;
+static atomic_size_t cache_limit = GRAPH_CACHE_DEFAULT_LIMIT;
+
+static void entry_drop(CacheEntry* e) {
+	if (e->vec) {
+		atomic_fetch_sub(&cache_bytes, e->len * sizeof(double));
+		free(e->vec);
+	}
+
+	memset(e, 0, sizeof(*e));
+}
+
+struct GraphCache* graph_cache_new(void) {
+	struct GraphCache* c = calloc(1, sizeof(struct GraphCache));
+
+	if (!c) {
+		die("malloc error (GraphCache)");
+	}
+
+	pthread_mutex_init(&c->lock, NULL);
+
+	return c;
+}
+
+void graph_cache_free(struct GraphCache* c) {
+	if (!c) {
+		return;
+	}
+
+	for (int k = 0; k < GRAPH_CACHE_NKEYS; k++) {
+		entry_drop(&c->e[k]);
+	}
+
+	pthread_mutex_destroy(&c->lock);
+	free(c);
+}
+
+bool graph_cache_get_scalar(const Graph* g, GraphCacheKey key, double* out) {
+	struct GraphCache* c = g->cache;
+
+	if (!c) {
+		return false;
+	}
+
+	pthread_mutex_lock(&c->lock);
+	CacheEntry* e = &c->e[key];
+	bool hit = e->valid && e->version == g->version;
+
+	if (hit) {
+		*out = e->scalar;
+	}
+
+	pthread_mutex_unlock(&c->lock);
+
+	return hit;
+}
+
+void graph_cache_put_scalar(const Graph* g, GraphCacheKey key, double v) {
+	struct GraphCache* c = g->cache;
+
+	if (!c) {
+		return;
+	}
+
+	pthread_mutex_lock(&c->lock);
+	CacheEntry* e = &c->e[key];
+	entry_drop(e);
+	e->valid = true;
+	e->version = g->version;
+	e->scalar = v;
+	pthread_mutex_unlock(&c->lock);
+}
+
+bool graph_cache_get_vec(const Graph* g, GraphCacheKey key, double* out,
+	size_t len) {
+	struct GraphCache* c = g->cache;
+
+	if (!c) {
+		return false;
+	}
+
+	pthread_mutex_lock(&c->lock);
+	CacheEntry* e = &c->e[key];
+	bool hit = e->valid && e->vec && e->version == g->version
+		&& e->len == len;
+
+	if (hit) {
+		memcpy(out, e->vec, len * sizeof(double));
+	} else if (e->valid && e->version != g->version) {
+		/*entrada velha: devolve a memória já*/
+		entry_drop(e);
+	}
+
+	pthread_mutex_unlock(&c->lock);
+
+	return hit;
+}
+
+void graph_cache_put_vec(const Graph* g, GraphCacheKey key, const double* v,
+	size_t len) {
+	struct GraphCache* c = g->cache;
+
+	if (!c) {
+		return;
+	}
+
+	size_t bytes = len * sizeof(double);
+
+	pthread_mutex_lock(&c->lock);
+	CacheEntry* e = &c->e[key];
+	entry_drop(e);
+
+	/*reserva os bytes antes de alocar; se passar do limite, desiste*/
+	size_t used = atomic_fetch_add(&cache_bytes, bytes);
+
+	if (used + bytes > atomic_load(&cache_limit)) {
+		atomic_fetch_sub(&cache_bytes, bytes);
+		pthread_mutex_unlock(&c->lock);
+		return;
+	}
+
+	e->vec = malloc(bytes ? bytes : 1);
+
+	if (!e->vec) {
+		atomic_fetch_sub(&cache_bytes, bytes);
+		pthread_mutex_unlock(&c->lock);
+		return;
+	}
+
+	memcpy(e->vec, v, bytes);
+	e->len = len;
+	e->valid = true;
+	e->version = g->version;
+	pthread_mutex_unlock(&c->lock);
+}
+
+void graph_invalidate(Graph* g) {
+	g->version++;
+
+	if (!g->cache) {
+		return;
+	}
+
+	pthread_mutex_lock(&g->cache->lock);
+
+	for (int k = 0; k < GRAPH_CACHE_NKEYS; k++) {
+		entry_drop(&g->cache->e[k]);
+	}
+
+	pthread_mutex_unlock(&g->cache->lock);
+}
+
+uint64_t graph_version(const Graph* g) {
+	return g->version;
+}
+
+void graph_cache_set_limit(size_t bytes) {
+	atomic_store(&cache_limit, bytes);
+}
+
+size_t graph_cache_usage(void) {
+	return atomic_load(&cache_bytes);
+}
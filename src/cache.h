@@ -0,0 +1,67 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+/* --- Cache de invariantes por versão do grafo --- */
+
+/*
+Cada Graph criado por graph_new carrega um GraphCache. Uma entrada
+guarda o valor de um invariante junto com g->version do momento em
+que foi calculado; se o grafo mudou depois disso (g->version é outro),
+a entrada é ignorada e o valor é recalculado.
+
+Escalares (n° de arestas, conexo, diâmetro...) sempre são guardados.
+Vetores (espectros) só são guardados enquanto a soma de todos eles,
+em todos os grafos, couber no limite de graph_cache_set_limit.
+
+As funções daqui são usadas pelas próprias rotinas da biblioteca
+(graph_num_edges, graph_spec_adj etc.); quem só usa a biblioteca
+normalmente não precisa delas. Um Graph sem cache (g->cache == NULL,
+por exemplo um Graph montado na mão) simplesmente não guarda nada.
+O acesso é protegido por um mutex, então um mesmo grafo pode ser
+consultado por várias threads.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "graphs.h"
+
+typedef enum {
+	GRAPH_CACHE_NUM_EDGES,
+	GRAPH_CACHE_CONNECTED,
+	GRAPH_CACHE_DIAMETER,
+	GRAPH_CACHE_SPEC_ADJ,
+	GRAPH_CACHE_SPEC_LAP,
+	GRAPH_CACHE_WIENER,
+	GRAPH_CACHE_SPEC_DISTANCE,
+	GRAPH_CACHE_SPEC_DISTANCE_LAP,
+	GRAPH_CACHE_NKEYS
+} GraphCacheKey;
+
+
+/*Aloca um cache vazio*/
+struct GraphCache* graph_cache_new(void);
+
+
+/*Libera o cache e devolve a memória dos vetores ao limite global*/
+void graph_cache_free(struct GraphCache* c);
+
+
+/*Se key foi calculado na versão atual de g, coloca o valor em *out
+e retorna true*/
+bool graph_cache_get_scalar(const Graph* g, GraphCacheKey key, double* out);
+
+
+/*Guarda o valor de key para a versão atual de g*/
+void graph_cache_put_scalar(const Graph* g, GraphCacheKey key, double v);
+
+
+/*Igual a graph_cache_get_scalar, copiando len doubles para out*/
+bool graph_cache_get_vec(const Graph* g, GraphCacheKey key, double* out,
+	size_t len);
+
+
+/*Guarda uma cópia de v (len doubles), se couber no limite*/
+void graph_cache_put_vec(const Graph* g, GraphCacheKey key, const double* v,
+	size_t len);
+
+#endif
@@ -0,0 +1,737 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include "charpoly.h"
+#include "graphs.h"
+
+typedef unsigned __int128 u128;
+
+/* --- Aritmética módulo p (p < 2^63) --- */
+
+static inline uint64_t addmod(uint64_t a, uint64_t b, uint64_t p) {
+	uint64_t s = a + b;
+	return (s >= p) ? s - p : s;
+}
+
+static inline uint64_t submod(uint64_t a, uint64_t b, uint64_t p) {
+	return (a >= b) ? a - b : a + p - b;
+}
+
+static inline uint64_t mulmod(uint64_t a, uint64_t b, uint64_t p) {
+	return (uint64_t) (((u128) a * b) % p);
+}
+
+static uint64_t powmod(uint64_t a, uint64_t e, uint64_t p) {
+	uint64_t r = 1 % p;
+
+	while (e) {
+		if (e & 1) {
+			r = mulmod(r, a, p);
+		}
+
+		a = mulmod(a, a, p);
+		e >>= 1;
+	}
+
+	return r;
+}
+
+/*p é primo, então a^(p-2) = a^(-1)*/
+static inline uint64_t invmod(uint64_t a, uint64_t p) {
+	return powmod(a, p - 2, p);
+}
+
+/*Miller-Rabin determinístico para 64 bits (bases fixas)*/
+static bool is_prime_u64(uint64_t n) {
+	static const uint64_t bases[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+
+	if (n < 2) {
+		return false;
+	}
+
+	for (size_t i = 0; i < sizeof(bases) / sizeof(bases[0]); i++) {
+		if (n % bases[i] == 0) {
+			return n == bases[i];
+		}
+	}
+
+	uint64_t d = n - 1;
+	int s = 0;
+
+	while ((d & 1) == 0) {
+		d >>= 1;
+		s++;
+	}
+
+	for (size_t i = 0; i < sizeof(bases) / sizeof(bases[0]); i++) {
+		uint64_t x = powmod(bases[i], d, n);
+
+		if (x == 1 || x == n - 1) {
+			continue;
+		}
+
+		bool composite = true;
+
+		for (int r = 1; r < s; r++) {
+			x = mulmod(x, x, n);
+
+			if (x == n - 1) {
+				composite = false;
+				break;
+			}
+		}
+
+		if (composite) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*Os np maiores primos menores que 2^62*/
+static void crt_primes(uint64_t* primes, size_t np) {
+	uint64_t c = (UINT64_C(1) << 62) - 1;
+
+	for (size_t i = 0; i < np; c -= 2) {
+		if (is_prime_u64(c)) {
+			primes[i++] = c;
+		}
+	}
+}
+
+static void check_integer_matrix(const double* A, size_t n) {
+	for (size_t i = 0; i < n * n; i++) {
+		if (A[i] != floor(A[i]) || fabs(A[i]) >= 9007199254740992.0) {
+			die("matriz com entrada não inteira (aritmética modular)");
+		}
+	}
+}
+
+static inline uint64_t reduce_entry(double a, uint64_t p) {
+	int64_t v = (int64_t) a;
+	int64_t r = v % (int64_t) p;
+
+	return (uint64_t) ((r < 0) ? r + (int64_t) p : r);
+}
+
+
+/* --- Polinômio característico módulo p --- */
+
+/*Leva H (n x n, já reduzida mod p) à forma de Hessenberg superior
+por transformações de semelhança (eliminação gaussiana com pivô)*/
+static void hessenberg_mod(uint64_t* H, size_t n, uint64_t p) {
+	for (size_t m = 1; m + 1 < n; m++) {
+		size_t piv = m;
+
+		while (piv < n && H[IDX(piv, m - 1, n)] == 0) {
+			piv++;
+		}
+
+		if (piv == n) {
+			continue;
+		}
+
+		if (piv != m) {
+			for (size_t j = 0; j < n; j++) {
+				uint64_t t = H[IDX(piv, j, n)];
+				H[IDX(piv, j, n)] = H[IDX(m, j, n)];
+				H[IDX(m, j, n)] = t;
+			}
+
+			for (size_t i = 0; i < n; i++) {
+				uint64_t t = H[IDX(i, piv, n)];
+				H[IDX(i, piv, n)] = H[IDX(i, m, n)];
+				H[IDX(i, m, n)] = t;
+			}
+		}
+
+		uint64_t inv = invmod(H[IDX(m, m - 1, n)], p);
+
+		for (size_t i = m + 1; i < n; i++) {
+			uint64_t u = mulmod(H[IDX(i, m - 1, n)], inv, p);
+
+			if (u == 0) {
+				continue;
+			}
+
+			/*linha_i -= u * linha_m*/
+			for (size_t j = m - 1; j < n; j++) {
+				H[IDX(i, j, n)] = submod(H[IDX(i, j, n)],
+					mulmod(u, H[IDX(m, j, n)], p), p);
+			}
+
+			/*coluna_m += u * coluna_i*/
+			for (size_t j = 0; j < n; j++) {
+				H[IDX(j, m, n)] = addmod(H[IDX(j, m, n)],
+					mulmod(u, H[IDX(j, i, n)], p), p);
+			}
+		}
+	}
+}
+
+/*Recorrência de Hessenberg (Cohen, A Course in Computational Algebraic
+Number Theory, alg. 2.2.9) truncada nos k + 1 coeficientes mais altos:
+
+P_m = (x - h_mm) P_(m-1) - sum_i h_(m-i,m) (prod_j h_(j,j-1)) P_(m-i-1)
+
+T[m][j] guarda o coeficiente de x^(m-j) em P_m, j = 0..k. Como
+P_(m-i-1) só contribui para x^(m-j) com j >= i + 1, a soma para
+em i = k - 1.*/
+static void charpoly_hessenberg_mod(const uint64_t* H, size_t n, size_t k,
+	uint64_t p, uint64_t* T, uint64_t* coeffs) {
+	size_t w = k + 1;
+
+	memset(T, 0, (n + 1) * w * sizeof(uint64_t));
+	T[0] = 1 % p;
+
+	for (size_t m = 1; m <= n; m++) {
+		uint64_t* Pm = &T[m * w];
+		const uint64_t* Pm1 = &T[(m - 1) * w];
+		uint64_t hmm = H[IDX(m - 1, m - 1, n)];
+
+		for (size_t j = 0; j <= k && j <= m; j++) {
+			uint64_t c = (j <= m - 1) ? Pm1[j] : 0;
+
+			if (j >= 1) {
+				c = submod(c, mulmod(hmm, Pm1[j - 1], p), p);
+			}
+
+			Pm[j] = c;
+		}
+
+		uint64_t t = 1 % p;
+
+		for (size_t i = 1; i < m && i < k; i++) {
+			t = mulmod(t, H[IDX(m - i, m - i - 1, n)], p);
+
+			if (t == 0) {
+				break;
+			}
+
+			uint64_t c = mulmod(t, H[IDX(m - i - 1, m - 1, n)], p);
+
+			if (c == 0) {
+				continue;
+			}
+
+			const uint64_t* Pq = &T[(m - i - 1) * w];
+
+			for (size_t j = i + 1; j <= k && j <= m; j++) {
+				Pm[j] = submod(Pm[j], mulmod(c, Pq[j - i - 1], p), p);
+			}
+		}
+	}
+
+	memcpy(coeffs, &T[n * w], w * sizeof(uint64_t));
+}
+
+static void char_coeffs_mod_work(const double* A, size_t n, size_t k,
+	uint64_t p, uint64_t* H, uint64_t* T, uint64_t* coeffs) {
+	for (size_t i = 0; i < n * n; i++) {
+		H[i] = reduce_entry(A[i], p);
+	}
+
+	hessenberg_mod(H, n, p);
+	charpoly_hessenberg_mod(H, n, k, p, T, coeffs);
+}
+
+/*Determinante de A mod p por eliminação gaussiana (H é rascunho)*/
+static uint64_t det_mod_work(const double* A, size_t n, uint64_t p,
+	uint64_t* H) {
+	for (size_t i = 0; i < n * n; i++) {
+		H[i] = reduce_entry(A[i], p);
+	}
+
+	uint64_t det = 1 % p;
+
+	for (size_t m = 0; m < n; m++) {
+		size_t piv = m;
+
+		while (piv < n && H[IDX(piv, m, n)] == 0) {
+			piv++;
+		}
+
+		if (piv == n) {
+			return 0;
+		}
+
+		if (piv != m) {
+			for (size_t j = m; j < n; j++) {
+				uint64_t t = H[IDX(piv, j, n)];
+				H[IDX(piv, j, n)] = H[IDX(m, j, n)];
+				H[IDX(m, j, n)] = t;
+			}
+
+			det = submod(0, det, p);
+		}
+
+		det = mulmod(det, H[IDX(m, m, n)], p);
+		uint64_t inv = invmod(H[IDX(m, m, n)], p);
+
+		for (size_t i = m + 1; i < n; i++) {
+			uint64_t u = mulmod(H[IDX(i, m, n)], inv, p);
+
+			if (u == 0) {
+				continue;
+			}
+
+			for (size_t j = m; j < n; j++) {
+				H[IDX(i, j, n)] = submod(H[IDX(i, j, n)],
+					mulmod(u, H[IDX(m, j, n)], p), p);
+			}
+		}
+	}
+
+	return det;
+}
+
+void matrix_char_coeffs_mod(const double* A, size_t n, size_t k,
+	uint64_t p, uint64_t* coeffs) {
+	if (k > n) {
+		k = n;
+	}
+
+	check_integer_matrix(A, n);
+
+	uint64_t* H = malloc((n * n + 1) * sizeof(uint64_t));
+	uint64_t* T = malloc((n + 1) * (k + 1) * sizeof(uint64_t));
+
+	if (!H || !T) {
+		die("malloc error (H || T)");
+	}
+
+	char_coeffs_mod_work(A, n, k, p, H, T, coeffs);
+
+	free(H);
+	free(T);
+}
+
+uint64_t matrix_det_mod(const double* A, size_t n, uint64_t p) {
+	check_integer_matrix(A, n);
+
+	uint64_t* H = malloc((n * n + 1) * sizeof(uint64_t));
+
+	if (!H) {
+		die("malloc error (H)");
+	}
+
+	uint64_t det = det_mod_work(A, n, p, H);
+	free(H);
+
+	return det;
+}
+
+
+/* --- BigInt --- */
+
+static void bigint_trim(BigInt* x) {
+	while (x->len > 0 && x->d[x->len - 1] == 0) {
+		x->len--;
+	}
+
+	if (x->len == 0) {
+		x->sign = 0;
+	}
+}
+
+/*x = x * m + a*/
+static void bigint_muladd(BigInt* x, uint64_t m, uint64_t a) {
+	u128 carry = a;
+
+	for (size_t i = 0; i < x->len; i++) {
+		u128 t = (u128) x->d[i] * m + carry;
+		x->d[i] = (uint64_t) t;
+		carry = t >> 64;
+	}
+
+	if (carry) {
+		x->d[x->len++] = (uint64_t) carry;
+	}
+}
+
+static int bigint_cmp_mag(const BigInt* a, const BigInt* b) {
+	if (a->len != b->len) {
+		return (a->len < b->len) ? -1 : 1;
+	}
+
+	for (size_t i = a->len; i-- > 0;) {
+		if (a->d[i] != b->d[i]) {
+			return (a->d[i] < b->d[i]) ? -1 : 1;
+		}
+	}
+
+	return 0;
+}
+
+/*a = b - a, supondo |b| >= |a|*/
+static void bigint_rsub_mag(BigInt* a, const BigInt* b) {
+	uint64_t borrow = 0;
+
+	for (size_t i = 0; i < b->len; i++) {
+		uint64_t ai = (i < a->len) ? a->d[i] : 0;
+		u128 t = (u128) b->d[i] - ai - borrow;
+		a->d[i] = (uint64_t) t;
+		borrow = (uint64_t) (t >> 127);
+	}
+
+	a->len = b->len;
+}
+
+void bigint_free(BigInt* x) {
+	if (!x) {
+		return;
+	}
+
+	free(x->d);
+	x->d = NULL;
+	x->len = 0;
+	x->sign = 0;
+}
+
+double bigint_to_double(const BigInt* x) {
+	double r = 0.0;
+
+	for (size_t i = x->len; i-- > 0;) {
+		r = r * 18446744073709551616.0 + (double) x->d[i];
+	}
+
+	return x->sign < 0 ? -r : r;
+}
+
+bool bigint_to_int64(const BigInt* x, int64_t* out) {
+	if (x->len == 0) {
+		*out = 0;
+		return true;
+	}
+
+	if (x->len > 1) {
+		return false;
+	}
+
+	uint64_t m = x->d[0];
+
+	if (x->sign > 0) {
+		if (m > (uint64_t) INT64_MAX) {
+			return false;
+		}
+
+		*out = (int64_t) m;
+	} else {
+		if (m > (uint64_t) INT64_MAX + 1) {
+			return false;
+		}
+
+		*out = (int64_t) (0 - m);
+	}
+
+	return true;
+}
+
+char* bigint_to_string(const BigInt* x) {
+	/*cada palavra de 64 bits tem no máximo 20 dígitos decimais*/
+	size_t cap = 20 * x->len + 3;
+	char* s = malloc(cap);
+	uint64_t* t = malloc((x->len + 1) * sizeof(uint64_t));
+
+	if (!s || !t) {
+		die("malloc error (bigint_to_string)");
+	}
+
+	memcpy(t, x->d, x->len * sizeof(uint64_t));
+	size_t len = x->len, pos = cap - 1;
+	s[pos] = '\0';
+
+	do {
+		/*divide t por 10^19 e guarda o resto*/
+		const uint64_t base = UINT64_C(10000000000000000000);
+		u128 rem = 0;
+
+		for (size_t i = len; i-- > 0;) {
+			u128 cur = (rem << 64) | t[i];
+			t[i] = (uint64_t) (cur / base);
+			rem = cur % base;
+		}
+
+		while (len > 0 && t[len - 1] == 0) {
+			len--;
+		}
+
+		uint64_t r = (uint64_t) rem;
+
+		for (int dgt = 0; dgt < 19 && (len > 0 || r > 0); dgt++) {
+			s[--pos] = (char) ('0' + r % 10);
+			r /= 10;
+		}
+	} while (len > 0);
+
+	if (pos == cap - 1) {
+		s[--pos] = '0';
+	}
+
+	if (x->sign < 0) {
+		s[--pos] = '-';
+	}
+
+	memmove(s, &s[pos], cap - pos);
+	free(t);
+
+	return s;
+}
+
+/*Reconstrói o inteiro x em (-P/2, P/2] com x = r[i] (mod primes[i]),
+P = prod primes[i] (algoritmo de Garner)*/
+static void crt_reconstruct(const uint64_t* primes, const uint64_t* r,
+	size_t stride, size_t np, const uint64_t* inv, BigInt* out) {
+	uint64_t* v = malloc(np * sizeof(uint64_t));
+
+	if (!v) {
+		die("malloc error (v)");
+	}
+
+	for (size_t i = 0; i < np; i++) {
+		uint64_t t = r[i * stride];
+
+		for (size_t j = 0; j < i; j++) {
+			t = mulmod(submod(t, v[j] % primes[i], primes[i]),
+				inv[IDX(j, i, np)], primes[i]);
+		}
+
+		v[i] = t;
+	}
+
+	BigInt x = {1, 0, calloc(np + 1, sizeof(uint64_t))};
+	BigInt P = {1, 0, calloc(np + 1, sizeof(uint64_t))};
+
+	if (!x.d || !P.d) {
+		die("malloc error (BigInt)");
+	}
+
+	/*x = v0 + p0 (v1 + p1 (v2 + ...)) por Horner*/
+	for (size_t i = np; i-- > 0;) {
+		bigint_muladd(&x, primes[i], v[i]);
+	}
+
+	P.d[0] = 1;
+	P.len = 1;
+
+	for (size_t i = 0; i < np; i++) {
+		bigint_muladd(&P, primes[i], 0);
+	}
+
+	/*se 2x > P, então o representante certo é x - P < 0*/
+	BigInt x2 = {1, x.len, calloc(np + 1, sizeof(uint64_t))};
+
+	if (!x2.d) {
+		die("malloc error (BigInt)");
+	}
+
+	memcpy(x2.d, x.d, x.len * sizeof(uint64_t));
+	bigint_muladd(&x2, 2, 0);
+
+	if (bigint_cmp_mag(&x2, &P) > 0) {
+		bigint_rsub_mag(&x, &P);
+		x.sign = -1;
+	}
+
+	bigint_trim(&x);
+	free(x2.d);
+	free(P.d);
+	free(v);
+
+	*out = x;
+}
+
+
+/* --- Driver multi-modular --- */
+
+/*log2 de uma cota para |coeffs[j]|, j <= k. coeffs[j] é (a menos do
+sinal) a soma dos menores principais j x j de A; pela desigualdade de
+Hadamard cada um é limitado pelo produto das normas das colunas, então
+|coeffs[j]| <= C(n, j) * (produto das j maiores normas de coluna)*/
+static double char_coeffs_log2_bound(const double* A, size_t n, size_t k) {
+	double* lnorm = malloc((n + 1) * sizeof(double));
+
+	if (!lnorm) {
+		die("malloc error (lnorm)");
+	}
+
+	for (size_t j = 0; j < n; j++) {
+		double s = 0.0;
+
+		for (size_t i = 0; i < n; i++) {
+			s += A[IDX(i, j, n)] * A[IDX(i, j, n)];
+		}
+
+		lnorm[j] = (s > 0.0) ? 0.5 * log2(s) : -INFINITY;
+	}
+
+	/*ordena decrescente (insertion sort basta, n é pequeno perto de n³)*/
+	for (size_t i = 1; i < n; i++) {
+		double t = lnorm[i];
+		size_t j = i;
+
+		while (j > 0 && lnorm[j - 1] < t) {
+			lnorm[j] = lnorm[j - 1];
+			j--;
+		}
+
+		lnorm[j] = t;
+	}
+
+	double best = 0.0, prod = 0.0;
+
+	for (size_t j = 1; j <= k; j++) {
+		prod += lnorm[j - 1];
+
+		if (prod == -INFINITY) {
+			break;
+		}
+
+		double lbinom = (lgamma((double) n + 1) - lgamma((double) j + 1)
+			- lgamma((double) (n - j) + 1)) / log(2.0);
+
+		if (prod + lbinom > best) {
+			best = prod + lbinom;
+		}
+	}
+
+	free(lnorm);
+	return best;
+}
+
+typedef struct {
+	const double* A;
+	size_t n, k;
+	bool det;				/* determinante (k = 0) em vez do polinômio*/
+	const uint64_t* primes;
+	size_t np;
+	size_t first, step;
+	uint64_t* residues;		/* np x (k + 1)*/
+} CharpolyJob;
+
+static void* charpoly_worker(void* arg) {
+	CharpolyJob* job = arg;
+	size_t n = job->n, k = job->k;
+
+	uint64_t* H = malloc((n * n + 1) * sizeof(uint64_t));
+	uint64_t* T = malloc((n + 1) * (k + 1) * sizeof(uint64_t));
+
+	if (!H || !T) {
+		die("malloc error (H || T)");
+	}
+
+	for (size_t i = job->first; i < job->np; i += job->step) {
+		if (job->det) {
+			job->residues[i] = det_mod_work(job->A, n, job->primes[i], H);
+		} else {
+			char_coeffs_mod_work(job->A, n, k, job->primes[i], H, T,
+				&job->residues[i * (k + 1)]);
+		}
+	}
+
+	free(H);
+	free(T);
+
+	return NULL;
+}
+
+/*Calcula os k + 1 valores (coeficientes ou, se det, o determinante
+com k = 0) módulo primos suficientes para bits bits e reconstrói*/
+static void multimodular(const double* A, size_t n, size_t k, bool det,
+	double bits, BigInt* out) {
+	/*P precisa ser maior que 2 * cota; cada primo tem 61 bits "úteis"*/
+	size_t np = (size_t) ceil((bits + 2.0) / 61.0);
+
+	if (np == 0) {
+		np = 1;
+	}
+
+	uint64_t* primes = malloc(np * sizeof(uint64_t));
+	uint64_t* residues = malloc(np * (k + 1) * sizeof(uint64_t));
+	uint64_t* inv = malloc(np * np * sizeof(uint64_t));
+
+	if (!primes || !residues || !inv) {
+		die("malloc error (primes || residues || inv)");
+	}
+
+	crt_primes(primes, np);
+
+	size_t nt = graph_num_threads();
+
+	if (nt > np) {
+		nt = np;
+	}
+
+	pthread_t* th = malloc(nt * sizeof(pthread_t));
+	CharpolyJob* jobs = malloc(nt * sizeof(CharpolyJob));
+
+	if (!th || !jobs) {
+		die("malloc error (threads)");
+	}
+
+	for (size_t t = 0; t < nt; t++) {
+		jobs[t] = (CharpolyJob) {A, n, k, det, primes, np, t, nt, residues};
+
+		if (pthread_create(&th[t], NULL, charpoly_worker, &jobs[t]) != 0) {
+			die("pthread_create");
+		}
+	}
+
+	/*inv[j][i] = primes[j]^(-1) mod primes[i], para Garner*/
+	for (size_t j = 0; j < np; j++) {
+		for (size_t i = j + 1; i < np; i++) {
+			inv[IDX(j, i, np)] = invmod(primes[j] % primes[i], primes[i]);
+		}
+	}
+
+	for (size_t t = 0; t < nt; t++) {
+		pthread_join(th[t], NULL);
+	}
+
+	for (size_t j = 0; j <= k; j++) {
+		crt_reconstruct(primes, &residues[j], k + 1, np, inv, &out[j]);
+	}
+
+	free(th);
+	free(jobs);
+	free(inv);
+	free(residues);
+	free(primes);
+}
+
+void matrix_char_coeffs_exact(const double* A, size_t n, size_t k,
+	BigInt* coeffs) {
+	if (k > n) {
+		k = n;
+	}
+
+	check_integer_matrix(A, n);
+	multimodular(A, n, k, false, char_coeffs_log2_bound(A, n, k), coeffs);
+}
+
+void matrix_det_exact(const double* A, size_t n, BigInt* det) {
+	check_integer_matrix(A, n);
+
+	/*Hadamard: |det A| <= produto das normas das colunas*/
+	double bits = 0.0;
+
+	for (size_t j = 0; j < n; j++) {
+		double s = 0.0;
+
+		for (size_t i = 0; i < n; i++) {
+			s += A[IDX(i, j, n)] * A[IDX(i, j, n)];
+		}
+
+		if (s == 0.0) {
+			bits = 0.0;
+			break;
+		}
+
+		bits += 0.5 * log2(s);
+	}
+
+	multimodular(A, n, 0, true, bits, det);
+}
@@ -0,0 +1,84 @@
+#ifndef CHARPOLY_H
+#define CHARPOLY_H
+
+/* --- Polinômio característico exato (aritmética modular + CRT). --- */
+
+/*
+A versão de matrix_char_coeffs em eig.h usa double, então para
+grafos um pouco maiores os coeficientes deixam de ser exatos (e
+o algoritmo é O(n⁴)). As funções daqui só aceitam matrizes com
+entradas inteiras (como a matriz de adjacência de um grafo sem
+pesos) e devolvem os coeficientes como inteiros de tamanho
+arbitrário.
+
+A ideia é:
+- reduzir A módulo vários primos de 62 bits;
+- para cada primo, levar A à forma de Hessenberg por semelhança
+  e achar o polinômio característico por recorrência, O(n³);
+- juntar os resíduos com o teorema chinês do resto (Garner).
+
+Os primos são processados em paralelo (veja graph_num_threads).
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*Inteiro de tamanho arbitrário. d guarda o módulo em palavras
+de 64 bits (a menos significativa primeiro)*/
+typedef struct {
+	int sign;			/* -1, 0 ou +1*/
+	size_t len;			/* N° de palavras em d*/
+	uint64_t* d;		/* Módulo (little-endian)*/
+} BigInt;
+
+
+/*Libera o conteúdo de x (não libera x)*/
+void bigint_free(BigInt* x);
+
+
+/*Converte x para double (arredondado)*/
+double bigint_to_double(const BigInt* x);
+
+
+/*Coloca x em *out e retorna true se x couber em um int64_t*/
+bool bigint_to_int64(const BigInt* x, int64_t* out);
+
+
+/*Retorna x em decimal numa string alocada dinamicamente
+(free-after-use)*/
+char* bigint_to_string(const BigInt* x);
+
+
+/*Acha os coeficientes exatos do polinômio característico
+det(xI - A) = coeffs[0] x^n + coeffs[1] x^(n-1) + ... + coeffs[n],
+com a mesma convenção de matrix_char_coeffs (coeffs[0] = 1).
+
+Só os k primeiros coeficientes depois do líder são calculados
+(coeffs deve ter espaço para k + 1 BigInt). Passe k = n para ter
+o polinômio inteiro. Com k pequeno a cota dos coeficientes é bem
+menor, então são necessários menos primos, e a recorrência em
+cima da forma de Hessenberg custa O(nk²) em vez de O(n³).
+
+As entradas de A devem ser inteiras (|a| < 2^53); caso contrário
+a função chama die. Libere cada coeffs[i] com bigint_free.*/
+void matrix_char_coeffs_exact(const double* A, size_t n, size_t k,
+	BigInt* coeffs);
+
+
+/*Acha os k + 1 primeiros coeficientes de det(xI - A) módulo o
+primo p (p < 2^63)*/
+void matrix_char_coeffs_mod(const double* A, size_t n, size_t k,
+	uint64_t p, uint64_t* coeffs);
+
+
+/*Determinante exato de A (entradas inteiras), pelo mesmo esquema:
+eliminação gaussiana módulo cada primo, O(n³), com o número de primos
+dado pela cota de Hadamard. Libere det com bigint_free*/
+void matrix_det_exact(const double* A, size_t n, BigInt* det);
+
+
+/*Determinante de A módulo o primo p (p < 2^63)*/
+uint64_t matrix_det_mod(const double* A, size_t n, uint64_t p);
+
+#endif
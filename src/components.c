@@ -0,0 +1,364 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <lapacke.h>
+#include "components.h"
+
+size_t graph_components(const Graph* g, size_t* label) {
+	size_t n = g->n;
+	size_t* queue = malloc((n + 1) * sizeof(size_t));
+
+	if (!queue) {
+		die("malloc error (queue)");
+	}
+
+	for (size_t v = 0; v < n; v++) {
+		label[v] = SIZE_MAX;
+	}
+
+	size_t c = 0;
+
+	for (size_t s = 0; s < n; s++) {
+		if (label[s] != SIZE_MAX) {
+			continue;
+		}
+
+		size_t head = 0, tail = 0;
+		queue[tail++] = s;
+		label[s] = c;
+
+		while (head < tail) {
+			size_t u = queue[head++];
+
+			for (size_t v = 0; v < n; v++) {
+				bool adj = g->A[IDX(u, v, n)] != 0.0
+					|| (g->directed && g->A[IDX(v, u, n)] != 0.0);
+
+				if (adj && label[v] == SIZE_MAX) {
+					label[v] = c;
+					queue[tail++] = v;
+				}
+			}
+		}
+
+		c++;
+	}
+
+	free(queue);
+
+	return c;
+}
+
+/*Tarjan sem recursão: call[] guarda a pilha de chamadas e next[v] o
+próximo vizinho de v a ser visitado*/
+size_t graph_strong_components(const Graph* g, size_t* label) {
+	size_t n = g->n;
+	size_t* index = malloc((n + 1) * sizeof(size_t));
+	size_t* low = malloc((n + 1) * sizeof(size_t));
+	size_t* next = malloc((n + 1) * sizeof(size_t));
+	size_t* stack = malloc((n + 1) * sizeof(size_t));
+	size_t* call = malloc((n + 1) * sizeof(size_t));
+	bool* on_stack = calloc(n + 1, sizeof(bool));
+
+	if (!index || !low || !next || !stack || !call || !on_stack) {
+		die("malloc error (tarjan)");
+	}
+
+	for (size_t v = 0; v < n; v++) {
+		index[v] = SIZE_MAX;
+	}
+
+	size_t counter = 0, sp = 0, c = 0;
+
+	for (size_t s = 0; s < n; s++) {
+		if (index[s] != SIZE_MAX) {
+			continue;
+		}
+
+		size_t depth = 0;
+		call[depth++] = s;
+		index[s] = low[s] = counter++;
+		next[s] = 0;
+		stack[sp++] = s;
+		on_stack[s] = true;
+
+		while (depth > 0) {
+			size_t u = call[depth - 1];
+			bool descended = false;
+
+			while (next[u] < n) {
+				size_t v = next[u]++;
+
+				if (g->A[IDX(u, v, n)] == 0.0) {
+					continue;
+				}
+
+				if (index[v] == SIZE_MAX) {
+					index[v] = low[v] = counter++;
+					next[v] = 0;
+					stack[sp++] = v;
+					on_stack[v] = true;
+					call[depth++] = v;
+					descended = true;
+					break;
+				}
+
+				if (on_stack[v] && index[v] < low[u]) {
+					low[u] = index[v];
+				}
+			}
+
+			if (descended) {
+				continue;
+			}
+
+			/*u terminou: fecha a componente se u for raiz*/
+			if (low[u] == index[u]) {
+				size_t w;
+
+				do {
+					w = stack[--sp];
+					on_stack[w] = false;
+					label[w] = c;
+				} while (w != u);
+
+				c++;
+			}
+
+			depth--;
+
+			if (depth > 0) {
+				size_t p = call[depth - 1];
+
+				if (low[u] < low[p]) {
+					low[p] = low[u];
+				}
+			}
+		}
+	}
+
+	/*Tarjan fecha as componentes em ordem topológica reversa*/
+	for (size_t v = 0; v < n; v++) {
+		label[v] = c - 1 - label[v];
+	}
+
+	free(index);
+	free(low);
+	free(next);
+	free(stack);
+	free(call);
+	free(on_stack);
+
+	return c;
+}
+
+/*Agrupa os vértices por rótulo (counting sort, estável)*/
+static void group_by_label(const size_t* label, size_t n, size_t c,
+	size_t* perm, size_t* start) {
+	memset(start, 0, (c + 1) * sizeof(size_t));
+
+	for (size_t v = 0; v < n; v++) {
+		start[label[v] + 1]++;
+	}
+
+	for (size_t b = 0; b < c; b++) {
+		start[b + 1] += start[b];
+	}
+
+	size_t* fill = malloc((c + 1) * sizeof(size_t));
+
+	if (!fill) {
+		die("malloc error (fill)");
+	}
+
+	memcpy(fill, start, (c + 1) * sizeof(size_t));
+
+	for (size_t v = 0; v < n; v++) {
+		perm[fill[label[v]]++] = v;
+	}
+
+	free(fill);
+}
+
+size_t graph_block_triangular_order(const Graph* g, size_t* perm,
+	size_t* start) {
+	size_t* label = malloc((g->n + 1) * sizeof(size_t));
+
+	if (!label) {
+		die("malloc error (label)");
+	}
+
+	size_t c = graph_strong_components(g, label);
+	group_by_label(label, g->n, c, perm, start);
+	free(label);
+
+	return c;
+}
+
+
+/* --- Espectro por blocos --- */
+
+typedef struct {
+	const double* A;
+	size_t n;
+	const size_t* perm;
+	const size_t* start;
+	const size_t* order;	/* blocos do maior para o menor*/
+	size_t c;
+	double* x;				/* x[start[b]..] = espectro do bloco b*/
+	atomic_size_t next;
+	atomic_int info;
+} BlockJob;
+
+static void* block_worker(void* arg) {
+	BlockJob* job = arg;
+	double* buf = NULL;
+	size_t cap = 0;
+
+	for (;;) {
+		size_t k = atomic_fetch_add(&job->next, 1);
+
+		if (k >= job->c) {
+			break;
+		}
+
+		size_t b = job->order[k];
+		size_t s = job->start[b];
+		size_t sz = job->start[b + 1] - s;
+		const size_t* vs = &job->perm[s];
+
+		if (sz == 1) {
+			job->x[s] = job->A[IDX(vs[0], vs[0], job->n)];
+			continue;
+		}
+
+		if (sz * sz > cap) {
+			cap = sz * sz;
+			free(buf);
+			buf = malloc(cap * sizeof(double));
+
+			if (!buf) {
+				die("malloc error (buf)");
+			}
+		}
+
+		for (size_t i = 0; i < sz; i++) {
+			for (size_t j = 0; j < sz; j++) {
+				buf[IDX(i, j, sz)] = job->A[IDX(vs[i], vs[j], job->n)];
+			}
+		}
+
+		int info = LAPACKE_dsyev(LAPACK_ROW_MAJOR, 'N', 'U', (int) sz, buf,
+			(int) sz, &job->x[s]);
+
+		if (info != 0) {
+			int zero = 0;
+			atomic_compare_exchange_strong(&job->info, &zero, info);
+		}
+	}
+
+	free(buf);
+
+	return NULL;
+}
+
+typedef struct {
+	size_t size;
+	size_t b;
+} BlockSize;
+
+static int cmp_block_size(const void* a, const void* b) {
+	size_t si = ((const BlockSize*) a)->size;
+	size_t sj = ((const BlockSize*) b)->size;
+
+	return (si < sj) - (si > sj);
+}
+
+int matrix_spec_blocks(const double* A, size_t n, const size_t* label,
+	size_t c, double* x) {
+	if (n == 0) {
+		return 0;
+	}
+
+	size_t* perm = malloc(n * sizeof(size_t));
+	size_t* start = malloc((c + 1) * sizeof(size_t));
+	size_t* order = malloc(c * sizeof(size_t));
+
+	if (!perm || !start || !order) {
+		die("malloc error (perm || start || order)");
+	}
+
+	group_by_label(label, n, c, perm, start);
+
+	/*maiores primeiro, para as threads terminarem juntas*/
+	BlockSize* sizes = malloc(c * sizeof(BlockSize));
+
+	if (!sizes) {
+		die("malloc error (sizes)");
+	}
+
+	for (size_t b = 0; b < c; b++) {
+		sizes[b] = (BlockSize) {start[b + 1] - start[b], b};
+	}
+
+	qsort(sizes, c, sizeof(BlockSize), cmp_block_size);
+
+	for (size_t b = 0; b < c; b++) {
+		order[b] = sizes[b].b;
+	}
+
+	free(sizes);
+
+	BlockJob job = {.A = A, .n = n, .perm = perm, .start = start,
+		.order = order, .c = c, .x = x};
+	atomic_init(&job.next, 0);
+	atomic_init(&job.info, 0);
+
+	/*só vale a pena abrir threads para os blocos não triviais*/
+	size_t big = 0;
+
+	while (big < c && start[order[big] + 1] - start[order[big]] > 1) {
+		big++;
+	}
+
+	size_t nt = graph_num_threads();
+
+	if (nt > big) {
+		nt = big;
+	}
+
+	if (nt <= 1) {
+		block_worker(&job);
+	} else {
+		pthread_t* th = malloc(nt * sizeof(pthread_t));
+
+		if (!th) {
+			die("malloc error (threads)");
+		}
+
+		for (size_t t = 0; t < nt; t++) {
+			if (pthread_create(&th[t], NULL, block_worker, &job) != 0) {
+				die("pthread_create");
+			}
+		}
+
+		for (size_t t = 0; t < nt; t++) {
+			pthread_join(th[t], NULL);
+		}
+
+		free(th);
+	}
+
+	int info = atomic_load(&job.info);
+
+	if (info == 0) {
+		qsort(x, n, sizeof(double), cmp_double);
+	}
+
+	free(perm);
+	free(start);
+	free(order);
+
+	return info;
+}
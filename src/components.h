@@ -0,0 +1,52 @@
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+
+/* --- Componentes e decomposição em blocos --- */
+
+/*
+O espectro de um grafo desconexo é a união dos espectros das suas
+componentes (a matriz vira bloco-diagonal depois de uma permutação).
+graph_spec_adj e graph_spec_lap usam isso automaticamente para grafos
+não direcionados: rotulam as componentes, copiam cada bloco para um
+buffer compacto, resolvem os blocos em paralelo (graph_num_threads())
+e juntam os espectros. Com c componentes de tamanho n/c o custo cai
+de O(n³) para O(n³/c²).
+
+Para grafos direcionados a mesma ideia vale com as componentes
+fortemente conexas: ordenando as componentes topologicamente a matriz
+fica bloco-triangular superior, e os autovalores são os dos blocos da
+diagonal (veja graph_block_triangular_order).
+*/
+
+#include "graphs.h"
+
+
+/*label[v] = componente (conexa, ou fracamente conexa se g for
+direcionado) de v, numeradas 0..c-1 na ordem do menor vértice.
+Retorna c*/
+size_t graph_components(const Graph* g, size_t* label);
+
+
+/*label[v] = componente fortemente conexa de v (Tarjan), numeradas em
+ordem topológica: toda aresta u -> v entre componentes diferentes
+tem label[u] < label[v]. Retorna o n° de componentes*/
+size_t graph_strong_components(const Graph* g, size_t* label);
+
+
+/*perm (n posições) lista os vértices agrupados por componente forte,
+em ordem topológica; os vértices da componente c são
+perm[start[c]..start[c+1]). start deve ter espaço para n + 1 posições.
+Com essa permutação, P A Pᵀ é bloco-triangular superior.
+Retorna o n° de componentes*/
+size_t graph_block_triangular_order(const Graph* g, size_t* perm,
+	size_t* start);
+
+
+/*Espectro de A (n x n, simétrica) sabendo que ela é bloco-diagonal
+segundo label (c blocos, label[v] < c): resolve cada bloco
+separadamente, em paralelo, e escreve a união em x (ordem
+crescente). Retorna o primeiro info != 0 do LAPACK*/
+int matrix_spec_blocks(const double* A, size_t n, const size_t* label,
+	size_t c, double* x);
+
+#endif
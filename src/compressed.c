@@ -0,0 +1,561 @@
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "compressed.h"
+#include "mem.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_SSSE3_PATH 1
+#endif
+
+/*Folga no fim de data: o caminho SIMD lê 16 bytes por grupo*/
+#define SVB_PAD 16
+
+
+/* --- Varint --- */
+
+static size_t varint_len(uint32_t v) {
+	size_t len = 1;
+
+	while (v >= 0x80) {
+		v >>= 7;
+		len++;
+	}
+
+	return len;
+}
+
+static uint8_t* varint_put(uint8_t* p, uint32_t v) {
+	while (v >= 0x80) {
+		*p++ = (uint8_t) (v | 0x80);
+		v >>= 7;
+	}
+
+	*p++ = (uint8_t) v;
+
+	return p;
+}
+
+static inline const uint8_t* varint_get(const uint8_t* p, uint32_t* v) {
+	/*caso comum: diferença pequena, um byte*/
+	if (*p < 0x80) {
+		*v = *p;
+		return p + 1;
+	}
+
+	uint32_t x = *p & 0x7F;
+	unsigned shift = 7;
+
+	while (*p++ & 0x80) {
+		x |= (uint32_t) (*p & 0x7F) << shift;
+		shift += 7;
+	}
+
+	*v = x;
+
+	return p;
+}
+
+static void varint_decode(const uint8_t* p, size_t d, uint32_t* out) {
+	uint32_t prev = 0;
+
+	for (size_t i = 0; i < d; i++) {
+		uint32_t delta;
+		p = varint_get(p, &delta);
+		prev += delta;
+		out[i] = prev;
+	}
+}
+
+
+/* --- StreamVByte --- */
+
+/*Código de 2 bits: n° de bytes - 1*/
+static unsigned svb_code(uint32_t v) {
+	return v < (1u << 8) ? 0 : v < (1u << 16) ? 1 : v < (1u << 24) ? 2 : 3;
+}
+
+static uint8_t* svb_put(uint8_t* p, const uint32_t* deltas, size_t d) {
+	uint8_t* ctrl = p;
+	uint8_t* data = p + (d + 3) / 4;
+	memset(ctrl, 0, (d + 3) / 4);
+
+	for (size_t i = 0; i < d; i++) {
+		unsigned code = svb_code(deltas[i]);
+		ctrl[i / 4] |= (uint8_t) (code << (2 * (i % 4)));
+
+		for (unsigned b = 0; b <= code; b++) {
+			*data++ = (uint8_t) (deltas[i] >> (8 * b));
+		}
+	}
+
+	return data;
+}
+
+static void svb_decode_scalar(const uint8_t* p, size_t d, uint32_t* out) {
+	const uint8_t* ctrl = p;
+	const uint8_t* data = p + (d + 3) / 4;
+	uint32_t prev = 0;
+
+	for (size_t i = 0; i < d; i++) {
+		unsigned code = (ctrl[i / 4] >> (2 * (i % 4))) & 3;
+		uint32_t v = 0;
+
+		for (unsigned b = 0; b <= code; b++) {
+			v |= (uint32_t) *data++ << (8 * b);
+		}
+
+		prev += v;
+		out[i] = prev;
+	}
+}
+
+/*Para cada byte de controle: máscara do pshufb (0x80 zera o byte) e
+quantos bytes de dados o grupo ocupa*/
+static uint8_t svb_shuffle[256][16];
+static uint8_t svb_length[256];
+static bool use_simd = true;
+static bool has_ssse3 = false;
+static pthread_once_t svb_once = PTHREAD_ONCE_INIT;
+
+static void svb_init(void) {
+	for (unsigned key = 0; key < 256; key++) {
+		unsigned pos = 0;
+
+		for (unsigned k = 0; k < 4; k++) {
+			unsigned len = ((key >> (2 * k)) & 3) + 1;
+
+			for (unsigned b = 0; b < 4; b++) {
+				svb_shuffle[key][4 * k + b] = b < len ? (uint8_t) pos++ : 0x80;
+			}
+		}
+
+		svb_length[key] = (uint8_t) pos;
+	}
+
+#ifdef HAVE_SSSE3_PATH
+	__builtin_cpu_init();
+	has_ssse3 = __builtin_cpu_supports("ssse3");
+#endif
+}
+
+#ifdef HAVE_SSSE3_PATH
+__attribute__((target("ssse3")))
+static void svb_decode_ssse3(const uint8_t* p, size_t d, uint32_t* out) {
+	const uint8_t* ctrl = p;
+	const uint8_t* data = p + (d + 3) / 4;
+	__m128i prev = _mm_setzero_si128();
+	size_t full = d / 4;
+
+	for (size_t g = 0; g < full; g++) {
+		uint8_t key = ctrl[g];
+		__m128i raw = _mm_loadu_si128((const __m128i*) data);
+		__m128i mask = _mm_loadu_si128((const __m128i*) svb_shuffle[key]);
+		__m128i x = _mm_shuffle_epi8(raw, mask);
+
+		/*soma prefixada dos 4 deltas + último valor do grupo anterior*/
+		x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+		x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+		x = _mm_add_epi32(x, prev);
+		_mm_storeu_si128((__m128i*) &out[4 * g], x);
+
+		prev = _mm_shuffle_epi32(x, 0xFF);
+		data += svb_length[key];
+	}
+
+	/*resto (< 4 valores): escalar*/
+	uint32_t last = full ? out[4 * full - 1] : 0;
+
+	for (size_t i = 4 * full; i < d; i++) {
+		unsigned code = (ctrl[i / 4] >> (2 * (i % 4))) & 3;
+		uint32_t v = 0;
+
+		for (unsigned b = 0; b <= code; b++) {
+			v |= (uint32_t) *data++ << (8 * b);
+		}
+
+		last += v;
+		out[i] = last;
+	}
+}
+#endif
+
+void graph_compressed_set_simd(bool on) {
+	pthread_once(&svb_once, svb_init);
+	use_simd = on;
+}
+
+
+/* --- Montagem --- */
+
+static uint32_t* alloc_u32(size_t count) {
+	uint32_t* p = malloc((count ? count : 1) * sizeof(uint32_t));
+
+	if (!p) {
+		die("malloc error (uint32_t)");
+	}
+
+	return p;
+}
+
+/*Tamanho da lista codificada de u (cabeçalho incluso); deltas recebe
+v0, v1 - v0, ...*/
+static size_t list_deltas(const GraphCSR* g, size_t u, GraphCodec codec,
+	uint32_t* deltas) {
+	size_t b = g->rowptr[u], d = g->rowptr[u + 1] - b;
+	size_t len = varint_len((uint32_t) d);
+	uint32_t prev = 0;
+
+	for (size_t i = 0; i < d; i++) {
+		uint32_t v = (uint32_t) g->col[b + i];
+		deltas[i] = v - prev;
+		prev = v;
+
+		len += codec == GRAPH_CODEC_VARINT
+			? varint_len(deltas[i]) : svb_code(deltas[i]) + 1;
+	}
+
+	if (codec == GRAPH_CODEC_STREAMVBYTE) {
+		len += (d + 3) / 4;
+	}
+
+	return len;
+}
+
+static uint64_t list_hash(const GraphCSR* g, size_t u) {
+	uint64_t h = 1469598103934665603ULL;
+
+	for (size_t e = g->rowptr[u]; e <= g->rowptr[u + 1]; e++) {
+		uint64_t v = e < g->rowptr[u + 1] ? g->col[e] : UINT64_MAX;
+		h = (h ^ v) * 1099511628211ULL;
+	}
+
+	return h;
+}
+
+static bool same_list(const GraphCSR* g, size_t u, size_t v) {
+	size_t du = g->rowptr[u + 1] - g->rowptr[u];
+	size_t dv = g->rowptr[v + 1] - g->rowptr[v];
+
+	return du == dv && memcmp(&g->col[g->rowptr[u]], &g->col[g->rowptr[v]],
+		du * sizeof(size_t)) == 0;
+}
+
+GraphCompressed* graph_compress(const GraphCSR* g, GraphCodec codec,
+	bool share) {
+	size_t n = g->n;
+
+	if (n >= UINT32_MAX) {
+		return NULL;
+	}
+
+	GraphCompressed* c = calloc(1, sizeof(GraphCompressed));
+
+	if (!c) {
+		die("malloc error (GraphCompressed)");
+	}
+
+	c->n = n;
+	c->directed = g->directed;
+	c->codec = codec;
+	c->nnz = g->rowptr[n];
+	c->offset = graph_mem_alloc((n ? n : 1) * sizeof(uint64_t));
+
+	for (size_t u = 0; u < n; u++) {
+		size_t d = g->rowptr[u + 1] - g->rowptr[u];
+		c->max_degree = d > c->max_degree ? d : c->max_degree;
+	}
+
+	uint32_t* deltas = alloc_u32(c->max_degree);
+
+	/*tabela de hash (vértice + 1, 0 = vazio) para achar listas iguais*/
+	size_t cap = 1;
+	uint32_t* table = NULL;
+	bool* owner = calloc(n + 1, sizeof(bool));
+
+	if (!owner) {
+		die("malloc error (owner)");
+	}
+
+	if (share) {
+		while (cap < 2 * n) {
+			cap *= 2;
+		}
+
+		table = calloc(cap, sizeof(uint32_t));
+
+		if (!table) {
+			die("malloc error (table)");
+		}
+	}
+
+	/*primeira passada: offsets (e quem reaproveita quem)*/
+	size_t pos = 0;
+
+	for (size_t u = 0; u < n; u++) {
+		if (share) {
+			size_t slot = list_hash(g, u) & (cap - 1);
+
+			while (table[slot] && !same_list(g, table[slot] - 1, u)) {
+				slot = (slot + 1) & (cap - 1);
+			}
+
+			if (table[slot]) {
+				c->offset[u] = c->offset[table[slot] - 1];
+				c->shared++;
+				continue;
+			}
+
+			table[slot] = (uint32_t) (u + 1);
+		}
+
+		owner[u] = true;
+		c->offset[u] = pos;
+		pos += list_deltas(g, u, codec, deltas);
+	}
+
+	c->bytes = pos;
+	c->data = graph_mem_alloc(pos + SVB_PAD);
+	memset(c->data + pos, 0, SVB_PAD);
+
+	/*segunda passada: escreve as listas*/
+	for (size_t u = 0; u < n; u++) {
+		if (!owner[u]) {
+			continue;
+		}
+
+		size_t d = g->rowptr[u + 1] - g->rowptr[u];
+		list_deltas(g, u, codec, deltas);
+		uint8_t* p = varint_put(c->data + c->offset[u], (uint32_t) d);
+
+		if (codec == GRAPH_CODEC_VARINT) {
+			for (size_t i = 0; i < d; i++) {
+				p = varint_put(p, deltas[i]);
+			}
+		} else {
+			svb_put(p, deltas, d);
+		}
+	}
+
+	free(deltas);
+	free(table);
+	free(owner);
+
+	return c;
+}
+
+void graph_compressed_free(GraphCompressed* c) {
+	if (!c) {
+		return;
+	}
+
+	graph_mem_free(c->offset);
+	graph_mem_free(c->data);
+	free(c);
+}
+
+size_t graph_compressed_bytes(const GraphCompressed* c) {
+	return sizeof(GraphCompressed) + c->n * sizeof(uint64_t) + c->bytes;
+}
+
+
+/* --- Leitura --- */
+
+size_t graph_compressed_neighbors(const GraphCompressed* c, size_t u,
+	uint32_t* out) {
+	uint32_t d;
+	const uint8_t* p = varint_get(c->data + c->offset[u], &d);
+
+	if (c->codec == GRAPH_CODEC_VARINT) {
+		varint_decode(p, d, out);
+		return d;
+	}
+
+	pthread_once(&svb_once, svb_init);
+
+#ifdef HAVE_SSSE3_PATH
+	if (use_simd && has_ssse3) {
+		svb_decode_ssse3(p, d, out);
+		return d;
+	}
+#endif
+
+	svb_decode_scalar(p, d, out);
+
+	return d;
+}
+
+size_t graph_compressed_degree(const GraphCompressed* c, size_t u) {
+	uint32_t d;
+	varint_get(c->data + c->offset[u], &d);
+
+	return d;
+}
+
+size_t graph_compressed_num_edges(const GraphCompressed* c) {
+	return c->directed ? c->nnz : c->nnz / 2;
+}
+
+void graph_compressed_ax(const GraphCompressed* c, const double* x,
+	double* y) {
+	uint32_t* nb = alloc_u32(c->max_degree);
+
+	for (size_t u = 0; u < c->n; u++) {
+		size_t d = graph_compressed_neighbors(c, u, nb);
+		double s = 0.0;
+
+		for (size_t i = 0; i < d; i++) {
+			s += x[nb[i]];
+		}
+
+		y[u] = s;
+	}
+
+	free(nb);
+}
+
+
+/* --- BFS --- */
+
+/*BFS com buffers do chamador; retorna quantos foram alcançados e, em
+ecc, a maior distância*/
+static size_t bfs_run(const GraphCompressed* c, size_t src, int* dist,
+	uint32_t* queue, uint32_t* nb, int* ecc) {
+	for (size_t v = 0; v < c->n; v++) {
+		dist[v] = -1;
+	}
+
+	size_t head = 0, tail = 0;
+	dist[src] = 0;
+	queue[tail++] = (uint32_t) src;
+
+	while (head < tail) {
+		uint32_t u = queue[head++];
+		size_t d = graph_compressed_neighbors(c, u, nb);
+
+		for (size_t i = 0; i < d; i++) {
+			uint32_t v = nb[i];
+
+			if (dist[v] < 0) {
+				dist[v] = dist[u] + 1;
+				queue[tail++] = v;
+			}
+		}
+	}
+
+	/*o último da fila é o mais distante*/
+	*ecc = dist[queue[tail - 1]];
+
+	return tail;
+}
+
+int graph_compressed_bfs(const GraphCompressed* c, size_t src, int* dist) {
+	uint32_t* queue = alloc_u32(c->n);
+	uint32_t* nb = alloc_u32(c->max_degree);
+	int ecc;
+
+	bfs_run(c, src, dist, queue, nb, &ecc);
+	free(queue);
+	free(nb);
+
+	return ecc;
+}
+
+bool graph_compressed_is_connected(const GraphCompressed* c) {
+	if (c->n <= 1) {
+		return true;
+	}
+
+	int* dist = malloc(c->n * sizeof(int));
+	uint32_t* queue = alloc_u32(c->n);
+	uint32_t* nb = alloc_u32(c->max_degree);
+	int ecc;
+
+	if (!dist) {
+		die("malloc error (dist)");
+	}
+
+	bool connected = bfs_run(c, 0, dist, queue, nb, &ecc) == c->n;
+	free(dist);
+	free(queue);
+	free(nb);
+
+	return connected;
+}
+
+typedef struct {
+	const GraphCompressed* c;
+	size_t first, step;		/* Origens first, first + step, ...*/
+	int result;
+} DiamJob;
+
+static void* diam_worker(void* arg) {
+	DiamJob* j = arg;
+	size_t n = j->c->n;
+	int* dist = malloc(n * sizeof(int));
+	uint32_t* queue = alloc_u32(n);
+	uint32_t* nb = alloc_u32(j->c->max_degree);
+
+	if (!dist) {
+		die("malloc error (dist)");
+	}
+
+	j->result = 0;
+
+	for (size_t s = j->first; s < n; s += j->step) {
+		int ecc;
+		bfs_run(j->c, s, dist, queue, nb, &ecc);
+		j->result = ecc > j->result ? ecc : j->result;
+	}
+
+	free(dist);
+	free(queue);
+	free(nb);
+
+	return NULL;
+}
+
+int graph_compressed_diameter(const GraphCompressed* c) {
+	size_t nt = graph_num_threads();
+
+	if (nt > c->n) {
+		nt = c->n ? c->n : 1;
+	}
+
+	DiamJob* jobs = malloc(nt * sizeof(DiamJob));
+	pthread_t* th = malloc(nt * sizeof(pthread_t));
+
+	if (!jobs || !th) {
+		die("malloc error (jobs || th)");
+	}
+
+	for (size_t t = 0; t < nt; t++) {
+		jobs[t] = (DiamJob) {c, t, nt, 0};
+	}
+
+	if (nt == 1) {
+		diam_worker(&jobs[0]);
+	} else {
+		for (size_t t = 0; t < nt; t++) {
+			if (pthread_create(&th[t], NULL, diam_worker, &jobs[t]) != 0) {
+				die("pthread_create");
+			}
+		}
+
+		for (size_t t = 0; t < nt; t++) {
+			pthread_join(th[t], NULL);
+		}
+	}
+
+	int d = 0;
+
+	for (size_t t = 0; t < nt; t++) {
+		d = jobs[t].result > d ? jobs[t].result : d;
+	}
+
+	free(jobs);
+	free(th);
+
+	return d;
+}
@@ -0,0 +1,106 @@
+#ifndef COMPRESSED_H
+#define COMPRESSED_H
+
+/* --- Adjacência comprimida (somente leitura) --- */
+
+/*
+Para os grafos esparsos grandes até o GraphCSR pesa: 8 bytes por
+entrada de col, e a varredura de vizinhos fica limitada pela banda de
+memória. GraphCompressed guarda só o padrão (sem pesos) com as listas
+de vizinhos codificadas por diferenças:
+
+  lista de u = varint(grau) + codec(v0, v1 - v0, v2 - v1, ...)
+
+Como as listas estão ordenadas, as diferenças são pequenas (ainda mais
+depois de renumerar com reorder.h), e cabem em 1 ou 2 bytes. Codecs:
+
+- GRAPH_CODEC_VARINT: varint (LEB128), 7 bits por byte;
+- GRAPH_CODEC_STREAMVBYTE: StreamVByte (Lemire et al.). Cada grupo de
+  4 valores tem um byte de controle (2 bits de tamanho por valor) e os
+  controles ficam antes dos dados, então um grupo é decodificado com
+  um pshufb e uma soma prefixada (SSSE3, escolhido em tempo de
+  execução; sem SSSE3 cai no laço escalar).
+
+Com share = true as listas idênticas (gêmeos, folhas do mesmo hub,
+vértices isolados) são guardadas uma só vez: offset[u] aponta para a
+lista já escrita (compressão por referência, na sua forma mais
+simples).
+
+Os kernels abaixo decodificam cada lista na hora, num buffer de
+max_degree posições, sem nunca montar o CSR.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "graphs.h"
+
+typedef enum {
+	GRAPH_CODEC_VARINT,
+	GRAPH_CODEC_STREAMVBYTE
+} GraphCodec;
+
+typedef struct {
+	size_t n;			/* N° de vértices (< 2^32)*/
+	bool directed;		/* Grafo direcionado?*/
+	GraphCodec codec;
+	size_t nnz;			/* N° de entradas (rowptr[n] do CSR)*/
+	size_t max_degree;	/* Maior lista (tamanho do buffer de decodificação)*/
+	size_t shared;		/* Listas reaproveitadas (share)*/
+	uint64_t* offset;	/* Início da lista de cada vértice em data*/
+	uint8_t* data;		/* Listas (com folga no fim para o SIMD)*/
+	size_t bytes;		/* Tamanho útil de data*/
+} GraphCompressed;
+
+
+/*Comprime o padrão de g (pesos são ignorados). Retorna NULL se
+n >= 2^32 (free-after-use com graph_compressed_free)*/
+GraphCompressed* graph_compress(const GraphCSR* g, GraphCodec codec,
+	bool share);
+
+
+/*Libera um GraphCompressed*/
+void graph_compressed_free(GraphCompressed* c);
+
+
+/*Memória total usada (offsets + listas)*/
+size_t graph_compressed_bytes(const GraphCompressed* c);
+
+
+/*Liga/desliga a decodificação SIMD (só tem efeito com SSSE3)*/
+void graph_compressed_set_simd(bool on);
+
+
+/*Decodifica os vizinhos de u em out (max_degree posições) e retorna
+o grau de saída*/
+size_t graph_compressed_neighbors(const GraphCompressed* c, size_t u,
+	uint32_t* out);
+
+
+/*Grau de saída de u (lê só o cabeçalho da lista)*/
+size_t graph_compressed_degree(const GraphCompressed* c, size_t u);
+
+
+/*Mesma conta de graph_num_edges*/
+size_t graph_compressed_num_edges(const GraphCompressed* c);
+
+
+/*Mesma definição de graph_is_connected (alcança todos a partir de 0)*/
+bool graph_compressed_is_connected(const GraphCompressed* c);
+
+
+/*BFS a partir de src: dist[v] = n° de arestas, ou -1 se v não é
+alcançável. Retorna a excentricidade de src (maior dist finita)*/
+int graph_compressed_bfs(const GraphCompressed* c, size_t src, int* dist);
+
+
+/*Mesma definição de graph_diameter (maior distância finita), com uma
+BFS por vértice dividida entre graph_num_threads() threads*/
+int graph_compressed_diameter(const GraphCompressed* c);
+
+
+/*y = Ax com os pesos todos 1*/
+void graph_compressed_ax(const GraphCompressed* c, const double* x,
+	double* y);
+
+#endif
@@ -0,0 +1,268 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <lapacke.h>
+#include "digraph.h"
+#include "eig.h"
+#include "components.h"
+#include "mem.h"
+
+static int cmp_complex(const void* a, const void* b) {
+	double complex x = *(const double complex*) a;
+	double complex y = *(const double complex*) b;
+
+	if (creal(x) != creal(y)) {
+		return creal(x) < creal(y) ? -1 : 1;
+	}
+
+	return (cimag(x) > cimag(y)) - (cimag(x) < cimag(y));
+}
+
+static bool is_symmetric(const double* A, size_t n) {
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = i + 1; j < n; j++) {
+			if (A[IDX(i, j, n)] != A[IDX(j, i, n)]) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/*dgeev (ou dsyev, se M for simétrica) de M, n x n, destruída; z sem
+ordenar*/
+static int spec_inplace(double* M, size_t n, double complex* z, double* wr,
+	double* wi) {
+	int info;
+
+	if (is_symmetric(M, n)) {
+		info = LAPACKE_dsyev(LAPACK_ROW_MAJOR, 'N', 'U', (int) n, M, (int) n,
+			wr);
+		memset(wi, 0, n * sizeof(double));
+	} else {
+		info = LAPACKE_dgeev(LAPACK_ROW_MAJOR, 'N', 'N', (int) n, M, (int) n,
+			wr, wi, NULL, 1, NULL, 1);
+	}
+
+	for (size_t i = 0; i < n && info == 0; i++) {
+		z[i] = wr[i] + wi[i] * I;
+	}
+
+	return info;
+}
+
+int matrix_spec_complex(const double* A, size_t n, double complex* z) {
+	if (n == 0) {
+		return 0;
+	}
+
+	double* M = graph_mem_matrix(n, n, A);
+	double* wr = malloc(n * sizeof(double));
+	double* wi = malloc(n * sizeof(double));
+
+	if (!wr || !wi) {
+		die("malloc error (wr || wi)");
+	}
+
+	int info = spec_inplace(M, n, z, wr, wi);
+
+	if (info == 0) {
+		qsort(z, n, sizeof(double complex), cmp_complex);
+	}
+
+	graph_mem_free(M);
+	free(wr);
+	free(wi);
+
+	return info;
+}
+
+/*M (adjacência ou laplaciana de g) tem o padrão de g fora da diagonal,
+então é bloco-triangular na ordem das componentes fortes de g*/
+static int spec_by_strong_blocks(const Graph* g, const double* M,
+	double complex* z) {
+	size_t n = g->n;
+
+	if (n == 0) {
+		return 0;
+	}
+
+	size_t* perm = malloc(n * sizeof(size_t));
+	size_t* start = malloc((n + 1) * sizeof(size_t));
+	double* wr = malloc(n * sizeof(double));
+	double* wi = malloc(n * sizeof(double));
+
+	if (!perm || !start || !wr || !wi) {
+		die("malloc error (spec_by_strong_blocks)");
+	}
+
+	size_t c = graph_block_triangular_order(g, perm, start);
+	size_t largest = 0;
+
+	for (size_t b = 0; b < c; b++) {
+		size_t sz = start[b + 1] - start[b];
+		largest = sz > largest ? sz : largest;
+	}
+
+	double* buf = graph_mem_alloc(largest * largest * sizeof(double));
+	int info = 0;
+
+	for (size_t b = 0; b < c && info == 0; b++) {
+		size_t s = start[b], sz = start[b + 1] - s;
+		const size_t* vs = &perm[s];
+
+		if (sz == 1) {
+			z[s] = M[IDX(vs[0], vs[0], n)];
+			continue;
+		}
+
+		for (size_t i = 0; i < sz; i++) {
+			for (size_t j = 0; j < sz; j++) {
+				buf[IDX(i, j, sz)] = M[IDX(vs[i], vs[j], n)];
+			}
+		}
+
+		info = spec_inplace(buf, sz, &z[s], wr, wi);
+	}
+
+	if (info == 0) {
+		qsort(z, n, sizeof(double complex), cmp_complex);
+	}
+
+	graph_mem_free(buf);
+	free(perm);
+	free(start);
+	free(wr);
+	free(wi);
+
+	return info;
+}
+
+/*Sem direção: o caminho real de eig.c (famílias, cache, bipartido,
+componentes)*/
+static int spec_real(const Graph* g, double complex* z, bool laplacian) {
+	double* x = malloc((g->n + 1) * sizeof(double));
+
+	if (!x) {
+		die("malloc error (x)");
+	}
+
+	int info = laplacian ? graph_spec_lap(g, x) : graph_spec_adj(g, x);
+
+	for (size_t i = 0; i < g->n && info == 0; i++) {
+		z[i] = x[i];
+	}
+
+	free(x);
+
+	return info;
+}
+
+int graph_spec_adj_complex(const Graph* g, double complex* z) {
+	if (!g->directed || g->n == 0) {
+		return g->n ? spec_real(g, z, false) : 0;
+	}
+
+	if (is_symmetric(g->A, g->n)) {
+		return spec_real(g, z, false);
+	}
+
+	return spec_by_strong_blocks(g, g->A, z);
+}
+
+int graph_spec_lap_complex(const Graph* g, double complex* z) {
+	size_t n = g->n;
+
+	if (n == 0) {
+		return 0;
+	}
+
+	if (!g->directed || is_symmetric(g->A, n)) {
+		return spec_real(g, z, true);
+	}
+
+	double* L = graph_mem_matrix(n, n, NULL);
+	graph_laplacian(g, L);
+	int info = spec_by_strong_blocks(g, L, z);
+	graph_mem_free(L);
+
+	return info;
+}
+
+
+/* --- Esparso --- */
+
+typedef struct {
+	const GraphCSR* g;
+	const double* scale;	/* Multiplica a linha i (ou NULL)*/
+} CSRMatvec;
+
+static void csr_matvec(const double* x, double* y, void* ctx) {
+	const CSRMatvec* c = ctx;
+	const GraphCSR* g = c->g;
+
+	for (size_t i = 0; i < g->n; i++) {
+		double s = 0.0;
+
+		for (size_t e = g->rowptr[i]; e < g->rowptr[i + 1]; e++) {
+			s += CSR_W(g, e) * x[g->col[e]];
+		}
+
+		y[i] = c->scale ? c->scale[i] * s : s;
+	}
+}
+
+int graph_csr_eigs(const GraphCSR* g, size_t k, ArnoldiWhich which,
+	double complex* z) {
+	CSRMatvec c = {g, NULL};
+
+	return arnoldi_eigs(csr_matvec, &c, g->n, k, which, 0, 0.0, 0, z);
+}
+
+int graph_perron_root(const GraphCSR* g, double* rho) {
+	if (g->n == 0) {
+		*rho = 0.0;
+		return 0;
+	}
+
+	double complex z;
+	int info = graph_csr_eigs(g, 1, ARNOLDI_LARGEST_MODULUS, &z);
+	*rho = cabs(z);
+
+	return info;
+}
+
+int graph_random_walk_gap(const GraphCSR* g, double* gap) {
+	size_t n = g->n;
+
+	if (n < 2) {
+		*gap = n ? 1.0 : 0.0;
+		return 0;
+	}
+
+	double* inv = malloc(n * sizeof(double));
+
+	if (!inv) {
+		die("malloc error (inv)");
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		double d = 0.0;
+
+		for (size_t e = g->rowptr[i]; e < g->rowptr[i + 1]; e++) {
+			d += CSR_W(g, e);
+		}
+
+		inv[i] = d > 0.0 ? 1.0 / d : 0.0;
+	}
+
+	CSRMatvec c = {g, inv};
+	double complex z[2];
+	int info = arnoldi_eigs(csr_matvec, &c, n, 2, ARNOLDI_LARGEST_MODULUS, 0,
+		0.0, 0, z);
+	*gap = cabs(z[0]) - cabs(z[1]);
+	free(inv);
+
+	return info;
+}
@@ -0,0 +1,59 @@
+#ifndef DIGRAPH_H
+#define DIGRAPH_H
+
+/* --- Espectro de grafos direcionados --- */
+
+/*
+A adjacência de um grafo direcionado em geral não é simétrica e tem
+autovalores complexos. O dsyev usado por graph_spec_adj lê só o
+triângulo superior, então graph_spec_adj e graph_spec_lap retornam -1
+nesse caso; use as funções daqui:
+
+- densas: dgeev (só autovalores). Antes, a matriz é posta em forma
+  bloco-triangular pelas componentes fortemente conexas (components.h):
+  os autovalores são os dos blocos da diagonal, então um DAG sai de
+  graça (só a diagonal) e cada componente é resolvida sozinha;
+- esparsas (GraphCSR): Arnoldi com reinício implícito (krylov.h) para
+  os poucos autovalores de maior módulo ou mais à direita, por exemplo
+  o raio espectral (raiz de Perron) e o gap espectral do passeio
+  aleatório.
+
+Os espectros completos saem em ordem crescente da parte real (e da
+imaginária no empate).
+*/
+
+#include <complex.h>
+#include "graphs.h"
+#include "krylov.h"
+
+
+/*Espectro de A (n x n, qualquer) pelo dgeev. Retorna o info do LAPACK*/
+int matrix_spec_complex(const double* A, size_t n, double complex* z);
+
+
+/*Espectro da adjacência de g (direcionado ou não), z com n posições.
+Retorna o primeiro info != 0 do LAPACK*/
+int graph_spec_adj_complex(const Graph* g, double complex* z);
+
+
+/*O mesmo para a laplaciana L = D_out - A*/
+int graph_spec_lap_complex(const Graph* g, double complex* z);
+
+
+/*Os k autovalores da adjacência de g escolhidos por which (veja
+arnoldi_eigs, que dá o significado do retorno)*/
+int graph_csr_eigs(const GraphCSR* g, size_t k, ArnoldiWhich which,
+	double complex* z);
+
+
+/*Raio espectral da adjacência (para pesos >= 0 é a raiz de Perron)*/
+int graph_perron_root(const GraphCSR* g, double* rho);
+
+
+/*Gap do passeio aleatório P = D_out⁻¹ A: |λ₁| - |λ₂|, com |λ₁| = 1 se
+todo vértice tiver aresta de saída. Mede a velocidade de mistura (0
+para grafos periódicos ou com mais de uma classe fechada). Pesos devem
+ser >= 0*/
+int graph_random_walk_gap(const GraphCSR* g, double* gap);
+
+#endif
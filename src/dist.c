@@ -0,0 +1,783 @@
+#include "dist.h"
+
+#ifdef GRAPH_USE_MPI
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/*BLACS e ScaLAPACK não têm cabeçalho C oficial*/
+extern int Csys2blacs_handle(MPI_Comm comm);
+extern void Cfree_blacs_system_handle(int handle);
+extern void Cblacs_gridinit(int* ctxt, const char* order, int nprow,
+	int npcol);
+extern void Cblacs_gridinfo(int ctxt, int* nprow, int* npcol, int* myrow,
+	int* mycol);
+extern void Cblacs_gridexit(int ctxt);
+
+extern void pdsyevr_(const char* jobz, const char* range, const char* uplo,
+	const int* n, double* a, const int* ia, const int* ja, const int* desca,
+	const double* vl, const double* vu, const int* il, const int* iu,
+	int* m, int* nz, double* w, double* z, const int* iz, const int* jz,
+	const int* descz, double* work, const int* lwork, int* iwork,
+	const int* liwork, int* info);
+
+extern void pdsyevd_(const char* jobz, const char* uplo, const int* n,
+	double* a, const int* ia, const int* ja, const int* desca, double* w,
+	double* z, const int* iz, const int* jz, const int* descz, double* work,
+	const int* lwork, int* iwork, const int* liwork, int* info);
+
+static void* xmalloc(size_t count, size_t size) {
+	void* p = malloc((count ? count : 1) * size);
+
+	if (!p) {
+		die("malloc error (dist)");
+	}
+
+	return p;
+}
+
+static void* xcalloc(size_t count, size_t size) {
+	void* p = calloc(count ? count : 1, size);
+
+	if (!p) {
+		die("calloc error (dist)");
+	}
+
+	return p;
+}
+
+/*Todos os processos concordam com ok?*/
+static bool all_ok(MPI_Comm comm, bool ok) {
+	int local = ok, global;
+	MPI_Allreduce(&local, &global, 1, MPI_INT, MPI_LAND, comm);
+
+	return global != 0;
+}
+
+/*Troca de mensagens de tamanho fixo: send tem counts[p] itens de size
+bytes para cada p, em ordem de destino. Retorna os recebidos (e o
+total em *nrecv)*/
+static void* exchange(MPI_Comm comm, int nprocs, const void* send,
+	const size_t* counts, size_t size, size_t* nrecv) {
+	int* scount = xmalloc(nprocs, sizeof(int));
+	int* rcount = xmalloc(nprocs, sizeof(int));
+	int* sdispl = xmalloc(nprocs, sizeof(int));
+	int* rdispl = xmalloc(nprocs, sizeof(int));
+
+	for (int p = 0; p < nprocs; p++) {
+		scount[p] = (int) (counts[p] * size);
+	}
+
+	MPI_Alltoall(scount, 1, MPI_INT, rcount, 1, MPI_INT, comm);
+
+	size_t stotal = 0, rtotal = 0;
+
+	for (int p = 0; p < nprocs; p++) {
+		sdispl[p] = (int) stotal;
+		rdispl[p] = (int) rtotal;
+		stotal += (size_t) scount[p];
+		rtotal += (size_t) rcount[p];
+	}
+
+	void* recv = xmalloc(rtotal, 1);
+	MPI_Alltoallv(send, scount, sdispl, MPI_BYTE, recv, rcount, rdispl,
+		MPI_BYTE, comm);
+
+	*nrecv = rtotal / size;
+	free(scount);
+	free(rcount);
+	free(sdispl);
+	free(rdispl);
+
+	return recv;
+}
+
+
+/* --- Grade e layout 2D cíclico --- */
+
+void graph_dist_grid_init(GraphDistGrid* grid, MPI_Comm comm) {
+	grid->comm = comm;
+	MPI_Comm_rank(comm, &grid->rank);
+	MPI_Comm_size(comm, &grid->size);
+
+	/*maior divisor <= sqrt(size)*/
+	int r = (int) sqrt((double) grid->size);
+
+	while (grid->size % r) {
+		r--;
+	}
+
+	grid->sys = Csys2blacs_handle(comm);
+	grid->ctxt = grid->sys;
+	Cblacs_gridinit(&grid->ctxt, "Row", r, grid->size / r);
+	Cblacs_gridinfo(grid->ctxt, &grid->nprow, &grid->npcol, &grid->myrow,
+		&grid->mycol);
+}
+
+void graph_dist_grid_free(GraphDistGrid* grid) {
+	Cblacs_gridexit(grid->ctxt);
+	Cfree_blacs_system_handle(grid->sys);
+}
+
+/*N° de linhas/colunas locais (numroc do ScaLAPACK)*/
+static int numroc(size_t n, int nb, int iproc, int nprocs) {
+	size_t nblocks = n / (size_t) nb;
+	size_t count = (nblocks / (size_t) nprocs) * (size_t) nb;
+	size_t extra = nblocks % (size_t) nprocs;
+
+	if ((size_t) iproc < extra) {
+		count += (size_t) nb;
+	} else if ((size_t) iproc == extra) {
+		count += n % (size_t) nb;
+	}
+
+	return (int) count;
+}
+
+/*Índice local -> global e global -> (dono, local)*/
+static size_t l2g(int l, int nb, int iproc, int nprocs) {
+	return ((size_t) (l / nb) * (size_t) nprocs + (size_t) iproc)
+		* (size_t) nb + (size_t) (l % nb);
+}
+
+static int g_owner(size_t g, int nb, int nprocs) {
+	return (int) ((g / (size_t) nb) % (size_t) nprocs);
+}
+
+static int g2l(size_t g, int nb, int nprocs) {
+	return (int) ((g / ((size_t) nb * (size_t) nprocs)) * (size_t) nb
+		+ g % (size_t) nb);
+}
+
+static void matrix_alloc(const GraphDistGrid* grid, size_t n, int nb,
+	GraphDistMatrix* M) {
+	M->grid = grid;
+	M->n = n;
+	M->nb = nb;
+	M->mloc = numroc(n, nb, grid->myrow, grid->nprow);
+	M->nloc = numroc(n, nb, grid->mycol, grid->npcol);
+
+	int desc[9] = {1, grid->ctxt, (int) n, (int) n, nb, nb, 0, 0,
+		M->mloc > 1 ? M->mloc : 1};
+	memcpy(M->desc, desc, sizeof(desc));
+
+	M->A = xcalloc((size_t) M->mloc * (size_t) M->nloc, sizeof(double));
+}
+
+#define LOCAL(M, li, lj) ((M)->A[(size_t) (lj) * (size_t) (M)->desc[8] + (li)])
+
+void graph_dist_matrix_free(GraphDistMatrix* M) {
+	free(M->A);
+	M->A = NULL;
+}
+
+
+/* --- Montagem de A --- */
+
+typedef struct {
+	uint64_t i, j;
+	double w;
+} Triple;
+
+int graph_dist_from_edges(const GraphDistGrid* grid, size_t n,
+	bool directed, size_t m, const size_t* u, const size_t* v,
+	const double* w, int nb, GraphDistMatrix* out) {
+	bool ok = true;
+
+	for (size_t k = 0; k < m; k++) {
+		ok = ok && u[k] < n && v[k] < n;
+	}
+
+	if (!all_ok(grid->comm, ok)) {
+		return -1;
+	}
+
+	matrix_alloc(grid, n, nb, out);
+
+	/*cada entrada vai para o dono do bloco (i, j)*/
+	size_t* counts = xcalloc(grid->size, sizeof(size_t));
+	size_t* fill = xcalloc(grid->size, sizeof(size_t));
+	Triple* send = xmalloc(2 * m, sizeof(Triple));
+
+	for (int pass = 0; pass < 2; pass++) {
+		for (size_t k = 0; k < m; k++) {
+			for (int dir = 0; dir < 2; dir++) {
+				if (dir == 1 && (directed || u[k] == v[k])) {
+					continue;
+				}
+
+				size_t i = dir ? v[k] : u[k], j = dir ? u[k] : v[k];
+				int p = g_owner(i, nb, grid->nprow) * grid->npcol
+					+ g_owner(j, nb, grid->npcol);
+
+				if (pass == 0) {
+					counts[p]++;
+				} else {
+					send[fill[p]++] = (Triple) {i, j, w ? w[k] : 1.0};
+				}
+			}
+		}
+
+		if (pass == 0) {
+			size_t acc = 0;
+
+			for (int p = 0; p < grid->size; p++) {
+				fill[p] = acc;
+				acc += counts[p];
+			}
+		}
+	}
+
+	size_t nrecv;
+	Triple* recv = exchange(grid->comm, grid->size, send, counts,
+		sizeof(Triple), &nrecv);
+
+	for (size_t k = 0; k < nrecv; k++) {
+		int li = g2l(recv[k].i, nb, grid->nprow);
+		int lj = g2l(recv[k].j, nb, grid->npcol);
+		LOCAL(out, li, lj) = recv[k].w;
+	}
+
+	free(counts);
+	free(fill);
+	free(send);
+	free(recv);
+
+	return 0;
+}
+
+void graph_dist_from_graph(const GraphDistGrid* grid, const Graph* g,
+	int nb, GraphDistMatrix* out) {
+	matrix_alloc(grid, g->n, nb, out);
+
+	for (int lj = 0; lj < out->nloc; lj++) {
+		size_t j = l2g(lj, nb, grid->mycol, grid->npcol);
+
+		for (int li = 0; li < out->mloc; li++) {
+			size_t i = l2g(li, nb, grid->myrow, grid->nprow);
+			LOCAL(out, li, lj) = g->A[IDX(i, j, g->n)];
+		}
+	}
+}
+
+/*Cada processo fica com as linhas k ≡ rank (mod size)*/
+static int read_edges(MPI_Comm comm, const char* path, size_t* n,
+	bool* directed, size_t* m, size_t** u, size_t** v, double** w) {
+	int rank, size;
+	MPI_Comm_rank(comm, &rank);
+	MPI_Comm_size(comm, &size);
+
+	FILE* f = fopen(path, "r");
+	size_t total = 0;
+	int dir = 0;
+	bool ok = f && fscanf(f, "%zu %d", n, &dir) == 2
+		&& fscanf(f, "%zu", &total) == 1;
+
+	size_t mine = ok ? total / (size_t) size
+		+ ((size_t) rank < total % (size_t) size) : 0;
+	*u = xmalloc(mine, sizeof(size_t));
+	*v = xmalloc(mine, sizeof(size_t));
+	*w = xmalloc(mine, sizeof(double));
+	*m = 0;
+
+	for (size_t k = 0; ok && k < total; k++) {
+		size_t a, b;
+		double x;
+		ok = fscanf(f, "%zu %zu %lf", &a, &b, &x) == 3;
+
+		if (ok && k % (size_t) size == (size_t) rank) {
+			(*u)[*m] = a;
+			(*v)[*m] = b;
+			(*w)[*m] = x;
+			(*m)++;
+		}
+	}
+
+	if (f) {
+		fclose(f);
+	}
+
+	*directed = dir != 0;
+
+	if (!all_ok(comm, ok)) {
+		free(*u);
+		free(*v);
+		free(*w);
+		return -1;
+	}
+
+	return 0;
+}
+
+int graph_dist_read_file(const GraphDistGrid* grid, const char* path,
+	int nb, GraphDistMatrix* out) {
+	size_t n, m, *u, *v;
+	double* w;
+	bool directed;
+
+	if (read_edges(grid->comm, path, &n, &directed, &m, &u, &v, &w) != 0) {
+		return -1;
+	}
+
+	int info = graph_dist_from_edges(grid, n, directed, m, u, v, w, nb, out);
+	free(u);
+	free(v);
+	free(w);
+
+	return info;
+}
+
+void graph_dist_laplacian(const GraphDistMatrix* A, GraphDistMatrix* L) {
+	const GraphDistGrid* grid = A->grid;
+	size_t n = A->n;
+	int nb = A->nb;
+	double* deg = xcalloc(n, sizeof(double));
+
+	/*soma parcial das linhas nas colunas locais, depois soma global*/
+	for (int lj = 0; lj < A->nloc; lj++) {
+		for (int li = 0; li < A->mloc; li++) {
+			deg[l2g(li, nb, grid->myrow, grid->nprow)] += LOCAL(A, li, lj);
+		}
+	}
+
+	MPI_Allreduce(MPI_IN_PLACE, deg, (int) n, MPI_DOUBLE, MPI_SUM, grid->comm);
+
+	matrix_alloc(grid, n, nb, L);
+
+	for (int lj = 0; lj < A->nloc; lj++) {
+		size_t j = l2g(lj, nb, grid->mycol, grid->npcol);
+
+		for (int li = 0; li < A->mloc; li++) {
+			size_t i = l2g(li, nb, grid->myrow, grid->nprow);
+			LOCAL(L, li, lj) = -LOCAL(A, li, lj) + (i == j ? deg[i] : 0.0);
+		}
+	}
+
+	free(deg);
+}
+
+
+/* --- Espectro --- */
+
+int graph_dist_spec(GraphDistMatrix* M, double* w) {
+	int n = (int) M->n, one = 1, il = 0, iu = 0, m, nz, info, lwork = -1,
+		liwork = -1, iwork_query;
+	double vl = 0.0, vu = 0.0, work_query, zdummy = 0.0;
+
+	if (n == 0) {
+		return 0;
+	}
+
+	/*consulta do tamanho do workspace*/
+	pdsyevr_("N", "A", "U", &n, M->A, &one, &one, M->desc, &vl, &vu, &il,
+		&iu, &m, &nz, w, &zdummy, &one, &one, M->desc, &work_query, &lwork,
+		&iwork_query, &liwork, &info);
+
+	if (info != 0) {
+		return info;
+	}
+
+	lwork = (int) work_query;
+	liwork = iwork_query;
+	double* work = xmalloc((size_t) lwork, sizeof(double));
+	int* iwork = xmalloc((size_t) liwork, sizeof(int));
+
+	pdsyevr_("N", "A", "U", &n, M->A, &one, &one, M->desc, &vl, &vu, &il,
+		&iu, &m, &nz, w, &zdummy, &one, &one, M->desc, work, &lwork, iwork,
+		&liwork, &info);
+
+	free(work);
+	free(iwork);
+
+	return info;
+}
+
+int graph_dist_eigvecs(GraphDistMatrix* M, double* w, GraphDistMatrix* Z) {
+	int n = (int) M->n, one = 1, info, lwork = -1, liwork = -1, iwork_query;
+	double work_query;
+
+	matrix_alloc(M->grid, M->n, M->nb, Z);
+
+	if (n == 0) {
+		return 0;
+	}
+
+	pdsyevd_("V", "U", &n, M->A, &one, &one, M->desc, w, Z->A, &one, &one,
+		Z->desc, &work_query, &lwork, &iwork_query, &liwork, &info);
+
+	if (info != 0) {
+		return info;
+	}
+
+	lwork = (int) work_query;
+	liwork = iwork_query;
+	double* work = xmalloc((size_t) lwork, sizeof(double));
+	int* iwork = xmalloc((size_t) liwork, sizeof(int));
+
+	pdsyevd_("V", "U", &n, M->A, &one, &one, M->desc, w, Z->A, &one, &one,
+		Z->desc, work, &lwork, iwork, &liwork, &info);
+
+	free(work);
+	free(iwork);
+
+	return info;
+}
+
+
+/* --- CSR 1D --- */
+
+static size_t range_block(size_t n, int size) {
+	size_t b = (n + (size_t) size - 1) / (size_t) size;
+
+	return b ? b : 1;
+}
+
+static void csr_range(GraphDistCSR* g, MPI_Comm comm, size_t n,
+	bool directed) {
+	g->comm = comm;
+	MPI_Comm_rank(comm, &g->rank);
+	MPI_Comm_size(comm, &g->size);
+	g->n = n;
+	g->directed = directed;
+
+	size_t b = range_block(n, g->size);
+	g->lo = (size_t) g->rank * b < n ? (size_t) g->rank * b : n;
+	g->hi = g->lo + b < n ? g->lo + b : n;
+}
+
+static int owner(const GraphDistCSR* g, size_t v) {
+	return (int) (v / range_block(g->n, g->size));
+}
+
+static int cmp_size(const void* a, const void* b) {
+	size_t x = *(const size_t*) a, y = *(const size_t*) b;
+
+	return (x > y) - (x < y);
+}
+
+typedef struct {
+	uint64_t u, v;
+} Pair;
+
+int graph_dist_csr_from_edges(MPI_Comm comm, size_t n, bool directed,
+	size_t m, const size_t* u, const size_t* v, GraphDistCSR* out) {
+	bool ok = true;
+
+	for (size_t k = 0; k < m; k++) {
+		ok = ok && u[k] < n && v[k] < n;
+	}
+
+	if (!all_ok(comm, ok)) {
+		return -1;
+	}
+
+	csr_range(out, comm, n, directed);
+
+	size_t* counts = xcalloc(out->size, sizeof(size_t));
+	size_t* fill = xcalloc(out->size, sizeof(size_t));
+	Pair* send = xmalloc(2 * m, sizeof(Pair));
+
+	for (int pass = 0; pass < 2; pass++) {
+		for (size_t k = 0; k < m; k++) {
+			for (int dir = 0; dir < 2; dir++) {
+				if (dir == 1 && (directed || u[k] == v[k])) {
+					continue;
+				}
+
+				size_t a = dir ? v[k] : u[k], b = dir ? u[k] : v[k];
+				int p = owner(out, a);
+
+				if (pass == 0) {
+					counts[p]++;
+				} else {
+					send[fill[p]++] = (Pair) {a, b};
+				}
+			}
+		}
+
+		if (pass == 0) {
+			size_t acc = 0;
+
+			for (int p = 0; p < out->size; p++) {
+				fill[p] = acc;
+				acc += counts[p];
+			}
+		}
+	}
+
+	size_t nrecv;
+	Pair* recv = exchange(comm, out->size, send, counts, sizeof(Pair),
+		&nrecv);
+
+	/*conta, preenche, ordena e tira repetidas*/
+	size_t nloc = out->hi - out->lo;
+	out->rowptr = xcalloc(nloc + 1, sizeof(size_t));
+
+	for (size_t k = 0; k < nrecv; k++) {
+		out->rowptr[recv[k].u - out->lo + 1]++;
+	}
+
+	for (size_t i = 0; i < nloc; i++) {
+		out->rowptr[i + 1] += out->rowptr[i];
+	}
+
+	size_t* pos = xmalloc(nloc, sizeof(size_t));
+	memcpy(pos, out->rowptr, nloc * sizeof(size_t));
+	out->col = xmalloc(nrecv, sizeof(size_t));
+
+	for (size_t k = 0; k < nrecv; k++) {
+		out->col[pos[recv[k].u - out->lo]++] = recv[k].v;
+	}
+
+	size_t nnz = 0;
+
+	for (size_t i = 0; i < nloc; i++) {
+		size_t b = out->rowptr[i], e = out->rowptr[i + 1];
+		qsort(&out->col[b], e - b, sizeof(size_t), cmp_size);
+		out->rowptr[i] = nnz;
+
+		for (size_t k = b; k < e; k++) {
+			if (k == b || out->col[k] != out->col[k - 1]) {
+				out->col[nnz++] = out->col[k];
+			}
+		}
+	}
+
+	out->rowptr[nloc] = nnz;
+
+	free(counts);
+	free(fill);
+	free(send);
+	free(recv);
+	free(pos);
+
+	return 0;
+}
+
+void graph_dist_csr_from_graph(MPI_Comm comm, const Graph* g,
+	GraphDistCSR* out) {
+	size_t n = g->n;
+	csr_range(out, comm, n, g->directed);
+
+	size_t nloc = out->hi - out->lo, nnz = 0;
+	out->rowptr = xmalloc(nloc + 1, sizeof(size_t));
+
+	for (size_t u = out->lo; u < out->hi; u++) {
+		for (size_t v = 0; v < n; v++) {
+			nnz += g->A[IDX(u, v, n)] != 0.0;
+		}
+	}
+
+	out->col = xmalloc(nnz, sizeof(size_t));
+	nnz = 0;
+
+	for (size_t u = out->lo; u < out->hi; u++) {
+		out->rowptr[u - out->lo] = nnz;
+
+		for (size_t v = 0; v < n; v++) {
+			if (g->A[IDX(u, v, n)] != 0.0) {
+				out->col[nnz++] = v;
+			}
+		}
+	}
+
+	out->rowptr[nloc] = nnz;
+}
+
+int graph_dist_csr_read_file(MPI_Comm comm, const char* path,
+	GraphDistCSR* out) {
+	size_t n, m, *u, *v;
+	double* w;
+	bool directed;
+
+	if (read_edges(comm, path, &n, &directed, &m, &u, &v, &w) != 0) {
+		return -1;
+	}
+
+	/*peso 0 é "sem aresta" em graph_read_from_file*/
+	size_t k = 0;
+
+	for (size_t e = 0; e < m; e++) {
+		if (w[e] != 0.0) {
+			u[k] = u[e];
+			v[k] = v[e];
+			k++;
+		}
+	}
+
+	int info = graph_dist_csr_from_edges(comm, n, directed, k, u, v, out);
+	free(u);
+	free(v);
+	free(w);
+
+	return info;
+}
+
+void graph_dist_csr_free(GraphDistCSR* g) {
+	free(g->rowptr);
+	free(g->col);
+	g->rowptr = NULL;
+	g->col = NULL;
+}
+
+
+/* --- BFS --- */
+
+/*Uma rodada: para cada vértice local u com front[u] != 0, manda
+(v, front[u]) ao dono de cada vizinho v. Devolve o que chegou*/
+static Pair* expand(const GraphDistCSR* g, const uint64_t* front,
+	size_t* nrecv) {
+	size_t nloc = g->hi - g->lo;
+	size_t* counts = xcalloc(g->size, sizeof(size_t));
+	size_t* fill = xcalloc(g->size, sizeof(size_t));
+	size_t total = 0;
+
+	for (size_t i = 0; i < nloc; i++) {
+		if (front[i]) {
+			for (size_t e = g->rowptr[i]; e < g->rowptr[i + 1]; e++) {
+				counts[owner(g, g->col[e])]++;
+				total++;
+			}
+		}
+	}
+
+	for (size_t p = 0, acc = 0; p < (size_t) g->size; p++) {
+		fill[p] = acc;
+		acc += counts[p];
+	}
+
+	Pair* send = xmalloc(total, sizeof(Pair));
+
+	for (size_t i = 0; i < nloc; i++) {
+		if (front[i]) {
+			for (size_t e = g->rowptr[i]; e < g->rowptr[i + 1]; e++) {
+				size_t v = g->col[e];
+				send[fill[owner(g, v)]++] = (Pair) {v, front[i]};
+			}
+		}
+	}
+
+	Pair* recv = exchange(g->comm, g->size, send, counts, sizeof(Pair),
+		nrecv);
+
+	free(counts);
+	free(fill);
+	free(send);
+
+	return recv;
+}
+
+/*BFS simultânea de até 64 origens (bit b = origem first + b). Se dist
+não for NULL (uma origem só), guarda as distâncias. Retorna a maior
+excentricidade entre as origens e, em reached, quantos vértices a
+origem 0 do lote alcançou*/
+static int multi_bfs(const GraphDistCSR* g, size_t first, size_t count,
+	int* dist, size_t* reached) {
+	size_t nloc = g->hi - g->lo;
+	uint64_t* seen = xcalloc(nloc, sizeof(uint64_t));
+	uint64_t* front = xcalloc(nloc, sizeof(uint64_t));
+	uint64_t* next = xcalloc(nloc, sizeof(uint64_t));
+
+	for (size_t b = 0; b < count; b++) {
+		size_t s = first + b;
+
+		if (s >= g->lo && s < g->hi) {
+			seen[s - g->lo] |= (uint64_t) 1 << b;
+			front[s - g->lo] |= (uint64_t) 1 << b;
+		}
+	}
+
+	if (dist) {
+		for (size_t i = 0; i < nloc; i++) {
+			dist[i] = seen[i] ? 0 : -1;
+		}
+	}
+
+	int level = 0;
+
+	for (;;) {
+		size_t nrecv;
+		Pair* recv = expand(g, front, &nrecv);
+		memset(next, 0, nloc * sizeof(uint64_t));
+
+		for (size_t k = 0; k < nrecv; k++) {
+			size_t i = recv[k].u - g->lo;
+			uint64_t fresh = recv[k].v & ~seen[i];
+			seen[i] |= fresh;
+			next[i] |= fresh;
+		}
+
+		free(recv);
+
+		bool any = false;
+
+		for (size_t i = 0; i < nloc && !any; i++) {
+			any = next[i] != 0;
+		}
+
+		if (all_ok(g->comm, !any)) {
+			break;
+		}
+
+		level++;
+
+		if (dist) {
+			for (size_t i = 0; i < nloc; i++) {
+				dist[i] = next[i] ? level : dist[i];
+			}
+		}
+
+		uint64_t* t = front;
+		front = next;
+		next = t;
+	}
+
+	if (reached) {
+		unsigned long long local = 0, global;
+
+		for (size_t i = 0; i < nloc; i++) {
+			local += seen[i] & 1;
+		}
+
+		MPI_Allreduce(&local, &global, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM,
+			g->comm);
+		*reached = (size_t) global;
+	}
+
+	free(seen);
+	free(front);
+	free(next);
+
+	return level;
+}
+
+int graph_dist_bfs(const GraphDistCSR* g, size_t src, int* dist) {
+	return multi_bfs(g, src, 1, dist, NULL);
+}
+
+bool graph_dist_is_connected(const GraphDistCSR* g) {
+	if (g->n <= 1) {
+		return true;
+	}
+
+	size_t reached;
+	multi_bfs(g, 0, 1, NULL, &reached);
+
+	return reached == g->n;
+}
+
+int graph_dist_diameter(const GraphDistCSR* g) {
+	int d = 0;
+
+	for (size_t s = 0; s < g->n; s += 64) {
+		size_t count = g->n - s < 64 ? g->n - s : 64;
+		int e = multi_bfs(g, s, count, NULL, NULL);
+		d = e > d ? e : d;
+	}
+
+	return d;
+}
+
+#endif
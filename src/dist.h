@@ -0,0 +1,134 @@
+#ifndef DIST_H
+#define DIST_H
+
+/* --- Backend distribuído (MPI + ScaLAPACK) --- */
+
+/*
+Só existe quando compilado com -DGRAPH_USE_MPI (make mpi); no build
+normal este módulo fica vazio.
+
+Para n ~ 150k a matriz densa (180 GB de double) não cabe num nó só,
+então nada aqui junta a matriz num processo:
+
+- espectro: GraphDistMatrix guarda A (ou L) em blocos 2D cíclicos
+  (nb x nb) sobre uma grade nprow x npcol de processos, no formato do
+  ScaLAPACK (column-major local, descritor desc). Autovalores saem de
+  pdsyevr e autovetores de pdsyevd;
+- BFS: GraphDistCSR divide os vértices em faixas contíguas (1D); cada
+  processo guarda as listas de saída dos seus vértices e a BFS troca
+  a fronteira por nível com MPI_Alltoallv. O diâmetro roda 64 BFS de
+  uma vez (uma por bit de um uint64_t), o que divide por 64 o número
+  de rodadas de comunicação.
+
+As arestas entram por graph_dist_read_file (cada processo lê sua fatia
+das linhas do arquivo de graph_read_from_file) ou por listas locais
+(graph_dist_*_from_edges, cada processo passa qualquer subconjunto), e
+são roteadas para os donos. As versões *_from_graph servem para grafos
+que cabem em todos os processos (testes).
+
+Todas as funções são coletivas: todos os processos do comunicador
+chamam, com os mesmos argumentos escalares.
+*/
+
+#ifdef GRAPH_USE_MPI
+
+#include <mpi.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "graphs.h"
+
+#define GRAPH_DIST_NB 64
+
+typedef struct {
+	MPI_Comm comm;
+	int rank, size;
+	int sys;			/* Handle BLACS de comm*/
+	int ctxt;			/* Contexto BLACS*/
+	int nprow, npcol;	/* Grade (nprow <= npcol, a mais quadrada possível)*/
+	int myrow, mycol;
+} GraphDistGrid;
+
+typedef struct {
+	const GraphDistGrid* grid;
+	size_t n;
+	int nb;				/* Lado do bloco*/
+	int mloc, nloc;		/* Linhas e colunas locais*/
+	int desc[9];		/* Descritor ScaLAPACK*/
+	double* A;			/* mloc x nloc, column-major (lld = max(1, mloc))*/
+} GraphDistMatrix;
+
+typedef struct {
+	MPI_Comm comm;
+	int rank, size;
+	size_t n;
+	bool directed;
+	size_t lo, hi;		/* Vértices locais: [lo, hi)*/
+	size_t* rowptr;		/* hi - lo + 1 posições*/
+	size_t* col;		/* Vizinhos (ids globais, ordem crescente)*/
+} GraphDistCSR;
+
+
+/*Monta a grade BLACS sobre comm*/
+void graph_dist_grid_init(GraphDistGrid* grid, MPI_Comm comm);
+void graph_dist_grid_free(GraphDistGrid* grid);
+
+
+/*A distribuída a partir de m arestas locais (u[k], v[k], w[k]); w NULL
+quer dizer peso 1. Sem direção cada aresta vale nos dois sentidos.
+Retorna -1 se algum vértice for >= n*/
+int graph_dist_from_edges(const GraphDistGrid* grid, size_t n,
+	bool directed, size_t m, const size_t* u, const size_t* v,
+	const double* w, int nb, GraphDistMatrix* out);
+
+
+/*A distribuída a partir de um Graph presente em todos os processos*/
+void graph_dist_from_graph(const GraphDistGrid* grid, const Graph* g,
+	int nb, GraphDistMatrix* out);
+
+
+/*Lê o arquivo (formato de graph_read_from_file) em paralelo e monta A.
+Retorna -1 se o arquivo não abrir ou estiver mal formado*/
+int graph_dist_read_file(const GraphDistGrid* grid, const char* path,
+	int nb, GraphDistMatrix* out);
+
+
+/*L = D - A com a mesma distribuição de A*/
+void graph_dist_laplacian(const GraphDistMatrix* A, GraphDistMatrix* L);
+
+
+/*Espectro de M (simétrica) em w, n posições em todos os processos,
+via pdsyevr. M é destruída. Retorna o info do ScaLAPACK*/
+int graph_dist_spec(GraphDistMatrix* M, double* w);
+
+
+/*Autovalores (w) e autovetores (Z, mesma distribuição de M) via
+pdsyevd. M é destruída. Retorna o info do ScaLAPACK*/
+int graph_dist_eigvecs(GraphDistMatrix* M, double* w, GraphDistMatrix* Z);
+
+
+void graph_dist_matrix_free(GraphDistMatrix* M);
+
+
+/*Listas de saída distribuídas em faixas de vértices (mesmas regras de
+graph_dist_from_edges)*/
+int graph_dist_csr_from_edges(MPI_Comm comm, size_t n, bool directed,
+	size_t m, const size_t* u, const size_t* v, GraphDistCSR* out);
+void graph_dist_csr_from_graph(MPI_Comm comm, const Graph* g,
+	GraphDistCSR* out);
+int graph_dist_csr_read_file(MPI_Comm comm, const char* path,
+	GraphDistCSR* out);
+void graph_dist_csr_free(GraphDistCSR* g);
+
+
+/*BFS a partir de src: dist[v - lo] para os vértices locais (-1 se não
+alcançável). Retorna a excentricidade de src*/
+int graph_dist_bfs(const GraphDistCSR* g, size_t src, int* dist);
+
+
+/*Mesmas definições de graph_is_connected e graph_diameter*/
+bool graph_dist_is_connected(const GraphDistCSR* g);
+int graph_dist_diameter(const GraphDistCSR* g);
+
+#endif
+#endif
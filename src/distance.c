@@ -0,0 +1,296 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <lapacke.h>
+#include "distance.h"
+#include "cache.h"
+
+typedef struct {
+	const GraphCSR* c;
+	double* D;			/* n x n ou NULL*/
+	double* trans;		/* n ou NULL*/
+	size_t nbatches;
+	atomic_size_t next_batch;
+} DistJob;
+
+/*BFS simultânea a partir das fontes s0..s0+k-1 (k <= 64). O bit i de
+seen[v] indica que a fonte s0 + i já alcançou v*/
+static void bfs64(const DistJob* job, size_t s0, size_t k, uint64_t* seen,
+	uint64_t* frontier, uint64_t* next) {
+	const GraphCSR* c = job->c;
+	size_t n = c->n;
+	double sums[64] = {0};
+	size_t reached[64];
+
+	memset(seen, 0, n * sizeof(uint64_t));
+	memset(frontier, 0, n * sizeof(uint64_t));
+
+	for (size_t i = 0; i < k; i++) {
+		seen[s0 + i] = frontier[s0 + i] = UINT64_C(1) << i;
+		reached[i] = 1;
+
+		if (job->D) {
+			double* row = &job->D[IDX(s0 + i, 0, n)];
+
+			for (size_t v = 0; v < n; v++) {
+				row[v] = INFINITY;
+			}
+
+			row[s0 + i] = 0.0;
+		}
+	}
+
+	bool active = true;
+
+	for (double level = 1.0; active; level += 1.0) {
+		memset(next, 0, n * sizeof(uint64_t));
+
+		for (size_t u = 0; u < n; u++) {
+			uint64_t f = frontier[u];
+
+			if (!f) {
+				continue;
+			}
+
+			for (size_t e = c->rowptr[u]; e < c->rowptr[u + 1]; e++) {
+				next[c->col[e]] |= f;
+			}
+		}
+
+		active = false;
+
+		for (size_t v = 0; v < n; v++) {
+			uint64_t nw = next[v] & ~seen[v];
+			frontier[v] = nw;
+
+			if (!nw) {
+				continue;
+			}
+
+			active = true;
+			seen[v] |= nw;
+
+			while (nw) {
+				size_t i = (size_t) __builtin_ctzll(nw);
+				nw &= nw - 1;
+				sums[i] += level;
+				reached[i]++;
+
+				if (job->D) {
+					job->D[IDX(s0 + i, v, n)] = level;
+				}
+			}
+		}
+	}
+
+	if (job->trans) {
+		for (size_t i = 0; i < k; i++) {
+			job->trans[s0 + i] = (reached[i] == n) ? sums[i] : INFINITY;
+		}
+	}
+}
+
+static void* dist_worker(void* arg) {
+	DistJob* job = arg;
+	size_t n = job->c->n;
+
+	uint64_t* seen = malloc(n * sizeof(uint64_t));
+	uint64_t* frontier = malloc(n * sizeof(uint64_t));
+	uint64_t* next = malloc(n * sizeof(uint64_t));
+
+	if (!seen || !frontier || !next) {
+		die("malloc error (bfs64)");
+	}
+
+	for (;;) {
+		size_t b = atomic_fetch_add(&job->next_batch, 1);
+
+		if (b >= job->nbatches) {
+			break;
+		}
+
+		size_t s0 = 64 * b;
+		size_t k = (n - s0 < 64) ? n - s0 : 64;
+		bfs64(job, s0, k, seen, frontier, next);
+	}
+
+	free(seen);
+	free(frontier);
+	free(next);
+
+	return NULL;
+}
+
+static void all_sources_bfs(const Graph* g, double* D, double* trans) {
+	if (g->n == 0) {
+		return;
+	}
+
+	GraphCSR* c = graph_csr_from_graph(g);
+	DistJob job = {.c = c, .D = D, .trans = trans,
+		.nbatches = (g->n + 63) / 64};
+	atomic_init(&job.next_batch, 0);
+
+	size_t nt = graph_num_threads();
+
+	if (nt > job.nbatches) {
+		nt = job.nbatches;
+	}
+
+	pthread_t* th = malloc(nt * sizeof(pthread_t));
+
+	if (!th) {
+		die("malloc error (threads)");
+	}
+
+	for (size_t t = 0; t < nt; t++) {
+		if (pthread_create(&th[t], NULL, dist_worker, &job) != 0) {
+			die("pthread_create");
+		}
+	}
+
+	for (size_t t = 0; t < nt; t++) {
+		pthread_join(th[t], NULL);
+	}
+
+	free(th);
+	graph_csr_free(c);
+}
+
+void graph_distance_matrix(const Graph* g, double* D) {
+	all_sources_bfs(g, D, NULL);
+}
+
+void graph_transmission(const Graph* g, double* t) {
+	all_sources_bfs(g, NULL, t);
+}
+
+double graph_wiener_index(const Graph* g) {
+	double cached;
+
+	if (graph_cache_get_scalar(g, GRAPH_CACHE_WIENER, &cached)) {
+		return cached;
+	}
+
+	double* t = malloc((g->n + 1) * sizeof(double));
+
+	if (!t) {
+		die("malloc error (t)");
+	}
+
+	graph_transmission(g, t);
+	double w = 0.0;
+
+	for (size_t i = 0; i < g->n; i++) {
+		w += t[i];
+	}
+
+	if (!g->directed) {
+		w /= 2.0;
+	}
+
+	free(t);
+	graph_cache_put_scalar(g, GRAPH_CACHE_WIENER, w);
+
+	return w;
+}
+
+/*Espectro de D, ou de Tr - D se laplacian, destruindo D (n x n,
+t = transmissões). -1 se algum vértice não alcança todos*/
+static int spec_distance_in_place(double* D, const double* t, size_t n,
+	bool laplacian, double* x) {
+	for (size_t i = 0; i < n; i++) {
+		if (isinf(t[i])) {
+			return -1;
+		}
+	}
+
+	if (laplacian) {
+		for (size_t i = 0; i < n * n; i++) {
+			D[i] = -D[i];
+		}
+
+		for (size_t i = 0; i < n; i++) {
+			D[IDX(i, i, n)] = t[i];
+		}
+	}
+
+	return LAPACKE_dsyev(LAPACK_ROW_MAJOR, 'N', 'U', (int) n, D, (int) n, x);
+}
+
+/*Monta D (e Tr - D se laplacian) e resolve direto em cima dela*/
+static int spec_distance(const Graph* g, double* x, bool laplacian) {
+	size_t n = g->n;
+	GraphCacheKey key = laplacian ? GRAPH_CACHE_SPEC_DISTANCE_LAP
+		: GRAPH_CACHE_SPEC_DISTANCE;
+
+	if (g->directed) {
+		return -1;
+	}
+
+	if (graph_cache_get_vec(g, key, x, n)) {
+		return 0;
+	}
+
+	double* D = malloc((n * n + 1) * sizeof(double));
+	double* t = malloc((n + 1) * sizeof(double));
+
+	if (!D || !t) {
+		die("malloc error (D || t)");
+	}
+
+	all_sources_bfs(g, D, t);
+	int info = spec_distance_in_place(D, t, n, laplacian, x);
+
+	if (info == 0) {
+		graph_cache_put_vec(g, key, x, n);
+	}
+
+	free(D);
+	free(t);
+
+	return info;
+}
+
+int graph_spec_distance(const Graph* g, double* x) {
+	return spec_distance(g, x, false);
+}
+
+int graph_spec_distance_laplacian(const Graph* g, double* x) {
+	return spec_distance(g, x, true);
+}
+
+/*Cópia de D e transmissões pelas somas das linhas*/
+static int matrix_spec_distance_any(const double* D, size_t n, double* x,
+	bool laplacian) {
+	double* M = malloc((n * n + 1) * sizeof(double));
+	double* t = calloc(n + 1, sizeof(double));
+
+	if (!M || !t) {
+		die("malloc error (M || t)");
+	}
+
+	memcpy(M, D, n * n * sizeof(double));
+
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = 0; j < n; j++) {
+			t[i] += D[IDX(i, j, n)];
+		}
+	}
+
+	int info = spec_distance_in_place(M, t, n, laplacian, x);
+	free(M);
+	free(t);
+
+	return info;
+}
+
+int matrix_spec_distance(const double* D, size_t n, double* x) {
+	return matrix_spec_distance_any(D, n, x, false);
+}
+
+int matrix_spec_distance_laplacian(const double* D, size_t n, double* x) {
+	return matrix_spec_distance_any(D, n, x, true);
+}
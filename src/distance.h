@@ -0,0 +1,55 @@
+#ifndef DISTANCE_H
+#define DISTANCE_H
+
+/* --- Matriz de distâncias e espectros de distância --- */
+
+/*
+As distâncias aqui contam arestas (pesos são ignorados; para
+distâncias com peso veja paths.h). Todas as funções usam BFS
+bit-paralela: 64 fontes por passada, cada vértice guarda em uma
+palavra de 64 bits quais das fontes já o alcançaram, e a fronteira de
+um nível é propagada com OR sobre as listas de vizinhos (CSR). As
+passadas são distribuídas entre graph_num_threads() threads.
+*/
+
+#include "graphs.h"
+
+
+/*D[i][j] = distância de i até j (D deve ter espaço para n * n
+doubles). Se j não é alcançável a partir de i, D[i][j] = INFINITY*/
+void graph_distance_matrix(const Graph* g, double* D);
+
+
+/*t[v] = transmissão de v = soma das distâncias de v aos outros
+vértices (INFINITY se algum não for alcançável). Não monta a matriz*/
+void graph_transmission(const Graph* g, double* t);
+
+
+/*Índice de Wiener: soma das distâncias sobre os pares {u, v}
+(para grafos direcionados, sobre os pares ordenados).
+INFINITY se o grafo não for conexo*/
+double graph_wiener_index(const Graph* g);
+
+
+/*Acha o espectro da matriz de distâncias D de g e retorna um int
+indicando erro se ele (o int) for != 0. Retorna -1 se g for
+direcionado ou desconexo (D não é simétrica/finita).
+A matriz D é montada e passada direto ao LAPACK, sem cópia*/
+int graph_spec_distance(const Graph* g, double* x);
+
+
+/*Mesmo que graph_spec_distance para a laplaciana de distâncias
+Tr - D, onde Tr é a matriz diagonal das transmissões. Tr - D é
+montada em cima de D, sem cópia*/
+int graph_spec_distance_laplacian(const Graph* g, double* x);
+
+
+/*Os mesmos espectros a partir de uma matriz de distâncias D (n x n,
+simétrica) que o chamador já tem, por exemplo de
+graph_distance_matrix: não refaz as BFS nem usa o cache. D não é
+alterada (as contas são numa cópia). Retorna -1 se D tiver entradas
+infinitas*/
+int matrix_spec_distance(const double* D, size_t n, double* x);
+int matrix_spec_distance_laplacian(const double* D, size_t n, double* x);
+
+#endif
@@ -1,19 +1,34 @@
 #include <stdio.h>
 #include <lapacke.h>
 #include "eig.h"
+#include "cache.h"
+#include "families.h"
+#include "components.h"
+#include "bipartite.h"
+#include "mem.h"
 
 static double* matrix_cpy(const double* A, size_t n) {
-	double* A_cpy = malloc(n * n * sizeof(double));
+	return graph_mem_matrix(n, n, A);
+}
+
+/*dsyev só lê o triângulo superior: direcionado e não simétrico dá
+espectro errado sem aviso (use digraph.h)*/
+static bool nonsymmetric(const Graph* g) {
+	size_t n = g->n;
 
-	if (!A_cpy) {
-		die("malloc error (A_cpy)");
+	if (!g->directed) {
+		return false;
 	}
 
-	for (size_t i = 0; i < n * n; i++) {
-		A_cpy[i] = A[i];
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = i + 1; j < n; j++) {
+			if (g->A[IDX(i, j, n)] != g->A[IDX(j, i, n)]) {
+				return true;
+			}
+		}
 	}
 
-	return A_cpy;
+	return false;
 }
 
 static double trace(const double* A, size_t n) {
@@ -41,28 +56,95 @@ int matrix_spec(const double* A, size_t n, double* x) {
 	int info = LAPACKE_dsyev(LAPACK_ROW_MAJOR, 'N', 'U', (int) n, 
 		A_cpy, (int) n, x);
 
-	free(A_cpy);
+	graph_mem_free(A_cpy);
+	return info;
+}
+
+
+/*Se g (não direcionado) for desconexo, M (adjacência ou laplaciana)
+é bloco-diagonal e cada componente é resolvida separadamente
+(components.h)*/
+static int spec_by_components(const Graph* g, const double* M, double* x) {
+	if (g->directed || graph_is_connected(g)) {
+		return matrix_spec(M, g->n, x);
+	}
+
+	size_t* label = malloc(g->n * sizeof(size_t));
+
+	if (!label) {
+		die("malloc error (label)");
+	}
+
+	size_t c = graph_components(g, label);
+	int info = matrix_spec_blocks(M, g->n, label, c, x);
+	free(label);
+
 	return info;
 }
 
 
 int graph_spec_adj(const Graph* g, double* x) {
-	double* A_cpy = matrix_cpy(g->A, g->n);
+	/*K_n, C_n, Cayley etc: fórmula fechada ou FFT (families.h)*/
+	if (graph_family_spec(g, x, false)) {
+		return 0;
+	}
+
+	if (graph_cache_get_vec(g, GRAPH_CACHE_SPEC_ADJ, x, g->n)) {
+		return 0;
+	}
+
+	if (nonsymmetric(g)) {
+		return -1;
+	}
+
+	/*bipartido: ±σ(B) pela SVD do bloco n1 x n2 (bipartite.h)*/
+	bool* side = malloc((g->n + 1) * sizeof(bool));
+
+	if (!side) {
+		die("malloc error (side)");
+	}
+
+	int info;
+
+	if (!g->directed && g->n > 0 && graph_bipartition(g, side)) {
+		info = graph_spec_bipartite(g, side, x);
+	} else {
+		info = spec_by_components(g, g->A, x);
+	}
+
+	free(side);
 
-	int info = matrix_spec(A_cpy, g->n, x);
+	if (info == 0) {
+		graph_cache_put_vec(g, GRAPH_CACHE_SPEC_ADJ, x, g->n);
+	}
 
-	free(A_cpy);
 	return info;
 }
 
 
 int graph_spec_lap(const Graph* g, double* x) {
-	double* l = (double*) calloc(g->n * g->n, sizeof(double));
+	if (graph_family_spec(g, x, true)) {
+		return 0;
+	}
+
+	if (graph_cache_get_vec(g, GRAPH_CACHE_SPEC_LAP, x, g->n)) {
+		return 0;
+	}
+
+	if (nonsymmetric(g)) {
+		return -1;
+	}
+
+	double* l = graph_mem_matrix(g->n, g->n, NULL);
 	graph_laplacian(g, l);
 
-	int info = matrix_spec(l, g->n, x);
+	int info = spec_by_components(g, l, x);
+
+	if (info == 0) {
+		graph_cache_put_vec(g, GRAPH_CACHE_SPEC_LAP, x, g->n);
+	}
 
-	free(l);
+	graph_mem_free(l);
 	return info;
 }
 
@@ -83,7 +165,7 @@ https://en.wikipedia.org/wiki/Faddeev%E2%80%93LeVerrier_algorithm
 */
 void matrix_char_coeffs(const double* A, size_t n, double* coeffs) {
 	double* Ak = matrix_cpy(A, n);
-	double* Tmp = calloc(n * n, sizeof(double));
+	double* Tmp = graph_mem_matrix(n, n, NULL);
 
 	if (!Ak || !Tmp) {
 		die("malloc error (Ak || Tmp)");
@@ -114,8 +196,8 @@ void matrix_char_coeffs(const double* A, size_t n, double* coeffs) {
 		coeffs[k] = -sum / (double) k;
 	}
 
-	free(Ak);
-	free(Tmp);
+	graph_mem_free(Ak);
+	graph_mem_free(Tmp);
 	free(S);
 }
 
@@ -13,18 +13,21 @@ Leia a nota importante em graphs.h :D
 #include "graphs.h"
 
 
-/*Acha o espectro (conjunto de autovalores) de A e
-retorna um int indicando erro se ele (o int) for > 0*/
+/*Acha o espectro (conjunto de autovalores) de A, que deve ser
+simétrica, e retorna um int indicando erro se ele (o int) for > 0*/
 int matrix_spec(const double* A, size_t n, double* x);
 
 
 /*Acha o espectro da matriz de adjacência de g e
-retorna um int indicando erro se ele (o int) for > 0*/
+retorna um int indicando erro se ele (o int) for > 0.
+Retorna -1 se g for direcionado e A não for simétrica (o espectro é
+complexo: veja digraph.h)*/
 int graph_spec_adj(const Graph* g, double* x);
 
 
 /*Acha o espectro da matriz laplaciana de g e
-retorna um int indicando erro se ele (o int) for > 0*/
+retorna um int indicando erro se ele (o int) for > 0
+(-1 no mesmo caso de graph_spec_adj)*/
 int graph_spec_lap(const Graph* g, double* x);
 
 
@@ -38,7 +41,10 @@ O algoritmo implementado tem complexidade O(n⁴), então use
 esta função com moderação.
 Eu poderia ter implementado de forma a achar apenas os k primeiros
 coeficientes para o algoritmo ter complexidade até O(kn³), mas preferi
-fazer assim mesmo*/
+fazer assim mesmo.
+Como tudo é feito em double, os coeficientes deixam de ser exatos para
+n moderado; para matrizes inteiras use matrix_char_coeffs_exact
+(charpoly.h)*/
 void matrix_char_coeffs(const double* A, size_t n, double* coeffs);
 
 /*Acha o rank de uma matriz*/
@@ -0,0 +1,377 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "enumerate.h"
+#include "batch.h"
+#include "eig.h"
+
+/* --- Forma canônica --- */
+
+/*Busca uma rotulação sigma (que preserva as classes de key) cujo
+código seja maior que o de eg. As posições são fixadas em ordem;
+ao fixar a posição j os bits (i, j), i < j, ficam determinados, então
+dá para comparar a coluna j com a de eg na hora: se for maior, eg
+não é canônico; se for menor, o ramo é podado*/
+static bool canon_search(const EnumGraph* eg, const uint32_t* key,
+	int* sigma, uint32_t used, size_t j) {
+	size_t n = eg->n;
+
+	if (j == n) {
+		return true;
+	}
+
+	uint32_t orig = 0;
+
+	for (size_t i = 0; i < j; i++) {
+		orig = (orig << 1) | ((eg->adj[j] >> i) & 1);
+	}
+
+	int tried[ENUM_MAX_N];
+	size_t ntried = 0;
+
+	for (size_t v = 0; v < n; v++) {
+		if ((used >> v) & 1 || key[v] != key[j]) {
+			continue;
+		}
+
+		/*se (v v') é automorfismo para algum v' já tentado neste nível,
+		os dois ramos geram os mesmos códigos*/
+		bool twin = false;
+
+		for (size_t t = 0; t < ntried && !twin; t++) {
+			int u = tried[t];
+			uint16_t a = eg->adj[u] & (uint16_t) ~(1u << v);
+			uint16_t b = eg->adj[v] & (uint16_t) ~(1u << u);
+			twin = (a == b);
+		}
+
+		if (twin) {
+			continue;
+		}
+
+		tried[ntried++] = (int) v;
+
+		uint32_t col = 0;
+
+		for (size_t i = 0; i < j; i++) {
+			col = (col << 1) | ((eg->adj[v] >> sigma[i]) & 1);
+		}
+
+		if (col > orig) {
+			return false;
+		}
+
+		if (col < orig) {
+			continue;
+		}
+
+		sigma[j] = (int) v;
+
+		if (!canon_search(eg, key, sigma, used | (1u << v), j + 1)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool enum_graph_is_canonical(const EnumGraph* eg) {
+	size_t n = eg->n;
+
+	/*teste barato: graus não crescentes*/
+	for (size_t i = 1; i < n; i++) {
+		if (eg->deg[i] > eg->deg[i - 1]) {
+			return false;
+		}
+	}
+
+	uint32_t key[ENUM_MAX_N];
+
+	for (size_t v = 0; v < n; v++) {
+		uint32_t s = 0;
+
+		for (size_t u = 0; u < n; u++) {
+			if ((eg->adj[v] >> u) & 1) {
+				s += (uint32_t) eg->deg[u];
+			}
+		}
+
+		key[v] = ((uint32_t) eg->deg[v] << 8) | s;
+
+		if (v > 0 && key[v] > key[v - 1]) {
+			return false;
+		}
+	}
+
+	int sigma[ENUM_MAX_N];
+
+	return canon_search(eg, key, sigma, 0, 0);
+}
+
+
+/* --- Caminho de Gray --- */
+
+/*aresta k = (pair_i[k], pair_j[k]), na ordem (0,1), (0,2), (1,2), ...*/
+static void edge_pairs(size_t n, uint8_t* pi, uint8_t* pj) {
+	size_t k = 0;
+
+	for (size_t j = 1; j < n; j++) {
+		for (size_t i = 0; i < j; i++) {
+			pi[k] = (uint8_t) i;
+			pj[k] = (uint8_t) j;
+			k++;
+		}
+	}
+}
+
+static void enum_graph_set(EnumGraph* eg, size_t n, uint64_t mask,
+	const uint8_t* pi, const uint8_t* pj) {
+	size_t E = n * (n - 1) / 2;
+
+	memset(eg, 0, sizeof(*eg));
+	eg->n = n;
+	eg->mask = mask;
+
+	for (size_t k = 0; k < E; k++) {
+		if ((mask >> k) & 1) {
+			eg->adj[pi[k]] |= (uint16_t) (1u << pj[k]);
+			eg->adj[pj[k]] |= (uint16_t) (1u << pi[k]);
+			eg->deg[pi[k]]++;
+			eg->deg[pj[k]]++;
+			eg->edges++;
+		}
+	}
+
+	for (size_t k = 0; k < E; k++) {
+		if ((mask >> k) & 1) {
+			eg->triangles += __builtin_popcount(eg->adj[pi[k]] & eg->adj[pj[k]]);
+		}
+	}
+
+	eg->triangles /= 3;
+}
+
+/*Atualiza eg ao trocar a aresta k: graus e arestas em O(1),
+triângulos pelo n° de vizinhos comuns*/
+static inline void enum_graph_flip(EnumGraph* eg, size_t k,
+	const uint8_t* pi, const uint8_t* pj) {
+	size_t i = pi[k], j = pj[k];
+	size_t common = (size_t) __builtin_popcount(eg->adj[i] & eg->adj[j]);
+
+	eg->mask ^= UINT64_C(1) << k;
+
+	if ((eg->adj[i] >> j) & 1) {
+		eg->adj[i] &= (uint16_t) ~(1u << j);
+		eg->adj[j] &= (uint16_t) ~(1u << i);
+		eg->deg[i]--;
+		eg->deg[j]--;
+		eg->edges--;
+		eg->triangles -= common;
+	} else {
+		eg->adj[i] |= (uint16_t) (1u << j);
+		eg->adj[j] |= (uint16_t) (1u << i);
+		eg->deg[i]++;
+		eg->deg[j]++;
+		eg->edges++;
+		eg->triangles += common;
+	}
+}
+
+#define ENUM_CHUNK_BITS 16
+
+typedef struct {
+	size_t n;
+	unsigned int flags;
+	enum_callback cb;
+	void* ctx;
+	const uint8_t* pi;
+	const uint8_t* pj;
+	uint64_t total;
+	atomic_uint_fast64_t next_chunk;
+	atomic_uint_fast64_t visited;
+} EnumShared;
+
+/*Grafos que cada thread acumula antes de calcular os espectros*/
+#define ENUM_SPEC_BATCH 256
+
+/*Grafos à espera do espectro (só com ENUM_SPECTRUM): o grafo k e a
+sua matriz de adjacência em a[k * n * n]*/
+typedef struct {
+	EnumGraph eg[ENUM_SPEC_BATCH];
+	double a[ENUM_SPEC_BATCH * ENUM_MAX_N * ENUM_MAX_N];
+	double w[ENUM_SPEC_BATCH * ENUM_MAX_N];
+	size_t count;
+} EnumSpecBuffer;
+
+typedef struct {
+	EnumShared* sh;
+	size_t thread;
+	EnumSpecBuffer* buf;
+} EnumWorker;
+
+/*Calcula os espectros pendentes com matrix_spec_batch e entrega os
+grafos ao callback. Se o QL da matriz k não convergiu, ela e as
+seguintes são refeitas com o LAPACK*/
+static void enum_flush(EnumWorker* w) {
+	EnumSpecBuffer* buf = w->buf;
+	size_t n = w->sh->n, nn = n * n;
+	int info = matrix_spec_batch(buf->a, n, buf->count, buf->w);
+
+	for (size_t k = info > 0 ? (size_t) info - 1 : buf->count;
+		k < buf->count; k++) {
+		matrix_spec(&buf->a[k * nn], n, &buf->w[k * n]);
+	}
+
+	for (size_t k = 0; k < buf->count; k++) {
+		memcpy(buf->eg[k].spec, &buf->w[k * n], n * sizeof(double));
+		w->sh->cb(&buf->eg[k], w->thread, w->sh->ctx);
+	}
+
+	buf->count = 0;
+}
+
+static inline uint64_t enum_visit(EnumWorker* w, const EnumGraph* eg) {
+	EnumShared* sh = w->sh;
+
+	if ((sh->flags & ENUM_ISOMORPH_PRUNE) && !enum_graph_is_canonical(eg)) {
+		return 0;
+	}
+
+	if (!(sh->flags & ENUM_SPECTRUM)) {
+		sh->cb(eg, w->thread, sh->ctx);
+		return 1;
+	}
+
+	EnumSpecBuffer* buf = w->buf;
+	size_t n = sh->n;
+	double* a = &buf->a[buf->count * n * n];
+
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = 0; j < n; j++) {
+			a[i * n + j] = (eg->adj[i] >> j) & 1;
+		}
+	}
+
+	buf->eg[buf->count++] = *eg;
+
+	if (buf->count == ENUM_SPEC_BATCH) {
+		enum_flush(w);
+	}
+
+	return 1;
+}
+
+static void* enum_worker(void* arg) {
+	EnumWorker* w = arg;
+	EnumShared* sh = w->sh;
+	uint64_t chunk = UINT64_C(1) << ENUM_CHUNK_BITS;
+	uint64_t count = 0;
+	EnumGraph eg;
+
+	if (sh->flags & ENUM_SPECTRUM) {
+		w->buf = malloc(sizeof(EnumSpecBuffer));
+
+		if (!w->buf) {
+			die("malloc error (graph_enumerate)");
+		}
+
+		w->buf->count = 0;
+	}
+
+	for (;;) {
+		uint64_t c = atomic_fetch_add(&sh->next_chunk, 1);
+		uint64_t a = c * chunk;
+
+		if (a >= sh->total) {
+			break;
+		}
+
+		uint64_t b = (sh->total - a < chunk) ? sh->total : a + chunk;
+
+		/*o t-ésimo código de Gray é t ^ (t >> 1); de t - 1 para t
+		muda o bit ctz(t)*/
+		enum_graph_set(&eg, sh->n, a ^ (a >> 1), sh->pi, sh->pj);
+		count += enum_visit(w, &eg);
+
+		for (uint64_t t = a + 1; t < b; t++) {
+			enum_graph_flip(&eg, (size_t) __builtin_ctzll(t), sh->pi, sh->pj);
+			count += enum_visit(w, &eg);
+		}
+	}
+
+	if (w->buf) {
+		if (w->buf->count > 0) {
+			enum_flush(w);
+		}
+
+		free(w->buf);
+	}
+
+	atomic_fetch_add(&sh->visited, count);
+
+	return NULL;
+}
+
+uint64_t graph_enumerate(size_t n, unsigned int flags, enum_callback cb,
+	void* ctx) {
+	if (n == 0 || n > ENUM_MAX_N_WALK) {
+		die("graph_enumerate: n fora do intervalo");
+	}
+
+	uint8_t pi[ENUM_MAX_N * ENUM_MAX_N], pj[ENUM_MAX_N * ENUM_MAX_N];
+	edge_pairs(n, pi, pj);
+
+	EnumShared sh = {
+		.n = n, .flags = flags, .cb = cb, .ctx = ctx, .pi = pi, .pj = pj,
+		.total = UINT64_C(1) << (n * (n - 1) / 2)
+	};
+	atomic_init(&sh.next_chunk, 0);
+	atomic_init(&sh.visited, 0);
+
+	size_t nt = graph_num_threads();
+	uint64_t nchunks = (sh.total >> ENUM_CHUNK_BITS) + 1;
+
+	if (nt > nchunks) {
+		nt = (size_t) nchunks;
+	}
+
+	pthread_t* th = malloc(nt * sizeof(pthread_t));
+	EnumWorker* workers = malloc(nt * sizeof(EnumWorker));
+
+	if (!th || !workers) {
+		die("malloc error (threads)");
+	}
+
+	for (size_t t = 0; t < nt; t++) {
+		workers[t] = (EnumWorker) {&sh, t, NULL};
+
+		if (pthread_create(&th[t], NULL, enum_worker, &workers[t]) != 0) {
+			die("pthread_create");
+		}
+	}
+
+	for (size_t t = 0; t < nt; t++) {
+		pthread_join(th[t], NULL);
+	}
+
+	free(th);
+	free(workers);
+
+	return atomic_load(&sh.visited);
+}
+
+Graph* enum_graph_to_graph(const EnumGraph* eg) {
+	Graph* g = graph_new(eg->n, false);
+
+	for (size_t i = 0; i < eg->n; i++) {
+		for (size_t j = i + 1; j < eg->n; j++) {
+			if ((eg->adj[i] >> j) & 1) {
+				graph_add_edge(g, i, j, 1.0);
+			}
+		}
+	}
+
+	return g;
+}
@@ -0,0 +1,76 @@
+#ifndef ENUMERATE_H
+#define ENUMERATE_H
+
+/* --- Enumeração exaustiva de grafos pequenos --- */
+
+/*
+Percorre todos os grafos rotulados (simples, não direcionados) de n
+vértices em ordem de código de Gray: de um grafo para o próximo
+muda uma única aresta. Assim os invariantes baratos (graus, n° de
+arestas, n° de triângulos) são atualizados em O(1)/O(n) por passo,
+sem graph_new, graph_add_edge nem malloc.
+
+Com ENUM_ISOMORPH_PRUNE só um representante de cada classe de
+isomorfismo é entregue: o rótulo canônico é o de maior código de
+adjacência entre as rotulações que ordenam os vértices por (grau,
+soma dos graus dos vizinhos) decrescente. A verificação descarta
+quase todo grafo rotulado só olhando a sequência de graus.
+
+Com ENUM_SPECTRUM cada thread acumula os grafos entregues e calcula
+os espectros em lotes com matrix_spec_batch (batch.h) antes de chamar
+o callback; assim o callback de um grafo pode vir depois dos passos
+seguintes da sequência.
+
+A sequência de Gray é dividida em blocos distribuídos entre
+graph_num_threads() threads; o callback é chamado em paralelo e
+recebe o índice da thread (< graph_num_threads()), para que cada
+uma acumule em sua própria área de ctx.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "graphs.h"
+
+#define ENUM_MAX_N 16
+
+/*Maior n aceito por graph_enumerate. A sequência tem 2^(n(n-1)/2)
+passos; com ENUM_ISOMORPH_PRUNE um núcleo faz cerca de 1,3e8 passos/s,
+o que dá (por núcleo): n = 8, 2^28 passos, ~2 s; n = 9, 2^36, ~9 min;
+n = 10, 2^45, ~78 h. n = 11 (2^55) levaria anos*/
+#define ENUM_MAX_N_WALK 10
+
+typedef struct {
+	size_t n;
+	uint16_t adj[ENUM_MAX_N];	/* Bit j de adj[i] = aresta ij*/
+	int deg[ENUM_MAX_N];		/* Graus*/
+	size_t edges;				/* N° de arestas*/
+	size_t triangles;			/* N° de triângulos*/
+	double spec[ENUM_MAX_N];	/* Espectro de A em ordem crescente
+								(só com ENUM_SPECTRUM)*/
+	uint64_t mask;				/* Bit k = aresta k na ordem
+								(0,1), (0,2), (1,2), (0,3), ...*/
+} EnumGraph;
+
+enum {
+	ENUM_ISOMORPH_PRUNE = 1 << 0,	/* Um grafo por classe de isomorfismo*/
+	ENUM_SPECTRUM = 1 << 1			/* Preenche EnumGraph.spec*/
+};
+
+typedef void (*enum_callback)(const EnumGraph* eg, size_t thread, void* ctx);
+
+
+/*Chama cb para cada grafo de n vértices (n <= ENUM_MAX_N_WALK) e
+retorna quantos grafos foram entregues ao callback*/
+uint64_t graph_enumerate(size_t n, unsigned int flags, enum_callback cb,
+	void* ctx);
+
+
+/*Verifica se eg está na sua forma canônica (veja acima)*/
+bool enum_graph_is_canonical(const EnumGraph* eg);
+
+
+/*Cria um Graph (free-after-use) a partir de eg*/
+Graph* enum_graph_to_graph(const EnumGraph* eg);
+
+#endif
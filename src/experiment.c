@@ -0,0 +1,594 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include "experiment.h"
+#include "eig.h"
+
+const double EXP_QUANTILES[EXP_NQUANTILES] = {0.05, 0.5, 0.95};
+
+static const char* const exp_names[EXP_NINVARIANTS] = {
+	"num_edges",
+	"connected",
+	"diameter",
+	"spectral_radius",
+	"energy",
+	"algebraic_connectivity",
+	"lap_spectral_radius"
+};
+
+/*Tentativas por thread em cada rodada*/
+#define EXP_BLOCK 16
+
+
+/* --- Acumuladores --- */
+
+void stats_init(RunningStats* s) {
+	s->count = 0;
+	s->mean = s->m2 = 0.0;
+	s->min = INFINITY;
+	s->max = -INFINITY;
+}
+
+void stats_push(RunningStats* s, double x) {
+	s->count++;
+	double d = x - s->mean;
+	s->mean += d / (double) s->count;
+	s->m2 += d * (x - s->mean);
+
+	if (x < s->min) {
+		s->min = x;
+	}
+
+	if (x > s->max) {
+		s->max = x;
+	}
+}
+
+double stats_variance(const RunningStats* s) {
+	return s->count > 1 ? s->m2 / (double) (s->count - 1) : 0.0;
+}
+
+void p2_init(P2Quantile* q, double p) {
+	memset(q, 0, sizeof(P2Quantile));
+	q->p = p;
+	q->dwant[0] = 0.0;
+	q->dwant[1] = p / 2.0;
+	q->dwant[2] = p;
+	q->dwant[3] = (1.0 + p) / 2.0;
+	q->dwant[4] = 1.0;
+}
+
+/*Interpolação parabólica (P²) do marcador i na direção s*/
+static double p2_parabolic(const P2Quantile* q, int i, double s) {
+	const double* h = q->q;
+	const double* n = q->pos;
+
+	return h[i] + s / (n[i + 1] - n[i - 1])
+		* ((n[i] - n[i - 1] + s) * (h[i + 1] - h[i]) / (n[i + 1] - n[i])
+		+ (n[i + 1] - n[i] - s) * (h[i] - h[i - 1]) / (n[i] - n[i - 1]));
+}
+
+void p2_push(P2Quantile* q, double x) {
+	/*as 5 primeiras observações viram os marcadores*/
+	if (q->count < 5) {
+		q->q[q->count++] = x;
+
+		if (q->count == 5) {
+			qsort(q->q, 5, sizeof(double), cmp_double);
+
+			for (int i = 0; i < 5; i++) {
+				q->pos[i] = i + 1;
+				q->want[i] = 1.0 + 4.0 * q->dwant[i];
+			}
+		}
+
+		return;
+	}
+
+	int k;
+
+	if (x < q->q[0]) {
+		q->q[0] = x;
+		k = 0;
+	} else if (x >= q->q[4]) {
+		q->q[4] = x;
+		k = 3;
+	} else {
+		k = 0;
+
+		while (x >= q->q[k + 1]) {
+			k++;
+		}
+	}
+
+	for (int i = k + 1; i < 5; i++) {
+		q->pos[i] += 1.0;
+	}
+
+	for (int i = 0; i < 5; i++) {
+		q->want[i] += q->dwant[i];
+	}
+
+	q->count++;
+
+	for (int i = 1; i <= 3; i++) {
+		double d = q->want[i] - q->pos[i];
+
+		if ((d >= 1.0 && q->pos[i + 1] - q->pos[i] > 1.0)
+			|| (d <= -1.0 && q->pos[i - 1] - q->pos[i] < -1.0)) {
+			double s = d >= 0.0 ? 1.0 : -1.0;
+			double h = p2_parabolic(q, i, s);
+
+			if (q->q[i - 1] < h && h < q->q[i + 1]) {
+				q->q[i] = h;
+			} else {
+				int j = i + (int) s;
+				q->q[i] += s * (q->q[j] - q->q[i]) / (q->pos[j] - q->pos[i]);
+			}
+
+			q->pos[i] += s;
+		}
+	}
+}
+
+double p2_value(const P2Quantile* q) {
+	if (q->count == 0) {
+		return NAN;
+	}
+
+	if (q->count >= 5) {
+		return q->q[2];
+	}
+
+	double tmp[5];
+	memcpy(tmp, q->q, q->count * sizeof(double));
+	qsort(tmp, q->count, sizeof(double), cmp_double);
+
+	return tmp[(size_t) round(q->p * (double) (q->count - 1))];
+}
+
+static void hist_init(Histogram* h, const ExpConfig* cfg, bool on) {
+	memset(h, 0, sizeof(Histogram));
+
+	if (!on) {
+		return;
+	}
+
+	h->lo = cfg->hist_lo;
+	h->hi = cfg->hist_hi;
+	h->bins = cfg->hist_bins;
+	h->counts = calloc(h->bins, sizeof(uint64_t));
+
+	if (!h->counts) {
+		die("malloc error (histogram)");
+	}
+}
+
+static void hist_push(Histogram* h, double x) {
+	if (x < h->lo) {
+		h->under++;
+	} else if (x >= h->hi) {
+		h->over++;
+	} else {
+		size_t b = (size_t) ((x - h->lo) / (h->hi - h->lo) * (double) h->bins);
+		h->counts[b < h->bins ? b : h->bins - 1]++;
+	}
+}
+
+static void hist_merge(Histogram* into, const Histogram* h) {
+	if (!into->counts) {
+		return;
+	}
+
+	for (size_t b = 0; b < into->bins; b++) {
+		into->counts[b] += h->counts[b];
+	}
+
+	into->under += h->under;
+	into->over += h->over;
+}
+
+
+/* --- Runner --- */
+
+typedef struct {
+	const ExpConfig* cfg;
+	size_t nvalues;
+	size_t first, count;	/* Tentativas desta thread na rodada*/
+	double* values;			/* EXP_BLOCK x nvalues*/
+	bool failed[EXP_BLOCK];
+	Histogram adj, lap;		/* Acumulados pela thread*/
+} ExpWorker;
+
+static void run_trial(ExpWorker* w, size_t trial, double* vals,
+	bool* failed) {
+	const ExpConfig* cfg = w->cfg;
+	unsigned inv = cfg->invariants;
+
+	for (size_t i = 0; i < w->nvalues; i++) {
+		vals[i] = NAN;
+	}
+
+	Rng rng;
+	rng_seed_stream(&rng, cfg->seed, trial);
+	Graph* g = cfg->gen(trial, &rng, cfg->ctx);
+	*failed = g == NULL;
+
+	if (!g) {
+		return;
+	}
+
+	size_t n = g->n;
+	bool need_adj = cfg->hist_adj || (cfg->measure && cfg->measure_spec_adj)
+		|| (inv & (EXP_BIT(EXP_SPECTRAL_RADIUS) | EXP_BIT(EXP_ENERGY)));
+	bool need_lap = cfg->hist_lap || (cfg->measure && cfg->measure_spec_lap)
+		|| (inv & (EXP_BIT(EXP_ALGEBRAIC_CONNECTIVITY)
+		| EXP_BIT(EXP_LAP_SPECTRAL_RADIUS)));
+	double* adj = NULL;
+	double* lap = NULL;
+
+	if (need_adj && n > 0) {
+		adj = malloc(n * sizeof(double));
+
+		if (!adj) {
+			die("malloc error (adj)");
+		}
+
+		if (graph_spec_adj(g, adj) != 0) {
+			free(adj);
+			adj = NULL;
+		}
+	}
+
+	if (need_lap && n > 0) {
+		lap = malloc(n * sizeof(double));
+
+		if (!lap) {
+			die("malloc error (lap)");
+		}
+
+		if (graph_spec_lap(g, lap) != 0) {
+			free(lap);
+			lap = NULL;
+		}
+	}
+
+	if (inv & EXP_BIT(EXP_NUM_EDGES)) {
+		vals[EXP_NUM_EDGES] = (double) graph_num_edges(g);
+	}
+
+	bool connected = true;
+
+	if (inv & (EXP_BIT(EXP_CONNECTED) | EXP_BIT(EXP_DIAMETER))) {
+		connected = graph_is_connected(g);
+	}
+
+	if (inv & EXP_BIT(EXP_CONNECTED)) {
+		vals[EXP_CONNECTED] = connected ? 1.0 : 0.0;
+	}
+
+	if ((inv & EXP_BIT(EXP_DIAMETER)) && connected) {
+		vals[EXP_DIAMETER] = (double) graph_diameter(g);
+	}
+
+	if (adj) {
+		if (inv & EXP_BIT(EXP_SPECTRAL_RADIUS)) {
+			vals[EXP_SPECTRAL_RADIUS] = adj[n - 1];
+		}
+
+		if (inv & EXP_BIT(EXP_ENERGY)) {
+			double e = 0.0;
+
+			for (size_t i = 0; i < n; i++) {
+				e += fabs(adj[i]);
+			}
+
+			vals[EXP_ENERGY] = e;
+		}
+
+		if (cfg->hist_adj) {
+			for (size_t i = 0; i < n; i++) {
+				hist_push(&w->adj, adj[i]);
+			}
+		}
+	}
+
+	if (lap) {
+		if ((inv & EXP_BIT(EXP_ALGEBRAIC_CONNECTIVITY)) && n > 1) {
+			vals[EXP_ALGEBRAIC_CONNECTIVITY] = lap[1];
+		}
+
+		if (inv & EXP_BIT(EXP_LAP_SPECTRAL_RADIUS)) {
+			vals[EXP_LAP_SPECTRAL_RADIUS] = lap[n - 1];
+		}
+
+		if (cfg->hist_lap) {
+			for (size_t i = 0; i < n; i++) {
+				hist_push(&w->lap, lap[i]);
+			}
+		}
+	}
+
+	if (cfg->measure) {
+		cfg->measure(g, adj, lap, &vals[EXP_NINVARIANTS], cfg->ctx);
+	}
+
+	free(adj);
+	free(lap);
+	graph_free(g);
+}
+
+static void* exp_worker(void* arg) {
+	ExpWorker* w = arg;
+
+	for (size_t i = 0; i < w->count; i++) {
+		run_trial(w, w->first + i, &w->values[i * w->nvalues], &w->failed[i]);
+	}
+
+	return NULL;
+}
+
+int experiment_run(const ExpConfig* cfg, ExpResult* res) {
+	memset(res, 0, sizeof(ExpResult));
+
+	if (!cfg->gen || (cfg->nextra > 0 && !cfg->measure)) {
+		return -1;
+	}
+
+	if ((cfg->hist_adj || cfg->hist_lap)
+		&& (cfg->hist_bins == 0 || !(cfg->hist_hi > cfg->hist_lo))) {
+		return -1;
+	}
+
+	size_t nv = EXP_NINVARIANTS + cfg->nextra;
+	res->nvalues = nv;
+	res->stats = malloc(nv * sizeof(RunningStats));
+	res->quantiles = malloc(nv * EXP_NQUANTILES * sizeof(P2Quantile));
+
+	if (!res->stats || !res->quantiles) {
+		die("malloc error (ExpResult)");
+	}
+
+	for (size_t i = 0; i < nv; i++) {
+		stats_init(&res->stats[i]);
+
+		for (size_t j = 0; j < EXP_NQUANTILES; j++) {
+			p2_init(&res->quantiles[IDX(i, j, EXP_NQUANTILES)],
+				EXP_QUANTILES[j]);
+		}
+	}
+
+	hist_init(&res->adj, cfg, cfg->hist_adj);
+	hist_init(&res->lap, cfg, cfg->hist_lap);
+
+	size_t nt = cfg->nthreads ? cfg->nthreads : graph_num_threads();
+	size_t nblocks = (cfg->trials + EXP_BLOCK - 1) / EXP_BLOCK;
+
+	if (nt > nblocks) {
+		nt = nblocks ? nblocks : 1;
+	}
+
+	ExpWorker* ws = calloc(nt, sizeof(ExpWorker));
+	pthread_t* th = malloc(nt * sizeof(pthread_t));
+
+	if (!ws || !th) {
+		die("malloc error (workers)");
+	}
+
+	for (size_t t = 0; t < nt; t++) {
+		ws[t].cfg = cfg;
+		ws[t].nvalues = nv;
+		ws[t].values = malloc(EXP_BLOCK * nv * sizeof(double));
+
+		if (!ws[t].values) {
+			die("malloc error (values)");
+		}
+
+		hist_init(&ws[t].adj, cfg, cfg->hist_adj);
+		hist_init(&ws[t].lap, cfg, cfg->hist_lap);
+	}
+
+	/*cada rodada: nt blocos de EXP_BLOCK tentativas consecutivas, depois
+	os valores entram nos acumuladores na ordem das tentativas*/
+	for (size_t start = 0; start < cfg->trials; start += nt * EXP_BLOCK) {
+		for (size_t t = 0; t < nt; t++) {
+			size_t first = start + t * EXP_BLOCK;
+			ws[t].first = first;
+			ws[t].count = first >= cfg->trials ? 0
+				: (cfg->trials - first < EXP_BLOCK ? cfg->trials - first
+				: EXP_BLOCK);
+		}
+
+		if (nt == 1) {
+			exp_worker(&ws[0]);
+		} else {
+			for (size_t t = 0; t < nt; t++) {
+				if (pthread_create(&th[t], NULL, exp_worker, &ws[t]) != 0) {
+					die("pthread_create");
+				}
+			}
+
+			for (size_t t = 0; t < nt; t++) {
+				pthread_join(th[t], NULL);
+			}
+		}
+
+		for (size_t t = 0; t < nt; t++) {
+			for (size_t i = 0; i < ws[t].count; i++) {
+				const double* vals = &ws[t].values[i * nv];
+				res->trials++;
+
+				if (ws[t].failed[i]) {
+					res->failed++;
+					continue;
+				}
+
+				for (size_t v = 0; v < nv; v++) {
+					if (isnan(vals[v])) {
+						continue;
+					}
+
+					stats_push(&res->stats[v], vals[v]);
+
+					for (size_t j = 0; j < EXP_NQUANTILES; j++) {
+						p2_push(&res->quantiles[IDX(v, j, EXP_NQUANTILES)],
+							vals[v]);
+					}
+				}
+			}
+		}
+	}
+
+	for (size_t t = 0; t < nt; t++) {
+		hist_merge(&res->adj, &ws[t].adj);
+		hist_merge(&res->lap, &ws[t].lap);
+		free(ws[t].values);
+		free(ws[t].adj.counts);
+		free(ws[t].lap.counts);
+	}
+
+	free(ws);
+	free(th);
+
+	return 0;
+}
+
+void experiment_result_free(ExpResult* res) {
+	free(res->stats);
+	free(res->quantiles);
+	free(res->adj.counts);
+	free(res->lap.counts);
+	memset(res, 0, sizeof(ExpResult));
+}
+
+
+/* --- Saída --- */
+
+static void value_name(size_t v, char* buf, size_t len) {
+	if (v < EXP_NINVARIANTS) {
+		snprintf(buf, len, "%s", exp_names[v]);
+	} else {
+		snprintf(buf, len, "extra_%zu", v - EXP_NINVARIANTS);
+	}
+}
+
+static void csv_hist(FILE* f, const char* name, const Histogram* h) {
+	if (!h->counts) {
+		return;
+	}
+
+	double width = (h->hi - h->lo) / (double) h->bins;
+
+	fprintf(f, "%s,-inf,%.17g,%llu\n", name, h->lo,
+		(unsigned long long) h->under);
+
+	for (size_t b = 0; b < h->bins; b++) {
+		fprintf(f, "%s,%.17g,%.17g,%llu\n", name, h->lo + b * width,
+			h->lo + (b + 1) * width, (unsigned long long) h->counts[b]);
+	}
+
+	fprintf(f, "%s,%.17g,inf,%llu\n", name, h->hi,
+		(unsigned long long) h->over);
+}
+
+int experiment_write_csv(const ExpResult* res, const char* path) {
+	FILE* f = path ? fopen(path, "w") : stdout;
+
+	if (!f) {
+		return -1;
+	}
+
+	fprintf(f, "# trials=%zu failed=%zu\n", res->trials, res->failed);
+	fprintf(f, "invariant,count,mean,variance,min,max");
+
+	for (size_t j = 0; j < EXP_NQUANTILES; j++) {
+		fprintf(f, ",q%g", EXP_QUANTILES[j]);
+	}
+
+	fprintf(f, "\n");
+
+	for (size_t v = 0; v < res->nvalues; v++) {
+		const RunningStats* s = &res->stats[v];
+		char name[64];
+
+		if (s->count == 0) {
+			continue;
+		}
+
+		value_name(v, name, sizeof(name));
+		fprintf(f, "%s,%llu,%.17g,%.17g,%.17g,%.17g", name,
+			(unsigned long long) s->count, s->mean, stats_variance(s),
+			s->min, s->max);
+
+		for (size_t j = 0; j < EXP_NQUANTILES; j++) {
+			fprintf(f, ",%.17g",
+				p2_value(&res->quantiles[IDX(v, j, EXP_NQUANTILES)]));
+		}
+
+		fprintf(f, "\n");
+	}
+
+	if (res->adj.counts || res->lap.counts) {
+		fprintf(f, "histogram,lo,hi,count\n");
+		csv_hist(f, "adj", &res->adj);
+		csv_hist(f, "lap", &res->lap);
+	}
+
+	if (path) {
+		fclose(f);
+	}
+
+	return 0;
+}
+
+/*fwrite de count itens; false se a escrita ficou curta*/
+static bool bin_put(FILE* f, const void* p, size_t size, size_t count) {
+	return fwrite(p, size, count, f) == count;
+}
+
+static bool bin_hist(FILE* f, const Histogram* h) {
+	uint64_t bins = h->counts ? h->bins : 0;
+	bool ok = bin_put(f, &bins, sizeof(uint64_t), 1)
+		&& bin_put(f, &h->lo, sizeof(double), 1)
+		&& bin_put(f, &h->hi, sizeof(double), 1);
+
+	if (ok && bins) {
+		ok = bin_put(f, h->counts, sizeof(uint64_t), bins);
+	}
+
+	return ok && bin_put(f, &h->under, sizeof(uint64_t), 1)
+		&& bin_put(f, &h->over, sizeof(uint64_t), 1);
+}
+
+int experiment_write_binary(const ExpResult* res, const char* path) {
+	FILE* f = fopen(path, "wb");
+
+	if (!f) {
+		return -1;
+	}
+
+	uint32_t version = 1;
+	uint64_t header[3] = {res->trials, res->failed, res->nvalues};
+
+	bool ok = bin_put(f, "GEXP", 1, 4)
+		&& bin_put(f, &version, sizeof(uint32_t), 1)
+		&& bin_put(f, header, sizeof(uint64_t), 3);
+
+	for (size_t v = 0; ok && v < res->nvalues; v++) {
+		const RunningStats* s = &res->stats[v];
+		double row[4 + EXP_NQUANTILES] = {s->mean, stats_variance(s),
+			s->min, s->max};
+
+		for (size_t j = 0; j < EXP_NQUANTILES; j++) {
+			row[4 + j] = p2_value(&res->quantiles[IDX(v, j, EXP_NQUANTILES)]);
+		}
+
+		ok = bin_put(f, &s->count, sizeof(uint64_t), 1)
+			&& bin_put(f, row, sizeof(double), 4 + EXP_NQUANTILES);
+	}
+
+	ok = ok && bin_hist(f, &res->adj) && bin_hist(f, &res->lap);
+
+	return (fclose(f) == 0 && ok) ? 0 : -1;
+}
@@ -0,0 +1,157 @@
+#ifndef EXPERIMENT_H
+#define EXPERIMENT_H
+
+/* --- Experimentos de Monte Carlo --- */
+
+/*
+Em vez de escrever o laço gerar / calcular espectro / imprimir em cada
+teste, descreva o experimento num ExpConfig e chame experiment_run:
+
+- o gerador recebe o número da tentativa e um Rng já semeado com
+  (seed, tentativa), então o resultado não depende do número de
+  threads nem da ordem em que as tentativas rodaram;
+- as tentativas rodam em paralelo (graph_num_threads()), em rodadas;
+  os valores de cada rodada são acumulados na ordem das tentativas;
+- nada é guardado por tentativa: os invariantes vão para acumuladores
+  de streaming (média/variância de Welford, mínimo/máximo, quantis
+  pelo algoritmo P² de Jain e Chlamtac) e os autovalores para
+  histogramas;
+- o resumo sai em CSV ou num binário compacto.
+
+Exemplo:
+
+Graph* gen(size_t trial, Rng* rng, void* ctx) {
+	return graph_random_r(100, *(double*) ctx, rng);
+}
+
+double p = 0.1;
+ExpConfig cfg = {.gen = gen, .ctx = &p, .trials = 10000, .seed = 42,
+	.invariants = EXP_BIT(EXP_SPECTRAL_RADIUS) | EXP_BIT(EXP_CONNECTED),
+	.hist_adj = true, .hist_lo = -10, .hist_hi = 20, .hist_bins = 300};
+ExpResult res;
+experiment_run(&cfg, &res);
+experiment_write_csv(&res, "resumo.csv");
+experiment_result_free(&res);
+*/
+
+#include <stdio.h>
+#include "graphs.h"
+#include "rng.h"
+
+/*Invariantes embutidos*/
+typedef enum {
+	EXP_NUM_EDGES,
+	EXP_CONNECTED,					/* 1 ou 0*/
+	EXP_DIAMETER,					/* só conta grafos conexos*/
+	EXP_SPECTRAL_RADIUS,			/* maior autovalor da adjacência*/
+	EXP_ENERGY,						/* Σ |λ_i| da adjacência*/
+	EXP_ALGEBRAIC_CONNECTIVITY,		/* 2° menor autovalor da laplaciana*/
+	EXP_LAP_SPECTRAL_RADIUS,		/* maior autovalor da laplaciana*/
+	EXP_NINVARIANTS
+} ExpInvariant;
+
+#define EXP_BIT(i) (1u << (i))
+
+/*Quantis guardados para cada invariante*/
+#define EXP_NQUANTILES 3
+extern const double EXP_QUANTILES[EXP_NQUANTILES];	/* 0.05, 0.5, 0.95*/
+
+
+/*Gera o grafo da tentativa trial (free-after-use, o runner chama
+graph_free). NULL conta como tentativa falha*/
+typedef Graph* (*ExpGenerator)(size_t trial, Rng* rng, void* ctx);
+
+
+/*Invariantes extras: escreve nextra valores em out (NAN = não conta).
+spec_adj/spec_lap são os espectros já calculados, ou NULL se o
+experimento não precisou deles: measure só os recebe com certeza se
+pedir (ExpConfig.measure_spec_adj/measure_spec_lap), senão cada
+tentativa pagaria dois eigensolvers à toa*/
+typedef void (*ExpMeasure)(const Graph* g, const double* spec_adj,
+	const double* spec_lap, double* out, void* ctx);
+
+
+typedef struct {
+	ExpGenerator gen;
+	void* ctx;				/* Passado ao gerador e a measure*/
+	size_t trials;
+	uint64_t seed;
+	unsigned invariants;	/* EXP_BIT(EXP_...) | ...*/
+	ExpMeasure measure;		/* Opcional*/
+	size_t nextra;			/* N° de valores de measure*/
+	bool measure_spec_adj;	/* measure usa o espectro da adjacência*/
+	bool measure_spec_lap;	/* ... e o da laplaciana*/
+	bool hist_adj;			/* Histograma dos autovalores da adjacência*/
+	bool hist_lap;			/* ... e da laplaciana*/
+	double hist_lo, hist_hi;
+	size_t hist_bins;
+	size_t nthreads;		/* 0 = graph_num_threads()*/
+} ExpConfig;
+
+
+/* --- Acumuladores --- */
+
+/*Média e variância de Welford, mínimo e máximo*/
+typedef struct {
+	uint64_t count;
+	double mean, m2, min, max;
+} RunningStats;
+
+/*Quantil p por P²: 5 marcadores, memória O(1)*/
+typedef struct {
+	double p;
+	uint64_t count;
+	double q[5];		/* Alturas*/
+	double pos[5];		/* Posições atuais*/
+	double want[5];		/* Posições desejadas*/
+	double dwant[5];
+} P2Quantile;
+
+/*Histograma de [lo, hi) em bins caixas iguais*/
+typedef struct {
+	double lo, hi;
+	size_t bins;
+	uint64_t* counts;	/* NULL se não foi pedido*/
+	uint64_t under, over;
+} Histogram;
+
+void stats_init(RunningStats* s);
+void stats_push(RunningStats* s, double x);
+double stats_variance(const RunningStats* s);
+
+void p2_init(P2Quantile* q, double p);
+void p2_push(P2Quantile* q, double x);
+double p2_value(const P2Quantile* q);
+
+
+typedef struct {
+	size_t trials;
+	size_t failed;				/* Gerador devolveu NULL*/
+	size_t nvalues;				/* EXP_NINVARIANTS + nextra*/
+	RunningStats* stats;		/* nvalues*/
+	P2Quantile* quantiles;		/* nvalues x EXP_NQUANTILES*/
+	Histogram adj, lap;
+} ExpResult;
+
+
+/*Roda o experimento. Retorna -1 se cfg for inválido*/
+int experiment_run(const ExpConfig* cfg, ExpResult* res);
+
+
+void experiment_result_free(ExpResult* res);
+
+
+/*Uma linha por invariante (nome, n, média, variância, min, max e
+quantis) e uma por caixa de histograma. path == NULL escreve em
+stdout. Retorna -1 se não conseguir abrir o arquivo*/
+int experiment_write_csv(const ExpResult* res, const char* path);
+
+
+/*Mesmo conteúdo em binário (ordem de bytes da máquina): "GEXP", versão
+(uint32), trials, failed e nvalues (uint64); para cada valor count
+(uint64) e mean, var, min, max e os quantis (double); para cada
+histograma (adj, lap) bins (uint64), lo, hi (double), counts, under e
+over (uint64). Retorna -1 se não conseguir abrir ou escrever tudo*/
+int experiment_write_binary(const ExpResult* res, const char* path);
+
+#endif
@@ -0,0 +1,487 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+#include "families.h"
+
+struct GraphFamily {
+	GraphFamilyKind kind;
+	uint64_t version;	/* g->version quando foi marcado*/
+	size_t a, b;		/* n (K_n, C_n, P_n), a e b (K_{a,b}) ou d (Q_d)*/
+	size_t r;			/* Cayley: n° de fatores Z_{dims[i]}*/
+	size_t* dims;
+	double* conn;		/* Cayley: indicadora de S ∪ -S (n posições)*/
+};
+
+static struct GraphFamily* family_new(Graph* g, GraphFamilyKind kind) {
+	struct GraphFamily* f = calloc(1, sizeof(struct GraphFamily));
+
+	if (!f) {
+		die("malloc error (GraphFamily)");
+	}
+
+	f->kind = kind;
+	f->version = g->version;
+	graph_family_free(g->family);
+	g->family = f;
+
+	return f;
+}
+
+void graph_family_free(struct GraphFamily* f) {
+	if (!f) {
+		return;
+	}
+
+	free(f->dims);
+	free(f->conn);
+	free(f);
+}
+
+void graph_family_set(Graph* g, GraphFamilyKind kind, size_t a, size_t b) {
+	struct GraphFamily* f = family_new(g, kind);
+	f->a = a;
+	f->b = b;
+}
+
+GraphFamilyKind graph_family(const Graph* g) {
+	if (!g->family || g->family->version != g->version) {
+		return GRAPH_FAMILY_NONE;
+	}
+
+	return g->family->kind;
+}
+
+bool graph_family_bipartition(const Graph* g, size_t* n1) {
+	GraphFamilyKind kind = graph_family(g);
+
+	if (kind != GRAPH_FAMILY_BIPARTITE
+		&& kind != GRAPH_FAMILY_COMPLETE_BIPARTITE) {
+		return false;
+	}
+
+	*n1 = g->family->a;
+
+	return true;
+}
+
+
+/* --- Geradores --- */
+
+Graph* graph_cycle(size_t n) {
+	if (n < 3) {
+		die("graph_cycle: n < 3");
+	}
+
+	Graph* g = graph_new(n, false);
+
+	for (size_t i = 0; i < n; i++) {
+		graph_add_edge(g, i, (i + 1) % n, 1.0);
+	}
+
+	graph_family_set(g, GRAPH_FAMILY_CYCLE, n, 0);
+
+	return g;
+}
+
+Graph* graph_path(size_t n) {
+	Graph* g = graph_new(n, false);
+
+	for (size_t i = 0; i + 1 < n; i++) {
+		graph_add_edge(g, i, i + 1, 1.0);
+	}
+
+	graph_family_set(g, GRAPH_FAMILY_PATH, n, 0);
+
+	return g;
+}
+
+Graph* graph_complete_bipartite(size_t a, size_t b) {
+	Graph* g = graph_new(a + b, false);
+
+	for (size_t i = 0; i < a; i++) {
+		for (size_t j = a; j < a + b; j++) {
+			graph_add_edge(g, i, j, 1.0);
+		}
+	}
+
+	graph_family_set(g, GRAPH_FAMILY_COMPLETE_BIPARTITE, a, b);
+
+	return g;
+}
+
+Graph* graph_hypercube(size_t d) {
+	if (d >= 8 * sizeof(size_t) / 2) {
+		die("graph_hypercube: d muito grande");
+	}
+
+	size_t n = (size_t) 1 << d;
+	Graph* g = graph_new(n, false);
+
+	for (size_t u = 0; u < n; u++) {
+		for (size_t k = 0; k < d; k++) {
+			size_t v = u ^ ((size_t) 1 << k);
+			g->A[IDX(u, v, n)] = 1.0;
+		}
+	}
+
+	graph_family_set(g, GRAPH_FAMILY_HYPERCUBE, d, 0);
+
+	return g;
+}
+
+Graph* graph_cayley_abelian(const size_t* dims, size_t r, const size_t* S,
+	size_t k) {
+	size_t n = 1;
+
+	for (size_t j = 0; j < r; j++) {
+		if (dims[j] == 0) {
+			die("graph_cayley_abelian: dims[j] == 0");
+		}
+
+		n *= dims[j];
+	}
+
+	double* conn = calloc(n, sizeof(double));
+	size_t* x = malloc((r + 1) * sizeof(size_t));
+
+	if (!conn || !x) {
+		die("malloc error (conn || x)");
+	}
+
+	/*indicadora de S ∪ -S*/
+	for (size_t i = 0; i < k; i++) {
+		size_t s = 0, neg = 0;
+
+		for (size_t j = 0; j < r; j++) {
+			size_t c = S[IDX(i, j, r)] % dims[j];
+			s = s * dims[j] + c;
+			neg = neg * dims[j] + (dims[j] - c) % dims[j];
+		}
+
+		if (s == 0) {
+			die("graph_cayley_abelian: S contém o elemento neutro");
+		}
+
+		conn[s] = conn[neg] = 1.0;
+	}
+
+	/*u ~ u + t para cada t com conn[t] = 1 (soma coordenada a coordenada)*/
+	Graph* g = graph_new(n, false);
+
+	for (size_t t = 1; t < n; t++) {
+		if (conn[t] == 0.0) {
+			continue;
+		}
+
+		for (size_t j = r, rest = t; j-- > 0; rest /= dims[j]) {
+			x[j] = rest % dims[j];
+		}
+
+		for (size_t u = 0; u < n; u++) {
+			size_t v = 0;
+
+			for (size_t j = 0, stride = n, rest = u; j < r; j++) {
+				stride /= dims[j];
+				size_t uj = rest / stride;
+				rest %= stride;
+				v = v * dims[j] + (uj + x[j]) % dims[j];
+			}
+
+			g->A[IDX(u, v, n)] = 1.0;
+		}
+	}
+
+	free(x);
+
+	struct GraphFamily* f = family_new(g, GRAPH_FAMILY_CAYLEY_ABELIAN);
+	f->a = n;
+	f->r = r;
+	f->dims = malloc((r + 1) * sizeof(size_t));
+	f->conn = conn;
+
+	if (!f->dims) {
+		die("malloc error (dims)");
+	}
+
+	memcpy(f->dims, dims, r * sizeof(size_t));
+
+	return g;
+}
+
+Graph* graph_circulant(size_t n, const size_t* S, size_t k) {
+	Graph* g = graph_cayley_abelian(&n, 1, S, k);
+	g->family->kind = GRAPH_FAMILY_CIRCULANT;
+
+	return g;
+}
+
+
+/* --- FFT --- */
+
+/*Radix-2 iterativa, n potência de 2. sign = -1 (direta) ou +1 (inversa,
+sem dividir por n)*/
+static void fft_pow2(double complex* x, size_t n, int sign) {
+	for (size_t i = 1, j = 0; i < n; i++) {
+		size_t bit = n >> 1;
+
+		for (; j & bit; bit >>= 1) {
+			j ^= bit;
+		}
+
+		j ^= bit;
+
+		if (i < j) {
+			double complex t = x[i];
+			x[i] = x[j];
+			x[j] = t;
+		}
+	}
+
+	for (size_t len = 2; len <= n; len <<= 1) {
+		double ang = sign * 2.0 * M_PI / (double) len;
+		double complex wl = cos(ang) + I * sin(ang);
+
+		for (size_t i = 0; i < n; i += len) {
+			double complex w = 1.0;
+
+			for (size_t j = 0; j < len / 2; j++) {
+				double complex u = x[i + j];
+				double complex v = x[i + j + len / 2] * w;
+				x[i + j] = u + v;
+				x[i + j + len / 2] = u - v;
+				w *= wl;
+			}
+		}
+	}
+}
+
+/*DFT direta de tamanho qualquer: radix-2 se der, senão Bluestein
+(a DFT vira uma convolução de tamanho potência de 2)*/
+static void fft(double complex* x, size_t n) {
+	if ((n & (n - 1)) == 0) {
+		fft_pow2(x, n, -1);
+		return;
+	}
+
+	size_t m = 1;
+
+	while (m < 2 * n - 1) {
+		m <<= 1;
+	}
+
+	double complex* w = malloc(n * sizeof(double complex));
+	double complex* a = calloc(m, sizeof(double complex));
+	double complex* b = calloc(m, sizeof(double complex));
+
+	if (!w || !a || !b) {
+		die("malloc error (bluestein)");
+	}
+
+	/*w_k = exp(-iπk²/n); k² mod 2n para não perder precisão*/
+	for (size_t k = 0; k < n; k++) {
+		size_t k2 = (size_t) (((unsigned __int128) k * k) % (2 * n));
+		double ang = -M_PI * (double) k2 / (double) n;
+		w[k] = cos(ang) + I * sin(ang);
+	}
+
+	for (size_t k = 0; k < n; k++) {
+		a[k] = x[k] * w[k];
+	}
+
+	b[0] = conj(w[0]);
+
+	for (size_t k = 1; k < n; k++) {
+		b[k] = b[m - k] = conj(w[k]);
+	}
+
+	fft_pow2(a, m, -1);
+	fft_pow2(b, m, -1);
+
+	for (size_t k = 0; k < m; k++) {
+		a[k] *= b[k];
+	}
+
+	fft_pow2(a, m, 1);
+
+	for (size_t k = 0; k < n; k++) {
+		x[k] = w[k] * a[k] / (double) m;
+	}
+
+	free(w);
+	free(a);
+	free(b);
+}
+
+/*FFT multidimensional (row-major) em cima de x: uma FFT 1D por linha
+de cada eixo*/
+static void fft_nd(double complex* x, const size_t* dims, size_t r,
+	size_t n) {
+	double complex* line = NULL;
+	size_t stride = n;
+
+	for (size_t j = 0; j < r; j++) {
+		size_t len = dims[j];
+		stride /= len;
+
+		line = realloc(line, len * sizeof(double complex));
+
+		if (!line) {
+			die("malloc error (line)");
+		}
+
+		for (size_t base = 0; base < n; base++) {
+			/*base percorre os índices com coordenada j igual a 0*/
+			if ((base / stride) % len != 0) {
+				continue;
+			}
+
+			for (size_t i = 0; i < len; i++) {
+				line[i] = x[base + i * stride];
+			}
+
+			fft(line, len);
+
+			for (size_t i = 0; i < len; i++) {
+				x[base + i * stride] = line[i];
+			}
+		}
+	}
+
+	free(line);
+}
+
+
+/* --- Espectros --- */
+
+static void spec_cayley(const struct GraphFamily* f, double* x,
+	bool laplacian) {
+	size_t n = f->a;
+	double complex* c = malloc(n * sizeof(double complex));
+
+	if (!c) {
+		die("malloc error (c)");
+	}
+
+	double deg = 0.0;
+
+	for (size_t i = 0; i < n; i++) {
+		c[i] = f->conn[i];
+		deg += f->conn[i];
+	}
+
+	fft_nd(c, f->dims, f->r, n);
+
+	/*S = -S, então a transformada é real*/
+	for (size_t i = 0; i < n; i++) {
+		x[i] = laplacian ? deg - creal(c[i]) : creal(c[i]);
+	}
+
+	free(c);
+	qsort(x, n, sizeof(double), cmp_double);
+}
+
+static void spec_hypercube(size_t d, double* x, bool laplacian) {
+	size_t j = 0;
+
+	/*d - 2k (ou 2k na laplaciana) com multiplicidade C(d, k)*/
+	for (size_t i = 0; i <= d; i++) {
+		size_t k = laplacian ? i : d - i;
+		size_t binom = 1;
+
+		for (size_t t = 0; t < k; t++) {
+			binom = binom * (d - t) / (t + 1);
+		}
+
+		double v = laplacian ? 2.0 * k : (double) d - 2.0 * k;
+
+		for (size_t t = 0; t < binom; t++) {
+			x[j++] = v;
+		}
+	}
+}
+
+bool graph_family_spec(const Graph* g, double* x, bool laplacian) {
+	GraphFamilyKind kind = graph_family(g);
+	const struct GraphFamily* f = g->family;
+	size_t n = g->n;
+
+	switch (kind) {
+	case GRAPH_FAMILY_NONE:
+	case GRAPH_FAMILY_BIPARTITE:
+		return false;
+
+	case GRAPH_FAMILY_COMPLETE:
+		for (size_t i = 0; i < n; i++) {
+			if (laplacian) {
+				x[i] = (i == 0) ? 0.0 : (double) n;
+			} else {
+				x[i] = (i + 1 == n) ? (double) n - 1.0 : -1.0;
+			}
+		}
+		break;
+
+	case GRAPH_FAMILY_CYCLE:
+		for (size_t j = 0; j < n; j++) {
+			double c = 2.0 * cos(2.0 * M_PI * (double) j / (double) n);
+			x[j] = laplacian ? 2.0 - c : c;
+		}
+
+		qsort(x, n, sizeof(double), cmp_double);
+		break;
+
+	case GRAPH_FAMILY_PATH:
+		/*já saem em ordem crescente*/
+		for (size_t j = 0; j < n; j++) {
+			if (laplacian) {
+				x[j] = 2.0 - 2.0 * cos(M_PI * (double) j / (double) n);
+			} else {
+				x[j] = 2.0 * cos(M_PI * (double) (n - j) / (double) (n + 1));
+			}
+		}
+		break;
+
+	case GRAPH_FAMILY_COMPLETE_BIPARTITE: {
+		size_t a = f->a, b = f->b;
+
+		for (size_t i = 0; i < n; i++) {
+			x[i] = 0.0;
+		}
+
+		if (a == 0 || b == 0) {
+			break;
+		}
+
+		if (laplacian) {
+			/*0, a (b - 1 vezes), b (a - 1 vezes), a + b*/
+			size_t lo = a < b ? a : b, hi = a < b ? b : a;
+			size_t j = 1;
+
+			for (size_t t = 0; t + 1 < hi; t++) {
+				x[j++] = (double) lo;
+			}
+
+			for (size_t t = 0; t + 1 < lo; t++) {
+				x[j++] = (double) hi;
+			}
+
+			x[n - 1] = (double) (a + b);
+		} else {
+			x[0] = -sqrt((double) a * (double) b);
+			x[n - 1] = -x[0];
+		}
+		break;
+	}
+
+	case GRAPH_FAMILY_HYPERCUBE:
+		spec_hypercube(f->a, x, laplacian);
+		break;
+
+	case GRAPH_FAMILY_CIRCULANT:
+	case GRAPH_FAMILY_CAYLEY_ABELIAN:
+		spec_cayley(f, x, laplacian);
+		break;
+	}
+
+	return true;
+}
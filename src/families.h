@@ -0,0 +1,98 @@
+#ifndef FAMILIES_H
+#define FAMILIES_H
+
+/* --- Famílias de grafos com espectro conhecido --- */
+
+/*
+Os geradores daqui (e graph_kn) marcam o Graph com a família a que
+ele pertence. Enquanto o grafo não for modificado (a marca guarda
+g->version, igual ao cache), graph_spec_adj e graph_spec_lap usam a
+fórmula fechada em vez do dsyev:
+
+completo K_n:          n - 1, -1 (n - 1 vezes)
+ciclo C_n:             2cos(2πj/n), j = 0..n-1
+caminho P_n:           2cos(πj/(n+1)), j = 1..n
+bipartido K_{a,b}:     ±√(ab), 0 (a + b - 2 vezes)
+hipercubo Q_d:         d - 2k com multiplicidade C(d, k)
+circulante/Cayley:     λ_χ = Σ_{s ∈ S} χ(s), para cada caractere χ
+
+Para circulantes (grupo Z_n) e grafos de Cayley de grupos abelianos
+Z_{n1} x ... x Z_{nr}, os autovalores são a transformada de Fourier
+(multidimensional) da indicadora do conjunto de conexão S, então
+saem com uma FFT em O(n log n). A FFT é radix-2 e usa Bluestein
+quando o tamanho não é potência de 2.
+
+Em todos os casos o grafo é k-regular ou tem laplaciana conhecida,
+então o espectro da laplaciana sai junto.
+*/
+
+#include "graphs.h"
+
+typedef enum {
+	GRAPH_FAMILY_NONE,
+	GRAPH_FAMILY_COMPLETE,
+	GRAPH_FAMILY_CYCLE,
+	GRAPH_FAMILY_PATH,
+	GRAPH_FAMILY_COMPLETE_BIPARTITE,
+	GRAPH_FAMILY_HYPERCUBE,
+	GRAPH_FAMILY_CIRCULANT,
+	GRAPH_FAMILY_CAYLEY_ABELIAN,
+	GRAPH_FAMILY_BIPARTITE		/* Só a partição é conhecida (bipartite.h)*/
+} GraphFamilyKind;
+
+
+/*Ciclo C_n (n >= 3)*/
+Graph* graph_cycle(size_t n);
+
+
+/*Caminho P_n: 0 - 1 - ... - (n - 1)*/
+Graph* graph_path(size_t n);
+
+
+/*K_{a,b}: vértices 0..a-1 de um lado, a..a+b-1 do outro*/
+Graph* graph_complete_bipartite(size_t a, size_t b);
+
+
+/*Hipercubo Q_d: 2^d vértices, u ~ v se diferem em um bit*/
+Graph* graph_hypercube(size_t d);
+
+
+/*Circulante: u ~ v se (v - u) mod n ou (u - v) mod n está em
+S[0..k-1]. S não pode conter 0 (mod n)*/
+Graph* graph_circulant(size_t n, const size_t* S, size_t k);
+
+
+/*Cayley de Z_{dims[0]} x ... x Z_{dims[r-1]}. O vértice
+(x_0, ..., x_{r-1}) tem índice x_0 * (dims[1]...dims[r-1]) + ... +
+x_{r-1} (row-major, como IDX). S é uma matriz k x r, cada linha um
+elemento do conjunto de conexão (-s é incluído automaticamente)*/
+Graph* graph_cayley_abelian(const size_t* dims, size_t r, const size_t* S,
+	size_t k);
+
+
+/*Família de g, ou GRAPH_FAMILY_NONE se g não tem marca ou foi
+modificado depois de marcado*/
+GraphFamilyKind graph_family(const Graph* g);
+
+
+/* --- Usadas por graphs.c/eig.c --- */
+
+/*Marca g (na versão atual) como K_n, C_n, P_n, K_{a,b}, Q_d ou
+bipartido com partição 0..a-1 / a..a+b-1 (b só é usado por K_{a,b} e
+bipartidos)*/
+void graph_family_set(Graph* g, GraphFamilyKind kind, size_t a, size_t b);
+
+
+/*Se g tem uma marca válida, escreve o espectro da adjacência (ou da
+laplaciana) em x, em ordem crescente, e retorna true*/
+bool graph_family_spec(const Graph* g, double* x, bool laplacian);
+
+
+/*Se a marca de g dá uma bipartição X = 0..n1-1, Y = n1..n-1, coloca
+n1 em *n1 e retorna true*/
+bool graph_family_bipartition(const Graph* g, size_t* n1);
+
+
+void graph_family_free(struct GraphFamily* f);
+
+#endif
@@ -0,0 +1,659 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "generators.h"
+#include "rng.h"
+
+/*Tamanhos fixos dos pedaços (não dependem do n° de threads)*/
+#define EDGE_CHUNK ((size_t) 1 << 16)	/* Arestas (BA, R-MAT)*/
+#define ROW_CHUNK ((size_t) 1 << 10)	/* Linhas (Chung–Lu, ordenação)*/
+#define SLOT_CHUNK ((uint64_t) 1 << 22)	/* Pares candidatos (SBM)*/
+
+static void* xmalloc(size_t count, size_t size) {
+	void* p = malloc((count ? count : 1) * size);
+
+	if (!p) {
+		die("malloc error (generators)");
+	}
+
+	return p;
+}
+
+
+/* --- Execução em pedaços --- */
+
+typedef struct {
+	void (*fn)(size_t chunk, void* ctx);
+	void* ctx;
+	size_t nchunks;
+	atomic_size_t next;
+} Pool;
+
+static void* pool_worker(void* arg) {
+	Pool* p = arg;
+	size_t c;
+
+	while ((c = atomic_fetch_add(&p->next, 1)) < p->nchunks) {
+		p->fn(c, p->ctx);
+	}
+
+	return NULL;
+}
+
+/*fn(0), ..., fn(nchunks - 1), distribuídos entre as threads sob demanda*/
+static void parallel_for(size_t nchunks, void (*fn)(size_t, void*),
+	void* ctx) {
+	Pool p = {fn, ctx, nchunks, 0};
+	size_t nt = graph_num_threads();
+
+	if (nt > nchunks) {
+		nt = nchunks ? nchunks : 1;
+	}
+
+	if (nt == 1) {
+		pool_worker(&p);
+		return;
+	}
+
+	pthread_t* th = xmalloc(nt, sizeof(pthread_t));
+
+	for (size_t t = 0; t < nt; t++) {
+		if (pthread_create(&th[t], NULL, pool_worker, &p) != 0) {
+			die("pthread_create");
+		}
+	}
+
+	for (size_t t = 0; t < nt; t++) {
+		pthread_join(th[t], NULL);
+	}
+
+	free(th);
+}
+
+
+/* --- Arestas por pedaço -> CSR --- */
+
+typedef struct {
+	uint32_t* e;		/* Pares (u, v) em sequência*/
+	size_t len, cap;	/* Em uint32_t*/
+} EdgeBuf;
+
+static void edge_push(EdgeBuf* b, uint32_t u, uint32_t v) {
+	if (u == v) {
+		return;
+	}
+
+	if (b->len + 2 > b->cap) {
+		b->cap = b->cap ? 2 * b->cap : 1024;
+		b->e = realloc(b->e, b->cap * sizeof(uint32_t));
+
+		if (!b->e) {
+			die("malloc error (EdgeBuf)");
+		}
+	}
+
+	b->e[b->len++] = u;
+	b->e[b->len++] = v;
+}
+
+static EdgeBuf* edge_bufs(size_t nchunks) {
+	EdgeBuf* bufs = calloc(nchunks ? nchunks : 1, sizeof(EdgeBuf));
+
+	if (!bufs) {
+		die("malloc error (EdgeBuf)");
+	}
+
+	return bufs;
+}
+
+typedef struct {
+	GraphCSR* g;
+	size_t* len;		/* Tamanho de cada linha depois de tirar repetidas*/
+} RowJob;
+
+static void rows_chunk(size_t chunk, void* ctx) {
+	RowJob* j = ctx;
+	GraphCSR* g = j->g;
+	size_t end = (chunk + 1) * ROW_CHUNK < g->n ? (chunk + 1) * ROW_CHUNK
+		: g->n;
+
+	for (size_t u = chunk * ROW_CHUNK; u < end; u++) {
+		size_t* a = &g->col[g->rowptr[u]];
+		size_t len = g->rowptr[u + 1] - g->rowptr[u], k = 0;
+
+		for (size_t i = 0; i < len; i++) {
+			if (i == 0 || a[i] != a[i - 1]) {
+				a[k++] = a[i];
+			}
+		}
+
+		j->len[u] = k;
+	}
+}
+
+/*As distribuições abaixo são divididas por faixas de linhas: cada
+thread lê todos os pares mas só escreve nas linhas da sua faixa, na
+mesma ordem que a versão serial. Lê mais (uma passada por thread), mas
+não precisa de atômicos e o resultado não muda com as threads*/
+typedef struct {
+	GraphCSR* g;
+	size_t nr;			/* Número de faixas*/
+	EdgeBuf* bufs;
+	size_t nchunks;
+	size_t* pos;
+	uint32_t* first;
+} ScatterJob;
+
+static void range_of(const ScatterJob* j, size_t r, uint32_t* lo,
+	uint32_t* hi) {
+	*lo = (uint32_t) (j->g->n * r / j->nr);
+	*hi = (uint32_t) (j->g->n * (r + 1) / j->nr);
+}
+
+static void count_range(size_t r, void* ctx) {
+	ScatterJob* j = ctx;
+	size_t* cnt = j->g->rowptr + 1;
+	uint32_t lo, hi;
+	range_of(j, r, &lo, &hi);
+
+	for (size_t c = 0; c < j->nchunks; c++) {
+		const uint32_t* e = j->bufs[c].e;
+
+		for (size_t k = 0; k < j->bufs[c].len; k++) {
+			if (e[k] - lo < hi - lo) {
+				cnt[e[k]]++;
+			}
+		}
+	}
+}
+
+static void first_range(size_t r, void* ctx) {
+	ScatterJob* j = ctx;
+	uint32_t lo, hi;
+	range_of(j, r, &lo, &hi);
+
+	for (size_t c = 0; c < j->nchunks; c++) {
+		const uint32_t* e = j->bufs[c].e;
+
+		for (size_t k = 0; k < j->bufs[c].len; k += 2) {
+			uint32_t u = e[k], v = e[k + 1];
+
+			if (u - lo < hi - lo) {
+				j->first[j->pos[u]++] = v;
+			}
+
+			if (v - lo < hi - lo) {
+				j->first[j->pos[v]++] = u;
+			}
+		}
+	}
+}
+
+static void second_range(size_t r, void* ctx) {
+	ScatterJob* j = ctx;
+	const GraphCSR* g = j->g;
+	uint32_t lo, hi;
+	range_of(j, r, &lo, &hi);
+
+	for (size_t v = 0; v < g->n; v++) {
+		for (size_t e = g->rowptr[v]; e < g->rowptr[v + 1]; e++) {
+			uint32_t u = j->first[e];
+
+			if (u - lo < hi - lo) {
+				g->col[j->pos[u]++] = v;
+			}
+		}
+	}
+}
+
+/*Junta os pedaços em ordem (o resultado não depende das threads),
+ordena as linhas e tira repetidas. Libera bufs.
+
+A ordenação é uma segunda distribuição, sem comparações: percorrendo
+as linhas v = 0, 1, ... da primeira e pondo v na linha de cada vizinho
+u, cada linha sai crescente (o grafo é simétrico, então a linha v da
+primeira tem exatamente os u com v na lista)*/
+static GraphCSR* csr_from_bufs(size_t n, EdgeBuf* bufs, size_t nchunks) {
+	GraphCSR* g = calloc(1, sizeof(GraphCSR));
+
+	if (!g) {
+		die("malloc error (GraphCSR)");
+	}
+
+	g->n = n;
+	g->directed = false;
+	g->rowptr = calloc(n + 1, sizeof(size_t));
+
+	if (!g->rowptr) {
+		die("malloc error (rowptr)");
+	}
+
+	size_t nr = graph_num_threads();
+	nr = nr < n ? nr : (n ? n : 1);
+	ScatterJob sj = {g, nr, bufs, nchunks, NULL, NULL};
+	parallel_for(nr, count_range, &sj);
+
+	for (size_t u = 0; u < n; u++) {
+		g->rowptr[u + 1] += g->rowptr[u];
+	}
+
+	size_t* pos = xmalloc(n, sizeof(size_t));
+	memcpy(pos, g->rowptr, n * sizeof(size_t));
+	sj.pos = pos;
+	sj.first = xmalloc(g->rowptr[n], sizeof(uint32_t));
+	parallel_for(nr, first_range, &sj);
+
+	for (size_t c = 0; c < nchunks; c++) {
+		free(bufs[c].e);
+	}
+
+	free(bufs);
+
+	memcpy(pos, g->rowptr, n * sizeof(size_t));
+	g->col = xmalloc(g->rowptr[n], sizeof(size_t));
+	parallel_for(nr, second_range, &sj);
+	free(sj.first);
+
+	/*tira repetidas em paralelo; compacta em seguida*/
+	RowJob job = {g, pos};
+	parallel_for((n + ROW_CHUNK - 1) / ROW_CHUNK, rows_chunk, &job);
+
+	size_t nnz = 0;
+
+	for (size_t u = 0; u < n; u++) {
+		size_t b = g->rowptr[u];
+		g->rowptr[u] = nnz;
+		memmove(&g->col[nnz], &g->col[b], pos[u] * sizeof(size_t));
+		nnz += pos[u];
+	}
+
+	g->rowptr[n] = nnz;
+	free(pos);
+
+	size_t* col = realloc(g->col, (nnz ? nnz : 1) * sizeof(size_t));
+	g->col = col ? col : g->col;
+
+	return g;
+}
+
+
+/* --- Barabási–Albert --- */
+
+typedef struct {
+	size_t m;
+	size_t edges;		/* (n - 1) * m*/
+	uint64_t seed;
+	EdgeBuf* bufs;
+} BAJob;
+
+/*Sorteio sem estado da posição i: splitmix64 de (seed, i). Um Rng
+por posição custaria 5 rodadas de splitmix; aqui é uma só. O viés do
+multiplica-e-desloca sem rejeição é < 2i / 2^64*/
+static uint64_t ba_draw(uint64_t seed, uint64_t i, uint64_t range) {
+	uint64_t z = rng_mix64(seed + (i + 1) * RNG_GOLDEN);
+
+	return (uint64_t) (((unsigned __int128) z * range) >> 64);
+}
+
+/*Posição 2i é a origem da aresta i (vértice 1 + i / m), 2i + 1 o
+destino, sorteado entre as posições anteriores*/
+static uint32_t ba_target(const BAJob* j, uint64_t i) {
+	for (;;) {
+		if (i == 0) {
+			return 0;
+		}
+
+		uint64_t x = ba_draw(j->seed, i, 2 * i);
+
+		if (x % 2 == 0) {
+			return (uint32_t) (1 + (x / 2) / j->m);
+		}
+
+		/*copia o destino de uma aresta anterior*/
+		i = x / 2;
+	}
+}
+
+static void ba_chunk(size_t chunk, void* ctx) {
+	BAJob* j = ctx;
+	size_t end = (chunk + 1) * EDGE_CHUNK < j->edges
+		? (chunk + 1) * EDGE_CHUNK : j->edges;
+
+	for (size_t i = chunk * EDGE_CHUNK; i < end; i++) {
+		edge_push(&j->bufs[chunk], (uint32_t) (1 + i / j->m),
+			ba_target(j, i));
+	}
+}
+
+GraphCSR* graph_csr_random_ba(size_t n, size_t m, uint64_t seed) {
+	if (n >= UINT32_MAX) {
+		return NULL;
+	}
+
+	size_t edges = n > 1 ? (n - 1) * m : 0;
+	size_t nchunks = (edges + EDGE_CHUNK - 1) / EDGE_CHUNK;
+	BAJob j = {m, edges, seed, edge_bufs(nchunks)};
+	parallel_for(nchunks, ba_chunk, &j);
+
+	return csr_from_bufs(n, j.bufs, nchunks);
+}
+
+
+/* --- Chung–Lu --- */
+
+typedef struct {
+	double w;
+	uint32_t v;
+} Weighted;
+
+static int cmp_weight_desc(const void* a, const void* b) {
+	const Weighted* x = a;
+	const Weighted* y = b;
+
+	if (x->w != y->w) {
+		return (x->w < y->w) - (x->w > y->w);
+	}
+
+	return (x->v > y->v) - (x->v < y->v);
+}
+
+typedef struct {
+	size_t n;
+	const Weighted* ord;
+	double total;
+	uint64_t seed;
+	EdgeBuf* bufs;
+} CLJob;
+
+static void cl_chunk(size_t chunk, void* ctx) {
+	CLJob* j = ctx;
+	size_t n = j->n;
+	size_t end = (chunk + 1) * ROW_CHUNK < n ? (chunk + 1) * ROW_CHUNK : n;
+	Rng r;
+	rng_seed_stream(&r, j->seed, chunk);
+
+	for (size_t i = chunk * ROW_CHUNK; i < end; i++) {
+		double wi = j->ord[i].w;
+		size_t v = i + 1;
+		double p = v < n ? fmin(1.0, wi * j->ord[v].w / j->total) : 0.0;
+
+		/*pula os pares com probabilidade <= p, depois corrige por q/p
+		(os pesos só diminuem)*/
+		while (v < n && p > 0.0) {
+			if (p < 1.0) {
+				double skip = floor(log1p(-rng_uniform(&r)) / log1p(-p));
+
+				if (skip >= (double) (n - v)) {
+					break;
+				}
+
+				v += (size_t) skip;
+			}
+
+			double q = fmin(1.0, wi * j->ord[v].w / j->total);
+
+			if (rng_uniform(&r) < q / p) {
+				edge_push(&j->bufs[chunk], j->ord[i].v, j->ord[v].v);
+			}
+
+			p = q;
+			v++;
+		}
+	}
+}
+
+GraphCSR* graph_csr_random_chung_lu(size_t n, const double* w,
+	uint64_t seed) {
+	if (n >= UINT32_MAX) {
+		return NULL;
+	}
+
+	Weighted* ord = xmalloc(n, sizeof(Weighted));
+	double total = 0.0;
+
+	for (size_t u = 0; u < n; u++) {
+		if (!(w[u] >= 0.0)) {
+			free(ord);
+			return NULL;
+		}
+
+		ord[u] = (Weighted) {w[u], (uint32_t) u};
+		total += w[u];
+	}
+
+	qsort(ord, n, sizeof(Weighted), cmp_weight_desc);
+
+	size_t nchunks = total > 0.0 ? (n + ROW_CHUNK - 1) / ROW_CHUNK : 0;
+	CLJob j = {n, ord, total, seed, edge_bufs(nchunks)};
+	parallel_for(nchunks, cl_chunk, &j);
+	free(ord);
+
+	return csr_from_bufs(n, j.bufs, nchunks);
+}
+
+void graph_powerlaw_weights(size_t n, double gamma, double avg_degree,
+	double* w) {
+	double e = -1.0 / (gamma - 1.0), sum = 0.0;
+
+	for (size_t i = 0; i < n; i++) {
+		w[i] = pow((double) (i + 1), e);
+		sum += w[i];
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		w[i] *= avg_degree * (double) n / sum;
+	}
+}
+
+
+/* --- R-MAT --- */
+
+typedef struct {
+	unsigned scale;
+	size_t edges;
+	uint64_t a, ab, abc;	/* Probabilidades acumuladas, em 1/2^32*/
+	const uint32_t* perm;
+	uint64_t seed;
+	EdgeBuf* bufs;
+} RMATJob;
+
+static void rmat_chunk(size_t chunk, void* ctx) {
+	RMATJob* j = ctx;
+	size_t end = (chunk + 1) * EDGE_CHUNK < j->edges
+		? (chunk + 1) * EDGE_CHUNK : j->edges;
+	Rng r;
+	rng_seed_stream(&r, j->seed, chunk);
+
+	for (size_t k = chunk * EDGE_CHUNK; k < end; k++) {
+		uint32_t u = 0, v = 0;
+		uint64_t bits = 0;
+
+		/*32 bits por nível, dois níveis por sorteio; sem desvios, já
+		que o quadrante é imprevisível*/
+		for (unsigned level = 0; level < j->scale; level++) {
+			bits = level % 2 ? bits >> 32 : rng_next(&r);
+			uint64_t x = bits & 0xFFFFFFFFu;
+			uint32_t ubit = x >= j->ab;
+			uint32_t vbit = (x >= j->a && x < j->ab) | (x >= j->abc);
+			u = (u << 1) | ubit;
+			v = (v << 1) | vbit;
+		}
+
+		edge_push(&j->bufs[chunk], j->perm[u], j->perm[v]);
+	}
+}
+
+GraphCSR* graph_csr_random_rmat(unsigned scale, size_t edge_factor,
+	double a, double b, double c, uint64_t seed) {
+	if (scale >= 32 || !(a >= 0.0 && b >= 0.0 && c >= 0.0)
+		|| a + b + c > 1.0) {
+		return NULL;
+	}
+
+	size_t n = (size_t) 1 << scale;
+	uint32_t* perm = xmalloc(n, sizeof(uint32_t));
+	Rng r;
+	rng_seed_stream(&r, seed, UINT64_MAX);
+
+	for (size_t i = 0; i < n; i++) {
+		perm[i] = (uint32_t) i;
+	}
+
+	for (size_t i = n; i-- > 1;) {
+		size_t k = rng_below(&r, i + 1);
+		uint32_t t = perm[i];
+		perm[i] = perm[k];
+		perm[k] = t;
+	}
+
+	size_t edges = edge_factor * n;
+	size_t nchunks = (edges + EDGE_CHUNK - 1) / EDGE_CHUNK;
+	double scale32 = 4294967296.0;
+	RMATJob j = {scale, edges, (uint64_t) (a * scale32),
+		(uint64_t) ((a + b) * scale32), (uint64_t) ((a + b + c) * scale32),
+		perm, seed, edge_bufs(nchunks)};
+	parallel_for(nchunks, rmat_chunk, &j);
+	free(perm);
+
+	return csr_from_bufs(n, j.bufs, nchunks);
+}
+
+
+/* --- SBM --- */
+
+/*Pedaço [start, end) dos pares candidatos entre os blocos r <= s*/
+typedef struct {
+	uint32_t r, s;
+	uint64_t start, end;
+} SlotRange;
+
+typedef struct {
+	size_t k;
+	const size_t* sizes;
+	const size_t* offset;
+	const double* P;
+	const SlotRange* ranges;
+	uint64_t seed;
+	EdgeBuf* bufs;
+} SBMJob;
+
+/*idx -> (i, j) com i < j, na ordem (0,1), (0,2), (1,2), (0,3)...*/
+static void triangle_pair(uint64_t idx, uint64_t* i, uint64_t* j) {
+	uint64_t t = (uint64_t) ((1.0 + sqrt(1.0 + 8.0 * (double) idx)) / 2.0);
+
+	while (t * (t - 1) / 2 > idx) {
+		t--;
+	}
+
+	while ((t + 1) * t / 2 <= idx) {
+		t++;
+	}
+
+	*j = t;
+	*i = idx - t * (t - 1) / 2;
+}
+
+static void sbm_chunk(size_t chunk, void* ctx) {
+	SBMJob* j = ctx;
+	const SlotRange* sr = &j->ranges[chunk];
+	double p = j->P[sr->r * j->k + sr->s];
+	uint64_t ns = j->sizes[sr->s];
+	Rng r;
+	rng_seed_stream(&r, j->seed, chunk);
+
+	for (uint64_t idx = sr->start; idx < sr->end; idx++) {
+		if (p < 1.0) {
+			double skip = floor(log1p(-rng_uniform(&r)) / log1p(-p));
+
+			if (skip >= (double) (sr->end - idx)) {
+				break;
+			}
+
+			idx += (uint64_t) skip;
+		}
+
+		uint64_t a, b;
+
+		if (sr->r == sr->s) {
+			triangle_pair(idx, &a, &b);
+		} else {
+			a = idx / ns;
+			b = idx % ns;
+		}
+
+		edge_push(&j->bufs[chunk], (uint32_t) (j->offset[sr->r] + a),
+			(uint32_t) (j->offset[sr->s] + b));
+	}
+}
+
+GraphCSR* graph_csr_random_sbm(size_t k, const size_t* sizes,
+	const double* P, uint64_t seed, size_t* labels) {
+	size_t* offset = xmalloc(k + 1, sizeof(size_t));
+	size_t nchunks = 0;
+	bool ok = true;
+	offset[0] = 0;
+
+	for (size_t r = 0; r < k; r++) {
+		offset[r + 1] = offset[r] + sizes[r];
+
+		for (size_t s = 0; s < k; s++) {
+			double p = P[r * k + s];
+			ok = ok && p >= 0.0 && p <= 1.0 && p == P[s * k + r];
+		}
+	}
+
+	size_t n = offset[k];
+
+	if (!ok || n >= UINT32_MAX) {
+		free(offset);
+		return NULL;
+	}
+
+	/*primeira passada conta os pedaços, a segunda preenche*/
+	SlotRange* ranges = NULL;
+
+	for (int pass = 0; pass < 2; pass++) {
+		size_t c = 0;
+
+		for (size_t r = 0; r < k; r++) {
+			for (size_t s = r; s < k; s++) {
+				uint64_t nr = sizes[r], ns = sizes[s];
+				uint64_t slots = r == s ? nr * (nr - (nr > 0)) / 2 : nr * ns;
+
+				if (P[r * k + s] == 0.0) {
+					continue;
+				}
+
+				for (uint64_t st = 0; st < slots; st += SLOT_CHUNK, c++) {
+					if (pass == 1) {
+						ranges[c] = (SlotRange) {(uint32_t) r, (uint32_t) s, st,
+							slots - st < SLOT_CHUNK ? slots : st + SLOT_CHUNK};
+					}
+				}
+			}
+		}
+
+		if (pass == 0) {
+			nchunks = c;
+			ranges = xmalloc(nchunks, sizeof(SlotRange));
+		}
+	}
+
+	SBMJob j = {k, sizes, offset, P, ranges, seed, edge_bufs(nchunks)};
+	parallel_for(nchunks, sbm_chunk, &j);
+
+	if (labels) {
+		for (size_t r = 0; r < k; r++) {
+			for (size_t v = offset[r]; v < offset[r + 1]; v++) {
+				labels[v] = r;
+			}
+		}
+	}
+
+	free(offset);
+	free(ranges);
+
+	return csr_from_bufs(n, j.bufs, nchunks);
+}
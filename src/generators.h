@@ -0,0 +1,67 @@
+#ifndef GENERATORS_H
+#define GENERATORS_H
+
+/* --- Geradores aleatórios esparsos (caudas pesadas e blocos) --- */
+
+/*
+Os geradores de graphs.h (G(n, p), regular, bipartido...) montam a
+matriz densa e custam O(n²), e nenhum deles tem a distribuição de
+graus de uma rede real. Os daqui custam O(n + m), escrevem direto num
+GraphCSR não direcionado (sem pesos, sem laços e sem arestas
+repetidas) e dividem o trabalho em pedaços de tamanho fixo entre
+graph_num_threads() threads. Cada pedaço tem a sua sequência
+rng_seed_stream(seed, pedaço), então o grafo depende só de seed, e não
+do número de threads.
+
+- Barabási–Albert: cada vértice novo liga a m vértices escolhidos com
+  probabilidade proporcional ao grau, pelo modelo de cópia (Batagelj e
+  Brandes): o destino da aresta i é o extremo de uma posição anterior
+  sorteada da lista de arestas. Na versão paralela (Sanders e Schulz)
+  cada posição tem seu próprio sorteio, então qualquer thread refaz a
+  cadeia de cópias sem esperar as outras;
+- Chung–Lu: P(u ~ v) = min(1, w_u w_v / Σw), grau esperado w_u. Pesos
+  ordenados e saltos geométricos (Miller e Hagberg);
+- R-MAT: cada aresta desce scale níveis escolhendo um quadrante com
+  probabilidades a, b, c, d = 1 - a - b - c (Kronecker 2x2, como no
+  Graph500); os ids são embaralhados no fim;
+- SBM: k blocos, P(u ~ v) = P[bu][bv]; saltos geométricos em cada par
+  de blocos. labels recebe o bloco de cada vértice (a resposta certa
+  para validar um agrupamento espectral).
+
+Arestas repetidas e laços sorteados são descartados, então o número de
+arestas pode ficar um pouco abaixo do nominal. Todos retornam NULL se
+os parâmetros forem inválidos ou n >= 2^32 (free-after-use com
+graph_csr_free).
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "graphs.h"
+
+
+/*n vértices; a partir do vértice 1, cada um liga a m anteriores*/
+GraphCSR* graph_csr_random_ba(size_t n, size_t m, uint64_t seed);
+
+
+/*Grau esperado w[u] (w >= 0)*/
+GraphCSR* graph_csr_random_chung_lu(size_t n, const double* w,
+	uint64_t seed);
+
+
+/*Pesos de lei de potência para graph_csr_random_chung_lu: w[i] ∝
+(i + 1)^(-1 / (gamma - 1)), com média avg_degree. gamma > 2*/
+void graph_powerlaw_weights(size_t n, double gamma, double avg_degree,
+	double* w);
+
+
+/*2^scale vértices e edge_factor * 2^scale arestas sorteadas*/
+GraphCSR* graph_csr_random_rmat(unsigned scale, size_t edge_factor,
+	double a, double b, double c, uint64_t seed);
+
+
+/*k blocos de sizes[i] vértices (em sequência: o bloco 0 primeiro),
+P k x k simétrica. labels (n posições) pode ser NULL*/
+GraphCSR* graph_csr_random_sbm(size_t k, const size_t* sizes,
+	const double* P, uint64_t seed, size_t* labels);
+
+#endif
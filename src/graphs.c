@@ -1,10 +1,14 @@
 #include "graphs.h"
+#include "cache.h"
+#include "families.h"
+#include "mem.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
 #include <math.h>
 #include <limits.h>
+#include <unistd.h>
 
 static inline void bounds_check(size_t n, size_t u, size_t v) {
 	if (u >= n || v >= n) {
@@ -17,6 +21,12 @@ void die(const char* msg) {
 	exit(EXIT_FAILURE);
 }
 
+int cmp_double(const void* a, const void* b) {
+	double x = *(const double*) a, y = *(const double*) b;
+
+	return (x > y) - (x < y);
+}
+
 Graph* graph_new(size_t	n, bool directed) {
 	Graph* g = (Graph*) calloc(1, sizeof(Graph));
 
@@ -26,18 +36,23 @@ Graph* graph_new(size_t	n, bool directed) {
 
 	g->n = n;
 	g->directed = directed;
-	g->A = (double*) calloc(n*n, sizeof(double));
-
-	if (!g->A) {
-		free(g);
-		die("malloc error (A)");
-	}
+	g->A = graph_mem_matrix(n, n, NULL);
+	g->cache = graph_cache_new();
 
 	return g;
 }
 
+/*Sorteio com rng, ou com rand() se rng for NULL*/
+static inline size_t rand_below(Rng* rng, size_t n) {
+	return rng ? (size_t) rng_below(rng, n) : (size_t) rand() % n;
+}
+
 /*Cria uma aresta com probabilidade p*/
 Graph* graph_random(size_t n, double p) {
+	return graph_random_r(n, p, NULL);
+}
+
+Graph* graph_random_r(size_t n, double p, Rng* rng) {
 	if (p < 0.0 || p > 1.0) {
 		die("p must be a valid probability");
 	}
@@ -51,7 +66,7 @@ Graph* graph_random(size_t n, double p) {
 				continue;
 			}
 
-			double r = (double) rand() / RAND_MAX;
+			double r = rng_uniform_or_rand(rng);
 
 			if (r < p) {
 				g->A[i * n + j] = 1.0;
@@ -67,17 +82,21 @@ Graph* graph_random(size_t n, double p) {
 }
 
 Graph* graph_random_connected(int n, double p) {
+	return graph_random_connected_r(n, p, NULL);
+}
+
+Graph* graph_random_connected_r(int n, double p, Rng* rng) {
 	Graph* g = graph_new(n, false);
 
 	for (int i = 1; i < n; i++) {
-		int j = rand() % i;
+		int j = (int) rand_below(rng, (size_t) i);
 		g->A[i * n + j] = 1;
 		g->A[j * n + i] = 1;
 	}
 
 	for (int i = 0; i < n; i++) {
 		for (int j = i + 1; j < n; j++) {
-			if (g->A[i * n + j] == 0 && ((double)rand() / RAND_MAX) < p) {
+			if (g->A[i * n + j] == 0 && rng_uniform_or_rand(rng) < p) {
 				g->A[i * n + j] = 1;
 				g->A[j * n + i] = 1;
 			}
@@ -88,6 +107,10 @@ Graph* graph_random_connected(int n, double p) {
 }
 
 Graph* graph_random_regular(size_t n, size_t k) {
+	return graph_random_regular_r(n, k, NULL);
+}
+
+Graph* graph_random_regular_r(size_t n, size_t k, Rng* rng) {
 	if (k >= n) {
 		return NULL;
 	}
@@ -115,7 +138,7 @@ Graph* graph_random_regular(size_t n, size_t k) {
 		}
 
 		for (size_t i = 0; i < m; i++) {
-			size_t j = rand() % m;
+			size_t j = rand_below(rng, m);
 			size_t tmp = stubs[i];
 			stubs[i] = stubs[j];
 			stubs[j] = tmp;
@@ -154,6 +177,10 @@ O algoritmo se dá da seguinte forma:
 - construa A a partir dos blocos
 */
 Graph* graph_random_bipartite(size_t n1, size_t n2, double p) {
+	return graph_random_bipartite_r(n1, n2, p, NULL);
+}
+
+Graph* graph_random_bipartite_r(size_t n1, size_t n2, double p, Rng* rng) {
 	if (p < 0.0 || p > 1.0) {
 		return NULL;
 	}
@@ -164,7 +191,7 @@ Graph* graph_random_bipartite(size_t n1, size_t n2, double p) {
 	/*Os vértices até (n1 - 1) pertencem a X*/
 	for (size_t i = 0; i < n1; i++) {
 		for (size_t j = 0; j < n2; j++) {
-			if ((double) rand() / RAND_MAX < p) {
+			if (rng_uniform_or_rand(rng) < p) {
 				size_t a = i;
 				size_t b = n1 + j;
 
@@ -174,6 +201,8 @@ Graph* graph_random_bipartite(size_t n1, size_t n2, double p) {
 		}
 	}
 
+	graph_family_set(g, GRAPH_FAMILY_BIPARTITE, n1, n2);
+
 	return g;
 }
 
@@ -182,6 +211,12 @@ bool graph_is_connected(const Graph* g) {
 
 	if (n <= 1) return true;
 
+	double cached;
+
+	if (graph_cache_get_scalar(g, GRAPH_CACHE_CONNECTED, &cached)) {
+		return cached != 0.0;
+	}
+
 	size_t *stack = malloc(n * sizeof(size_t));
 	char *vis   = calloc(n, 1);
 	if (!stack || !vis) { free(stack); free(vis); return false; }
@@ -204,12 +239,18 @@ bool graph_is_connected(const Graph* g) {
 	}
 
 	free(stack); free(vis);
+	graph_cache_put_scalar(g, GRAPH_CACHE_CONNECTED, visitados == (int) n);
 	return visitados == (int) n;
 }
 
 size_t graph_num_edges(const Graph* g) {
 	size_t n = g->n;
 	size_t count = 0;
+	double cached;
+
+	if (graph_cache_get_scalar(g, GRAPH_CACHE_NUM_EDGES, &cached)) {
+		return (size_t) cached;
+	}
 
 	for (size_t i = 0; i < n; i++) {
 		for (size_t j = 0; j < n; j++) {
@@ -223,6 +264,22 @@ size_t graph_num_edges(const Graph* g) {
 		count /= 2;
 	}
 
+	graph_cache_put_scalar(g, GRAPH_CACHE_NUM_EDGES, (double) count);
+	return count;
+}
+
+size_t graph_num_nonloop_edges(const Graph* g) {
+	size_t n = g->n;
+	size_t count = 0;
+
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = g->directed ? 0 : i + 1; j < n; j++) {
+			if (j != i && g->A[i * n + j] != 0.0) {
+				count++;
+			}
+		}
+	}
+
 	return count;
 }
 
@@ -231,7 +288,9 @@ void graph_free(Graph* g) {
 		return;
 	}
 
-	free(g->A);
+	graph_cache_free(g->cache);
+	graph_family_free(g->family);
+	graph_mem_free(g->A);
 	free(g);
 }
 
@@ -241,11 +300,13 @@ void graph_clear(Graph* g) {
 	}
 
 	memset(g->A, 0, g->n * g->n * sizeof(double));
+	g->version++;
 }
 
 void graph_add_edge(Graph* g, size_t u, size_t v, double w) {
 	bounds_check(g->n, u, v);
 	g->A[IDX(u, v, g->n)] = w;
+	g->version++;
 
 	/*se g não for direcionado, g->A será simétrica*/
 	if (!g->directed && u != v) {
@@ -256,6 +317,7 @@ void graph_add_edge(Graph* g, size_t u, size_t v, double w) {
 void graph_remove_edge(Graph* g, size_t u, size_t v) {
 	bounds_check(g->n, u, v);
 	g->A[IDX(u, v, g->n)] = 0.0;
+	g->version++;
 
 	if (!g->directed && u != v) {
 		g->A[IDX(v, u, g->n)] = 0.0;
@@ -570,6 +632,8 @@ Graph* graph_kn(size_t n) {
 		}
 	}
 
+	graph_family_set(Kn, GRAPH_FAMILY_COMPLETE, n, 0);
+
 	return Kn;
 }
 
@@ -626,6 +690,11 @@ static int graph_bfs_longest_from(const Graph* g, size_t src) {
 
 int graph_diameter(const Graph *g) {
 	int diameter = 0;
+	double cached;
+
+	if (graph_cache_get_scalar(g, GRAPH_CACHE_DIAMETER, &cached)) {
+		return (int) cached;
+	}
 
 	for (size_t i = 0; i < g->n; i++) {
 		int d = graph_bfs_longest_from(g, i);
@@ -635,5 +704,93 @@ int graph_diameter(const Graph *g) {
 		}
 	}
 
+	graph_cache_put_scalar(g, GRAPH_CACHE_DIAMETER, diameter);
 	return diameter;
-}
\ No newline at end of file
+}
+
+size_t graph_num_threads(void) {
+	const char* env = getenv("GRAPH_NUM_THREADS");
+
+	if (env) {
+		long t = strtol(env, NULL, 10);
+
+		if (t > 0) {
+			return (size_t) t;
+		}
+	}
+
+	long p = sysconf(_SC_NPROCESSORS_ONLN);
+
+	return (p > 0) ? (size_t) p : 1;
+}
+
+GraphCSR* graph_csr_from_graph(const Graph* g) {
+	size_t n = g->n;
+	GraphCSR* c = calloc(1, sizeof(GraphCSR));
+
+	if (!c) {
+		die("malloc error (GraphCSR)");
+	}
+
+	c->n = n;
+	c->directed = g->directed;
+	c->rowptr = malloc((n + 1) * sizeof(size_t));
+
+	if (!c->rowptr) {
+		die("malloc error (rowptr)");
+	}
+
+	/*primeira passada conta, a segunda preenche*/
+	size_t nnz = 0;
+	bool unit = true;
+	c->rowptr[0] = 0;
+
+	for (size_t i = 0; i < n; i++) {
+		const double* row = &g->A[IDX(i, 0, n)];
+
+		for (size_t j = 0; j < n; j++) {
+			if (row[j] != 0.0) {
+				nnz++;
+				unit = unit && row[j] == 1.0;
+			}
+		}
+
+		c->rowptr[i + 1] = nnz;
+	}
+
+	c->col = malloc((nnz ? nnz : 1) * sizeof(size_t));
+	c->w = unit ? NULL : malloc((nnz ? nnz : 1) * sizeof(double));
+
+	if (!c->col || (!unit && !c->w)) {
+		die("malloc error (col || w)");
+	}
+
+	for (size_t i = 0, k = 0; i < n; i++) {
+		const double* row = &g->A[IDX(i, 0, n)];
+
+		for (size_t j = 0; j < n; j++) {
+			if (row[j] != 0.0) {
+				c->col[k] = j;
+
+				if (c->w) {
+					c->w[k] = row[j];
+				}
+
+				k++;
+			}
+		}
+	}
+
+	return c;
+}
+
+void graph_csr_free(GraphCSR* g) {
+	if (!g) {
+		return;
+	}
+
+	free(g->rowptr);
+	free(g->col);
+	free(g->w);
+	free(g);
+}
@@ -32,7 +32,9 @@ free(deg); // caso o programa não saia imediatamente
 */
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include "rng.h"
 
 /*
 Toda matriz considerada em qualquer código deste projeto
@@ -43,11 +45,24 @@ row-major order matrix:
 https://en.wikipedia.org/wiki/Row-_and_column-major_order
 
 O elemento (i, j) é acessado usando a fórmula i * n + j onde 
-n é o tamanho da matriz.*/
+n é o tamanho da matriz.
+
+version é incrementado por graph_add_edge, graph_remove_edge e
+graph_clear; invariantes e espectros já calculados ficam guardados
+em cache (veja cache.h) e só valem para a versão em que foram
+calculados. Se você escrever direto em g->A depois de consultar o
+grafo, chame graph_invalidate(g).
+
+Os geradores de families.h (e graph_kn) também marcam o grafo com a
+família a que ele pertence; a marca vale só para a versão em que foi
+feita.*/
 typedef struct {
 	size_t n;  			/* N° de vértices*/
 	bool directed;		/* Grafo direcionado?*/
-	double* A;			/* Matriz de adjacência*/
+	double* A;			/* Matriz de adjacência (graph_mem_matrix, mem.h)*/
+	uint64_t version;	/* N° de modificações*/
+	struct GraphCache* cache;	/* Invariantes calculados (pode ser NULL)*/
+	struct GraphFamily* family;	/* Família conhecida (pode ser NULL)*/
 } Graph;
 
 
@@ -56,10 +71,33 @@ typedef struct {
 #define IDX(i, j, n) ((i) * (n) + j)
 
 
+/*Representação esparsa (compressed sparse row) de um grafo, para
+algoritmos que só precisam percorrer vizinhos (BFS, Dijkstra...).
+Os vizinhos (arestas de saída) de u são col[rowptr[u]..rowptr[u+1]),
+em ordem crescente, com pesos w[k]. w == NULL quer dizer que todos os
+pesos são 1 (use CSR_W para ler). Sem direção cada aresta aparece
+nas duas listas.*/
+typedef struct {
+	size_t n;			/* N° de vértices*/
+	bool directed;		/* Grafo direcionado?*/
+	size_t* rowptr;		/* n + 1 posições*/
+	size_t* col;		/* rowptr[n] posições*/
+	double* w;			/* Pesos (ou NULL)*/
+} GraphCSR;
+
+
+/*Peso da k-ésima entrada de um GraphCSR*/
+#define CSR_W(g, k) ((g)->w ? (g)->w[k] : 1.0)
+
+
 /*Função auxiliar para erros*/
 void die(const char* msg);
 
 
+/*Comparação de doubles para qsort (ordem crescente)*/
+int cmp_double(const void* a, const void* b);
+
+
 /*Cria um grafo em memória dinâmica (free-after-use) e 
 retorna um ponteiro para ele.
 A matriz g->A é preenchida com zeros, então o acesso à memória
@@ -80,10 +118,20 @@ Graph* graph_random_connected(int n, double p);
 Graph* graph_random_regular(size_t n, size_t k);
 
 
-/*Cria um grafo bipartido (de partições de tamanho n1 e n2) aleatório*/
+/*Cria um grafo bipartido (de partições de tamanho n1 e n2) aleatório.
+Os vértices 0..n1-1 formam uma parte; o grafo sai marcado como
+GRAPH_FAMILY_BIPARTITE (veja families.h e bipartite.h)*/
 Graph* graph_random_bipartite(size_t n1, size_t n2, double p);
 
 
+/*Mesmos geradores, sorteando com rng (veja rng.h) em vez de rand().
+Com rng == NULL são iguais às versões acima*/
+Graph* graph_random_r(size_t n, double p, Rng* rng);
+Graph* graph_random_connected_r(int n, double p, Rng* rng);
+Graph* graph_random_regular_r(size_t n, size_t k, Rng* rng);
+Graph* graph_random_bipartite_r(size_t n1, size_t n2, double p, Rng* rng);
+
+
 /*Verifica se g é conexo*/
 bool graph_is_connected(const Graph* g);
 
@@ -92,6 +140,13 @@ bool graph_is_connected(const Graph* g);
 size_t graph_num_edges(const Graph* g);
 
 
+/*Número de arestas sem contar os laços: pares i < j com A[i][j] != 0
+(não direcionado) ou entradas i != j (direcionado). É o número de
+vértices de graph_line_graph e o tamanho dos vetores indexados por
+aresta (na ordem da parte triangular superior de A)*/
+size_t graph_num_nonloop_edges(const Graph* g);
+
+
 /*Libera o conteúdo de um grafo*/
 void graph_free(Graph* g);
 
@@ -197,11 +252,45 @@ Graph* graph_read_from_file(const char* path);
 double graph_paths_length(const Graph* g, size_t v, size_t u, unsigned int k);
 
 
-/*Cria o Kn*/
+/*Cria o Kn (marcado como GRAPH_FAMILY_COMPLETE, veja families.h)*/
 Graph* graph_kn(size_t n);
 
 /*Acha o diâmetro do grafo*/
 int graph_diameter(const Graph *g);
 
 
+/*Monta a representação CSR de g (free-after-use com graph_csr_free)*/
+GraphCSR* graph_csr_from_graph(const Graph* g);
+
+
+/*Libera um GraphCSR*/
+void graph_csr_free(GraphCSR* g);
+
+
+/*Descarta tudo o que foi guardado em cache para g e incrementa
+g->version. Necessário só se g->A for alterada diretamente*/
+void graph_invalidate(Graph* g);
+
+
+/*Retorna a versão atual de g*/
+uint64_t graph_version(const Graph* g);
+
+
+/*Limite (em bytes) da memória usada por espectros em cache, somando
+todos os grafos. O padrão é GRAPH_CACHE_DEFAULT_LIMIT; 0 desliga o
+cache de vetores (escalares continuam sendo guardados)*/
+#define GRAPH_CACHE_DEFAULT_LIMIT ((size_t) 64 << 20)
+void graph_cache_set_limit(size_t bytes);
+
+
+/*Memória (em bytes) usada hoje por vetores em cache*/
+size_t graph_cache_usage(void);
+
+
+/*Número de threads usadas pelas rotinas paralelas da biblioteca.
+Por padrão é o número de processadores online; pode ser trocado
+pela variável de ambiente GRAPH_NUM_THREADS*/
+size_t graph_num_threads(void);
+
+
 #endif
\ No newline at end of file
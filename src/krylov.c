@@ -0,0 +1,459 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <lapacke.h>
+#include "krylov.h"
+#include "graphs.h"
+#include "rng.h"
+
+typedef struct {
+	MatvecFn mv;
+	void* ctx;
+	size_t n, m;		/* Dimensão e tamanho da base*/
+	double* V;			/* m + 1 vetores de n posições (V[j * n ..])*/
+	double* H;			/* Hessenberg m x m*/
+	double* f;			/* Resíduo (n)*/
+	double fnorm;
+	double* h;			/* m + 1, coeficientes de Gram-Schmidt*/
+	Rng rng;
+} Arnoldi;
+
+/*Critério de ordenação (maior primeiro)*/
+typedef struct {
+	double key, im;
+	size_t idx;
+} RitzOrder;
+
+static int cmp_ritz(const void* a, const void* b) {
+	const RitzOrder* x = a;
+	const RitzOrder* y = b;
+
+	if (x->key != y->key) {
+		return x->key < y->key ? 1 : -1;
+	}
+
+	/*par conjugado: parte imaginária positiva primeiro*/
+	return (x->im < y->im) - (x->im > y->im);
+}
+
+static double dot(const double* x, const double* y, size_t n) {
+	double s = 0.0;
+
+	for (size_t i = 0; i < n; i++) {
+		s += x[i] * y[i];
+	}
+
+	return s;
+}
+
+/*w -= V[0..j] (V[0..j]ᵀ w), duas vezes (DGKS); acumula os coeficientes
+em h[0..j]*/
+static void orthogonalize(Arnoldi* a, double* w, size_t j) {
+	size_t n = a->n;
+
+	memset(a->h, 0, (j + 1) * sizeof(double));
+
+	for (int pass = 0; pass < 2; pass++) {
+		for (size_t i = 0; i <= j; i++) {
+			const double* v = &a->V[i * n];
+			double c = dot(v, w, n);
+			a->h[i] += c;
+
+			for (size_t t = 0; t < n; t++) {
+				w[t] -= c * v[t];
+			}
+		}
+	}
+}
+
+/*Vetor aleatório unitário ortogonal a V[0..j-1], em V[j]*/
+static void random_vector(Arnoldi* a, size_t j) {
+	size_t n = a->n;
+	double* v = &a->V[j * n];
+
+	for (int tries = 0; tries < 5; tries++) {
+		for (size_t i = 0; i < n; i++) {
+			v[i] = rng_uniform(&a->rng) - 0.5;
+		}
+
+		if (j > 0) {
+			orthogonalize(a, v, j - 1);
+		}
+
+		double norm = sqrt(dot(v, v, n));
+
+		if (norm > 1e-8) {
+			for (size_t i = 0; i < n; i++) {
+				v[i] /= norm;
+			}
+
+			return;
+		}
+	}
+
+	die("arnoldi: não achei vetor inicial");
+}
+
+/*Estende a fatoração M V_j = V_j H_j + f eⱼᵀ de j para m colunas*/
+static void extend(Arnoldi* a, size_t from) {
+	size_t n = a->n, m = a->m;
+
+	for (size_t j = from; j < m; j++) {
+		double* w = a->f;
+		a->mv(&a->V[j * n], w, a->ctx);
+
+		double wnorm = sqrt(dot(w, w, n));
+		orthogonalize(a, w, j);
+
+		for (size_t i = 0; i <= j; i++) {
+			a->H[IDX(i, j, m)] = a->h[i];
+		}
+
+		double beta = sqrt(dot(w, w, n));
+		a->fnorm = beta;
+
+		if (j + 1 == m) {
+			break;
+		}
+
+		/*subespaço invariante: continua com um vetor novo e H fica
+		bloco-triangular (os autovalores do bloco já são exatos)*/
+		if (beta <= 1e-12 * (wnorm > 0.0 ? wnorm : 1.0)) {
+			a->H[IDX(j + 1, j, m)] = 0.0;
+			random_vector(a, j + 1);
+			continue;
+		}
+
+		a->H[IDX(j + 1, j, m)] = beta;
+
+		for (size_t i = 0; i < n; i++) {
+			a->V[(j + 1) * n + i] = w[i] / beta;
+		}
+	}
+}
+
+/*Q (m x m) de M = QR*/
+static int qr_q(double* M, size_t m, double* tau) {
+	int info = LAPACKE_dgeqrf(LAPACK_ROW_MAJOR, (int) m, (int) m, M,
+		(int) m, tau);
+
+	if (info == 0) {
+		info = LAPACKE_dorgqr(LAPACK_ROW_MAJOR, (int) m, (int) m, (int) m, M,
+			(int) m, tau);
+	}
+
+	return info;
+}
+
+/*C = AB (m x m)*/
+static void small_mult(const double* A, const double* B, double* C,
+	size_t m, bool transpose_a) {
+	for (size_t i = 0; i < m; i++) {
+		for (size_t j = 0; j < m; j++) {
+			double s = 0.0;
+
+			for (size_t t = 0; t < m; t++) {
+				double aij = transpose_a ? A[IDX(t, i, m)] : A[IDX(i, t, m)];
+				s += aij * B[IDX(t, j, m)];
+			}
+
+			C[IDX(i, j, m)] = s;
+		}
+	}
+}
+
+/*Aplica os valores de Ritz ord[keff..m-1] como deslocamentos: H vira
+Qᵀ H Q e o produto dos Q fica em T*/
+static int apply_shifts(Arnoldi* a, const double* wr, const double* wi,
+	const RitzOrder* ord, size_t keff, double* T, double* Q, double* Qt,
+	double* tau) {
+	size_t m = a->m;
+
+	memset(T, 0, m * m * sizeof(double));
+
+	for (size_t i = 0; i < m; i++) {
+		T[IDX(i, i, m)] = 1.0;
+	}
+
+	for (size_t s = keff; s < m; s++) {
+		size_t c = ord[s].idx;
+		double mu = wr[c], nu = wi[c];
+
+		if (nu < 0.0) {
+			continue;
+		}
+
+		if (nu == 0.0) {
+			memcpy(Q, a->H, m * m * sizeof(double));
+
+			for (size_t i = 0; i < m; i++) {
+				Q[IDX(i, i, m)] -= mu;
+			}
+		} else {
+			/*(H - μI)(H - μ̄I) = H² - 2 Re μ H + |μ|² I*/
+			small_mult(a->H, a->H, Q, m, false);
+
+			for (size_t i = 0; i < m * m; i++) {
+				Q[i] -= 2.0 * mu * a->H[i];
+			}
+
+			for (size_t i = 0; i < m; i++) {
+				Q[IDX(i, i, m)] += mu * mu + nu * nu;
+			}
+		}
+
+		int info = qr_q(Q, m, tau);
+
+		if (info != 0) {
+			return info;
+		}
+
+		small_mult(Q, a->H, Qt, m, true);
+		small_mult(Qt, Q, a->H, m, false);
+		small_mult(T, Q, Qt, m, false);
+		memcpy(T, Qt, m * m * sizeof(double));
+
+		/*limpa o lixo de arredondamento abaixo da subdiagonal*/
+		for (size_t i = 2; i < m; i++) {
+			for (size_t j = 0; j + 1 < i; j++) {
+				a->H[IDX(i, j, m)] = 0.0;
+			}
+		}
+	}
+
+	return 0;
+}
+
+/*Matriz densa (n produtos M eᵢ) e dgeev*/
+static int dense_eigs(MatvecFn mv, void* ctx, size_t n, size_t k,
+	ArnoldiWhich which, double complex* z) {
+	double* M = malloc(n * n * sizeof(double));
+	double* e = calloc(n, sizeof(double));
+	double* y = malloc(n * sizeof(double));
+	double* wr = malloc(n * sizeof(double));
+	double* wi = malloc(n * sizeof(double));
+	RitzOrder* ord = malloc(n * sizeof(RitzOrder));
+
+	if (!M || !e || !y || !wr || !wi || !ord) {
+		die("malloc error (dense_eigs)");
+	}
+
+	for (size_t j = 0; j < n; j++) {
+		e[j] = 1.0;
+		mv(e, y, ctx);
+		e[j] = 0.0;
+
+		for (size_t i = 0; i < n; i++) {
+			M[IDX(i, j, n)] = y[i];
+		}
+	}
+
+	int info = LAPACKE_dgeev(LAPACK_ROW_MAJOR, 'N', 'N', (int) n, M,
+		(int) n, wr, wi, NULL, 1, NULL, 1);
+
+	if (info == 0) {
+		for (size_t i = 0; i < n; i++) {
+			ord[i].key = which == ARNOLDI_LARGEST_MODULUS
+				? hypot(wr[i], wi[i]) : wr[i];
+			ord[i].im = wi[i];
+			ord[i].idx = i;
+		}
+
+		qsort(ord, n, sizeof(RitzOrder), cmp_ritz);
+
+		for (size_t i = 0; i < k; i++) {
+			z[i] = wr[ord[i].idx] + wi[ord[i].idx] * I;
+		}
+	}
+
+	free(M);
+	free(e);
+	free(y);
+	free(wr);
+	free(wi);
+	free(ord);
+
+	return info;
+}
+
+int arnoldi_eigs(MatvecFn mv, void* ctx, size_t n, size_t k,
+	ArnoldiWhich which, size_t ncv, double tol, size_t maxit,
+	double complex* z) {
+	if (k == 0 || k > n) {
+		return ARNOLDI_INVALID;
+	}
+
+	size_t m = ncv ? ncv : (2 * k + 1 > 20 ? 2 * k + 1 : 20);
+	m = m < k + 2 ? k + 2 : m;
+
+	if (m >= n) {
+		return dense_eigs(mv, ctx, n, k, which, z);
+	}
+
+	tol = tol > 0.0 ? tol : 1e-10;
+	maxit = maxit ? maxit : 300;
+
+	Arnoldi a = {mv, ctx, n, m, malloc((m + 1) * n * sizeof(double)),
+		calloc(m * m, sizeof(double)), malloc(n * sizeof(double)), 0.0,
+		malloc((m + 1) * sizeof(double)), {{0}}};
+	double* Hc = malloc(m * m * sizeof(double));
+	double* Y = malloc(m * m * sizeof(double));
+	double* Q = malloc(m * m * sizeof(double));
+	double* Qt = malloc(m * m * sizeof(double));
+	double* T = malloc(m * m * sizeof(double));
+	double* tau = malloc(m * sizeof(double));
+	double* wr = malloc(m * sizeof(double));
+	double* wi = malloc(m * sizeof(double));
+	double* Vn = malloc((m + 1) * n * sizeof(double));
+	RitzOrder* ord = malloc(m * sizeof(RitzOrder));
+
+	if (!a.V || !a.H || !a.f || !a.h || !Hc || !Y || !Q || !Qt || !T
+		|| !tau || !wr || !wi || !Vn || !ord) {
+		die("malloc error (arnoldi)");
+	}
+
+	/*semente fixa: resultado reprodutível*/
+	rng_seed(&a.rng, 0x41524e4f4c4449);
+	random_vector(&a, 0);
+	extend(&a, 0);
+
+	int status = ARNOLDI_NO_CONVERGENCE;
+
+	for (size_t it = 0; it <= maxit; it++) {
+		memcpy(Hc, a.H, m * m * sizeof(double));
+		int info = LAPACKE_dgeev(LAPACK_ROW_MAJOR, 'N', 'V', (int) m, Hc,
+			(int) m, wr, wi, NULL, 1, Y, (int) m);
+
+		if (info != 0) {
+			status = info;
+			break;
+		}
+
+		for (size_t i = 0; i < m; i++) {
+			ord[i].key = which == ARNOLDI_LARGEST_MODULUS
+				? hypot(wr[i], wi[i]) : wr[i];
+			ord[i].im = wi[i];
+			ord[i].idx = i;
+		}
+
+		qsort(ord, m, sizeof(RitzOrder), cmp_ritz);
+
+		/*não separar um par conjugado*/
+		size_t keff = k;
+
+		if (wi[ord[k - 1].idx] > 0.0) {
+			keff++;
+		}
+
+		for (size_t i = 0; i < k; i++) {
+			z[i] = wr[ord[i].idx] + wi[ord[i].idx] * I;
+		}
+
+		/*resíduo de Ritz: ‖f‖ |último componente de y|; no par complexo
+		o vetor de dgeev ocupa as colunas c (real) e c + 1 (imag.)*/
+		bool converged = true;
+
+		for (size_t i = 0; i < keff && converged; i++) {
+			size_t c = ord[i].idx;
+			double last;
+
+			if (wi[c] == 0.0) {
+				last = fabs(Y[IDX(m - 1, c, m)]);
+			} else {
+				size_t re = wi[c] > 0.0 ? c : c - 1;
+				last = hypot(Y[IDX(m - 1, re, m)], Y[IDX(m - 1, re + 1, m)]);
+			}
+
+			double theta = hypot(wr[c], wi[c]);
+			double scale = theta > pow(DBL_EPSILON, 2.0 / 3.0) ? theta
+				: pow(DBL_EPSILON, 2.0 / 3.0);
+
+			converged = a.fnorm * last <= tol * scale;
+		}
+
+		if (converged) {
+			status = 0;
+			break;
+		}
+
+		if (it == maxit) {
+			break;
+		}
+
+		info = apply_shifts(&a, wr, wi, ord, keff, T, Q, Qt, tau);
+
+		if (info != 0) {
+			status = info;
+			break;
+		}
+
+		/*V = V T (só as keff + 1 primeiras colunas interessam)*/
+		for (size_t j = 0; j <= keff; j++) {
+			double* v = &Vn[j * n];
+			memset(v, 0, n * sizeof(double));
+
+			for (size_t i = 0; i < m; i++) {
+				double t = T[IDX(i, j, m)];
+
+				if (t == 0.0) {
+					continue;
+				}
+
+				for (size_t r = 0; r < n; r++) {
+					v[r] += t * a.V[i * n + r];
+				}
+			}
+		}
+
+		/*novo resíduo: f = V[keff] H[keff][keff-1] + f T[m-1][keff-1]*/
+		double beta = a.H[IDX(keff, keff - 1, m)];
+		double sigma = T[IDX(m - 1, keff - 1, m)];
+
+		for (size_t r = 0; r < n; r++) {
+			a.f[r] = Vn[keff * n + r] * beta + a.f[r] * sigma;
+		}
+
+		memcpy(a.V, Vn, keff * n * sizeof(double));
+
+		for (size_t i = 0; i < m; i++) {
+			for (size_t j = (i > keff ? 0 : keff); j < m; j++) {
+				a.H[IDX(i, j, m)] = 0.0;
+			}
+		}
+
+		double fnorm = sqrt(dot(a.f, a.f, n));
+
+		if (fnorm <= 1e-14) {
+			a.H[IDX(keff, keff - 1, m)] = 0.0;
+			random_vector(&a, keff);
+		} else {
+			orthogonalize(&a, a.f, keff - 1);
+			fnorm = sqrt(dot(a.f, a.f, n));
+			a.H[IDX(keff, keff - 1, m)] = fnorm;
+
+			for (size_t r = 0; r < n; r++) {
+				a.V[keff * n + r] = a.f[r] / fnorm;
+			}
+		}
+
+		extend(&a, keff);
+	}
+
+	free(a.V);
+	free(a.H);
+	free(a.f);
+	free(a.h);
+	free(Hc);
+	free(Y);
+	free(Q);
+	free(Qt);
+	free(T);
+	free(tau);
+	free(wr);
+	free(wi);
+	free(Vn);
+	free(ord);
+
+	return status;
+}
@@ -0,0 +1,51 @@
+#ifndef KRYLOV_H
+#define KRYLOV_H
+
+/* --- Arnoldi com reinício implícito --- */
+
+/*
+Acha alguns autovalores de uma matriz n x n qualquer (não simétrica)
+conhecendo só o produto y = M x, que o chamador fornece por um
+MatvecFn. Serve para grafos direcionados grandes e esparsos (GraphCSR),
+onde o dgeev denso (O(n³) tempo e O(n²) memória) é inviável.
+
+O algoritmo é o do ARPACK (Sorensen): monta uma base de Krylov de
+ncv vetores, calcula os valores de Ritz pelo dgeev na Hessenberg
+ncv x ncv, e reinicia aplicando os valores de Ritz indesejados como
+deslocamentos (um passo de QR por deslocamento; pares conjugados
+viram um deslocamento duplo real), o que mantém só a parte desejada
+da base sem recomeçar do zero. Custo por reinício: ncv - k produtos
+M x mais O(n ncv²) de ortogonalização.
+
+Os autovalores saem como double complex (complex.h), em ordem
+decrescente do critério pedido; pares conjugados aparecem juntos,
+o de parte imaginária positiva primeiro.
+*/
+
+#include <stddef.h>
+#include <complex.h>
+
+#define ARNOLDI_INVALID -1
+#define ARNOLDI_NO_CONVERGENCE 1
+
+/*y = M x (x e y com n posições)*/
+typedef void (*MatvecFn)(const double* x, double* y, void* ctx);
+
+typedef enum {
+	ARNOLDI_LARGEST_MODULUS,	/* Maiores |λ| (raio espectral)*/
+	ARNOLDI_LARGEST_REAL		/* Maiores Re λ (mais à direita)*/
+} ArnoldiWhich;
+
+
+/*Os k autovalores de M (n x n) escolhidos por which, em z (k
+posições). ncv = tamanho da base (0 = max(2k + 1, 20); no mínimo
+k + 2), tol = tolerância relativa do resíduo de Ritz (0 = 1e-10),
+maxit = n° máximo de reinícios (0 = 300). Se ncv >= n a matriz é
+montada (n produtos) e resolvida pelo dgeev. Retorna 0,
+ARNOLDI_NO_CONVERGENCE (z tem as melhores aproximações),
+ARNOLDI_INVALID (k = 0 ou k > n) ou o info > 0 do LAPACK*/
+int arnoldi_eigs(MatvecFn mv, void* ctx, size_t n, size_t k,
+	ArnoldiWhich which, size_t ncv, double tol, size_t maxit,
+	double complex* z);
+
+#endif
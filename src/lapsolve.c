@@ -0,0 +1,965 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <lapacke.h>
+#include "lapsolve.h"
+#include "eig.h"
+
+typedef struct {
+	const GraphCSR* c;
+	GraphCSR* own;		/* c, quando montado a partir de um Graph*/
+	size_t n;
+	double* deg;		/* grau com peso (Jacobi)*/
+	size_t* comp;		/* componente de cada vértice*/
+	size_t ncomp;
+	double* comp_size;
+	GraphPrecond pc;
+	size_t* order;		/* floresta: ordem de BFS a partir das raízes*/
+	size_t* parent;		/* SIZE_MAX nas raízes*/
+	double* pw;			/* peso da aresta v - parent[v]*/
+} LapSystem;
+
+static void* xmalloc(size_t bytes) {
+	void* p = malloc(bytes ? bytes : 1);
+
+	if (!p) {
+		die("malloc error (lapsolve)");
+	}
+
+	return p;
+}
+
+
+/* --- Floresta geradora de peso máximo (precondicionador) --- */
+
+typedef struct {
+	double w;
+	size_t u, v;
+} WEdge;
+
+static int cmp_wedge_desc(const void* a, const void* b) {
+	double x = ((const WEdge*) a)->w, y = ((const WEdge*) b)->w;
+
+	return (x < y) - (x > y);
+}
+
+static size_t uf_find(size_t* uf, size_t x) {
+	while (uf[x] != x) {
+		uf[x] = uf[uf[x]];
+		x = uf[x];
+	}
+
+	return x;
+}
+
+static void build_tree(LapSystem* s) {
+	const GraphCSR* c = s->c;
+	size_t n = s->n;
+	size_t m = 0;
+	WEdge* edges = xmalloc(c->rowptr[n] * sizeof(WEdge));
+
+	for (size_t u = 0; u < n; u++) {
+		for (size_t e = c->rowptr[u]; e < c->rowptr[u + 1]; e++) {
+			if (u < c->col[e]) {
+				edges[m++] = (WEdge) {CSR_W(c, e), u, c->col[e]};
+			}
+		}
+	}
+
+	qsort(edges, m, sizeof(WEdge), cmp_wedge_desc);
+
+	/*Kruskal; a floresta fica numa lista de adjacência compacta*/
+	size_t* uf = xmalloc(n * sizeof(size_t));
+	size_t* tdeg = calloc(n + 1, sizeof(size_t));
+	WEdge* tree = xmalloc(n * sizeof(WEdge));
+	size_t nt = 0;
+
+	if (!tdeg) {
+		die("malloc error (tdeg)");
+	}
+
+	for (size_t v = 0; v < n; v++) {
+		uf[v] = v;
+	}
+
+	for (size_t i = 0; i < m; i++) {
+		size_t a = uf_find(uf, edges[i].u), b = uf_find(uf, edges[i].v);
+
+		if (a != b) {
+			uf[a] = b;
+			tree[nt++] = edges[i];
+			tdeg[edges[i].u + 1]++;
+			tdeg[edges[i].v + 1]++;
+		}
+	}
+
+	for (size_t v = 0; v < n; v++) {
+		tdeg[v + 1] += tdeg[v];
+	}
+
+	size_t* adj = xmalloc(2 * nt * sizeof(size_t));
+	double* adjw = xmalloc(2 * nt * sizeof(double));
+	size_t* fill = xmalloc((n + 1) * sizeof(size_t));
+	memcpy(fill, tdeg, (n + 1) * sizeof(size_t));
+
+	for (size_t i = 0; i < nt; i++) {
+		adj[fill[tree[i].u]] = tree[i].v;
+		adjw[fill[tree[i].u]++] = tree[i].w;
+		adj[fill[tree[i].v]] = tree[i].u;
+		adjw[fill[tree[i].v]++] = tree[i].w;
+	}
+
+	/*BFS para enraizar cada árvore*/
+	s->order = xmalloc(n * sizeof(size_t));
+	s->parent = xmalloc(n * sizeof(size_t));
+	s->pw = xmalloc(n * sizeof(double));
+	bool* seen = calloc(n + 1, sizeof(bool));
+
+	if (!seen) {
+		die("malloc error (seen)");
+	}
+
+	size_t tail = 0;
+
+	for (size_t r = 0; r < n; r++) {
+		if (seen[r]) {
+			continue;
+		}
+
+		size_t head = tail;
+		s->order[tail++] = r;
+		s->parent[r] = SIZE_MAX;
+		seen[r] = true;
+
+		while (head < tail) {
+			size_t u = s->order[head++];
+
+			for (size_t k = tdeg[u]; k < tdeg[u + 1]; k++) {
+				size_t v = adj[k];
+
+				if (!seen[v]) {
+					seen[v] = true;
+					s->parent[v] = u;
+					s->pw[v] = adjw[k];
+					s->order[tail++] = v;
+				}
+			}
+		}
+	}
+
+	free(edges);
+	free(uf);
+	free(tdeg);
+	free(tree);
+	free(adj);
+	free(adjw);
+	free(fill);
+	free(seen);
+}
+
+
+/* --- Sistema --- */
+
+/*Monta o sistema direto do CSR (sem cópia): O(n + m)*/
+static int system_init_csr(LapSystem* s, const GraphCSR* c,
+	GraphPrecond pc) {
+	size_t n = c->n;
+
+	if (c->directed) {
+		return LAPSOLVE_INVALID;
+	}
+
+	for (size_t e = 0; c->w && e < c->rowptr[n]; e++) {
+		if (c->w[e] < 0.0) {
+			return LAPSOLVE_INVALID;
+		}
+	}
+
+	memset(s, 0, sizeof(LapSystem));
+	s->c = c;
+	s->n = n;
+	s->pc = pc;
+	s->deg = xmalloc(n * sizeof(double));
+	s->comp = xmalloc(n * sizeof(size_t));
+	size_t* queue = xmalloc(n * sizeof(size_t));
+
+	/*laços não entram na laplaciana*/
+	for (size_t u = 0; u < n; u++) {
+		s->deg[u] = 0.0;
+
+		for (size_t e = s->c->rowptr[u]; e < s->c->rowptr[u + 1]; e++) {
+			if (s->c->col[e] != u) {
+				s->deg[u] += CSR_W(s->c, e);
+			}
+		}
+
+		s->comp[u] = SIZE_MAX;
+	}
+
+	for (size_t r = 0; r < n; r++) {
+		if (s->comp[r] != SIZE_MAX) {
+			continue;
+		}
+
+		size_t head = 0, tail = 0;
+		queue[tail++] = r;
+		s->comp[r] = s->ncomp;
+
+		while (head < tail) {
+			size_t u = queue[head++];
+
+			for (size_t e = s->c->rowptr[u]; e < s->c->rowptr[u + 1]; e++) {
+				size_t v = s->c->col[e];
+
+				if (s->comp[v] == SIZE_MAX) {
+					s->comp[v] = s->ncomp;
+					queue[tail++] = v;
+				}
+			}
+		}
+
+		s->ncomp++;
+	}
+
+	free(queue);
+	s->comp_size = calloc(s->ncomp + 1, sizeof(double));
+
+	if (!s->comp_size) {
+		die("malloc error (comp_size)");
+	}
+
+	for (size_t v = 0; v < n; v++) {
+		s->comp_size[s->comp[v]] += 1.0;
+	}
+
+	if (pc == GRAPH_PRECOND_TREE) {
+		build_tree(s);
+	}
+
+	return 0;
+}
+
+/*Confere g em O(n²) e converte para CSR*/
+static int system_init(LapSystem* s, const Graph* g, GraphPrecond pc) {
+	if (g->directed) {
+		return LAPSOLVE_INVALID;
+	}
+
+	for (size_t i = 0; i < g->n * g->n; i++) {
+		if (g->A[i] < 0.0) {
+			return LAPSOLVE_INVALID;
+		}
+	}
+
+	GraphCSR* c = graph_csr_from_graph(g);
+	int info = system_init_csr(s, c, pc);
+
+	if (info != 0) {
+		graph_csr_free(c);
+		return info;
+	}
+
+	s->own = c;
+
+	return 0;
+}
+
+static void system_free(LapSystem* s) {
+	graph_csr_free(s->own);
+	free(s->deg);
+	free(s->comp);
+	free(s->comp_size);
+	free(s->order);
+	free(s->parent);
+	free(s->pw);
+}
+
+/*Y = L X (n x k)*/
+static void lap_mult(const LapSystem* s, const double* X, double* Y,
+	size_t k) {
+	const GraphCSR* c = s->c;
+
+	for (size_t u = 0; u < s->n; u++) {
+		double* y = &Y[IDX(u, 0, k)];
+		const double* xu = &X[IDX(u, 0, k)];
+
+		memset(y, 0, k * sizeof(double));
+
+		for (size_t e = c->rowptr[u]; e < c->rowptr[u + 1]; e++) {
+			const double* xv = &X[IDX(c->col[e], 0, k)];
+			double w = CSR_W(c, e);
+
+			for (size_t j = 0; j < k; j++) {
+				y[j] += w * (xu[j] - xv[j]);
+			}
+		}
+	}
+}
+
+/*Tira a média de cada coluna em cada componente (projeta fora do
+núcleo de L)*/
+static void project(const LapSystem* s, double* X, size_t k) {
+	double* sum = calloc(s->ncomp * k + 1, sizeof(double));
+
+	if (!sum) {
+		die("malloc error (sum)");
+	}
+
+	for (size_t v = 0; v < s->n; v++) {
+		for (size_t j = 0; j < k; j++) {
+			sum[IDX(s->comp[v], j, k)] += X[IDX(v, j, k)];
+		}
+	}
+
+	for (size_t v = 0; v < s->n; v++) {
+		double sz = s->comp_size[s->comp[v]];
+
+		for (size_t j = 0; j < k; j++) {
+			X[IDX(v, j, k)] -= sum[IDX(s->comp[v], j, k)] / sz;
+		}
+	}
+
+	free(sum);
+}
+
+/*Z = M⁻¹ R*/
+static void precondition(const LapSystem* s, const double* R, double* Z,
+	size_t k) {
+	size_t n = s->n;
+
+	switch (s->pc) {
+	case GRAPH_PRECOND_NONE:
+		memcpy(Z, R, n * k * sizeof(double));
+		break;
+
+	case GRAPH_PRECOND_JACOBI:
+		for (size_t v = 0; v < n; v++) {
+			double d = s->deg[v] > 0.0 ? 1.0 / s->deg[v] : 0.0;
+
+			for (size_t j = 0; j < k; j++) {
+				Z[IDX(v, j, k)] = d * R[IDX(v, j, k)];
+			}
+		}
+		break;
+
+	case GRAPH_PRECOND_TREE: {
+		/*elimina folhas: acc[v] = soma de R na subárvore de v, que é o
+		fluxo pela aresta v - parent[v]; depois desce fixando a raiz em 0*/
+		double* acc = xmalloc(n * k * sizeof(double));
+		memcpy(acc, R, n * k * sizeof(double));
+
+		for (size_t i = n; i-- > 0;) {
+			size_t v = s->order[i], p = s->parent[v];
+
+			if (p != SIZE_MAX) {
+				for (size_t j = 0; j < k; j++) {
+					acc[IDX(p, j, k)] += acc[IDX(v, j, k)];
+				}
+			}
+		}
+
+		for (size_t i = 0; i < n; i++) {
+			size_t v = s->order[i], p = s->parent[v];
+
+			for (size_t j = 0; j < k; j++) {
+				Z[IDX(v, j, k)] = (p == SIZE_MAX) ? 0.0
+					: Z[IDX(p, j, k)] + acc[IDX(v, j, k)] / s->pw[v];
+			}
+		}
+
+		free(acc);
+		break;
+	}
+	}
+
+	project(s, Z, k);
+}
+
+/*out[j] = <X[:, j], Y[:, j]>*/
+static void col_dots(const double* X, const double* Y, size_t n, size_t k,
+	double* out) {
+	memset(out, 0, k * sizeof(double));
+
+	for (size_t v = 0; v < n; v++) {
+		for (size_t j = 0; j < k; j++) {
+			out[j] += X[IDX(v, j, k)] * Y[IDX(v, j, k)];
+		}
+	}
+}
+
+/*PCG em lote: cada coluna tem seus próprios alpha/beta, mas L P é
+calculado de uma vez para todas*/
+static int pcg(const LapSystem* s, const double* B, size_t k, double* X,
+	double tol) {
+	size_t n = s->n, nk = n * k;
+
+	if (nk == 0) {
+		return 0;
+	}
+
+	double* R = xmalloc(nk * sizeof(double));
+	double* Z = xmalloc(nk * sizeof(double));
+	double* P = xmalloc(nk * sizeof(double));
+	double* Q = xmalloc(nk * sizeof(double));
+	double* rz = xmalloc(k * sizeof(double));
+	double* tmp = xmalloc(k * sizeof(double));
+	double* bnorm = xmalloc(k * sizeof(double));
+	bool* done = xmalloc(k * sizeof(bool));
+
+	memcpy(R, B, nk * sizeof(double));
+	project(s, R, k);
+	memset(X, 0, nk * sizeof(double));
+	col_dots(R, R, n, k, bnorm);
+
+	size_t active = 0;
+
+	for (size_t j = 0; j < k; j++) {
+		bnorm[j] = sqrt(bnorm[j]);
+		done[j] = bnorm[j] == 0.0;
+		active += !done[j];
+	}
+
+	precondition(s, R, Z, k);
+	memcpy(P, Z, nk * sizeof(double));
+	col_dots(R, Z, n, k, rz);
+
+	size_t maxit = 4 * n + 100;
+
+	for (size_t it = 0; it < maxit && active > 0; it++) {
+		lap_mult(s, P, Q, k);
+		col_dots(P, Q, n, k, tmp);
+
+		for (size_t v = 0; v < n; v++) {
+			for (size_t j = 0; j < k; j++) {
+				if (!done[j] && tmp[j] > 0.0) {
+					double alpha = rz[j] / tmp[j];
+					X[IDX(v, j, k)] += alpha * P[IDX(v, j, k)];
+					R[IDX(v, j, k)] -= alpha * Q[IDX(v, j, k)];
+				}
+			}
+		}
+
+		col_dots(R, R, n, k, tmp);
+
+		for (size_t j = 0; j < k; j++) {
+			if (!done[j] && sqrt(tmp[j]) <= tol * bnorm[j]) {
+				done[j] = true;
+				active--;
+			}
+		}
+
+		precondition(s, R, Z, k);
+		col_dots(R, Z, n, k, tmp);
+
+		for (size_t j = 0; j < k; j++) {
+			double beta = (!done[j] && rz[j] != 0.0) ? tmp[j] / rz[j] : 0.0;
+			rz[j] = tmp[j];
+			tmp[j] = beta;
+		}
+
+		for (size_t v = 0; v < n; v++) {
+			for (size_t j = 0; j < k; j++) {
+				if (!done[j]) {
+					P[IDX(v, j, k)] = Z[IDX(v, j, k)] + tmp[j] * P[IDX(v, j, k)];
+				}
+			}
+		}
+	}
+
+	project(s, X, k);
+
+	free(R);
+	free(Z);
+	free(P);
+	free(Q);
+	free(rz);
+	free(tmp);
+	free(bnorm);
+	free(done);
+
+	return active > 0 ? LAPSOLVE_NO_CONVERGENCE : 0;
+}
+
+
+/*(e_u - e_v)ᵀ L⁺ (e_u - e_v) num sistema já montado*/
+static double system_resistance(const LapSystem* s, size_t u, size_t v) {
+	size_t n = s->n;
+
+	if (u >= n || v >= n) {
+		die("vértice fora do intervalo");
+	}
+
+	if (s->comp[u] != s->comp[v]) {
+		return INFINITY;
+	}
+
+	if (u == v) {
+		return 0.0;
+	}
+
+	double* b = calloc(n, sizeof(double));
+	double* x = xmalloc(n * sizeof(double));
+
+	if (!b) {
+		die("malloc error (b)");
+	}
+
+	b[u] = 1.0;
+	b[v] = -1.0;
+	pcg(s, b, 1, x, LAPSOLVE_TOL);
+	double r = x[u] - x[v];
+
+	free(b);
+	free(x);
+
+	return r;
+}
+
+
+/* --- Interface --- */
+
+int graph_laplacian_solve_batch(const Graph* g, const double* B, size_t k,
+	double* X, GraphPrecond pc, double tol) {
+	LapSystem s;
+	int info = system_init(&s, g, pc);
+
+	if (info != 0) {
+		return info;
+	}
+
+	info = pcg(&s, B, k, X, tol > 0.0 ? tol : LAPSOLVE_TOL);
+	system_free(&s);
+
+	return info;
+}
+
+int graph_laplacian_solve(const Graph* g, const double* b, double* x) {
+	return graph_laplacian_solve_batch(g, b, 1, x, GRAPH_PRECOND_JACOBI,
+		LAPSOLVE_TOL);
+}
+
+int graph_csr_laplacian_solve_batch(const GraphCSR* c, const double* B,
+	size_t k, double* X, GraphPrecond pc, double tol) {
+	LapSystem s;
+	int info = system_init_csr(&s, c, pc);
+
+	if (info != 0) {
+		return info;
+	}
+
+	info = pcg(&s, B, k, X, tol > 0.0 ? tol : LAPSOLVE_TOL);
+	system_free(&s);
+
+	return info;
+}
+
+int graph_csr_laplacian_solve(const GraphCSR* c, const double* b,
+	double* x) {
+	return graph_csr_laplacian_solve_batch(c, b, 1, x, GRAPH_PRECOND_JACOBI,
+		LAPSOLVE_TOL);
+}
+
+double graph_effective_resistance(const Graph* g, size_t u, size_t v) {
+	if (u >= g->n || v >= g->n) {
+		die("vértice fora do intervalo");
+	}
+
+	LapSystem s;
+
+	if (system_init(&s, g, GRAPH_PRECOND_JACOBI) != 0) {
+		return NAN;
+	}
+
+	double r = system_resistance(&s, u, v);
+	system_free(&s);
+
+	return r;
+}
+
+double graph_csr_effective_resistance(const GraphCSR* c, size_t u,
+	size_t v) {
+	LapSystem s;
+
+	if (system_init_csr(&s, c, GRAPH_PRECOND_JACOBI) != 0) {
+		return NAN;
+	}
+
+	double r = system_resistance(&s, u, v);
+	system_free(&s);
+
+	return r;
+}
+
+double graph_kirchhoff_index(const Graph* g) {
+	size_t n = g->n;
+
+	if (!graph_is_connected(g)) {
+		return INFINITY;
+	}
+
+	double* mu = xmalloc(n * sizeof(double));
+
+	if (graph_spec_lap(g, mu) != 0) {
+		free(mu);
+		return NAN;
+	}
+
+	/*mu[0] = 0 é o único autovalor nulo (g é conexo)*/
+	double kf = 0.0;
+
+	for (size_t i = 1; i < n; i++) {
+		kf += 1.0 / mu[i];
+	}
+
+	free(mu);
+
+	return (double) n * kf;
+}
+
+/*Sinal ±1 da direção j: 64 sinais por sorteio de rng, ou rand()*/
+static inline bool rand_sign(Rng* rng, size_t j, uint64_t* bits) {
+	if (!rng) {
+		return rand() & 1;
+	}
+
+	if (j % 64 == 0) {
+		*bits = rng_next(rng);
+	}
+
+	return (*bits >> (j % 64)) & 1;
+}
+
+static int resistances_approx(const Graph* g, double eps, Rng* rng,
+	double* r) {
+	size_t n = g->n;
+
+	if (eps <= 0.0) {
+		return LAPSOLVE_INVALID;
+	}
+
+	LapSystem s;
+	int info = system_init(&s, g, GRAPH_PRECOND_JACOBI);
+
+	if (info != 0) {
+		return info;
+	}
+
+	/*Y = Q W^{1/2} B com Q k x m de ±1/√k; guardamos Yᵀ (n x k)*/
+	size_t k = (size_t) ceil(24.0 * log((double) (n > 2 ? n : 2))
+		/ (eps * eps));
+	double scale = 1.0 / sqrt((double) k);
+	double* Y = calloc(n * k, sizeof(double));
+	double* Z = xmalloc(n * k * sizeof(double));
+	uint64_t bits = 0;
+
+	if (!Y) {
+		die("malloc error (Y)");
+	}
+
+	for (size_t u = 0; u < n; u++) {
+		for (size_t v = u + 1; v < n; v++) {
+			double w = g->A[IDX(u, v, n)];
+
+			if (w == 0.0) {
+				continue;
+			}
+
+			double sw = sqrt(w) * scale;
+
+			for (size_t j = 0; j < k; j++) {
+				double q = rand_sign(rng, j, &bits) ? sw : -sw;
+				Y[IDX(u, j, k)] += q;
+				Y[IDX(v, j, k)] -= q;
+			}
+		}
+	}
+
+	/*R(u, v) ≈ ||Z(u, :) - Z(v, :)||² com Z = L⁺ Yᵀ*/
+	info = pcg(&s, Y, k, Z, 1e-6);
+
+	for (size_t u = 0, e = 0; u < n; u++) {
+		for (size_t v = u + 1; v < n; v++) {
+			if (g->A[IDX(u, v, n)] == 0.0) {
+				continue;
+			}
+
+			double d = 0.0;
+
+			for (size_t j = 0; j < k; j++) {
+				double t = Z[IDX(u, j, k)] - Z[IDX(v, j, k)];
+				d += t * t;
+			}
+
+			r[e++] = d;
+		}
+	}
+
+	free(Y);
+	free(Z);
+	system_free(&s);
+
+	return info;
+}
+
+int graph_edge_resistances_approx(const Graph* g, double eps, double* r) {
+	return resistances_approx(g, eps, NULL, r);
+}
+
+
+/* --- Esparsificação espectral --- */
+
+/*Precisão das resistências usadas para sortear: basta uma aproximação
+grosseira, o erro entra só nas probabilidades*/
+#define SPARSIFY_RES_EPS 1.0
+
+/*p_e = min(1, SPARSIFY_C w_e R_e log n / eps²). Bem abaixo da
+constante do teorema de Spielman-Srivastava: escolhida pelo teste,
+o fator (1 ± eps) resultante é empírico*/
+#define SPARSIFY_C 4.0
+
+GraphCSR* graph_sparsify(const Graph* g, double eps, GraphSparsifier how) {
+	return graph_sparsify_r(g, eps, how, NULL);
+}
+
+GraphCSR* graph_sparsify_r(const Graph* g, double eps, GraphSparsifier how,
+	Rng* rng) {
+	size_t n = g->n, m = 0;
+
+	if (g->directed || eps <= 0.0) {
+		return NULL;
+	}
+
+	for (size_t u = 0; u < n; u++) {
+		for (size_t v = u + 1; v < n; v++) {
+			if (g->A[IDX(u, v, n)] < 0.0) {
+				return NULL;
+			}
+
+			m += g->A[IDX(u, v, n)] != 0.0;
+		}
+	}
+
+	/*r[e]: resistência (ou a estimativa pelos graus) de cada aresta, na
+	ordem da parte triangular superior*/
+	double* r = xmalloc(m * sizeof(double));
+
+	if (how == GRAPH_SPARSIFY_RESISTANCE) {
+		if (resistances_approx(g, SPARSIFY_RES_EPS, rng, r)
+			== LAPSOLVE_INVALID) {
+			free(r);
+			return NULL;
+		}
+	} else {
+		double* deg = calloc(n + 1, sizeof(double));
+
+		if (!deg) {
+			die("malloc error (deg)");
+		}
+
+		for (size_t u = 0; u < n; u++) {
+			for (size_t v = 0; v < n; v++) {
+				deg[u] += v != u ? g->A[IDX(u, v, n)] : 0.0;
+			}
+		}
+
+		for (size_t u = 0, e = 0; u < n; u++) {
+			for (size_t v = u + 1; v < n; v++) {
+				if (g->A[IDX(u, v, n)] != 0.0) {
+					r[e++] = 1.0 / deg[u] + 1.0 / deg[v];
+				}
+			}
+		}
+
+		free(deg);
+	}
+
+	/*primeira passada sorteia e conta, a segunda preenche*/
+	double c = SPARSIFY_C * log((double) (n > 2 ? n : 2)) / (eps * eps);
+	double* kept = xmalloc(m * sizeof(double));		/* Peso novo (0 = fora)*/
+	GraphCSR* h = calloc(1, sizeof(GraphCSR));
+
+	if (!h) {
+		die("malloc error (GraphCSR)");
+	}
+
+	h->n = n;
+	h->directed = false;
+	h->rowptr = calloc(n + 1, sizeof(size_t));
+
+	if (!h->rowptr) {
+		die("malloc error (rowptr)");
+	}
+
+	for (size_t u = 0, e = 0; u < n; u++) {
+		for (size_t v = u + 1; v < n; v++) {
+			double w = g->A[IDX(u, v, n)];
+
+			if (w == 0.0) {
+				continue;
+			}
+
+			double p = c * w * r[e];
+			kept[e] = 0.0;
+
+			if (p >= 1.0 || rng_uniform_or_rand(rng) < p) {
+				kept[e] = p >= 1.0 ? w : w / p;
+				h->rowptr[u + 1]++;
+				h->rowptr[v + 1]++;
+			}
+
+			e++;
+		}
+	}
+
+	for (size_t u = 0; u < n; u++) {
+		h->rowptr[u + 1] += h->rowptr[u];
+	}
+
+	/*percorrendo u crescente, cada linha também sai crescente*/
+	size_t* pos = xmalloc((n + 1) * sizeof(size_t));
+	memcpy(pos, h->rowptr, (n + 1) * sizeof(size_t));
+	h->col = xmalloc(h->rowptr[n] * sizeof(size_t));
+	h->w = xmalloc(h->rowptr[n] * sizeof(double));
+
+	for (size_t u = 0, e = 0; u < n; u++) {
+		for (size_t v = u + 1; v < n; v++) {
+			if (g->A[IDX(u, v, n)] == 0.0) {
+				continue;
+			}
+
+			if (kept[e] != 0.0) {
+				h->col[pos[u]] = v;
+				h->w[pos[u]++] = kept[e];
+				h->col[pos[v]] = u;
+				h->w[pos[v]++] = kept[e];
+			}
+
+			e++;
+		}
+	}
+
+	free(pos);
+	free(kept);
+	free(r);
+
+	return h;
+}
+
+/*Lanczos no produto interno <x, y>_G = xᵀ L_G y com o operador
+L_G⁺ L_H, que é autoadjunto nele: cada etapa é um produto por L_H e um
+PCG em G. Reortogonaliza contra toda a base (duas passadas), então T
+fica confiável mesmo com autovalores repetidos*/
+int graph_csr_spectral_distortion(const GraphCSR* g, const GraphCSR* h,
+	size_t steps, Rng* rng, double* lo, double* hi) {
+	size_t n = g->n;
+
+	if (h->n != n || steps == 0) {
+		return LAPSOLVE_INVALID;
+	}
+
+	LapSystem sg, sh;
+	int info = system_init_csr(&sg, g, GRAPH_PRECOND_JACOBI);
+
+	if (info != 0) {
+		return info;
+	}
+
+	info = system_init_csr(&sh, h, GRAPH_PRECOND_NONE);
+
+	if (info != 0) {
+		system_free(&sg);
+		return info;
+	}
+
+	double* V = xmalloc((steps + 1) * n * sizeof(double));
+	double* GV = xmalloc((steps + 1) * n * sizeof(double));
+	double* z = xmalloc(n * sizeof(double));
+	double* alpha = xmalloc(steps * sizeof(double));
+	double* beta = xmalloc(steps * sizeof(double));
+	double norm = 0.0;
+	size_t k = 0;
+
+	for (size_t v = 0; v < n; v++) {
+		V[v] = rng_uniform_or_rand(rng) - 0.5;
+	}
+
+	project(&sg, V, 1);
+	lap_mult(&sg, V, GV, 1);
+	col_dots(V, GV, n, 1, &norm);
+
+	/*sem arestas em G não há range(L_G) a comparar*/
+	if (norm <= 0.0) {
+		info = LAPSOLVE_INVALID;
+	}
+
+	for (size_t v = 0; v < n && info == 0; v++) {
+		V[v] /= sqrt(norm);
+		GV[v] /= sqrt(norm);
+	}
+
+	while (info == 0 && k < steps) {
+		double* v = &V[k * n];
+		double* w = &V[(k + 1) * n];
+		double* gw = &GV[(k + 1) * n];
+		double a, b = 0.0;
+
+		lap_mult(&sh, v, z, 1);
+		col_dots(z, v, n, 1, &a);
+
+		if (pcg(&sg, z, 1, w, LAPSOLVE_TOL) != 0) {
+			info = LAPSOLVE_NO_CONVERGENCE;
+			break;
+		}
+
+		for (int pass = 0; pass < 2; pass++) {
+			for (size_t i = 0; i <= k; i++) {
+				double c;
+				col_dots(w, &GV[i * n], n, 1, &c);
+
+				for (size_t u = 0; u < n; u++) {
+					w[u] -= c * V[i * n + u];
+				}
+			}
+		}
+
+		/*depois do cancelamento w é pequeno: sem projetar, um resto
+		constante estragaria as diferenças em lap_mult*/
+		project(&sg, w, 1);
+		lap_mult(&sg, w, gw, 1);
+		col_dots(w, gw, n, 1, &b);
+		b = sqrt(fmax(b, 0.0));
+		alpha[k] = a;
+		beta[k++] = b;
+
+		/*subespaço invariante (a menos do erro do PCG): os valores de
+		Ritz já são exatos*/
+		if (b <= 1e-8 * fabs(a)) {
+			break;
+		}
+
+		for (size_t u = 0; u < n; u++) {
+			w[u] /= b;
+			gw[u] /= b;
+		}
+	}
+
+	if (info == 0 && LAPACKE_dstev(LAPACK_ROW_MAJOR, 'N', (int) k, alpha,
+		beta, NULL, 1) != 0) {
+		info = LAPSOLVE_NO_CONVERGENCE;
+	}
+
+	if (info == 0) {
+		*lo = alpha[0];
+		*hi = alpha[k - 1];
+	}
+
+	free(V);
+	free(GV);
+	free(z);
+	free(alpha);
+	free(beta);
+	system_free(&sg);
+	system_free(&sh);
+
+	return info;
+}
@@ -0,0 +1,137 @@
+#ifndef LAPSOLVE_H
+#define LAPSOLVE_H
+
+/* --- Sistemas com a laplaciana e resistência efetiva --- */
+
+/*
+L = D - A é singular: o núcleo tem um vetor constante por componente.
+graph_laplacian_solve resolve L x = b por gradiente conjugado
+precondicionado (PCG) na representação esparsa, projetando b e cada
+iterado no complemento do núcleo (soma zero em cada componente).
+O resultado é x = L⁺ b, o produto pela pseudo-inversa, sem nunca
+montar L⁺ (que custaria O(n³)).
+
+Precondicionadores:
+- Jacobi: a diagonal D;
+- árvore: uma floresta geradora de peso máximo (Kruskal), cuja
+  laplaciana é resolvida exatamente em O(n) eliminando folhas. Ajuda
+  bastante em grafos com pesos muito diferentes ou diâmetro grande.
+
+A versão em lote resolve k lados direitos juntos: cada coluna tem o
+seu próprio PCG, mas o produto pela laplaciana percorre o grafo uma
+vez só para todas.
+
+Só vale para grafos não direcionados com pesos > 0.
+
+Esparsificação (Spielman-Srivastava): num grafo denso cada produto por
+L custa O(n²). graph_sparsify mantém a aresta e com probabilidade
+p_e = min(1, C w_e R_e log n / eps²) e peso w_e / p_e. Como Σ w_e R_e =
+n - (n° de componentes), sobram O(n log n / eps²) arestas em média.
+O teorema garante, com alta probabilidade, (1 - eps) xᵀ L_G x <=
+xᵀ L_H x <= (1 + eps) xᵀ L_G x para todo x, mas com um C bem maior,
+que em grafos densos manteria quase todas as arestas. Aqui C = 4 e as
+resistências são só grosseiras (SPARSIFY_RES_EPS), então o fator
+(1 ± eps) é heurístico: foi ajustado pelo teste (em G(1500, 1/2) com
+eps = 0.5 o espectro de H fica a ~22% do de G), não é uma garantia.
+Para saber o fator realmente atingido por um H,
+graph_csr_spectral_distortion mede os extremos de xᵀ L_H x / xᵀ L_G x.
+H é um GraphCSR: resolva nele com as funções graph_csr_* acima, sem
+voltar à matriz densa. R_e vem de
+graph_edge_resistances_approx; para grafos quase regulares (como
+graph_random(n, p) ou K_n) a estimativa 1/d_u + 1/d_v pelos graus é
+quase exata e dispensa os sistemas lineares.
+*/
+
+#include "graphs.h"
+#include "rng.h"
+
+/*Códigos de erro (0 = ok)*/
+#define LAPSOLVE_INVALID (-1)		/* Grafo direcionado ou peso <= 0*/
+#define LAPSOLVE_NO_CONVERGENCE 1	/* Estourou maxit (x = último iterado)*/
+
+/*Tolerância padrão: ||b - Lx|| <= tol ||b||*/
+#define LAPSOLVE_TOL 1e-10
+
+typedef enum {
+	GRAPH_PRECOND_NONE,
+	GRAPH_PRECOND_JACOBI,
+	GRAPH_PRECOND_TREE
+} GraphPrecond;
+
+
+/*x = L⁺ b (Jacobi, tolerância LAPSOLVE_TOL)*/
+int graph_laplacian_solve(const Graph* g, const double* b, double* x);
+
+
+/*X = L⁺ B para k lados direitos. B e X são n x k (row-major, coluna j
+= lado direito j). tol <= 0 usa LAPSOLVE_TOL*/
+int graph_laplacian_solve_batch(const Graph* g, const double* B, size_t k,
+	double* X, GraphPrecond pc, double tol);
+
+
+/*Resistência efetiva entre u e v: (e_u - e_v)ᵀ L⁺ (e_u - e_v).
+INFINITY se estiverem em componentes diferentes, NAN se o grafo for
+inválido*/
+double graph_effective_resistance(const Graph* g, size_t u, size_t v);
+
+
+/*As mesmas três direto do CSR (cada aresta nas duas linhas, como em
+graph_csr_from_graph ou graph_sparsify): o sistema é montado em
+O(n + m), sem a varredura O(n²) da matriz densa*/
+int graph_csr_laplacian_solve(const GraphCSR* c, const double* b,
+	double* x);
+
+int graph_csr_laplacian_solve_batch(const GraphCSR* c, const double* B,
+	size_t k, double* X, GraphPrecond pc, double tol);
+
+double graph_csr_effective_resistance(const GraphCSR* c, size_t u,
+	size_t v);
+
+
+/*Índice de Kirchhoff: soma das resistências de todos os pares,
+n Σ 1/μ_i (μ_i > 0 autovalores da laplaciana). INFINITY se g for
+desconexo*/
+double graph_kirchhoff_index(const Graph* g);
+
+
+/*Aproxima a resistência efetiva de todas as arestas com erro relativo
+~eps (Spielman-Srivastava): projeta W^{1/2} B (m x n) em
+k = O(log n / eps²) direções aleatórias ±1 e resolve k sistemas em
+lote. r deve ter graph_num_nonloop_edges(g) posições (laços não têm
+resistência), com as arestas na ordem da parte triangular superior de
+A (linha a linha), como em graph_line_graph. Usa rand()*/
+int graph_edge_resistances_approx(const Graph* g, double eps, double* r);
+
+
+
+typedef enum {
+	GRAPH_SPARSIFY_RESISTANCE,	/* R_e aproximada (PCG em lote)*/
+	GRAPH_SPARSIFY_DEGREE		/* R_e ≈ 1/d_u + 1/d_v (uniforme se regular)*/
+} GraphSparsifier;
+
+
+/*H esparso, com pesos, que aproxima a laplaciana de g a um fator
+~(1 ± eps) (0 < eps < 1; heurístico, veja acima). NULL se g for direcionado ou tiver peso < 0.
+Usa rand()*/
+GraphCSR* graph_sparsify(const Graph* g, double eps, GraphSparsifier how);
+
+
+/*O mesmo sorteando com rng (NULL usa rand())*/
+GraphCSR* graph_sparsify_r(const Graph* g, double eps, GraphSparsifier how,
+	Rng* rng);
+
+
+/*Distorção atingida por H em relação a g: lo <= hi estimam o menor e o
+maior valor de xᵀ L_H x / xᵀ L_G x em range(L_G), isto é, os extremos
+dos autovalores de L_G^{-1/2} L_H L_G^{-1/2} restrita a range(L_G). H
+aproxima g a (1 ± eps) exatamente quando 1 - eps <= lo e hi <= 1 + eps.
+Faz steps etapas de Lanczos (cada uma um PCG em g; ~30 bastam): os
+valores de Ritz ficam sempre dentro do intervalo verdadeiro, então com
+poucas etapas a distorção é subestimada. LAPSOLVE_INVALID se os
+tamanhos diferirem, um dos dois for direcionado ou tiver peso < 0, ou
+g não tiver arestas; LAPSOLVE_NO_CONVERGENCE se um PCG falhar. Sorteia
+o vetor inicial com rng (NULL usa rand())*/
+int graph_csr_spectral_distortion(const GraphCSR* g, const GraphCSR* h,
+	size_t steps, Rng* rng, double* lo, double* hi);
+
+#endif
@@ -0,0 +1,925 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <float.h>
+#include <math.h>
+#include <pthread.h>
+#include <lapacke.h>
+#include "matfun.h"
+#include "rng.h"
+
+/*O operador: M = A ou, para a energia, M = A² (dois produtos). Com
+k > 0, M é restrita ao complemento dos autovetores V (k x n)*/
+typedef struct {
+	MatvecFn mv;
+	void* ctx;
+	bool square;
+	const double* V;
+	size_t k;
+} Op;
+
+/*Vetores de Lanczos e a tridiagonal; um por thread*/
+typedef struct {
+	size_t n;
+	double *v, *prev, *w, *tmp, *u;
+	double alpha[MATFUN_MAX_STEPS + 1], beta[MATFUN_MAX_STEPS + 1];
+	double d[MATFUN_MAX_STEPS + 1], e[MATFUN_MAX_STEPS + 1];
+	double z[MATFUN_MAX_STEPS + 1];
+} Work;
+
+static Work* work_new(size_t n) {
+	Work* wk = malloc(sizeof(Work));
+	double* buf = calloc(5 * n + 1, sizeof(double));
+
+	if (!wk || !buf) {
+		die("malloc error (matfun)");
+	}
+
+	wk->n = n;
+	wk->v = buf;
+	wk->prev = buf + n;
+	wk->w = buf + 2 * n;
+	wk->tmp = buf + 3 * n;
+	wk->u = buf + 4 * n;
+
+	return wk;
+}
+
+static void work_free(Work* wk) {
+	free(wk->u - 4 * wk->n);
+	free(wk);
+}
+
+static double dot(const double* x, const double* y, size_t n) {
+	double s = 0.0;
+
+	for (size_t i = 0; i < n; i++) {
+		s += x[i] * y[i];
+	}
+
+	return s;
+}
+
+/*y -= V Vᵀ y*/
+static void project(const Op* op, double* y, size_t n) {
+	for (size_t j = 0; j < op->k; j++) {
+		const double* v = op->V + j * n;
+		double c = dot(v, y, n);
+
+		for (size_t i = 0; i < n; i++) {
+			y[i] -= c * v[i];
+		}
+	}
+}
+
+static void apply(const Op* op, Work* wk, const double* x, double* y) {
+	if (op->square) {
+		op->mv(x, wk->tmp, op->ctx);
+		op->mv(wk->tmp, y, op->ctx);
+	} else {
+		op->mv(x, y, op->ctx);
+	}
+
+	/*reprojeta a cada passo: o arredondamento traria de volta as
+	direções de V, que dominam f(A)*/
+	project(op, y, wk->n);
+}
+
+/*QL implícito na tridiagonal (d, e), m x m, com e[i] ligando i e i + 1.
+Só a primeira linha z da matriz de autovetores é acompanhada (é o que
+a regra de quadratura usa), então custa O(m²)*/
+static void tridiag_ql(double* d, double* e, double* z, size_t m) {
+	e[m - 1] = 0.0;
+
+	for (size_t l = 0; l < m; l++) {
+		size_t iter = 0, k;
+
+		do {
+			for (k = l; k + 1 < m; k++) {
+				double dd = fabs(d[k]) + fabs(d[k + 1]);
+
+				if (fabs(e[k]) <= DBL_EPSILON * dd) {
+					break;
+				}
+			}
+
+			if (k == l || iter++ == 60) {
+				break;
+			}
+
+			double g = (d[l + 1] - d[l]) / (2.0 * e[l]);
+			double r = hypot(g, 1.0);
+			g = d[k] - d[l] + e[l] / (g + copysign(r, g));
+			double s = 1.0, c = 1.0, p = 0.0;
+			bool split = false;
+
+			for (size_t i = k; i-- > l; ) {
+				double f = s * e[i], b = c * e[i];
+				r = hypot(f, g);
+				e[i + 1] = r;
+
+				/*deflação no meio da varredura*/
+				if (r == 0.0) {
+					d[i + 1] -= p;
+					e[k] = 0.0;
+					split = true;
+					break;
+				}
+
+				s = f / r;
+				c = g / r;
+				g = d[i + 1] - p;
+				r = (d[i] - g) * s + 2.0 * c * b;
+				p = s * r;
+				d[i + 1] = g + p;
+				g = c * r - b;
+
+				f = z[i + 1];
+				z[i + 1] = s * z[i] + c * f;
+				z[i] = c * z[i] - s * f;
+			}
+
+			if (!split) {
+				d[l] -= p;
+				e[l] = g;
+				e[k] = 0.0;
+			}
+		} while (true);
+	}
+}
+
+/*Regra de quadratura da tridiagonal m x m (diag, off): Σ z_i² f(θ_i)*/
+static double rule(Work* wk, const double* diag, const double* off,
+	size_t m, ScalarFn f) {
+	memcpy(wk->d, diag, m * sizeof(double));
+	memcpy(wk->e, off, m * sizeof(double));
+	memset(wk->z, 0, m * sizeof(double));
+	wk->z[0] = 1.0;
+
+	tridiag_ql(wk->d, wk->e, wk->z, m);
+	double s = 0.0;
+
+	for (size_t i = 0; i < m; i++) {
+		s += wk->z[i] * wk->z[i] * f(wk->d[i]);
+	}
+
+	return s;
+}
+
+/*Gauss-Radau com nó em c: T_m estendida por uma linha, com o último
+elemento da diagonal escolhido para que c seja autovalor. Esse
+elemento é c + β_m² / d_m, com d_m o último pivô de T_m - cI*/
+static double radau(Work* wk, size_t m, double c, ScalarFn f) {
+	double piv = wk->alpha[0] - c;
+
+	for (size_t j = 1; j < m; j++) {
+		piv = wk->alpha[j] - c - wk->beta[j - 1] * wk->beta[j - 1] / piv;
+	}
+
+	if (piv == 0.0) {
+		return NAN;
+	}
+
+	wk->alpha[m] = c + wk->beta[m - 1] * wk->beta[m - 1] / piv;
+
+	return rule(wk, wk->alpha, wk->beta, m + 1, f);
+}
+
+/*Um passo de Lanczos: w = M v - β_{m-1} prev - α_m v. Guarda α_m e
+β_m = |w| e retorna β_m*/
+static double lanczos_step(const Op* op, Work* wk, size_t m) {
+	size_t n = wk->n;
+	double *v = wk->v, *w = wk->w;
+	apply(op, wk, v, w);
+
+	if (m > 0) {
+		double b = wk->beta[m - 1];
+
+		for (size_t i = 0; i < n; i++) {
+			w[i] -= b * wk->prev[i];
+		}
+	}
+
+	double a = dot(w, v, n);
+
+	for (size_t i = 0; i < n; i++) {
+		w[i] -= a * v[i];
+	}
+
+	wk->alpha[m] = a;
+	wk->beta[m] = sqrt(dot(w, w, n));
+
+	return wk->beta[m];
+}
+
+/*v vira prev e w / b vira v*/
+static void lanczos_shift(Work* wk, double b) {
+	double* w = wk->w;
+	wk->w = wk->prev;
+	wk->prev = wk->v;
+	wk->v = w;
+
+	for (size_t i = 0; i < wk->n; i++) {
+		w[i] /= b;
+	}
+}
+
+/*v = u / |u|; retorna |u|²*/
+static double lanczos_start(Work* wk, const double* u) {
+	double nu = dot(u, u, wk->n);
+
+	if (nu > 0.0) {
+		double scale = 1.0 / sqrt(nu);
+
+		for (size_t i = 0; i < wk->n; i++) {
+			wk->v[i] = scale * u[i];
+		}
+	}
+
+	return nu;
+}
+
+/*uᵀ f(M) u: Lanczos a partir de u / |u| até as cotas de Radau se
+encontrarem. Sem reortogonalização: a perda de ortogonalidade só
+repete nós, o que as regras toleram*/
+static void quadrature(const Op* op, Work* wk, const double* u, ScalarFn f,
+	double lo, double hi, double tol, MatfunBounds* out) {
+	double nu = lanczos_start(wk, u);
+	*out = (MatfunBounds) {0.0, 0.0, 0.0, 0};
+
+	if (nu == 0.0) {
+		return;
+	}
+
+	double tiny = 1e-12 * fmax(fabs(lo), fabs(hi));
+	double G = 0.0, lower = 0.0, upper = 0.0;
+	size_t m = 0;
+
+	while (m < MATFUN_MAX_STEPS) {
+		double b = lanczos_step(op, wk, m);
+		m++;
+		G = rule(wk, wk->alpha, wk->beta, m, f);
+
+		/*subespaço invariante: a regra de Gauss é exata*/
+		if (b <= tiny || m == wk->n) {
+			lower = upper = G;
+			break;
+		}
+
+		double r1 = radau(wk, m, lo, f), r2 = radau(wk, m, hi, f);
+		lower = fmin(G, fmin(r1, r2));
+		upper = fmax(G, fmax(r1, r2));
+
+		if (upper - lower <= tol * fmax(fabs(lower), fabs(upper))) {
+			break;
+		}
+
+		lanczos_shift(wk, b);
+	}
+
+	*out = (MatfunBounds) {nu * G, nu * lower, nu * upper, m};
+}
+
+/*Intervalo com o espectro de M: valores de Ritz extremos de um
+Lanczos curto, com folga do resíduo β_m |s_m| (última componente do
+vetor de Ritz) e mais 0.1% da largura*/
+static void interval(const Op* op, size_t n, double* lo, double* hi) {
+	*lo = *hi = 0.0;
+
+	if (n == 0) {
+		return;
+	}
+
+	Work* wk = work_new(n);
+	Rng rng;
+	rng_seed(&rng, 1);
+
+	for (size_t i = 0; i < n; i++) {
+		wk->u[i] = rng_uniform(&rng) - 0.5;
+	}
+
+	lanczos_start(wk, wk->u);
+	size_t steps = n < MATFUN_INTERVAL_STEPS ? n : MATFUN_INTERVAL_STEPS;
+	size_t m = 0;
+	double b = 0.0;
+
+	while (m < steps) {
+		b = lanczos_step(op, wk, m);
+		m++;
+
+		if (b <= 1e-12 * fabs(wk->alpha[0]) || m == steps) {
+			break;
+		}
+
+		lanczos_shift(wk, b);
+	}
+
+	/*z acompanha a última linha dos autovetores*/
+	memcpy(wk->d, wk->alpha, m * sizeof(double));
+	memcpy(wk->e, wk->beta, m * sizeof(double));
+	memset(wk->z, 0, m * sizeof(double));
+	wk->z[m - 1] = 1.0;
+	tridiag_ql(wk->d, wk->e, wk->z, m);
+
+	size_t imin = 0, imax = 0;
+
+	for (size_t i = 1; i < m; i++) {
+		imin = wk->d[i] < wk->d[imin] ? i : imin;
+		imax = wk->d[i] > wk->d[imax] ? i : imax;
+	}
+
+	double pad = 1e-3 * (wk->d[imax] - wk->d[imin]);
+	*lo = wk->d[imin] - b * fabs(wk->z[imin]) - pad;
+	*hi = wk->d[imax] + b * fabs(wk->z[imax]) + pad;
+	work_free(wk);
+}
+
+/*Deflação para os traços: tr f(A) = Σ f(θ_i) + tr(P f(A) P), com θ_i
+e as colunas de V os pares de Ritz do topo que já convergiram e
+P = I - V Vᵀ. No índice de Estrada exp(λ_1) domina a matriz, e sem
+isso o erro padrão de Hutchinson fica perto de √(2 / sondas) x valor*/
+typedef struct {
+	double* V;
+	size_t k;
+	double theta[MATFUN_DEFLATE];
+} Deflation;
+
+/*Como interval, mas com reortogonalização completa (guarda a base,
+MATFUN_INTERVAL_STEPS x n) e os vetores de Ritz do topo em dfl*/
+static void deflation(const Op* op, size_t n, double* lo, double* hi,
+	Deflation* dfl) {
+	*lo = *hi = 0.0;
+	dfl->V = NULL;
+	dfl->k = 0;
+
+	if (n == 0) {
+		return;
+	}
+
+	size_t steps = n < MATFUN_INTERVAL_STEPS ? n : MATFUN_INTERVAL_STEPS;
+	Work* wk = work_new(n);
+	double* Q = malloc(steps * n * sizeof(double));
+	double* Z = malloc(steps * steps * sizeof(double));
+
+	if (!Q || !Z) {
+		die("malloc error (matfun)");
+	}
+
+	Rng rng;
+	rng_seed(&rng, 1);
+
+	for (size_t i = 0; i < n; i++) {
+		wk->u[i] = rng_uniform(&rng) - 0.5;
+	}
+
+	lanczos_start(wk, wk->u);
+	size_t m = 0;
+	double b = 0.0;
+
+	while (m < steps) {
+		memcpy(Q + m * n, wk->v, n * sizeof(double));
+		lanczos_step(op, wk, m);
+
+		/*Gram-Schmidt contra toda a base, duas vezes*/
+		for (int pass = 0; pass < 2; pass++) {
+			for (size_t j = 0; j <= m; j++) {
+				double c = dot(Q + j * n, wk->w, n);
+
+				for (size_t i = 0; i < n; i++) {
+					wk->w[i] -= c * Q[j * n + i];
+				}
+			}
+		}
+
+		b = wk->beta[m] = sqrt(dot(wk->w, wk->w, n));
+		m++;
+
+		if (b <= 1e-12 * fabs(wk->alpha[0]) || m == steps) {
+			break;
+		}
+
+		lanczos_shift(wk, b);
+	}
+
+	memcpy(wk->d, wk->alpha, m * sizeof(double));
+	memcpy(wk->e, wk->beta, m * sizeof(double));
+
+	if (LAPACKE_dstev(LAPACK_ROW_MAJOR, 'V', m, wk->d, wk->e, Z, m) != 0) {
+		free(Q);
+		free(Z);
+		work_free(wk);
+		interval(op, n, lo, hi);
+		return;
+	}
+
+	/*d crescente; resíduo do par i: b |Z[m - 1][i]|*/
+	double pad = 1e-3 * (wk->d[m - 1] - wk->d[0]);
+	double rho = fmax(fabs(wk->d[0]), fabs(wk->d[m - 1]));
+	*lo = wk->d[0] - b * fabs(Z[IDX(m - 1, 0, m)]) - pad;
+	*hi = wk->d[m - 1] + b * fabs(Z[IDX(m - 1, m - 1, m)]) + pad;
+
+	size_t k = 0;
+
+	while (k < MATFUN_DEFLATE && k < m
+		&& b * fabs(Z[IDX(m - 1, m - 1 - k, m)]) <= 1e-10 * rho) {
+		k++;
+	}
+
+	if (k > 0) {
+		dfl->V = calloc(k * n, sizeof(double));
+
+		if (!dfl->V) {
+			die("malloc error (matfun)");
+		}
+
+		for (size_t j = 0; j < k; j++) {
+			size_t c = m - 1 - j;
+			dfl->theta[j] = wk->d[c];
+
+			for (size_t r = 0; r < m; r++) {
+				double z = Z[IDX(r, c, m)];
+
+				for (size_t i = 0; i < n; i++) {
+					dfl->V[j * n + i] += z * Q[r * n + i];
+				}
+			}
+		}
+
+		dfl->k = k;
+	}
+
+	free(Q);
+	free(Z);
+	work_free(wk);
+}
+
+/*(q(u + v) - q(u - v)) / 4, com as cotas combinadas*/
+static void bilinear(const Op* op, Work* wk, const double* u,
+	const double* v, ScalarFn f, double lo, double hi, double tol,
+	MatfunBounds* out) {
+	size_t n = wk->n;
+	double* s = calloc(n + 1, sizeof(double));
+
+	if (!s) {
+		die("malloc error (matfun)");
+	}
+
+	MatfunBounds plus, minus;
+
+	for (size_t i = 0; i < n; i++) {
+		s[i] = u[i] + v[i];
+	}
+
+	quadrature(op, wk, s, f, lo, hi, tol, &plus);
+
+	for (size_t i = 0; i < n; i++) {
+		s[i] = u[i] - v[i];
+	}
+
+	quadrature(op, wk, s, f, lo, hi, tol, &minus);
+	free(s);
+
+	out->value = 0.25 * (plus.value - minus.value);
+	out->lower = 0.25 * (plus.lower - minus.upper);
+	out->upper = 0.25 * (plus.upper - minus.lower);
+	out->steps = plus.steps > minus.steps ? plus.steps : minus.steps;
+}
+
+/* --- Sondas e vértices em paralelo --- */
+
+typedef struct {
+	const Op* op;
+	size_t n;
+	ScalarFn f;
+	double lo, hi, tol;
+	uint64_t seed;
+	bool probes;			/* Sondas ±1 ou vetores canônicos*/
+	const size_t* vs;		/* Vértices (NULL = 0..count - 1)*/
+	size_t count;
+	MatfunBounds* res;
+	atomic_size_t next;
+} Job;
+
+static void* job_worker(void* arg) {
+	Job* job = arg;
+	Work* wk = work_new(job->n);
+	double* u = wk->u;
+
+	for (;;) {
+		size_t k = atomic_fetch_add(&job->next, 1);
+
+		if (k >= job->count) {
+			break;
+		}
+
+		if (job->probes) {
+			Rng rng;
+			rng_seed_stream(&rng, job->seed, k);
+			uint64_t bits = 0;
+
+			for (size_t i = 0; i < job->n; i++) {
+				if (i % 64 == 0) {
+					bits = rng_next(&rng);
+				}
+
+				u[i] = (bits >> (i % 64)) & 1 ? 1.0 : -1.0;
+			}
+
+			project(job->op, u, job->n);
+
+			quadrature(job->op, wk, u, job->f, job->lo, job->hi, job->tol,
+				&job->res[k]);
+		} else {
+			size_t v = job->vs ? job->vs[k] : k;
+			u[v] = 1.0;
+			quadrature(job->op, wk, u, job->f, job->lo, job->hi, job->tol,
+				&job->res[k]);
+			u[v] = 0.0;
+		}
+	}
+
+	work_free(wk);
+
+	return NULL;
+}
+
+static void run_job(Job* job) {
+	atomic_init(&job->next, 0);
+	size_t nt = graph_num_threads();
+
+	if (nt > job->count) {
+		nt = job->count;
+	}
+
+	if (nt <= 1) {
+		job_worker(job);
+		return;
+	}
+
+	pthread_t* th = malloc(nt * sizeof(pthread_t));
+
+	if (!th) {
+		die("malloc error (threads)");
+	}
+
+	for (size_t t = 0; t < nt; t++) {
+		if (pthread_create(&th[t], NULL, job_worker, job) != 0) {
+			die("pthread_create");
+		}
+	}
+
+	for (size_t t = 0; t < nt; t++) {
+		pthread_join(th[t], NULL);
+	}
+
+	free(th);
+}
+
+static void trace(const Op* op, size_t n, ScalarFn f, double lo, double hi,
+	size_t probes, double tol, uint64_t seed, MatfunTrace* out) {
+	if (probes == 0) {
+		probes = MATFUN_PROBES;
+	}
+
+	*out = (MatfunTrace) {0.0, 0.0, 0.0, 0.0, probes};
+
+	if (n == 0) {
+		return;
+	}
+
+	MatfunBounds* res = malloc(probes * sizeof(MatfunBounds));
+
+	if (!res) {
+		die("malloc error (matfun)");
+	}
+
+	Job job = {.op = op, .n = n, .f = f, .lo = lo, .hi = hi,
+		.tol = tol > 0.0 ? tol : MATFUN_TRACE_TOL, .seed = seed,
+		.probes = true, .count = probes, .res = res};
+	run_job(&job);
+
+	double s = 0.0, s2 = 0.0;
+
+	for (size_t p = 0; p < probes; p++) {
+		s += res[p].value;
+		out->lower += res[p].lower / probes;
+		out->upper += res[p].upper / probes;
+	}
+
+	out->value = s / probes;
+
+	for (size_t p = 0; p < probes; p++) {
+		s2 += (res[p].value - out->value) * (res[p].value - out->value);
+	}
+
+	if (probes > 1) {
+		out->std_error = sqrt(s2 / (probes - 1) / probes);
+	}
+
+	free(res);
+}
+
+int matfun_quadratic(MatvecFn mv, void* ctx, size_t n, const double* u,
+	ScalarFn f, double lo, double hi, double tol, MatfunBounds* out) {
+	if (lo > hi) {
+		return -1;
+	}
+
+	Op op = {mv, ctx, false, NULL, 0};
+	Work* wk = work_new(n);
+	quadrature(&op, wk, u, f, lo, hi, tol > 0.0 ? tol : MATFUN_TOL, out);
+	work_free(wk);
+
+	return 0;
+}
+
+int matfun_bilinear(MatvecFn mv, void* ctx, size_t n, const double* u,
+	const double* v, ScalarFn f, double lo, double hi, double tol,
+	MatfunBounds* out) {
+	if (lo > hi) {
+		return -1;
+	}
+
+	Op op = {mv, ctx, false, NULL, 0};
+	Work* wk = work_new(n);
+	bilinear(&op, wk, u, v, f, lo, hi, tol > 0.0 ? tol : MATFUN_TOL, out);
+	work_free(wk);
+
+	return 0;
+}
+
+int matfun_trace(MatvecFn mv, void* ctx, size_t n, ScalarFn f, double lo,
+	double hi, size_t probes, double tol, uint64_t seed, MatfunTrace* out) {
+	if (lo > hi) {
+		return -1;
+	}
+
+	Op op = {mv, ctx, false, NULL, 0};
+	trace(&op, n, f, lo, hi, probes, tol, seed, out);
+
+	return 0;
+}
+
+int matfun_interval(MatvecFn mv, void* ctx, size_t n, double* lo,
+	double* hi) {
+	Op op = {mv, ctx, false, NULL, 0};
+	interval(&op, n, lo, hi);
+
+	return 0;
+}
+
+/* --- Grafos --- */
+
+void graph_matvec(const double* x, double* y, void* g) {
+	const Graph* G = g;
+	matrix_vecmult(G->A, G->n, x, y);
+}
+
+void graph_csr_matvec(const double* x, double* y, void* g) {
+	const GraphCSR* G = g;
+
+	for (size_t i = 0; i < G->n; i++) {
+		double s = 0.0;
+
+		for (size_t e = G->rowptr[i]; e < G->rowptr[i + 1]; e++) {
+			s += CSR_W(G, e) * x[G->col[e]];
+		}
+
+		y[i] = s;
+	}
+}
+
+/*Maior soma de |pesos| de uma linha: o espectro fica em [-r, r]*/
+static double gershgorin(const Graph* g) {
+	double r = 0.0;
+
+	for (size_t i = 0; i < g->n; i++) {
+		double s = 0.0;
+
+		for (size_t j = 0; j < g->n; j++) {
+			s += fabs(g->A[IDX(i, j, g->n)]);
+		}
+
+		r = fmax(r, s);
+	}
+
+	return r;
+}
+
+static double csr_gershgorin(const GraphCSR* g) {
+	double r = 0.0;
+
+	for (size_t i = 0; i < g->n; i++) {
+		double s = 0.0;
+
+		for (size_t e = g->rowptr[i]; e < g->rowptr[i + 1]; e++) {
+			s += fabs(CSR_W(g, e));
+		}
+
+		r = fmax(r, s);
+	}
+
+	return r;
+}
+
+/*raiz com os nós de Ritz levemente negativos (arredondamento) em 0*/
+static double sqrt0(double x) {
+	return x > 0.0 ? sqrt(x) : 0.0;
+}
+
+/*Intervalo do espectro de A: o de Lanczos, cortado por Gershgorin
+(que sozinho é folgado demais para exp em grafos com hubs: exp(hi)
+estouraria e as cotas de Radau demorariam a fechar)*/
+typedef struct {
+	Op op;
+	size_t n;
+	double lo, hi;
+} GraphOp;
+
+static GraphOp graph_op(MatvecFn mv, void* ctx, size_t n, double r) {
+	GraphOp G = {{mv, ctx, false, NULL, 0}, n, 0.0, 0.0};
+	interval(&G.op, n, &G.lo, &G.hi);
+	G.lo = fmax(G.lo, -r);
+	G.hi = fmin(G.hi, r);
+
+	return G;
+}
+
+/*Estrada com deflação; o intervalo sai do mesmo Lanczos*/
+static void estrada(MatvecFn mv, void* ctx, size_t n, double r,
+	size_t probes, uint64_t seed, MatfunTrace* out) {
+	Op op = {mv, ctx, false, NULL, 0};
+	Deflation dfl;
+	double lo, hi;
+	deflation(&op, n, &lo, &hi, &dfl);
+	lo = fmax(lo, -r);
+	hi = fmin(hi, r);
+
+	op.V = dfl.V;
+	op.k = dfl.k;
+	trace(&op, n, exp, lo, hi, probes, 0.0, seed, out);
+
+	for (size_t j = 0; j < dfl.k; j++) {
+		double e = exp(dfl.theta[j]);
+		out->value += e;
+		out->lower += e;
+		out->upper += e;
+	}
+
+	free(dfl.V);
+}
+
+static void energy(GraphOp* G, size_t probes, uint64_t seed,
+	MatfunTrace* out) {
+	double rho = fmax(fabs(G->lo), fabs(G->hi));
+	G->op.square = true;
+	trace(&G->op, G->n, sqrt0, 0.0, rho * rho, probes, 0.0, seed, out);
+}
+
+static bool valid_vertices(size_t n, const size_t* vs, size_t k) {
+	for (size_t i = 0; vs && i < k; i++) {
+		if (vs[i] >= n) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void centrality(const GraphOp* G, const size_t* vs, size_t k,
+	MatfunBounds* out) {
+	if (!vs) {
+		k = G->n;
+	}
+
+	if (k == 0) {
+		return;
+	}
+
+	Job job = {.op = &G->op, .n = G->n, .f = exp, .lo = G->lo, .hi = G->hi,
+		.tol = MATFUN_TOL, .probes = false, .vs = vs, .count = k,
+		.res = out};
+	run_job(&job);
+}
+
+static void communicability(const GraphOp* G, size_t p, size_t q,
+	MatfunBounds* out) {
+	size_t n = G->n;
+	Work* wk = work_new(n);
+	double* u = calloc(2 * n, sizeof(double));
+
+	if (!u) {
+		die("malloc error (matfun)");
+	}
+
+	u[p] = 1.0;
+
+	if (p == q) {
+		quadrature(&G->op, wk, u, exp, G->lo, G->hi, MATFUN_TOL, out);
+	} else {
+		u[n + q] = 1.0;
+		bilinear(&G->op, wk, u, u + n, exp, G->lo, G->hi, MATFUN_TOL, out);
+	}
+
+	free(u);
+	work_free(wk);
+}
+
+int graph_estrada_index(const Graph* g, size_t probes, uint64_t seed,
+	MatfunTrace* out) {
+	if (g->directed) {
+		return -1;
+	}
+
+	estrada(graph_matvec, (void*) g, g->n, gershgorin(g), probes, seed, out);
+
+	return 0;
+}
+
+int graph_csr_estrada_index(const GraphCSR* g, size_t probes, uint64_t seed,
+	MatfunTrace* out) {
+	if (g->directed) {
+		return -1;
+	}
+
+	estrada(graph_csr_matvec, (void*) g, g->n, csr_gershgorin(g), probes,
+		seed, out);
+
+	return 0;
+}
+
+int graph_energy(const Graph* g, size_t probes, uint64_t seed,
+	MatfunTrace* out) {
+	if (g->directed) {
+		return -1;
+	}
+
+	GraphOp G = graph_op(graph_matvec, (void*) g, g->n, gershgorin(g));
+	energy(&G, probes, seed, out);
+
+	return 0;
+}
+
+int graph_csr_energy(const GraphCSR* g, size_t probes, uint64_t seed,
+	MatfunTrace* out) {
+	if (g->directed) {
+		return -1;
+	}
+
+	GraphOp G = graph_op(graph_csr_matvec, (void*) g, g->n,
+		csr_gershgorin(g));
+	energy(&G, probes, seed, out);
+
+	return 0;
+}
+
+int graph_subgraph_centrality(const Graph* g, const size_t* vs, size_t k,
+	MatfunBounds* out) {
+	if (g->directed || !valid_vertices(g->n, vs, k)) {
+		return -1;
+	}
+
+	GraphOp G = graph_op(graph_matvec, (void*) g, g->n, gershgorin(g));
+	centrality(&G, vs, k, out);
+
+	return 0;
+}
+
+int graph_csr_subgraph_centrality(const GraphCSR* g, const size_t* vs,
+	size_t k, MatfunBounds* out) {
+	if (g->directed || !valid_vertices(g->n, vs, k)) {
+		return -1;
+	}
+
+	GraphOp G = graph_op(graph_csr_matvec, (void*) g, g->n,
+		csr_gershgorin(g));
+	centrality(&G, vs, k, out);
+
+	return 0;
+}
+
+int graph_communicability(const Graph* g, size_t p, size_t q,
+	MatfunBounds* out) {
+	if (g->directed || p >= g->n || q >= g->n) {
+		return -1;
+	}
+
+	GraphOp G = graph_op(graph_matvec, (void*) g, g->n, gershgorin(g));
+	communicability(&G, p, q, out);
+
+	return 0;
+}
+
+int graph_csr_communicability(const GraphCSR* g, size_t p, size_t q,
+	MatfunBounds* out) {
+	if (g->directed || p >= g->n || q >= g->n) {
+		return -1;
+	}
+
+	GraphOp G = graph_op(graph_csr_matvec, (void*) g, g->n,
+		csr_gershgorin(g));
+	communicability(&G, p, q, out);
+
+	return 0;
+}
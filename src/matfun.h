@@ -0,0 +1,139 @@
+#ifndef MATFUN_H
+#define MATFUN_H
+
+/* --- Funções de matriz por quadratura de Lanczos --- */
+
+/*
+Vários invariantes são somas ou entradas de f(A) para uma função f:
+
+- índice de Estrada: tr exp(A) = Σ exp(λ_i);
+- centralidade de subgrafo de v: exp(A)_vv;
+- comunicabilidade entre p e q: exp(A)_pq;
+- energia: Σ |λ_i| = tr (A²)^(1/2).
+
+Pelo espectro (graph_spec_adj) isso custa O(n³). Aqui nada é
+diagonalizado: uᵀ f(M) u é uma integral na medida espectral de u, e
+k passos de Lanczos a partir de u dão a regra de Gauss de k nós para
+ela (Golub-Meurant): os nós são os autovalores da tridiagonal T_k e
+os pesos, os quadrados das primeiras componentes dos autovetores (que
+saem de um QL que só acompanha a primeira linha, O(k²)). Fixando um
+nó numa ponta [lo, hi] do espectro saem as regras de Gauss-Radau;
+quando as derivadas de f têm sinal constante em [lo, hi] (exp, raiz
+em [0, ∞)) as duas regras de Radau cercam o valor exato, e os passos
+param quando a distância entre elas fica abaixo de tol x |valor|.
+Cada passo custa um produto M x, dado pelo chamador (MatvecFn de
+krylov.h), então serve para Graph denso e para GraphCSR.
+
+Os traços usam Hutchinson (tr f(M) ≈ média de zᵀ f(M) z, com z de
+±1); as sondas rodam em paralelo (graph_num_threads()) e a
+sonda p usa a sequência rng_seed_stream(seed, p), então o resultado
+não depende do número de threads. Há então dois erros: o do
+estimador (std_error, que cai com 1/√sondas) e o da quadratura
+(lower e upper, a média das cotas de cada sonda).
+
+A energia é calculada como tr g(A²) com g = raiz sobre [0, ρ²] (ρ o
+raio espectral), e não com |x| sobre A: |x| não é suave em 0, e as
+regras de Radau não dariam cotas.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "graphs.h"
+#include "krylov.h"
+
+#define MATFUN_TOL 1e-10		/* Padrão para formas e entradas*/
+#define MATFUN_TRACE_TOL 1e-4	/* Padrão por sonda nos traços*/
+#define MATFUN_MAX_STEPS 100
+#define MATFUN_PROBES 30
+#define MATFUN_INTERVAL_STEPS 40
+#define MATFUN_DEFLATE 8
+
+typedef double (*ScalarFn)(double x);
+
+typedef struct {
+	double value;		/* Regra de Gauss*/
+	double lower;		/* Cotas de Gauss-Radau*/
+	double upper;
+	size_t steps;		/* Passos de Lanczos (o maior, se forem várias)*/
+} MatfunBounds;
+
+typedef struct {
+	double value;		/* Estimativa de Hutchinson*/
+	double std_error;	/* Erro padrão do estimador*/
+	double lower;		/* value com as cotas da quadratura*/
+	double upper;
+	size_t probes;
+} MatfunTrace;
+
+
+/*uᵀ f(M) u para M simétrica n x n com espectro em [lo, hi]. tol = 0
+usa MATFUN_TOL. f é chamada nos nós, que pelo arredondamento podem
+cair um pouco fora de [lo, hi] (a raiz precisa tratar x < 0). Retorna
+0 ou -1 (lo > hi)*/
+int matfun_quadratic(MatvecFn mv, void* ctx, size_t n, const double* u,
+	ScalarFn f, double lo, double hi, double tol, MatfunBounds* out);
+
+
+/*uᵀ f(M) v, por polarização: (q(u + v) - q(u - v)) / 4*/
+int matfun_bilinear(MatvecFn mv, void* ctx, size_t n, const double* u,
+	const double* v, ScalarFn f, double lo, double hi, double tol,
+	MatfunBounds* out);
+
+
+/*tr f(M). probes = 0 usa MATFUN_PROBES e tol = 0, MATFUN_TRACE_TOL.
+mv é chamado de várias threads ao mesmo tempo (com ctx compartilhado)*/
+int matfun_trace(MatvecFn mv, void* ctx, size_t n, ScalarFn f, double lo,
+	double hi, size_t probes, double tol, uint64_t seed, MatfunTrace* out);
+
+
+/*Estimativa de um intervalo [lo, hi] com o espectro de M: os valores
+de Ritz extremos de MATFUN_INTERVAL_STEPS passos de Lanczos, com folga
+do resíduo. Não é uma garantia, mas na prática sempre contém o
+espectro e é bem mais justo que Gershgorin*/
+int matfun_interval(MatvecFn mv, void* ctx, size_t n, double* lo,
+	double* hi);
+
+
+/*Produtos y = A x prontos para os MatvecFn (ctx = o grafo)*/
+void graph_matvec(const double* x, double* y, void* g);
+void graph_csr_matvec(const double* x, double* y, void* g);
+
+
+/*As funções abaixo retornam -1 se g for direcionado. O intervalo do
+espectro é o de matfun_interval, cortado por Gershgorin (maior soma de
+|pesos| de uma linha)*/
+
+/*Índice de Estrada, tr exp(A). Os pares de Ritz do topo que o
+Lanczos de matfun_interval já resolveu (até MATFUN_DEFLATE) entram
+exatos, e Hutchinson fica só com o resto: sem isso exp(λ_1) domina e
+o erro padrão é da ordem do próprio valor. Usa
+MATFUN_INTERVAL_STEPS x n doubles a mais*/
+int graph_estrada_index(const Graph* g, size_t probes, uint64_t seed,
+	MatfunTrace* out);
+int graph_csr_estrada_index(const GraphCSR* g, size_t probes, uint64_t seed,
+	MatfunTrace* out);
+
+
+/*Energia, Σ |λ_i| = tr (A²)^(1/2)*/
+int graph_energy(const Graph* g, size_t probes, uint64_t seed,
+	MatfunTrace* out);
+int graph_csr_energy(const GraphCSR* g, size_t probes, uint64_t seed,
+	MatfunTrace* out);
+
+
+/*out[i] = exp(A)_vv para v = vs[i] (k posições; vs = NULL usa todos
+os vértices e k = n), em paralelo. Retorna -1 também se algum
+vértice estiver fora do intervalo*/
+int graph_subgraph_centrality(const Graph* g, const size_t* vs, size_t k,
+	MatfunBounds* out);
+int graph_csr_subgraph_centrality(const GraphCSR* g, const size_t* vs,
+	size_t k, MatfunBounds* out);
+
+
+/*Comunicabilidade exp(A)_pq*/
+int graph_communicability(const Graph* g, size_t p, size_t q,
+	MatfunBounds* out);
+int graph_csr_communicability(const GraphCSR* g, size_t p, size_t q,
+	MatfunBounds* out);
+
+#endif
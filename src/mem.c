@@ -0,0 +1,212 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include "mem.h"
+#include "graphs.h"
+
+/*Abaixo disso não vale a pena criar threads para zerar/copiar*/
+#define FIRST_TOUCH_MIN ((size_t) 4 << 20)
+
+/*Cabeçalho guardado logo antes do ponteiro devolvido*/
+typedef enum {
+	MEM_LIBC,
+	MEM_MMAP,
+	MEM_USER
+} MemKind;
+
+typedef struct {
+	void* base;
+	size_t total;
+	MemKind kind;
+	void (*ufree)(void* p, size_t size, void* ctx);
+	void* uctx;
+} MemHeader;
+
+_Static_assert(sizeof(MemHeader) <= GRAPH_MEM_ALIGN, "MemHeader grande demais");
+
+static GraphAllocator user;
+static bool has_user = false;
+static GraphHugePages huge = GRAPH_HUGE_TRANSPARENT;
+static bool first_touch = true;
+static pthread_once_t env_once = PTHREAD_ONCE_INIT;
+
+static void read_env(void) {
+	const char* h = getenv("GRAPH_HUGE_PAGES");
+
+	if (h) {
+		if (strcmp(h, "off") == 0 || strcmp(h, "0") == 0) {
+			huge = GRAPH_HUGE_OFF;
+		} else if (strcmp(h, "explicit") == 0) {
+			huge = GRAPH_HUGE_EXPLICIT;
+		} else {
+			huge = GRAPH_HUGE_TRANSPARENT;
+		}
+	}
+
+	const char* t = getenv("GRAPH_FIRST_TOUCH");
+
+	if (t && strcmp(t, "0") == 0) {
+		first_touch = false;
+	}
+}
+
+void graph_mem_set_allocator(const GraphAllocator* a) {
+	has_user = a != NULL;
+
+	if (a) {
+		user = *a;
+	}
+}
+
+/*as funções set_* valem mais que o ambiente, então ele é lido antes*/
+void graph_mem_set_huge_pages(GraphHugePages mode) {
+	pthread_once(&env_once, read_env);
+	huge = mode;
+}
+
+void graph_mem_set_first_touch(bool on) {
+	pthread_once(&env_once, read_env);
+	first_touch = on;
+}
+
+static size_t round_up(size_t x, size_t m) {
+	return (x + m - 1) / m * m;
+}
+
+void* graph_mem_alloc(size_t size) {
+	pthread_once(&env_once, read_env);
+
+	MemHeader h = {NULL, size + GRAPH_MEM_ALIGN, MEM_LIBC, NULL, NULL};
+
+	if (has_user) {
+		h.kind = MEM_USER;
+		h.ufree = user.free;
+		h.uctx = user.ctx;
+		h.base = user.alloc(h.total, GRAPH_MEM_ALIGN, user.ctx);
+
+		if (!h.base || (uintptr_t) h.base % GRAPH_MEM_ALIGN) {
+			die("GraphAllocator devolveu bloco nulo ou desalinhado");
+		}
+	} else if (huge != GRAPH_HUGE_OFF && h.total >= GRAPH_MEM_HUGE_MIN) {
+#ifdef MAP_HUGETLB
+		if (huge == GRAPH_HUGE_EXPLICIT) {
+			size_t len = round_up(h.total, GRAPH_MEM_HUGE_MIN);
+			void* p = mmap(NULL, len, PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+			if (p != MAP_FAILED) {
+				h.base = p;
+				h.total = len;
+				h.kind = MEM_MMAP;
+			}
+		}
+#endif
+
+		/*sem páginas reservadas (ou sem MAP_HUGETLB): transparentes*/
+		if (!h.base) {
+			if (posix_memalign(&h.base, GRAPH_MEM_HUGE_MIN, h.total) != 0) {
+				die("malloc error (graph_mem_alloc)");
+			}
+
+#ifdef MADV_HUGEPAGE
+			size_t len = h.total / GRAPH_MEM_HUGE_MIN * GRAPH_MEM_HUGE_MIN;
+			madvise(h.base, len, MADV_HUGEPAGE);
+#endif
+		}
+	} else if (posix_memalign(&h.base, GRAPH_MEM_ALIGN, h.total) != 0) {
+		die("malloc error (graph_mem_alloc)");
+	}
+
+	memcpy(h.base, &h, sizeof(MemHeader));
+
+	return (char*) h.base + GRAPH_MEM_ALIGN;
+}
+
+void graph_mem_free(void* p) {
+	if (!p) {
+		return;
+	}
+
+	MemHeader h;
+	memcpy(&h, (char*) p - GRAPH_MEM_ALIGN, sizeof(MemHeader));
+
+	switch (h.kind) {
+	case MEM_USER:
+		h.ufree(h.base, h.total, h.uctx);
+		break;
+	case MEM_MMAP:
+		munmap(h.base, h.total);
+		break;
+	default:
+		free(h.base);
+	}
+}
+
+
+/* --- First touch --- */
+
+typedef struct {
+	double* dst;
+	const double* src;
+	size_t begin, end;	/* Faixa de elementos (linhas inteiras)*/
+} TouchJob;
+
+static void* touch_worker(void* arg) {
+	TouchJob* j = arg;
+	size_t len = (j->end - j->begin) * sizeof(double);
+
+	if (j->src) {
+		memcpy(&j->dst[j->begin], &j->src[j->begin], len);
+	} else {
+		memset(&j->dst[j->begin], 0, len);
+	}
+
+	return NULL;
+}
+
+double* graph_mem_matrix(size_t rows, size_t cols, const double* src) {
+	size_t count = rows * cols;
+	double* M = graph_mem_alloc(count * sizeof(double));
+	size_t nt = graph_num_threads();
+
+	if (!first_touch || count * sizeof(double) < FIRST_TOUCH_MIN) {
+		nt = 1;
+	}
+
+	if (nt > rows) {
+		nt = rows ? rows : 1;
+	}
+
+	TouchJob* jobs = malloc(nt * sizeof(TouchJob));
+	pthread_t* th = malloc(nt * sizeof(pthread_t));
+
+	if (!jobs || !th) {
+		die("malloc error (first touch)");
+	}
+
+	for (size_t t = 0; t < nt; t++) {
+		jobs[t] = (TouchJob) {M, src, rows * t / nt * cols,
+			rows * (t + 1) / nt * cols};
+	}
+
+	if (nt == 1) {
+		touch_worker(&jobs[0]);
+	} else {
+		for (size_t t = 0; t < nt; t++) {
+			if (pthread_create(&th[t], NULL, touch_worker, &jobs[t]) != 0) {
+				die("pthread_create");
+			}
+		}
+
+		for (size_t t = 0; t < nt; t++) {
+			pthread_join(th[t], NULL);
+		}
+	}
+
+	free(jobs);
+	free(th);
+
+	return M;
+}
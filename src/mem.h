@@ -0,0 +1,72 @@
+#ifndef MEM_H
+#define MEM_H
+
+/* --- Alocação das matrizes --- */
+
+/*
+Toda matriz n x n da biblioteca (adjacência de graph_new, cópias para
+o LAPACK, laplaciana de graph_spec_lap) passa por aqui:
+
+- o início de cada bloco é alinhado a GRAPH_MEM_ALIGN bytes (linha de
+  cache / registrador AVX-512);
+- blocos grandes (>= GRAPH_MEM_HUGE_MIN) podem usar huge pages:
+  transparentes (madvise MADV_HUGEPAGE) ou explícitas (mmap com
+  MAP_HUGETLB, que exige páginas reservadas em
+  /proc/sys/vm/nr_hugepages; sem elas cai nas transparentes);
+- matrizes grandes são zeradas/copiadas em paralelo, cada thread com
+  uma faixa de linhas (first touch): num servidor com vários nós NUMA
+  as páginas ficam espalhadas pelos nós em vez de todas no nó da
+  thread principal;
+- um GraphAllocator troca o malloc por funções do usuário (arena,
+  contadores, memkind...).
+
+Padrões: GRAPH_HUGE_PAGES = off | thp | explicit (padrão thp) e
+GRAPH_FIRST_TOUCH = 0 desliga a inicialização paralela. Configure antes
+de criar grafos: a configuração é global e não é protegida por lock.
+*/
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#define GRAPH_MEM_ALIGN 64
+#define GRAPH_MEM_HUGE_MIN ((size_t) 2 << 20)
+
+typedef enum {
+	GRAPH_HUGE_OFF,
+	GRAPH_HUGE_TRANSPARENT,
+	GRAPH_HUGE_EXPLICIT
+} GraphHugePages;
+
+
+/*alloc recebe o tamanho e o alinhamento pedido e devolve NULL se falhar;
+free recebe o mesmo tamanho. ctx é repassado às duas*/
+typedef struct {
+	void* (*alloc)(size_t size, size_t align, void* ctx);
+	void (*free)(void* p, size_t size, void* ctx);
+	void* ctx;
+} GraphAllocator;
+
+
+/*NULL volta ao alocador padrão. Blocos já alocados continuam sendo
+liberados pelo alocador que os criou*/
+void graph_mem_set_allocator(const GraphAllocator* a);
+
+void graph_mem_set_huge_pages(GraphHugePages mode);
+
+void graph_mem_set_first_touch(bool on);
+
+
+/*size bytes alinhados, não inicializados (chama die se faltar memória).
+Libere com graph_mem_free*/
+void* graph_mem_alloc(size_t size);
+
+
+/*Matriz rows x cols de double, cópia de src ou zerada se src for NULL.
+A inicialização é paralela por faixas de linhas (first touch)*/
+double* graph_mem_matrix(size_t rows, size_t cols, const double* src);
+
+
+/*Libera um bloco de graph_mem_alloc/graph_mem_matrix; NULL é ignorado*/
+void graph_mem_free(void* p);
+
+#endif
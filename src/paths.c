@@ -0,0 +1,687 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "paths.h"
+
+#define NONE SIZE_MAX
+
+/* --- Pairing heap indexado por vértice --- */
+
+/*prev é o pai para o primeiro filho e o irmão da esquerda para os
+outros, para que decrease-key consiga cortar o nó em O(1)*/
+typedef struct {
+	double key;
+	size_t child, next, prev;
+} PHNode;
+
+typedef struct {
+	PHNode* nodes;
+	size_t* stack;		/* Rascunho para o delete-min (two-pass)*/
+	char* state;		/* 0 = nunca visto, 1 = no heap, 2 = fixado*/
+	size_t root;
+} PairingHeap;
+
+static void ph_init(PairingHeap* h, size_t n) {
+	h->nodes = malloc((n + 1) * sizeof(PHNode));
+	h->stack = malloc((n + 1) * sizeof(size_t));
+	h->state = malloc(n + 1);
+
+	if (!h->nodes || !h->stack || !h->state) {
+		die("malloc error (PairingHeap)");
+	}
+}
+
+static void ph_reset(PairingHeap* h, size_t n) {
+	memset(h->state, 0, n);
+	h->root = NONE;
+}
+
+static void ph_destroy(PairingHeap* h) {
+	free(h->nodes);
+	free(h->stack);
+	free(h->state);
+}
+
+static size_t ph_meld(PHNode* N, size_t x, size_t y) {
+	if (x == NONE) {
+		return y;
+	}
+
+	if (y == NONE) {
+		return x;
+	}
+
+	if (N[y].key < N[x].key) {
+		size_t t = x;
+		x = y;
+		y = t;
+	}
+
+	N[y].next = N[x].child;
+
+	if (N[x].child != NONE) {
+		N[N[x].child].prev = y;
+	}
+
+	N[y].prev = x;
+	N[x].child = y;
+
+	return x;
+}
+
+static void ph_push(PairingHeap* h, size_t v, double key) {
+	h->nodes[v] = (PHNode) {key, NONE, NONE, NONE};
+	h->state[v] = 1;
+	h->root = ph_meld(h->nodes, h->root, v);
+}
+
+static void ph_decrease(PairingHeap* h, size_t v, double key) {
+	PHNode* N = h->nodes;
+	N[v].key = key;
+
+	if (v == h->root) {
+		return;
+	}
+
+	size_t p = N[v].prev;
+
+	if (N[p].child == v) {
+		N[p].child = N[v].next;
+	} else {
+		N[p].next = N[v].next;
+	}
+
+	if (N[v].next != NONE) {
+		N[N[v].next].prev = p;
+	}
+
+	N[v].next = N[v].prev = NONE;
+	h->root = ph_meld(N, h->root, v);
+}
+
+static size_t ph_pop(PairingHeap* h) {
+	PHNode* N = h->nodes;
+	size_t r = h->root;
+	size_t c = N[r].child, top = 0;
+
+	/*primeira passada: junta os filhos dois a dois*/
+	while (c != NONE) {
+		size_t a = c, b = N[a].next;
+		N[a].next = N[a].prev = NONE;
+
+		if (b == NONE) {
+			h->stack[top++] = a;
+			break;
+		}
+
+		c = N[b].next;
+		N[b].next = N[b].prev = NONE;
+		h->stack[top++] = ph_meld(N, a, b);
+	}
+
+	/*segunda passada: da direita para a esquerda*/
+	size_t root = NONE;
+
+	while (top > 0) {
+		root = ph_meld(N, h->stack[--top], root);
+	}
+
+	h->root = root;
+	h->state[r] = 2;
+
+	return r;
+}
+
+
+/* --- Dijkstra --- */
+
+static bool has_negative_weight(const GraphCSR* g) {
+	if (!g->w) {
+		return false;
+	}
+
+	for (size_t k = 0; k < g->rowptr[g->n]; k++) {
+		if (g->w[k] < 0.0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*w != NULL substitui os pesos de g (usado por Johnson)*/
+static void dijkstra_core(const GraphCSR* g, const double* w, size_t src,
+	double* dist, PairingHeap* h) {
+	size_t n = g->n;
+
+	for (size_t v = 0; v < n; v++) {
+		dist[v] = INFINITY;
+	}
+
+	ph_reset(h, n);
+	dist[src] = 0.0;
+	ph_push(h, src, 0.0);
+
+	while (h->root != NONE) {
+		size_t u = ph_pop(h);
+		double du = dist[u];
+
+		for (size_t e = g->rowptr[u]; e < g->rowptr[u + 1]; e++) {
+			size_t v = g->col[e];
+			double nd = du + (w ? w[e] : CSR_W(g, e));
+
+			if (h->state[v] == 2 || nd >= dist[v]) {
+				continue;
+			}
+
+			dist[v] = nd;
+
+			if (h->state[v] == 0) {
+				ph_push(h, v, nd);
+			} else {
+				ph_decrease(h, v, nd);
+			}
+		}
+	}
+}
+
+int graph_sssp_dijkstra(const GraphCSR* g, size_t src, double* dist) {
+	if (src >= g->n) {
+		die("vértice fora do intervalo");
+	}
+
+	if (has_negative_weight(g)) {
+		return PATHS_NEGATIVE_WEIGHT;
+	}
+
+	PairingHeap h;
+	ph_init(&h, g->n);
+	dijkstra_core(g, NULL, src, dist, &h);
+	ph_destroy(&h);
+
+	return 0;
+}
+
+
+/* --- Bellman-Ford (SPFA) --- */
+
+/*Se src == NONE, todos os vértices começam com distância 0 (fonte
+virtual ligada a todos com peso 0, como em Johnson)*/
+static int spfa(const GraphCSR* g, size_t src, double* dist) {
+	size_t n = g->n;
+	size_t* queue = malloc((n + 1) * sizeof(size_t));
+	size_t* len = calloc(n + 1, sizeof(size_t));
+	char* inq = calloc(n + 1, 1);
+
+	if (!queue || !len || !inq) {
+		die("malloc error (spfa)");
+	}
+
+	size_t head = 0, count = 0;
+
+	for (size_t v = 0; v < n; v++) {
+		dist[v] = (src == NONE) ? 0.0 : INFINITY;
+
+		if (src == NONE) {
+			queue[count++] = v;
+			inq[v] = 1;
+		}
+	}
+
+	if (src != NONE) {
+		dist[src] = 0.0;
+		queue[count++] = src;
+		inq[src] = 1;
+	}
+
+	int status = 0;
+
+	while (count > 0 && status == 0) {
+		size_t u = queue[head];
+		head = (head + 1) % (n + 1);
+		count--;
+		inq[u] = 0;
+
+		for (size_t e = g->rowptr[u]; e < g->rowptr[u + 1]; e++) {
+			size_t v = g->col[e];
+			double nd = dist[u] + CSR_W(g, e);
+
+			if (nd < dist[v]) {
+				dist[v] = nd;
+				len[v] = len[u] + 1;
+
+				/*um caminho mínimo tem no máximo n - 1 arestas*/
+				if (len[v] >= n) {
+					status = PATHS_NEGATIVE_CYCLE;
+					break;
+				}
+
+				if (!inq[v]) {
+					queue[(head + count) % (n + 1)] = v;
+					count++;
+					inq[v] = 1;
+				}
+			}
+		}
+	}
+
+	free(queue);
+	free(len);
+	free(inq);
+
+	return status;
+}
+
+int graph_sssp_bellman_ford(const GraphCSR* g, size_t src, double* dist) {
+	if (src >= g->n) {
+		die("vértice fora do intervalo");
+	}
+
+	return spfa(g, src, dist);
+}
+
+int graph_sssp(const GraphCSR* g, size_t src, double* dist) {
+	if (has_negative_weight(g)) {
+		return graph_sssp_bellman_ford(g, src, dist);
+	}
+
+	return graph_sssp_dijkstra(g, src, dist);
+}
+
+
+/* --- Delta-stepping --- */
+
+/*Para pesos >= 0 a ordem dos bits de um double é a mesma ordem
+numérica, então o mínimo atômico é um CAS sobre uint64_t*/
+static inline uint64_t dbits(double x) {
+	uint64_t b;
+	memcpy(&b, &x, sizeof(b));
+	return b;
+}
+
+static inline double bitsd(uint64_t b) {
+	double x;
+	memcpy(&x, &b, sizeof(x));
+	return x;
+}
+
+static inline bool atomic_min_dist(_Atomic uint64_t* d, double nd) {
+	uint64_t nb = dbits(nd);
+	uint64_t cur = atomic_load(d);
+
+	while (nb < cur) {
+		if (atomic_compare_exchange_weak(d, &cur, nb)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+typedef struct {
+	const GraphCSR* g;
+	double delta;
+	size_t nt;
+	_Atomic uint64_t* dist;
+	atomic_uchar* active;		/* Distância caiu desde o último relaxamento*/
+	char* settled;				/* Relaxado no balde atual (dono só)*/
+	size_t* local_min;			/* Menor balde ativo de cada thread*/
+	pthread_barrier_t barrier;
+	atomic_bool again;
+	size_t bucket;
+	bool again_now;
+} DeltaShared;
+
+typedef struct {
+	DeltaShared* sh;
+	size_t tid;
+} DeltaWorker;
+
+static inline size_t bucket_of(double d, double delta) {
+	return (size_t) (d / delta);
+}
+
+static void relax_edges(DeltaShared* sh, size_t v, bool light) {
+	const GraphCSR* g = sh->g;
+	double dv = bitsd(atomic_load(&sh->dist[v]));
+
+	for (size_t e = g->rowptr[v]; e < g->rowptr[v + 1]; e++) {
+		double w = CSR_W(g, e);
+
+		if ((w <= sh->delta) != light) {
+			continue;
+		}
+
+		size_t u = g->col[e];
+		double nd = dv + w;
+
+		if (atomic_min_dist(&sh->dist[u], nd)) {
+			atomic_store(&sh->active[u], 1);
+
+			if (light && bucket_of(nd, sh->delta) == sh->bucket) {
+				atomic_store(&sh->again, true);
+			}
+		}
+	}
+}
+
+static void* delta_worker(void* arg) {
+	DeltaWorker* w = arg;
+	DeltaShared* sh = w->sh;
+	size_t n = sh->g->n;
+	size_t lo = n * w->tid / sh->nt, hi = n * (w->tid + 1) / sh->nt;
+
+	for (;;) {
+		/*fase leve: repete enquanto algum vértice entrar no balde atual*/
+		do {
+			for (size_t v = lo; v < hi; v++) {
+				if (!atomic_load(&sh->active[v])) {
+					continue;
+				}
+
+				double dv = bitsd(atomic_load(&sh->dist[v]));
+
+				if (bucket_of(dv, sh->delta) != sh->bucket) {
+					continue;
+				}
+
+				atomic_store(&sh->active[v], 0);
+				sh->settled[v] = 1;
+				relax_edges(sh, v, true);
+			}
+
+			pthread_barrier_wait(&sh->barrier);
+
+			if (w->tid == 0) {
+				sh->again_now = atomic_exchange(&sh->again, false);
+			}
+
+			pthread_barrier_wait(&sh->barrier);
+		} while (sh->again_now);
+
+		/*fase pesada: arestas > delta levam sempre a baldes futuros*/
+		size_t best = SIZE_MAX;
+
+		for (size_t v = lo; v < hi; v++) {
+			if (sh->settled[v]) {
+				sh->settled[v] = 0;
+				relax_edges(sh, v, false);
+			}
+		}
+
+		pthread_barrier_wait(&sh->barrier);
+
+		for (size_t v = lo; v < hi; v++) {
+			if (atomic_load(&sh->active[v])) {
+				size_t b = bucket_of(bitsd(atomic_load(&sh->dist[v])), sh->delta);
+				best = (b < best) ? b : best;
+			}
+		}
+
+		sh->local_min[w->tid] = best;
+		pthread_barrier_wait(&sh->barrier);
+
+		if (w->tid == 0) {
+			size_t b = SIZE_MAX;
+
+			for (size_t t = 0; t < sh->nt; t++) {
+				b = (sh->local_min[t] < b) ? sh->local_min[t] : b;
+			}
+
+			sh->bucket = b;
+		}
+
+		pthread_barrier_wait(&sh->barrier);
+
+		if (sh->bucket == SIZE_MAX) {
+			break;
+		}
+	}
+
+	return NULL;
+}
+
+int graph_sssp_delta_stepping(const GraphCSR* g, size_t src, double delta,
+	double* dist) {
+	size_t n = g->n;
+
+	if (src >= n) {
+		die("vértice fora do intervalo");
+	}
+
+	if (has_negative_weight(g)) {
+		return PATHS_NEGATIVE_WEIGHT;
+	}
+
+	size_t m = g->rowptr[n];
+
+	if (delta <= 0.0) {
+		double wmax = 0.0;
+
+		for (size_t k = 0; k < m; k++) {
+			wmax = fmax(wmax, CSR_W(g, k));
+		}
+
+		double avg_deg = (n > 0) ? (double) m / (double) n : 1.0;
+		delta = (wmax > 0.0) ? wmax / fmax(avg_deg, 1.0) : 1.0;
+	}
+
+	DeltaShared sh = {.g = g, .delta = delta, .bucket = 0};
+	sh.nt = graph_num_threads();
+
+	if (sh.nt > n) {
+		sh.nt = n;
+	}
+
+	sh.dist = malloc(n * sizeof(*sh.dist));
+	sh.active = malloc(n * sizeof(*sh.active));
+	sh.settled = calloc(n, 1);
+	sh.local_min = malloc(sh.nt * sizeof(size_t));
+	pthread_t* th = malloc(sh.nt * sizeof(pthread_t));
+	DeltaWorker* workers = malloc(sh.nt * sizeof(DeltaWorker));
+
+	if (!sh.dist || !sh.active || !sh.settled || !sh.local_min || !th
+		|| !workers) {
+		die("malloc error (delta-stepping)");
+	}
+
+	for (size_t v = 0; v < n; v++) {
+		atomic_init(&sh.dist[v], dbits(INFINITY));
+		atomic_init(&sh.active[v], 0);
+	}
+
+	atomic_init(&sh.dist[src], dbits(0.0));
+	atomic_init(&sh.active[src], 1);
+	atomic_init(&sh.again, false);
+	pthread_barrier_init(&sh.barrier, NULL, (unsigned) sh.nt);
+
+	for (size_t t = 0; t < sh.nt; t++) {
+		workers[t] = (DeltaWorker) {&sh, t};
+
+		if (pthread_create(&th[t], NULL, delta_worker, &workers[t]) != 0) {
+			die("pthread_create");
+		}
+	}
+
+	for (size_t t = 0; t < sh.nt; t++) {
+		pthread_join(th[t], NULL);
+	}
+
+	for (size_t v = 0; v < n; v++) {
+		dist[v] = bitsd(atomic_load(&sh.dist[v]));
+	}
+
+	pthread_barrier_destroy(&sh.barrier);
+	free(sh.dist);
+	free((void*) sh.active);
+	free(sh.settled);
+	free(sh.local_min);
+	free(th);
+	free(workers);
+
+	return 0;
+}
+
+
+/* --- Todas as fontes --- */
+
+typedef struct {
+	const GraphCSR* g;
+	const double* w;		/* Pesos reponderados (ou NULL)*/
+	const double* h;		/* Potenciais de Johnson (ou NULL)*/
+	double* D;				/* n x n ou NULL*/
+	double* ecc;			/* n ou NULL*/
+	atomic_size_t next;
+} AllSourcesJob;
+
+static void* all_sources_worker(void* arg) {
+	AllSourcesJob* job = arg;
+	const GraphCSR* g = job->g;
+	size_t n = g->n;
+	double* dist = malloc((n + 1) * sizeof(double));
+	PairingHeap h;
+
+	if (!dist) {
+		die("malloc error (dist)");
+	}
+
+	ph_init(&h, n);
+
+	for (;;) {
+		size_t s = atomic_fetch_add(&job->next, 1);
+
+		if (s >= n) {
+			break;
+		}
+
+		dijkstra_core(g, job->w, s, dist, &h);
+		double ecc = 0.0;
+
+		for (size_t v = 0; v < n; v++) {
+			/*desfaz a reponderação: d(s,v) = d'(s,v) - h(s) + h(v)*/
+			double d = dist[v];
+
+			if (job->h && !isinf(d)) {
+				d += job->h[v] - job->h[s];
+			}
+
+			if (job->D) {
+				job->D[IDX(s, v, n)] = d;
+			}
+
+			ecc = fmax(ecc, d);
+		}
+
+		if (job->ecc) {
+			job->ecc[s] = ecc;
+		}
+	}
+
+	ph_destroy(&h);
+	free(dist);
+
+	return NULL;
+}
+
+static int all_sources(const GraphCSR* g, double* D, double* ecc) {
+	size_t n = g->n;
+	double* h = NULL;
+	double* w = NULL;
+
+	if (n == 0) {
+		return 0;
+	}
+
+	if (has_negative_weight(g)) {
+		h = malloc(n * sizeof(double));
+		w = malloc(g->rowptr[n] * sizeof(double));
+
+		if (!h || !w) {
+			die("malloc error (johnson)");
+		}
+
+		if (spfa(g, NONE, h) != 0) {
+			free(h);
+			free(w);
+			return PATHS_NEGATIVE_CYCLE;
+		}
+
+		for (size_t u = 0; u < n; u++) {
+			for (size_t e = g->rowptr[u]; e < g->rowptr[u + 1]; e++) {
+				/*>= 0 a menos de arredondamento*/
+				w[e] = fmax(0.0, g->w[e] + h[u] - h[g->col[e]]);
+			}
+		}
+	}
+
+	AllSourcesJob job = {.g = g, .w = w, .h = h, .D = D, .ecc = ecc};
+	atomic_init(&job.next, 0);
+
+	size_t nt = graph_num_threads();
+
+	if (nt > n) {
+		nt = n;
+	}
+
+	pthread_t* th = malloc(nt * sizeof(pthread_t));
+
+	if (!th) {
+		die("malloc error (threads)");
+	}
+
+	for (size_t t = 0; t < nt; t++) {
+		if (pthread_create(&th[t], NULL, all_sources_worker, &job) != 0) {
+			die("pthread_create");
+		}
+	}
+
+	for (size_t t = 0; t < nt; t++) {
+		pthread_join(th[t], NULL);
+	}
+
+	free(th);
+	free(h);
+	free(w);
+
+	return 0;
+}
+
+int graph_apsp(const GraphCSR* g, double* D) {
+	return all_sources(g, D, NULL);
+}
+
+int graph_weighted_eccentricities(const GraphCSR* g, double* ecc) {
+	return all_sources(g, NULL, ecc);
+}
+
+static double ecc_extreme(const GraphCSR* g, bool max) {
+	double* ecc = malloc((g->n + 1) * sizeof(double));
+
+	if (!ecc) {
+		die("malloc error (ecc)");
+	}
+
+	if (graph_weighted_eccentricities(g, ecc) != 0) {
+		free(ecc);
+		return NAN;
+	}
+
+	double r = max ? 0.0 : INFINITY;
+
+	for (size_t v = 0; v < g->n; v++) {
+		r = max ? fmax(r, ecc[v]) : fmin(r, ecc[v]);
+	}
+
+	free(ecc);
+	return (g->n == 0) ? 0.0 : r;
+}
+
+double graph_weighted_diameter(const GraphCSR* g) {
+	return ecc_extreme(g, true);
+}
+
+double graph_weighted_radius(const GraphCSR* g) {
+	return ecc_extreme(g, false);
+}
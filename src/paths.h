@@ -0,0 +1,66 @@
+#ifndef PATHS_H
+#define PATHS_H
+
+/* --- Caminhos mínimos com peso --- */
+
+/*
+Diferente de graph_diameter (que conta arestas), as funções daqui
+usam os pesos w guardados por graph_add_edge/graph_read_from_file.
+Todas trabalham sobre a representação esparsa GraphCSR (converta um
+Graph com graph_csr_from_graph), então custam O(m log n) por fonte
+em vez de O(n²).
+
+- Dijkstra com pairing heap (decrease-key O(1) amortizado) para
+  pesos >= 0;
+- delta-stepping com graph_num_threads() threads para pesos >= 0;
+- Bellman-Ford na variante SPFA (fila) para pesos negativos, com
+  detecção de ciclo negativo;
+- todos os pares por Johnson: Bellman-Ford uma vez para achar
+  potenciais, depois Dijkstra com pesos reponderados, com as fontes
+  divididas entre threads.
+
+dist[v] = INFINITY quando v não é alcançável.
+*/
+
+#include "graphs.h"
+
+/*Códigos de erro (0 = ok)*/
+#define PATHS_NEGATIVE_WEIGHT (-1)	/* Dijkstra/delta-stepping com peso < 0*/
+#define PATHS_NEGATIVE_CYCLE (-2)	/* Ciclo negativo alcançável*/
+
+
+/*Dijkstra a partir de src. Retorna PATHS_NEGATIVE_WEIGHT se algum
+peso for negativo*/
+int graph_sssp_dijkstra(const GraphCSR* g, size_t src, double* dist);
+
+
+/*Delta-stepping paralelo a partir de src. delta <= 0 escolhe
+delta = (maior peso) / (grau médio)*/
+int graph_sssp_delta_stepping(const GraphCSR* g, size_t src, double delta,
+	double* dist);
+
+
+/*Bellman-Ford (SPFA) a partir de src. Retorna PATHS_NEGATIVE_CYCLE se
+houver ciclo negativo alcançável a partir de src*/
+int graph_sssp_bellman_ford(const GraphCSR* g, size_t src, double* dist);
+
+
+/*Escolhe Dijkstra ou Bellman-Ford conforme o sinal dos pesos*/
+int graph_sssp(const GraphCSR* g, size_t src, double* dist);
+
+
+/*D[i][j] = distância de i até j (n x n). Aceita pesos negativos
+(Johnson); retorna PATHS_NEGATIVE_CYCLE se houver ciclo negativo*/
+int graph_apsp(const GraphCSR* g, double* D);
+
+
+/*ecc[v] = maior distância de v até outro vértice (INFINITY se algum
+não for alcançável), sem guardar a matriz de distâncias*/
+int graph_weighted_eccentricities(const GraphCSR* g, double* ecc);
+
+
+/*Maior/menor excentricidade. NAN se houver ciclo negativo*/
+double graph_weighted_diameter(const GraphCSR* g);
+double graph_weighted_radius(const GraphCSR* g);
+
+#endif
@@ -0,0 +1,357 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "products.h"
+#include "eig.h"
+
+typedef enum {
+	PRODUCT_CARTESIAN,
+	PRODUCT_TENSOR,
+	PRODUCT_STRONG
+} ProductKind;
+
+static Graph* product(const Graph* G, const Graph* H, ProductKind kind) {
+	if (G->directed != H->directed) {
+		die("produto de grafos de tipos diferentes");
+	}
+
+	size_t n1 = G->n, n2 = H->n, n = n1 * n2;
+	Graph* P = graph_new(n, G->directed);
+
+	for (size_t i = 0; i < n1; i++) {
+		for (size_t j = 0; j < n2; j++) {
+			double* row = &P->A[IDX(i * n2 + j, 0, n)];
+
+			for (size_t k = 0; k < n1; k++) {
+				double a = G->A[IDX(i, k, n1)];
+
+				for (size_t l = 0; l < n2; l++) {
+					double b = H->A[IDX(j, l, n2)];
+					double v = 0.0;
+
+					/*A ⊗ I e I ⊗ B*/
+					if (kind != PRODUCT_TENSOR) {
+						v += (j == l ? a : 0.0) + (i == k ? b : 0.0);
+					}
+
+					/*A ⊗ B*/
+					if (kind != PRODUCT_CARTESIAN) {
+						v += a * b;
+					}
+
+					row[k * n2 + l] = v;
+				}
+			}
+		}
+	}
+
+	return P;
+}
+
+Graph* graph_cartesian_product(const Graph* G, const Graph* H) {
+	return product(G, H, PRODUCT_CARTESIAN);
+}
+
+Graph* graph_tensor_product(const Graph* G, const Graph* H) {
+	return product(G, H, PRODUCT_TENSOR);
+}
+
+Graph* graph_strong_product(const Graph* G, const Graph* H) {
+	return product(G, H, PRODUCT_STRONG);
+}
+
+Graph* graph_complement(const Graph* G) {
+	size_t n = G->n;
+	Graph* C = graph_new(n, G->directed);
+
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = 0; j < n; j++) {
+			if (i != j && G->A[IDX(i, j, n)] == 0.0) {
+				C->A[IDX(i, j, n)] = 1.0;
+			}
+		}
+	}
+
+	return C;
+}
+
+Graph* graph_line_graph(const Graph* G) {
+	if (G->directed) {
+		die("graph_line_graph: grafo direcionado");
+	}
+
+	size_t n = G->n;
+	size_t m = graph_num_nonloop_edges(G);
+
+	/*inc[v] = lista das arestas que tocam v*/
+	size_t* start = calloc(n + 1, sizeof(size_t));
+	size_t* inc = malloc((2 * m + 1) * sizeof(size_t));
+
+	if (!start || !inc) {
+		die("malloc error (start || inc)");
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = i + 1; j < n; j++) {
+			if (G->A[IDX(i, j, n)] != 0.0) {
+				start[i + 1]++;
+				start[j + 1]++;
+			}
+		}
+	}
+
+	for (size_t v = 0; v < n; v++) {
+		start[v + 1] += start[v];
+	}
+
+	size_t* fill = malloc((n + 1) * sizeof(size_t));
+
+	if (!fill) {
+		die("malloc error (fill)");
+	}
+
+	memcpy(fill, start, (n + 1) * sizeof(size_t));
+
+	for (size_t i = 0, e = 0; i < n; i++) {
+		for (size_t j = i + 1; j < n; j++) {
+			if (G->A[IDX(i, j, n)] != 0.0) {
+				inc[fill[i]++] = e;
+				inc[fill[j]++] = e;
+				e++;
+			}
+		}
+	}
+
+	/*duas arestas são vizinhas em L(G) se dividem um vértice*/
+	Graph* L = graph_new(m, false);
+
+	for (size_t v = 0; v < n; v++) {
+		for (size_t a = start[v]; a < start[v + 1]; a++) {
+			for (size_t b = a + 1; b < start[v + 1]; b++) {
+				L->A[IDX(inc[a], inc[b], m)] = 1.0;
+				L->A[IDX(inc[b], inc[a], m)] = 1.0;
+			}
+		}
+	}
+
+	free(start);
+	free(inc);
+	free(fill);
+
+	return L;
+}
+
+
+/* --- Espectros --- */
+
+static int spec_product(const Graph* G, const Graph* H, double* x,
+	ProductKind kind) {
+	if (G->directed || H->directed) {
+		return -1;
+	}
+
+	size_t n1 = G->n, n2 = H->n;
+	double* l = malloc((n1 + 1) * sizeof(double));
+	double* mu = malloc((n2 + 1) * sizeof(double));
+
+	if (!l || !mu) {
+		die("malloc error (l || mu)");
+	}
+
+	int info = graph_spec_adj(G, l);
+
+	if (info == 0) {
+		info = graph_spec_adj(H, mu);
+	}
+
+	if (info == 0) {
+		for (size_t i = 0; i < n1; i++) {
+			for (size_t j = 0; j < n2; j++) {
+				double v;
+
+				switch (kind) {
+				case PRODUCT_CARTESIAN:
+					v = l[i] + mu[j];
+					break;
+				case PRODUCT_TENSOR:
+					v = l[i] * mu[j];
+					break;
+				default:
+					v = (l[i] + 1.0) * (mu[j] + 1.0) - 1.0;
+					break;
+				}
+
+				x[i * n2 + j] = v;
+			}
+		}
+
+		qsort(x, n1 * n2, sizeof(double), cmp_double);
+	}
+
+	free(l);
+	free(mu);
+
+	return info;
+}
+
+int graph_spec_cartesian_product(const Graph* G, const Graph* H, double* x) {
+	return spec_product(G, H, x, PRODUCT_CARTESIAN);
+}
+
+int graph_spec_tensor_product(const Graph* G, const Graph* H, double* x) {
+	return spec_product(G, H, x, PRODUCT_TENSOR);
+}
+
+int graph_spec_strong_product(const Graph* G, const Graph* H, double* x) {
+	return spec_product(G, H, x, PRODUCT_STRONG);
+}
+
+/*G é simples: pesos 0/1, sem laços*/
+static bool is_simple(const Graph* G) {
+	size_t n = G->n;
+
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = 0; j < n; j++) {
+			double a = G->A[IDX(i, j, n)];
+
+			if ((a != 0.0 && a != 1.0) || (i == j && a != 0.0)) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/*Se G é simples e k-regular, coloca k em *k*/
+static bool simple_regular(const Graph* G, double* k) {
+	size_t n = G->n;
+
+	if (!is_simple(G)) {
+		return false;
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		double d = 0.0;
+
+		for (size_t j = 0; j < n; j++) {
+			d += G->A[IDX(i, j, n)];
+		}
+
+		if (i == 0) {
+			*k = d;
+		} else if (d != *k) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int graph_spec_complement(const Graph* G, double* x) {
+	if (G->directed) {
+		return -1;
+	}
+
+	size_t n = G->n;
+	double k;
+
+	if (n == 0) {
+		return 0;
+	}
+
+	if (!simple_regular(G, &k)) {
+		Graph* C = graph_complement(G);
+		int info = graph_spec_adj(C, x);
+		graph_free(C);
+
+		return info;
+	}
+
+	double* l = malloc(n * sizeof(double));
+
+	if (!l) {
+		die("malloc error (l)");
+	}
+
+	int info = graph_spec_adj(G, l);
+
+	if (info == 0) {
+		/*tira a cópia de k mais próxima (o maior autovalor é k)*/
+		size_t skip = n - 1;
+
+		for (size_t i = 0, j = 0; i < n; i++) {
+			if (i != skip) {
+				x[j++] = -1.0 - l[i];
+			}
+		}
+
+		x[n - 1] = (double) n - 1.0 - k;
+		qsort(x, n, sizeof(double), cmp_double);
+	}
+
+	free(l);
+
+	return info;
+}
+
+int graph_spec_line_graph(const Graph* G, double* x) {
+	if (G->directed) {
+		return -1;
+	}
+
+	size_t n = G->n;
+	size_t m = graph_num_nonloop_edges(G);
+
+	if (m == 0) {
+		return 0;
+	}
+
+	/*com pesos ou laços, D + A não é mais BBᵀ da incidência 0/1 que
+	graph_line_graph usa: monta L(G) e chama o eigensolver*/
+	if (!is_simple(G)) {
+		Graph* L = graph_line_graph(G);
+		int info = graph_spec_adj(L, x);
+		graph_free(L);
+
+		return info;
+	}
+
+	/*Q = D + A (laplaciana sem sinal)*/
+	double* Q = malloc(n * n * sizeof(double));
+	double* q = malloc(n * sizeof(double));
+	double* deg = malloc(n * sizeof(double));
+
+	if (!Q || !q || !deg) {
+		die("malloc error (Q || q || deg)");
+	}
+
+	graph_degree(G, deg, NULL);
+	memcpy(Q, G->A, n * n * sizeof(double));
+
+	for (size_t i = 0; i < n; i++) {
+		Q[IDX(i, i, n)] += deg[i];
+	}
+
+	int info = matrix_spec(Q, n, q);
+
+	if (info == 0) {
+		/*BᵀB (m x m) tem os autovalores de BBᵀ (n x n), mais zeros
+		se m > n ou menos os n - m menores se m < n*/
+		size_t j = 0;
+
+		for (size_t i = 0; i + n < m; i++) {
+			x[j++] = -2.0;
+		}
+
+		for (size_t i = (m < n) ? n - m : 0; i < n; i++) {
+			x[j++] = q[i] - 2.0;
+		}
+	}
+
+	free(Q);
+	free(q);
+	free(deg);
+
+	return info;
+}
@@ -0,0 +1,72 @@
+#ifndef PRODUCTS_H
+#define PRODUCTS_H
+
+/* --- Produtos de grafos, complemento e grafo linha --- */
+
+/*
+No produto de G (n1 vértices) por H (n2 vértices), o vértice (i, j)
+recebe o índice i * n2 + j. Com A = A(G) e B = A(H):
+
+cartesiano: A ⊗ I + I ⊗ B         espectro {λ_i + μ_j}
+tensorial:  A ⊗ B                 espectro {λ_i μ_j}
+forte:      A ⊗ I + I ⊗ B + A ⊗ B espectro {(λ_i + 1)(μ_j + 1) - 1}
+
+Então as funções graph_spec_*_product só precisam dos espectros dos
+fatores (que ficam em cache, veja cache.h): custo O(n1³ + n2³) para
+os fatores e O(n1 n2 log(n1 n2)) para montar e ordenar o resultado,
+em vez de O((n1 n2)³).
+
+Para o complemento de um grafo k-regular, o espectro é
+{n - 1 - k} ∪ {-1 - λ : λ autovalor de G, tirando uma cópia de k};
+se G não for regular a função monta o complemento e chama o
+eigensolver.
+
+Para o grafo linha L(G), com m arestas: A(L(G)) = BᵀB - 2I, onde B é
+a matriz de incidência sem sinal, e BBᵀ = D + A é a laplaciana sem
+sinal. Então o espectro de L(G) sai do espectro (n x n) de D + A, mais
+-2 com multiplicidade m - n, em vez de um eigensolve m x m. Isso só
+vale para G simples (0/1, sem laços); com pesos ou laços a função
+monta L(G) como graph_line_graph (ignorando os pesos) e chama o
+eigensolver.
+
+As funções espectrais só aceitam grafos não direcionados e retornam
+-1 caso contrário (ou o info do LAPACK, se > 0).
+*/
+
+#include "graphs.h"
+
+
+/*Constroem os produtos (free-after-use); G e H devem ter o mesmo
+tipo (direcionado ou não)*/
+Graph* graph_cartesian_product(const Graph* G, const Graph* H);
+Graph* graph_tensor_product(const Graph* G, const Graph* H);
+Graph* graph_strong_product(const Graph* G, const Graph* H);
+
+
+/*Complemento de G (sem laços). Os pesos de G são ignorados: uv é
+aresta do complemento se e só se A[u][v] == 0*/
+Graph* graph_complement(const Graph* G);
+
+
+/*Grafo linha de G (não direcionado, sem laços). A k-ésima aresta de
+G, na ordem em que aparece na parte triangular superior de A (linha
+a linha), é o vértice k de L(G). Os pesos e laços de G são ignorados:
+L(G) é sempre 0/1*/
+Graph* graph_line_graph(const Graph* G);
+
+
+/*x deve ter espaço para n1 * n2 doubles (ordem crescente)*/
+int graph_spec_cartesian_product(const Graph* G, const Graph* H, double* x);
+int graph_spec_tensor_product(const Graph* G, const Graph* H, double* x);
+int graph_spec_strong_product(const Graph* G, const Graph* H, double* x);
+
+
+/*x deve ter espaço para n doubles*/
+int graph_spec_complement(const Graph* G, double* x);
+
+
+/*x deve ter espaço para graph_num_nonloop_edges(G) doubles (os laços
+não viram vértices de L(G))*/
+int graph_spec_line_graph(const Graph* G, double* x);
+
+#endif
@@ -0,0 +1,780 @@
+#include <stdlib.h>
+#include <string.h>
+#include "reorder.h"
+#include "cache.h"
+
+/*Padrão simetrizado, sem laços, vizinhos em ordem crescente*/
+typedef struct {
+	size_t n;
+	size_t* rowptr;
+	size_t* col;
+} SymAdj;
+
+static void* xmalloc(size_t count, size_t size) {
+	void* p = malloc((count ? count : 1) * size);
+
+	if (!p) {
+		die("malloc error (reorder)");
+	}
+
+	return p;
+}
+
+static void sym_free(SymAdj* a) {
+	free(a->rowptr);
+	free(a->col);
+}
+
+static void sym_from_graph(const Graph* g, SymAdj* a) {
+	size_t n = g->n;
+	a->n = n;
+	a->rowptr = xmalloc(n + 1, sizeof(size_t));
+
+	/*primeira passada conta, a segunda preenche*/
+	for (int pass = 0; pass < 2; pass++) {
+		size_t k = 0;
+
+		for (size_t i = 0; i < n; i++) {
+			a->rowptr[i] = k;
+
+			for (size_t j = 0; j < n; j++) {
+				bool adj = g->A[IDX(i, j, n)] != 0.0
+					|| (g->directed && g->A[IDX(j, i, n)] != 0.0);
+
+				if (j != i && adj) {
+					if (pass == 1) {
+						a->col[k] = j;
+					}
+
+					k++;
+				}
+			}
+		}
+
+		a->rowptr[n] = k;
+
+		if (pass == 0) {
+			a->col = xmalloc(k, sizeof(size_t));
+		}
+	}
+}
+
+static int cmp_size(const void* a, const void* b) {
+	size_t x = *(const size_t*) a, y = *(const size_t*) b;
+
+	return (x > y) - (x < y);
+}
+
+static void sym_from_csr(const GraphCSR* g, SymAdj* a) {
+	size_t n = g->n;
+	size_t* cnt = calloc(n + 1, sizeof(size_t));
+
+	if (!cnt) {
+		die("malloc error (cnt)");
+	}
+
+	a->n = n;
+	a->rowptr = xmalloc(n + 1, sizeof(size_t));
+
+	for (size_t u = 0; u < n; u++) {
+		for (size_t e = g->rowptr[u]; e < g->rowptr[u + 1]; e++) {
+			if (g->col[e] != u) {
+				cnt[u]++;
+
+				if (g->directed) {
+					cnt[g->col[e]]++;
+				}
+			}
+		}
+	}
+
+	a->rowptr[0] = 0;
+
+	for (size_t u = 0; u < n; u++) {
+		a->rowptr[u + 1] = a->rowptr[u] + cnt[u];
+		cnt[u] = a->rowptr[u];
+	}
+
+	a->col = xmalloc(a->rowptr[n], sizeof(size_t));
+
+	for (size_t u = 0; u < n; u++) {
+		for (size_t e = g->rowptr[u]; e < g->rowptr[u + 1]; e++) {
+			size_t v = g->col[e];
+
+			if (v != u) {
+				a->col[cnt[u]++] = v;
+
+				if (g->directed) {
+					a->col[cnt[v]++] = u;
+				}
+			}
+		}
+	}
+
+	free(cnt);
+
+	if (!g->directed) {
+		return;
+	}
+
+	/*direcionado: u -> v e v -> u viram duas cópias; ordena e compacta*/
+	size_t k = 0;
+
+	for (size_t u = 0; u < n; u++) {
+		size_t b = a->rowptr[u], e = a->rowptr[u + 1];
+		qsort(&a->col[b], e - b, sizeof(size_t), cmp_size);
+		a->rowptr[u] = k;
+
+		for (size_t i = b; i < e; i++) {
+			if (i == b || a->col[i] != a->col[i - 1]) {
+				a->col[k++] = a->col[i];
+			}
+		}
+	}
+
+	a->rowptr[n] = k;
+}
+
+
+/* --- Banda e perfil --- */
+
+void graph_bandwidth(const Graph* g, GraphBandwidth* b) {
+	size_t n = g->n;
+	b->bandwidth = b->profile = 0;
+
+	for (size_t i = 0; i < n; i++) {
+		const double* row = &g->A[IDX(i, 0, n)];
+		size_t first = n, last = 0;
+		bool any = false;
+
+		for (size_t j = 0; j < n; j++) {
+			if (row[j] != 0.0) {
+				first = any ? first : j;
+				last = j;
+				any = true;
+			}
+		}
+
+		if (!any) {
+			continue;
+		}
+
+		size_t lo = i - (first < i ? first : i);
+		size_t hi = last > i ? last - i : 0;
+		b->bandwidth = lo > b->bandwidth ? lo : b->bandwidth;
+		b->bandwidth = hi > b->bandwidth ? hi : b->bandwidth;
+		b->profile += lo;
+	}
+}
+
+void graph_csr_bandwidth(const GraphCSR* g, GraphBandwidth* b) {
+	b->bandwidth = b->profile = 0;
+
+	for (size_t i = 0; i < g->n; i++) {
+		size_t lo = 0;
+
+		for (size_t e = g->rowptr[i]; e < g->rowptr[i + 1]; e++) {
+			size_t j = g->col[e];
+			size_t d = j > i ? j - i : i - j;
+
+			b->bandwidth = d > b->bandwidth ? d : b->bandwidth;
+			lo = j < i && i - j > lo ? i - j : lo;
+		}
+
+		b->profile += lo;
+	}
+}
+
+
+/* --- RCM --- */
+
+typedef struct {
+	size_t deg, v;
+} DegVertex;
+
+static int cmp_deg_asc(const void* a, const void* b) {
+	const DegVertex* x = a;
+	const DegVertex* y = b;
+
+	if (x->deg != y->deg) {
+		return (x->deg > y->deg) - (x->deg < y->deg);
+	}
+
+	return (x->v > y->v) - (x->v < y->v);
+}
+
+static int cmp_deg_desc(const void* a, const void* b) {
+	const DegVertex* x = a;
+	const DegVertex* y = b;
+
+	if (x->deg != y->deg) {
+		return (x->deg < y->deg) - (x->deg > y->deg);
+	}
+
+	return (x->v > y->v) - (x->v < y->v);
+}
+
+#define DEG(a, v) ((a)->rowptr[(v) + 1] - (a)->rowptr[v])
+
+/*BFS de r marcando level com stamp; devolve a excentricidade e, em
+*far, o vértice de menor grau do último nível*/
+static size_t bfs_levels(const SymAdj* a, size_t r, size_t* level,
+	size_t* queue, size_t* far) {
+	size_t head = 0, tail = 0;
+	queue[tail++] = r;
+	level[r] = 0;
+
+	while (head < tail) {
+		size_t u = queue[head++];
+
+		for (size_t e = a->rowptr[u]; e < a->rowptr[u + 1]; e++) {
+			size_t v = a->col[e];
+
+			if (level[v] == SIZE_MAX) {
+				level[v] = level[u] + 1;
+				queue[tail++] = v;
+			}
+		}
+	}
+
+	size_t ecc = level[queue[tail - 1]];
+	*far = queue[tail - 1];
+
+	for (size_t i = tail; i-- > 0 && level[queue[i]] == ecc;) {
+		if (DEG(a, queue[i]) < DEG(a, *far)) {
+			*far = queue[i];
+		}
+	}
+
+	/*limpa só o que foi visitado*/
+	for (size_t i = 0; i < tail; i++) {
+		level[queue[i]] = SIZE_MAX;
+	}
+
+	return ecc;
+}
+
+/*George–Liu: anda para o vértice mais distante enquanto a
+excentricidade crescer*/
+static size_t pseudo_peripheral(const SymAdj* a, size_t r, size_t* level,
+	size_t* queue) {
+	size_t far;
+	size_t ecc = bfs_levels(a, r, level, queue, &far);
+
+	for (int it = 0; it < 10; it++) {
+		size_t next;
+		size_t e2 = bfs_levels(a, far, level, queue, &next);
+
+		if (e2 <= ecc) {
+			break;
+		}
+
+		r = far;
+		ecc = e2;
+		far = next;
+	}
+
+	return r;
+}
+
+static void order_rcm(const SymAdj* a, size_t* perm) {
+	size_t n = a->n;
+	size_t* level = xmalloc(n, sizeof(size_t));
+	size_t* queue = xmalloc(n, sizeof(size_t));
+	bool* seen = calloc(n + 1, sizeof(bool));
+	DegVertex* by_deg = xmalloc(n, sizeof(DegVertex));
+	DegVertex* nb = xmalloc(n, sizeof(DegVertex));
+
+	if (!seen) {
+		die("malloc error (seen)");
+	}
+
+	for (size_t v = 0; v < n; v++) {
+		level[v] = SIZE_MAX;
+		by_deg[v] = (DegVertex) {DEG(a, v), v};
+	}
+
+	qsort(by_deg, n, sizeof(DegVertex), cmp_deg_asc);
+
+	size_t k = 0;
+
+	/*uma componente por vez, começando pelo vértice de menor grau*/
+	for (size_t s = 0; s < n; s++) {
+		if (seen[by_deg[s].v]) {
+			continue;
+		}
+
+		size_t r = pseudo_peripheral(a, by_deg[s].v, level, queue);
+		size_t head = k;
+		perm[k++] = r;
+		seen[r] = true;
+
+		while (head < k) {
+			size_t u = perm[head++];
+			size_t m = 0;
+
+			for (size_t e = a->rowptr[u]; e < a->rowptr[u + 1]; e++) {
+				size_t v = a->col[e];
+
+				if (!seen[v]) {
+					seen[v] = true;
+					nb[m++] = (DegVertex) {DEG(a, v), v};
+				}
+			}
+
+			qsort(nb, m, sizeof(DegVertex), cmp_deg_asc);
+
+			for (size_t i = 0; i < m; i++) {
+				perm[k++] = nb[i].v;
+			}
+		}
+	}
+
+	/*reverso*/
+	for (size_t i = 0; i < n / 2; i++) {
+		size_t t = perm[i];
+		perm[i] = perm[n - 1 - i];
+		perm[n - 1 - i] = t;
+	}
+
+	free(level);
+	free(queue);
+	free(seen);
+	free(by_deg);
+	free(nb);
+}
+
+static void order_degree(const SymAdj* a, size_t* perm) {
+	DegVertex* by_deg = xmalloc(a->n, sizeof(DegVertex));
+
+	for (size_t v = 0; v < a->n; v++) {
+		by_deg[v] = (DegVertex) {DEG(a, v), v};
+	}
+
+	qsort(by_deg, a->n, sizeof(DegVertex), cmp_deg_desc);
+
+	for (size_t v = 0; v < a->n; v++) {
+		perm[v] = by_deg[v].v;
+	}
+
+	free(by_deg);
+}
+
+
+/* --- Gorder --- */
+
+/*Heap de máximo "preguiçoso": cada mudança de score empilha uma
+entrada nova; entradas velhas são descartadas ao sair*/
+typedef struct {
+	long score;
+	size_t v;
+} HeapItem;
+
+typedef struct {
+	HeapItem* items;
+	size_t len, cap;
+} LazyHeap;
+
+static void heap_push(LazyHeap* h, long score, size_t v) {
+	if (h->len == h->cap) {
+		h->cap = h->cap ? 2 * h->cap : 64;
+		h->items = realloc(h->items, h->cap * sizeof(HeapItem));
+
+		if (!h->items) {
+			die("malloc error (heap)");
+		}
+	}
+
+	size_t i = h->len++;
+
+	while (i > 0 && h->items[(i - 1) / 2].score < score) {
+		h->items[i] = h->items[(i - 1) / 2];
+		i = (i - 1) / 2;
+	}
+
+	h->items[i] = (HeapItem) {score, v};
+}
+
+static HeapItem heap_pop(LazyHeap* h) {
+	HeapItem top = h->items[0];
+	HeapItem last = h->items[--h->len];
+	size_t i = 0;
+
+	for (;;) {
+		size_t c = 2 * i + 1;
+
+		if (c >= h->len) {
+			break;
+		}
+
+		if (c + 1 < h->len && h->items[c + 1].score > h->items[c].score) {
+			c++;
+		}
+
+		if (h->items[c].score <= last.score) {
+			break;
+		}
+
+		h->items[i] = h->items[c];
+		i = c;
+	}
+
+	if (h->len > 0) {
+		h->items[i] = last;
+	}
+
+	return top;
+}
+
+/*Entrada (delta = 1) ou saída (delta = -1) de u da janela: vizinhos
+de u e vizinhos dos vizinhos (que compartilham um vizinho com u)
+mudam de score*/
+static void window_update(const SymAdj* a, size_t u, long delta,
+	long* score, const bool* placed, LazyHeap* h) {
+	for (size_t e = a->rowptr[u]; e < a->rowptr[u + 1]; e++) {
+		size_t w = a->col[e];
+
+		if (!placed[w]) {
+			score[w] += delta;
+			heap_push(h, score[w], w);
+		}
+
+		for (size_t f = a->rowptr[w]; f < a->rowptr[w + 1]; f++) {
+			size_t v = a->col[f];
+
+			if (!placed[v] && v != u) {
+				score[v] += delta;
+				heap_push(h, score[v], v);
+			}
+		}
+	}
+}
+
+static void order_gorder(const SymAdj* a, size_t* perm) {
+	size_t n = a->n;
+	long* score = calloc(n + 1, sizeof(long));
+	bool* placed = calloc(n + 1, sizeof(bool));
+	DegVertex* by_deg = xmalloc(n, sizeof(DegVertex));
+	LazyHeap h = {NULL, 0, 0};
+
+	if (!score || !placed) {
+		die("malloc error (score || placed)");
+	}
+
+	for (size_t v = 0; v < n; v++) {
+		by_deg[v] = (DegVertex) {DEG(a, v), v};
+	}
+
+	qsort(by_deg, n, sizeof(DegVertex), cmp_deg_desc);
+
+	size_t next_deg = 0;
+
+	for (size_t k = 0; k < n; k++) {
+		size_t v = n;
+
+		while (h.len > 0) {
+			HeapItem it = heap_pop(&h);
+
+			if (!placed[it.v] && it.score == score[it.v]) {
+				v = it.v;
+				break;
+			}
+		}
+
+		/*nada ligado à janela: o de maior grau que falta*/
+		if (v == n) {
+			while (placed[by_deg[next_deg].v]) {
+				next_deg++;
+			}
+
+			v = by_deg[next_deg].v;
+		}
+
+		perm[k] = v;
+		placed[v] = true;
+
+		if (k >= GORDER_WINDOW) {
+			window_update(a, perm[k - GORDER_WINDOW], -1, score, placed, &h);
+		}
+
+		window_update(a, v, 1, score, placed, &h);
+	}
+
+	free(score);
+	free(placed);
+	free(by_deg);
+	free(h.items);
+}
+
+static int order_sym(const SymAdj* a, GraphOrder method, size_t* perm) {
+	switch (method) {
+	case GRAPH_ORDER_RCM:
+		order_rcm(a, perm);
+		return 0;
+	case GRAPH_ORDER_DEGREE:
+		order_degree(a, perm);
+		return 0;
+	case GRAPH_ORDER_GORDER:
+		order_gorder(a, perm);
+		return 0;
+	default:
+		return -1;
+	}
+}
+
+int graph_order(const Graph* g, GraphOrder method, size_t* perm) {
+	SymAdj a;
+	sym_from_graph(g, &a);
+	int info = order_sym(&a, method, perm);
+	sym_free(&a);
+
+	return info;
+}
+
+int graph_csr_order(const GraphCSR* g, GraphOrder method, size_t* perm) {
+	SymAdj a;
+	sym_from_csr(g, &a);
+	int info = order_sym(&a, method, perm);
+	sym_free(&a);
+
+	return info;
+}
+
+
+/* --- Aplicação da permutação --- */
+
+void vector_permute(double* x, const size_t* perm, size_t n) {
+	bool* done = calloc(n + 1, sizeof(bool));
+
+	if (!done) {
+		die("malloc error (done)");
+	}
+
+	/*segue cada ciclo i -> perm[i] -> ...*/
+	for (size_t s = 0; s < n; s++) {
+		if (done[s]) {
+			continue;
+		}
+
+		double first = x[s];
+		size_t i = s;
+
+		while (perm[i] != s) {
+			x[i] = x[perm[i]];
+			done[i] = true;
+			i = perm[i];
+		}
+
+		x[i] = first;
+		done[i] = true;
+	}
+
+	free(done);
+}
+
+void vector_unpermute(double* x, const size_t* perm, size_t n) {
+	bool* done = calloc(n + 1, sizeof(bool));
+
+	if (!done) {
+		die("malloc error (done)");
+	}
+
+	for (size_t s = 0; s < n; s++) {
+		if (done[s]) {
+			continue;
+		}
+
+		double carry = x[s];
+		size_t i = s;
+
+		do {
+			size_t j = perm[i];
+			double t = x[j];
+			x[j] = carry;
+			carry = t;
+			done[j] = true;
+			i = j;
+		} while (i != s);
+	}
+
+	free(done);
+}
+
+/*Linhas: mesmo ciclo de vector_permute, uma linha inteira por vez*/
+static void permute_rows(double* A, size_t n, const size_t* perm,
+	double* tmp) {
+	bool* done = calloc(n + 1, sizeof(bool));
+
+	if (!done) {
+		die("malloc error (done)");
+	}
+
+	size_t bytes = n * sizeof(double);
+
+	for (size_t s = 0; s < n; s++) {
+		if (done[s]) {
+			continue;
+		}
+
+		memcpy(tmp, &A[IDX(s, 0, n)], bytes);
+		size_t i = s;
+
+		while (perm[i] != s) {
+			memcpy(&A[IDX(i, 0, n)], &A[IDX(perm[i], 0, n)], bytes);
+			done[i] = true;
+			i = perm[i];
+		}
+
+		memcpy(&A[IDX(i, 0, n)], tmp, bytes);
+		done[i] = true;
+	}
+
+	free(done);
+}
+
+/*Chaves do cache que não dependem da numeração*/
+static const GraphCacheKey invariant_scalars[] = {
+	GRAPH_CACHE_NUM_EDGES, GRAPH_CACHE_CONNECTED, GRAPH_CACHE_DIAMETER,
+	GRAPH_CACHE_WIENER
+};
+
+static const GraphCacheKey invariant_vectors[] = {
+	GRAPH_CACHE_SPEC_ADJ, GRAPH_CACHE_SPEC_LAP, GRAPH_CACHE_SPEC_DISTANCE,
+	GRAPH_CACHE_SPEC_DISTANCE_LAP
+};
+
+#define NSCALARS (sizeof(invariant_scalars) / sizeof(invariant_scalars[0]))
+#define NVECTORS (sizeof(invariant_vectors) / sizeof(invariant_vectors[0]))
+
+void graph_permute(Graph* g, const size_t* perm) {
+	size_t n = g->n;
+	double* tmp = xmalloc(n, sizeof(double));
+
+	/*guarda o que continua valendo antes de invalidar*/
+	double scalars[NSCALARS];
+	bool has_scalar[NSCALARS];
+	double* vectors[NVECTORS];
+
+	for (size_t k = 0; k < NSCALARS; k++) {
+		/*direcionado: "conexo" é alcançar tudo a partir do vértice 0*/
+		bool skip = g->directed
+			&& invariant_scalars[k] == GRAPH_CACHE_CONNECTED;
+		has_scalar[k] = !skip
+			&& graph_cache_get_scalar(g, invariant_scalars[k], &scalars[k]);
+	}
+
+	for (size_t k = 0; k < NVECTORS; k++) {
+		vectors[k] = xmalloc(n, sizeof(double));
+
+		if (!graph_cache_get_vec(g, invariant_vectors[k], vectors[k], n)) {
+			free(vectors[k]);
+			vectors[k] = NULL;
+		}
+	}
+
+	permute_rows(g->A, n, perm, tmp);
+
+	for (size_t i = 0; i < n; i++) {
+		double* row = &g->A[IDX(i, 0, n)];
+
+		for (size_t j = 0; j < n; j++) {
+			tmp[j] = row[perm[j]];
+		}
+
+		memcpy(row, tmp, n * sizeof(double));
+	}
+
+	graph_invalidate(g);
+
+	for (size_t k = 0; k < NSCALARS; k++) {
+		if (has_scalar[k]) {
+			graph_cache_put_scalar(g, invariant_scalars[k], scalars[k]);
+		}
+	}
+
+	for (size_t k = 0; k < NVECTORS; k++) {
+		if (vectors[k]) {
+			graph_cache_put_vec(g, invariant_vectors[k], vectors[k], n);
+			free(vectors[k]);
+		}
+	}
+
+	free(tmp);
+}
+
+int graph_reorder(Graph* g, GraphOrder method, size_t* perm) {
+	int info = graph_order(g, method, perm);
+
+	if (info == 0) {
+		graph_permute(g, perm);
+	}
+
+	return info;
+}
+
+typedef struct {
+	size_t col;
+	double w;
+} Entry;
+
+static int cmp_entry(const void* a, const void* b) {
+	size_t x = ((const Entry*) a)->col, y = ((const Entry*) b)->col;
+
+	return (x > y) - (x < y);
+}
+
+GraphCSR* graph_csr_permute(const GraphCSR* g, const size_t* perm) {
+	size_t n = g->n, nnz = g->rowptr[n];
+	size_t* inv = xmalloc(n, sizeof(size_t));
+	GraphCSR* c = calloc(1, sizeof(GraphCSR));
+
+	if (!c) {
+		die("malloc error (GraphCSR)");
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		inv[perm[i]] = i;
+	}
+
+	c->n = n;
+	c->directed = g->directed;
+	c->rowptr = xmalloc(n + 1, sizeof(size_t));
+	c->col = xmalloc(nnz, sizeof(size_t));
+	c->w = g->w ? xmalloc(nnz, sizeof(double)) : NULL;
+
+	Entry* row = NULL;
+	size_t cap = 0, k = 0;
+	c->rowptr[0] = 0;
+
+	for (size_t i = 0; i < n; i++) {
+		size_t old = perm[i];
+		size_t b = g->rowptr[old], len = g->rowptr[old + 1] - b;
+
+		if (len > cap) {
+			cap = len;
+			free(row);
+			row = xmalloc(cap, sizeof(Entry));
+		}
+
+		for (size_t e = 0; e < len; e++) {
+			row[e] = (Entry) {inv[g->col[b + e]], CSR_W(g, b + e)};
+		}
+
+		qsort(row, len, sizeof(Entry), cmp_entry);
+
+		for (size_t e = 0; e < len; e++, k++) {
+			c->col[k] = row[e].col;
+
+			if (c->w) {
+				c->w[k] = row[e].w;
+			}
+		}
+
+		c->rowptr[i + 1] = k;
+	}
+
+	free(row);
+	free(inv);
+
+	return c;
+}
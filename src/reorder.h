@@ -0,0 +1,78 @@
+#ifndef REORDER_H
+#define REORDER_H
+
+/* --- Renumeração de vértices para localidade --- */
+
+/*
+A numeração dos vértices que vem do arquivo (graph_read_from_file) é
+arbitrária. Num grafo esparso, vizinhos ficam espalhados pela memória
+e cada passo de BFS ou de y = Ax (GraphCSR) lê uma linha de cache
+diferente. Renumerar os vértices para que vizinhos fiquem próximos
+reduz essas faltas:
+
+- GRAPH_ORDER_RCM: Cuthill–McKee reverso, BFS a partir de um vértice
+  pseudo-periférico, vizinhos em ordem crescente de grau. Minimiza
+  banda e perfil (bom para malhas e grafos "compridos");
+- GRAPH_ORDER_DEGREE: grau decrescente; os hubs ficam juntos no
+  começo (bom para grafos com lei de potência);
+- GRAPH_ORDER_GORDER: Gorder (Wei et al.), guloso com uma janela dos
+  GORDER_WINDOW últimos vértices: o próximo é o que mais compartilha
+  vizinhos com a janela ou é vizinho dela, o que agrupa comunidades.
+
+Todas usam o padrão simetrizado (u ~ v se A[u][v] ou A[v][u] != 0).
+
+Convenção: perm[novo] = antigo. Depois de graph_permute(g, perm) o
+vértice i de g é o antigo perm[i]; um vetor calculado no grafo
+renumerado (graus, distâncias, autovetores...) volta para os ids
+originais com vector_unpermute.
+*/
+
+#include "graphs.h"
+
+typedef enum {
+	GRAPH_ORDER_RCM,
+	GRAPH_ORDER_DEGREE,
+	GRAPH_ORDER_GORDER
+} GraphOrder;
+
+#define GORDER_WINDOW 5
+
+/*Banda: max |i - j| sobre as entradas não nulas; perfil (envelope):
+Σ_i (i - menor j <= i com A[i][j] != 0)*/
+typedef struct {
+	size_t bandwidth;
+	size_t profile;
+} GraphBandwidth;
+
+
+void graph_bandwidth(const Graph* g, GraphBandwidth* b);
+void graph_csr_bandwidth(const GraphCSR* g, GraphBandwidth* b);
+
+
+/*Calcula a ordem (perm com n posições) sem mexer em g. Retorna -1 se
+method for inválido*/
+int graph_order(const Graph* g, GraphOrder method, size_t* perm);
+int graph_csr_order(const GraphCSR* g, GraphOrder method, size_t* perm);
+
+
+/*Renumera g no lugar: A vira P A Pᵀ usando O(n) de memória extra.
+Espectros e escalares em cache (invariantes) continuam valendo*/
+void graph_permute(Graph* g, const size_t* perm);
+
+
+/*graph_order + graph_permute. perm recebe a ordem usada*/
+int graph_reorder(Graph* g, GraphOrder method, size_t* perm);
+
+
+/*Novo GraphCSR renumerado (free-after-use com graph_csr_free)*/
+GraphCSR* graph_csr_permute(const GraphCSR* g, const size_t* perm);
+
+
+/*No lugar: x[i] = x_antigo[perm[i]] (ids originais -> novos)*/
+void vector_permute(double* x, const size_t* perm, size_t n);
+
+
+/*No lugar: x_antigo[perm[i]] = x[i] (ids novos -> originais)*/
+void vector_unpermute(double* x, const size_t* perm, size_t n);
+
+#endif
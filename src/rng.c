@@ -0,0 +1,70 @@
+#include <stdlib.h>
+#include "rng.h"
+
+uint64_t rng_mix64(uint64_t z) {
+	z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+	z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+
+	return z ^ (z >> 31);
+}
+
+static uint64_t splitmix64(uint64_t* x) {
+	return rng_mix64(*x += RNG_GOLDEN);
+}
+
+static inline uint64_t rotl(uint64_t x, int k) {
+	return (x << k) | (x >> (64 - k));
+}
+
+void rng_seed(Rng* r, uint64_t seed) {
+	for (int i = 0; i < 4; i++) {
+		r->s[i] = splitmix64(&seed);
+	}
+}
+
+void rng_seed_stream(Rng* r, uint64_t seed, uint64_t stream) {
+	/*mistura stream antes, para seeds vizinhas não darem estados
+	vizinhos*/
+	uint64_t x = stream;
+	rng_seed(r, seed ^ splitmix64(&x));
+}
+
+uint64_t rng_next(Rng* r) {
+	uint64_t* s = r->s;
+	uint64_t result = rotl(s[1] * 5, 7) * 9;
+	uint64_t t = s[1] << 17;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = rotl(s[3], 45);
+
+	return result;
+}
+
+double rng_uniform(Rng* r) {
+	return (double) (rng_next(r) >> 11) * 0x1.0p-53;
+}
+
+double rng_uniform_or_rand(Rng* r) {
+	return r ? rng_uniform(r) : (double) rand() / RAND_MAX;
+}
+
+/*Lemire: multiplica e rejeita a faixa que causaria viés*/
+uint64_t rng_below(Rng* r, uint64_t n) {
+	unsigned __int128 m = (unsigned __int128) rng_next(r) * n;
+	uint64_t low = (uint64_t) m;
+
+	if (low < n) {
+		uint64_t threshold = -n % n;
+
+		while (low < threshold) {
+			m = (unsigned __int128) rng_next(r) * n;
+			low = (uint64_t) m;
+		}
+	}
+
+	return (uint64_t) (m >> 64);
+}
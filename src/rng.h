@@ -0,0 +1,56 @@
+#ifndef RNG_H
+#define RNG_H
+
+/* --- Gerador pseudoaleatório com estado explícito --- */
+
+/*
+rand() tem estado global: duas threads chamando rand() disputam o
+mesmo estado e o resultado depende da ordem em que rodaram. Rng é o
+xoshiro256** (Blackman e Vigna) com o estado numa struct, semeado por
+splitmix64, então cada thread (ou cada tentativa de um experimento,
+veja experiment.h) pode ter a sua sequência reproduzível.
+
+Os geradores graph_*_r de graphs.h recebem um Rng*; passar NULL usa
+rand(), que é o que as versões sem _r fazem.
+*/
+
+#include <stdint.h>
+
+typedef struct {
+	uint64_t s[4];
+} Rng;
+
+
+/*Inicializa r a partir de seed*/
+void rng_seed(Rng* r, uint64_t seed);
+
+
+/*Inicializa r com a sequência número stream derivada de seed. Sequências
+diferentes são independentes para efeitos práticos*/
+void rng_seed_stream(Rng* r, uint64_t seed, uint64_t stream);
+
+
+/*Finalizador do splitmix64: mistura os bits de z, sem estado. Serve
+para sorteios indexados (rng_mix64(seed + i * RNG_GOLDEN)) sem um Rng
+por posição*/
+#define RNG_GOLDEN UINT64_C(0x9e3779b97f4a7c15)
+uint64_t rng_mix64(uint64_t z);
+
+
+/*Próximos 64 bits*/
+uint64_t rng_next(Rng* r);
+
+
+/*Uniforme em [0, 1), 53 bits*/
+double rng_uniform(Rng* r);
+
+
+/*Uniforme em {0, ..., n - 1} sem viés (n > 0)*/
+uint64_t rng_below(Rng* r, uint64_t n);
+
+
+/*rng_uniform(r), ou rand() / RAND_MAX se r for NULL: o sorteio das
+funções _r*/
+double rng_uniform_or_rand(Rng* r);
+
+#endif
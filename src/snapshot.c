@@ -0,0 +1,682 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "snapshot.h"
+#include "cache.h"
+#include "mem.h"
+
+/*Alinhamento dos payloads (e do índice)*/
+#define SNAP_ALIGN 64
+
+/*Gravado na ordem da máquina: lido de volta dá outro valor se o
+arquivo veio de uma máquina com a outra ordem de bytes*/
+#define SNAP_ENDIAN 0x01020304u
+
+typedef enum {
+	SNAP_WEIGHT_NONE,		/* CSR sem pesos (todos 1)*/
+	SNAP_WEIGHT_F64			/* double*/
+} SnapWeight;
+
+typedef struct {
+	char magic[4];			/* "GBIN"*/
+	uint32_t version;		/* GRAPH_SNAPSHOT_VERSION*/
+	uint32_t endian;		/* SNAP_ENDIAN*/
+	uint32_t entry_size;	/* sizeof(SnapEntry)*/
+	uint64_t count;			/* N° de entradas*/
+	uint64_t index;			/* Posição do índice*/
+	uint64_t index_sum;		/* Checksum do índice*/
+	uint64_t sum;			/* Checksum do cabeçalho (com sum = 0)*/
+	uint64_t reserved[2];
+} SnapHeader;
+
+typedef struct {
+	uint64_t n;
+	uint32_t layout;		/* GraphLayout*/
+	uint32_t weight;		/* SnapWeight*/
+	uint32_t directed;
+	uint32_t reserved;
+	uint64_t nnz;			/* n * n (denso) ou rowptr[n] (CSR)*/
+	uint64_t offset;		/* Início do payload (múltiplo de SNAP_ALIGN)*/
+	uint64_t bytes;			/* Tamanho do payload, com o preenchimento*/
+	uint64_t sum;			/* Checksum do payload*/
+	uint64_t reserved2;
+} SnapEntry;
+
+_Static_assert(sizeof(SnapHeader) == SNAP_ALIGN, "SnapHeader != 64 bytes");
+_Static_assert(sizeof(SnapEntry) == SNAP_ALIGN, "SnapEntry != 64 bytes");
+/*rowptr e col do GraphCSR apontam direto para os uint64 do arquivo*/
+_Static_assert(sizeof(size_t) == sizeof(uint64_t), "size_t de 64 bits");
+
+/*Grafo de uma entrada, montado em cima do mapeamento*/
+typedef struct {
+	GraphLayout layout;
+	union {
+		Graph g;
+		GraphCSR c;
+	};
+} SnapItem;
+
+struct GraphSnapshot {
+	const uint8_t* base;	/* Mapeamento*/
+	size_t size;
+	size_t count;
+	const SnapEntry* entry;
+	SnapItem* item;
+};
+
+struct GraphSnapshotWriter {
+	FILE* f;
+	uint64_t pos;
+	bool failed;
+	size_t count, cap;
+	SnapEntry* entry;
+};
+
+static size_t round_up(size_t x) {
+	return (x + SNAP_ALIGN - 1) / SNAP_ALIGN * SNAP_ALIGN;
+}
+
+
+/* --- Checksum --- */
+
+/*
+Rodadas do XXH64 (Collet) em 4 pistas sobre palavras de 64 bits. Os
+tamanhos são sempre múltiplos de 8, então não há cauda em bytes. Não
+é compatível com o XXH64 de verdade (que também mistura as pistas de
+outro jeito), só tem a mesma velocidade e a mesma difusão.
+*/
+
+#define P1 11400714785074694791ULL
+#define P2 14029467366897019727ULL
+#define P3 1609587929392839161ULL
+
+typedef struct {
+	uint64_t acc[4];
+	uint64_t words;
+} Sum;
+
+static inline uint64_t rotl(uint64_t x, int r) {
+	return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t sum_round(uint64_t acc, uint64_t w) {
+	return rotl(acc + w * P2, 31) * P1;
+}
+
+static void sum_init(Sum* s) {
+	s->acc[0] = P1 + P2;
+	s->acc[1] = P2;
+	s->acc[2] = 0;
+	s->acc[3] = -P1;
+	s->words = 0;
+}
+
+/*As pistas continuam de onde a última chamada parou*/
+static void sum_update(Sum* s, const void* p, size_t bytes) {
+	const uint8_t* b = p;
+	size_t k = bytes / 8, i = 0;
+	uint64_t w;
+
+	for (; i < k && (s->words & 3); i++, s->words++) {
+		memcpy(&w, b + 8 * i, 8);
+		s->acc[s->words & 3] = sum_round(s->acc[s->words & 3], w);
+	}
+
+	uint64_t a0 = s->acc[0], a1 = s->acc[1], a2 = s->acc[2], a3 = s->acc[3];
+	size_t start = i;
+
+	for (; i + 4 <= k; i += 4) {
+		uint64_t x[4];
+		memcpy(x, b + 8 * i, sizeof(x));
+		a0 = sum_round(a0, x[0]);
+		a1 = sum_round(a1, x[1]);
+		a2 = sum_round(a2, x[2]);
+		a3 = sum_round(a3, x[3]);
+	}
+
+	s->acc[0] = a0;
+	s->acc[1] = a1;
+	s->acc[2] = a2;
+	s->acc[3] = a3;
+	s->words += i - start;
+
+	for (; i < k; i++, s->words++) {
+		memcpy(&w, b + 8 * i, 8);
+		s->acc[s->words & 3] = sum_round(s->acc[s->words & 3], w);
+	}
+}
+
+static uint64_t sum_final(const Sum* s) {
+	uint64_t h = rotl(s->acc[0], 1) + rotl(s->acc[1], 7)
+		+ rotl(s->acc[2], 12) + rotl(s->acc[3], 18) + s->words * 8;
+
+	h ^= h >> 33;
+	h *= P2;
+	h ^= h >> 29;
+	h *= P3;
+	h ^= h >> 32;
+
+	return h;
+}
+
+static uint64_t checksum(const void* p, size_t bytes) {
+	Sum s;
+	sum_init(&s);
+	sum_update(&s, p, bytes);
+
+	return sum_final(&s);
+}
+
+static uint64_t header_sum(const SnapHeader* h) {
+	SnapHeader c = *h;
+	c.sum = 0;
+
+	return checksum(&c, sizeof(c));
+}
+
+
+/* --- Escrita --- */
+
+static void put(GraphSnapshotWriter* w, const void* p, size_t bytes, Sum* s) {
+	if (bytes == 0 || w->failed) {
+		return;
+	}
+
+	if (fwrite(p, 1, bytes, w->f) != bytes) {
+		w->failed = true;
+	}
+
+	if (s) {
+		sum_update(s, p, bytes);
+	}
+
+	w->pos += bytes;
+}
+
+/*Zeros até a próxima fronteira de SNAP_ALIGN*/
+static void pad(GraphSnapshotWriter* w, Sum* s) {
+	static const uint8_t zeros[SNAP_ALIGN];
+
+	put(w, zeros, round_up(w->pos) - w->pos, s);
+}
+
+GraphSnapshotWriter* graph_snapshot_create(const char* path) {
+	GraphSnapshotWriter* w = calloc(1, sizeof(GraphSnapshotWriter));
+
+	if (!w) {
+		die("malloc error (GraphSnapshotWriter)");
+	}
+
+	w->f = fopen(path, "wb");
+
+	if (!w->f) {
+		free(w);
+
+		return NULL;
+	}
+
+	SnapHeader h = {0};
+	put(w, &h, sizeof(h), NULL);
+
+	return w;
+}
+
+/*Nova entrada começando no próximo payload alinhado*/
+static SnapEntry* new_entry(GraphSnapshotWriter* w, size_t n, bool directed,
+	GraphLayout layout, SnapWeight weight, size_t nnz) {
+	if (w->count == w->cap) {
+		w->cap = w->cap ? 2 * w->cap : 64;
+		w->entry = realloc(w->entry, w->cap * sizeof(SnapEntry));
+
+		if (!w->entry) {
+			die("malloc error (snapshot index)");
+		}
+	}
+
+	pad(w, NULL);
+
+	SnapEntry* e = &w->entry[w->count++];
+	memset(e, 0, sizeof(SnapEntry));
+	e->n = n;
+	e->layout = layout;
+	e->weight = weight;
+	e->directed = directed;
+	e->nnz = nnz;
+	e->offset = w->pos;
+
+	return e;
+}
+
+static int end_entry(GraphSnapshotWriter* w, SnapEntry* e, Sum* s) {
+	pad(w, s);
+	e->bytes = w->pos - e->offset;
+	e->sum = sum_final(s);
+
+	return w->failed ? -1 : 0;
+}
+
+int graph_snapshot_add(GraphSnapshotWriter* w, const Graph* g) {
+	size_t n = g->n;
+	SnapEntry* e = new_entry(w, n, g->directed, GRAPH_LAYOUT_DENSE,
+		SNAP_WEIGHT_F64, n * n);
+	Sum s;
+	sum_init(&s);
+	put(w, g->A, n * n * sizeof(double), &s);
+
+	return end_entry(w, e, &s);
+}
+
+int graph_snapshot_add_csr(GraphSnapshotWriter* w, const GraphCSR* g) {
+	size_t n = g->n, nnz = g->rowptr[n];
+	SnapEntry* e = new_entry(w, n, g->directed, GRAPH_LAYOUT_CSR,
+		g->w ? SNAP_WEIGHT_F64 : SNAP_WEIGHT_NONE, nnz);
+	Sum s;
+	sum_init(&s);
+	put(w, g->rowptr, (n + 1) * sizeof(uint64_t), &s);
+	pad(w, &s);
+	put(w, g->col, nnz * sizeof(uint64_t), &s);
+
+	if (g->w) {
+		pad(w, &s);
+		put(w, g->w, nnz * sizeof(double), &s);
+	}
+
+	return end_entry(w, e, &s);
+}
+
+int graph_snapshot_finish(GraphSnapshotWriter* w) {
+	pad(w, NULL);
+
+	SnapHeader h = {0};
+	memcpy(h.magic, "GBIN", 4);
+	h.version = GRAPH_SNAPSHOT_VERSION;
+	h.endian = SNAP_ENDIAN;
+	h.entry_size = sizeof(SnapEntry);
+	h.count = w->count;
+	h.index = w->pos;
+	h.index_sum = checksum(w->entry, w->count * sizeof(SnapEntry));
+	h.sum = header_sum(&h);
+
+	put(w, w->entry, w->count * sizeof(SnapEntry), NULL);
+
+	if (fseek(w->f, 0, SEEK_SET) != 0) {
+		w->failed = true;
+	}
+
+	put(w, &h, sizeof(h), NULL);
+
+	int err = fclose(w->f) != 0 || w->failed ? -1 : 0;
+	free(w->entry);
+	free(w);
+
+	return err;
+}
+
+int graph_save_binary(const Graph* g, const char* path) {
+	GraphSnapshotWriter* w = graph_snapshot_create(path);
+
+	if (!w) {
+		return -1;
+	}
+
+	int err = graph_snapshot_add(w, g);
+
+	return graph_snapshot_finish(w) != 0 || err != 0 ? -1 : 0;
+}
+
+int graph_csr_save_binary(const GraphCSR* g, const char* path) {
+	GraphSnapshotWriter* w = graph_snapshot_create(path);
+
+	if (!w) {
+		return -1;
+	}
+
+	int err = graph_snapshot_add_csr(w, g);
+
+	return graph_snapshot_finish(w) != 0 || err != 0 ? -1 : 0;
+}
+
+
+/* --- Leitura (mmap) --- */
+
+/*Tamanho que o payload de e deveria ter (SIZE_MAX se a entrada for
+inválida ou estourar)*/
+static size_t payload_bytes(const SnapEntry* e) {
+	size_t n = e->n, nnz = e->nnz, a, b;
+
+	if (e->layout == GRAPH_LAYOUT_DENSE) {
+		if (e->weight != SNAP_WEIGHT_F64 || __builtin_mul_overflow(n, n, &a)
+			|| a != nnz || __builtin_mul_overflow(a, sizeof(double), &b)) {
+			return SIZE_MAX;
+		}
+
+		return round_up(b);
+	}
+
+	if (e->layout != GRAPH_LAYOUT_CSR || e->weight > SNAP_WEIGHT_F64
+		|| n >= SIZE_MAX / 16 || nnz >= SIZE_MAX / 32) {
+		return SIZE_MAX;
+	}
+
+	a = round_up((n + 1) * sizeof(uint64_t)) + round_up(nnz * sizeof(uint64_t));
+
+	return a + (e->weight == SNAP_WEIGHT_F64 ? round_up(nnz * sizeof(double))
+		: 0);
+}
+
+/*Monta o item i em cima do payload, que já foi validado*/
+static void map_item(GraphSnapshot* s, size_t i) {
+	const SnapEntry* e = &s->entry[i];
+	SnapItem* it = &s->item[i];
+	uint8_t* p = (uint8_t*) s->base + e->offset;
+
+	it->layout = e->layout;
+
+	if (e->layout == GRAPH_LAYOUT_DENSE) {
+		it->g.n = e->n;
+		it->g.directed = e->directed;
+		it->g.A = (double*) p;
+
+		return;
+	}
+
+	size_t col = round_up((e->n + 1) * sizeof(uint64_t));
+	size_t w = col + round_up(e->nnz * sizeof(uint64_t));
+
+	it->c.n = e->n;
+	it->c.directed = e->directed;
+	it->c.rowptr = (size_t*) p;
+	it->c.col = (size_t*) (p + col);
+	it->c.w = e->weight == SNAP_WEIGHT_F64 ? (double*) (p + w) : NULL;
+}
+
+/*Estrutura do CSR: rowptr crescente de 0 a nnz e col < n*/
+static bool csr_valid(const GraphCSR* c, size_t nnz) {
+	if (c->rowptr[0] != 0 || c->rowptr[c->n] != nnz) {
+		return false;
+	}
+
+	for (size_t u = 0; u < c->n; u++) {
+		if (c->rowptr[u] > c->rowptr[u + 1]) {
+			return false;
+		}
+	}
+
+	for (size_t k = 0; k < nnz; k++) {
+		if (c->col[k] >= c->n) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool graph_snapshot_verify(const GraphSnapshot* s, size_t i) {
+	if (i >= s->count) {
+		return false;
+	}
+
+	const SnapEntry* e = &s->entry[i];
+
+	if (checksum(s->base + e->offset, e->bytes) != e->sum) {
+		return false;
+	}
+
+	return e->layout == GRAPH_LAYOUT_DENSE || csr_valid(&s->item[i].c, e->nnz);
+}
+
+GraphSnapshot* graph_snapshot_open(const char* path, bool verify) {
+	int fd = open(path, O_RDONLY);
+	struct stat st;
+
+	if (fd < 0) {
+		return NULL;
+	}
+
+	if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(SnapHeader)) {
+		close(fd);
+
+		return NULL;
+	}
+
+	size_t size = (size_t) st.st_size;
+	void* base = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+
+	if (base == MAP_FAILED) {
+		return NULL;
+	}
+
+	GraphSnapshot* s = calloc(1, sizeof(GraphSnapshot));
+
+	if (!s) {
+		die("malloc error (GraphSnapshot)");
+	}
+
+	s->base = base;
+	s->size = size;
+
+	SnapHeader h;
+	memcpy(&h, base, sizeof(h));
+
+	if (memcmp(h.magic, "GBIN", 4) != 0 || h.version != GRAPH_SNAPSHOT_VERSION
+		|| h.endian != SNAP_ENDIAN || h.entry_size != sizeof(SnapEntry)
+		|| h.sum != header_sum(&h) || h.index % SNAP_ALIGN != 0
+		|| h.index > size || h.count > (size - h.index) / sizeof(SnapEntry)
+		|| h.index_sum != checksum(s->base + h.index,
+			h.count * sizeof(SnapEntry))) {
+		graph_snapshot_close(s);
+
+		return NULL;
+	}
+
+	s->count = h.count;
+	s->entry = (const SnapEntry*) (s->base + h.index);
+	s->item = calloc(s->count + 1, sizeof(SnapItem));
+
+	if (!s->item) {
+		die("malloc error (GraphSnapshot)");
+	}
+
+	for (size_t i = 0; i < s->count; i++) {
+		const SnapEntry* e = &s->entry[i];
+		size_t bytes = payload_bytes(e);
+
+		if (e->bytes != bytes || e->offset % SNAP_ALIGN != 0
+			|| e->offset < sizeof(SnapHeader) || e->offset > h.index
+			|| bytes > h.index - e->offset) {
+			graph_snapshot_close(s);
+
+			return NULL;
+		}
+
+		map_item(s, i);
+
+		/*as pontas de rowptr custam uma ou duas páginas; o resto só
+		com verify*/
+		bool ok = verify ? graph_snapshot_verify(s, i)
+			: e->layout == GRAPH_LAYOUT_DENSE
+			|| (s->item[i].c.rowptr[0] == 0
+				&& s->item[i].c.rowptr[e->n] == e->nnz);
+
+		if (!ok) {
+			graph_snapshot_close(s);
+
+			return NULL;
+		}
+	}
+
+	return s;
+}
+
+void graph_snapshot_close(GraphSnapshot* s) {
+	if (!s) {
+		return;
+	}
+
+	munmap((void*) s->base, s->size);
+	free(s->item);
+	free(s);
+}
+
+size_t graph_snapshot_count(const GraphSnapshot* s) {
+	return s->count;
+}
+
+GraphLayout graph_snapshot_layout(const GraphSnapshot* s, size_t i) {
+	if (i >= s->count) {
+		return GRAPH_LAYOUT_NONE;
+	}
+
+	return s->item[i].layout;
+}
+
+const Graph* graph_snapshot_graph(const GraphSnapshot* s, size_t i) {
+	if (i >= s->count || s->item[i].layout != GRAPH_LAYOUT_DENSE) {
+		return NULL;
+	}
+
+	return &s->item[i].g;
+}
+
+const GraphCSR* graph_snapshot_csr(const GraphSnapshot* s, size_t i) {
+	if (i >= s->count || s->item[i].layout != GRAPH_LAYOUT_CSR) {
+		return NULL;
+	}
+
+	return &s->item[i].c;
+}
+
+
+/* --- Cópias --- */
+
+Graph* graph_snapshot_load(const GraphSnapshot* s, size_t i) {
+	if (i >= s->count) {
+		return NULL;
+	}
+
+	const SnapItem* it = &s->item[i];
+
+	if (it->layout == GRAPH_LAYOUT_DENSE) {
+		/*como graph_new, mas copiando direto (sem zerar antes)*/
+		Graph* g = calloc(1, sizeof(Graph));
+
+		if (!g) {
+			die("malloc error (Graph)");
+		}
+
+		g->n = it->g.n;
+		g->directed = it->g.directed;
+		g->A = graph_mem_matrix(g->n, g->n, it->g.A);
+		g->cache = graph_cache_new();
+
+		return g;
+	}
+
+	/*aberto sem verify só rowptr[0] e rowptr[n] foram conferidos: um
+	rowptr fora de ordem ou col >= n escreveria fora de g->A*/
+	const GraphCSR* c = &it->c;
+
+	if (!csr_valid(c, s->entry[i].nnz)) {
+		return NULL;
+	}
+
+	Graph* g = graph_new(c->n, c->directed);
+
+	for (size_t u = 0; u < c->n; u++) {
+		for (size_t k = c->rowptr[u]; k < c->rowptr[u + 1]; k++) {
+			g->A[IDX(u, c->col[k], c->n)] = CSR_W(c, k);
+		}
+	}
+
+	return g;
+}
+
+GraphCSR* graph_snapshot_load_csr(const GraphSnapshot* s, size_t i) {
+	if (i >= s->count) {
+		return NULL;
+	}
+
+	const SnapItem* it = &s->item[i];
+
+	if (it->layout == GRAPH_LAYOUT_DENSE) {
+		return graph_csr_from_graph(&it->g);
+	}
+
+	const GraphCSR* c = &it->c;
+	size_t nnz = c->rowptr[c->n];
+
+	if (!csr_valid(c, s->entry[i].nnz)) {
+		return NULL;
+	}
+
+	GraphCSR* g = calloc(1, sizeof(GraphCSR));
+
+	if (!g) {
+		die("malloc error (GraphCSR)");
+	}
+
+	g->n = c->n;
+	g->directed = c->directed;
+	g->rowptr = malloc((c->n + 1) * sizeof(size_t));
+	g->col = malloc((nnz + 1) * sizeof(size_t));
+	g->w = c->w ? malloc((nnz + 1) * sizeof(double)) : NULL;
+
+	if (!g->rowptr || !g->col || (c->w && !g->w)) {
+		die("malloc error (GraphCSR)");
+	}
+
+	memcpy(g->rowptr, c->rowptr, (c->n + 1) * sizeof(size_t));
+	memcpy(g->col, c->col, nnz * sizeof(size_t));
+
+	if (c->w) {
+		memcpy(g->w, c->w, nnz * sizeof(double));
+	}
+
+	return g;
+}
+
+Graph* graph_load_binary(const char* path) {
+	/*só a entrada copiada precisa do checksum*/
+	GraphSnapshot* s = graph_snapshot_open(path, false);
+
+	if (!s) {
+		return NULL;
+	}
+
+	if (!graph_snapshot_verify(s, 0)) {
+		graph_snapshot_close(s);
+
+		return NULL;
+	}
+
+	Graph* g = graph_snapshot_load(s, 0);
+	graph_snapshot_close(s);
+
+	return g;
+}
+
+GraphCSR* graph_csr_load_binary(const char* path) {
+	/*só a entrada copiada precisa do checksum*/
+	GraphSnapshot* s = graph_snapshot_open(path, false);
+
+	if (!s) {
+		return NULL;
+	}
+
+	if (!graph_snapshot_verify(s, 0)) {
+		graph_snapshot_close(s);
+
+		return NULL;
+	}
+
+	GraphCSR* g = graph_snapshot_load_csr(s, 0);
+	graph_snapshot_close(s);
+
+	return g;
+}
@@ -0,0 +1,112 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+/* --- Formato binário de grafos (snapshots) --- */
+
+/*
+graph_read_from_file refaz o grafo aresta por aresta a partir de
+texto; para passar grafos que nós mesmos geramos de um estágio para
+outro isso é desperdício. O formato daqui guarda os dados como estão
+na memória, e um arquivo pode ter um grafo ou um lote inteiro:
+
+  cabeçalho (64 bytes): "GBIN", versão, marca de ordem de bytes,
+                        n° de entradas, posição e checksum do índice
+  payloads:             um por entrada, cada um alinhado a 64 bytes
+  índice (no fim):      64 bytes por entrada: n, layout (denso ou
+                        CSR), tipo dos pesos, direcionado, nnz,
+                        posição, tamanho e checksum do payload
+
+O payload denso é g->A (n x n double, row-major). O CSR é rowptr
+(n + 1 uint64), col (nnz uint64) e, se houver pesos, w (nnz double),
+cada vetor começando numa fronteira de 64 bytes. Os números ficam na
+ordem de bytes da máquina que escreveu (como experiment_write_binary):
+um arquivo de outra ordem é recusado.
+
+graph_snapshot_open mapeia o arquivo (mmap somente leitura) e devolve
+Graph e GraphCSR que apontam direto para o mapeamento, sem cópia: o
+custo de abrir é o do índice, e as páginas de cada grafo só são lidas
+do disco quando usadas. Esses grafos são const e não têm cache (veja
+cache.h). Para um grafo comum (modificável) use graph_load_binary ou
+graph_snapshot_load, que copiam. (Para uma matriz densa maior que a
+RAM o formato certo é o de tiled.h.)
+
+O checksum (64 bits, por palavras, no estilo do XXH64) do cabeçalho e
+do índice é sempre conferido; o de cada payload só com verify = true
+(ou graph_snapshot_verify), porque conferir lê o arquivo inteiro.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "graphs.h"
+
+#define GRAPH_SNAPSHOT_VERSION 1
+
+typedef enum {
+	GRAPH_LAYOUT_DENSE,		/* Graph (matriz n x n)*/
+	GRAPH_LAYOUT_CSR,		/* GraphCSR*/
+	GRAPH_LAYOUT_NONE		/* Entrada fora do intervalo*/
+} GraphLayout;
+
+typedef struct GraphSnapshot GraphSnapshot;
+typedef struct GraphSnapshotWriter GraphSnapshotWriter;
+
+
+/*Grava g (ou o CSR g) num arquivo com uma entrada. Retorna 0 ou -1
+(erro de E/S)*/
+int graph_save_binary(const Graph* g, const char* path);
+int graph_csr_save_binary(const GraphCSR* g, const char* path);
+
+
+/*Lê a primeira entrada de path como um Graph (ou GraphCSR) comum,
+convertendo de CSR para denso (ou o contrário) se preciso. Confere só
+o checksum dessa entrada, então o custo não cresce com as outras
+entradas do arquivo. NULL se o arquivo não existir ou for inválido*/
+Graph* graph_load_binary(const char* path);
+GraphCSR* graph_csr_load_binary(const char* path);
+
+
+/*Arquivo com várias entradas: graph_snapshot_create, um
+graph_snapshot_add(_csr) por grafo e graph_snapshot_finish, que
+escreve o índice e libera w (mesmo se der erro). NULL/-1 se houver
+erro de E/S; depois de um erro só finish faz sentido*/
+GraphSnapshotWriter* graph_snapshot_create(const char* path);
+int graph_snapshot_add(GraphSnapshotWriter* w, const Graph* g);
+int graph_snapshot_add_csr(GraphSnapshotWriter* w, const GraphCSR* g);
+int graph_snapshot_finish(GraphSnapshotWriter* w);
+
+
+/*Mapeia path. NULL se o arquivo não existir, for de outra versão ou
+ordem de bytes, ou se algum checksum (ou, com verify, a estrutura de
+algum CSR) não bater*/
+GraphSnapshot* graph_snapshot_open(const char* path, bool verify);
+
+
+/*Desfaz o mapeamento: os ponteiros devolvidos abaixo deixam de valer*/
+void graph_snapshot_close(GraphSnapshot* s);
+
+
+/*N° de entradas e layout da entrada i (GRAPH_LAYOUT_NONE se i
+estiver fora do intervalo)*/
+size_t graph_snapshot_count(const GraphSnapshot* s);
+GraphLayout graph_snapshot_layout(const GraphSnapshot* s, size_t i);
+
+
+/*Entrada i, sem cópia (direto do mapeamento). NULL se i estiver fora
+do intervalo ou a entrada tiver o outro layout*/
+const Graph* graph_snapshot_graph(const GraphSnapshot* s, size_t i);
+const GraphCSR* graph_snapshot_csr(const GraphSnapshot* s, size_t i);
+
+
+/*Cópias da entrada i (free-after-use), convertendo o layout se
+preciso. NULL se i estiver fora do intervalo ou se a estrutura de uma
+entrada CSR for inválida (rowptr fora de ordem, col >= n), o que
+graph_snapshot_open sem verify não confere. O checksum só é conferido
+por graph_snapshot_verify*/
+Graph* graph_snapshot_load(const GraphSnapshot* s, size_t i);
+GraphCSR* graph_snapshot_load_csr(const GraphSnapshot* s, size_t i);
+
+
+/*Confere o checksum (e a estrutura, se for CSR) da entrada i*/
+bool graph_snapshot_verify(const GraphSnapshot* s, size_t i);
+
+#endif
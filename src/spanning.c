@@ -0,0 +1,393 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <lapacke.h>
+#include "spanning.h"
+
+/*L₀: laplaciana sem a última linha e coluna ((n - 1) x (n - 1))*/
+static double* reduced_laplacian(const Graph* g) {
+	size_t n = g->n, m = n - 1;
+	double* L = malloc((m * m + 1) * sizeof(double));
+
+	if (!L) {
+		die("malloc error (L)");
+	}
+
+	for (size_t i = 0; i < m; i++) {
+		double d = 0.0;
+
+		for (size_t j = 0; j < n; j++) {
+			if (j != i) {
+				d += g->A[IDX(i, j, n)];
+			}
+
+			if (j < m) {
+				L[IDX(i, j, m)] = -g->A[IDX(i, j, n)];
+			}
+		}
+
+		L[IDX(i, i, m)] = d;
+	}
+
+	return L;
+}
+
+double graph_log_spanning_trees(const Graph* g) {
+	if (g->directed) {
+		return NAN;
+	}
+
+	if (g->n <= 1) {
+		return 0.0;
+	}
+
+	size_t m = g->n - 1;
+	double* L = reduced_laplacian(g);
+
+	/*L₀ é definida positiva se e só se g é conexo*/
+	int info = LAPACKE_dpotrf(LAPACK_ROW_MAJOR, 'L', (int) m, L, (int) m);
+	double logdet = -INFINITY;
+
+	if (info == 0) {
+		logdet = 0.0;
+
+		for (size_t i = 0; i < m; i++) {
+			logdet += 2.0 * log(L[IDX(i, i, m)]);
+		}
+	}
+
+	free(L);
+
+	return logdet;
+}
+
+int graph_spanning_trees_exact(const Graph* g, BigInt* count) {
+	if (g->directed) {
+		return -1;
+	}
+
+	/*det da matriz 0 x 0 é 1*/
+	if (g->n <= 1) {
+		matrix_det_exact(NULL, 0, count);
+		return 0;
+	}
+
+	double* L = reduced_laplacian(g);
+	matrix_det_exact(L, g->n - 1, count);
+	free(L);
+
+	return 0;
+}
+
+
+/* --- Estimador estocástico --- */
+
+typedef struct {
+	const GraphCSR* c;
+	size_t m;			/* n - 1*/
+	double* isd;		/* 1/√d de cada vértice (D^(-1/2))*/
+} Reduced;
+
+/*Y = N X, N = D^(-1/2) L₀ D^(-1/2), X e Y m x k*/
+static void normalized_mult(const Reduced* r, const double* X, double* Y,
+	size_t k) {
+	const GraphCSR* c = r->c;
+
+	for (size_t u = 0; u < r->m; u++) {
+		double* y = &Y[IDX(u, 0, k)];
+
+		/*diagonal de N é 1 (laços não entram)*/
+		memcpy(y, &X[IDX(u, 0, k)], k * sizeof(double));
+
+		for (size_t e = c->rowptr[u]; e < c->rowptr[u + 1]; e++) {
+			size_t v = c->col[e];
+
+			if (v == u || v >= r->m) {
+				continue;
+			}
+
+			double w = CSR_W(c, e) * r->isd[u] * r->isd[v];
+			const double* x = &X[IDX(v, 0, k)];
+
+			for (size_t j = 0; j < k; j++) {
+				y[j] -= w * x[j];
+			}
+		}
+	}
+}
+
+/*Menor valor de Ritz de N depois de alguns passos de Lanczos*/
+static double lanczos_min(const Reduced* r, size_t steps, Rng* rng) {
+	size_t m = r->m;
+	double* v = malloc(m * sizeof(double));
+	double* v_prev = calloc(m, sizeof(double));
+	double* w = malloc(m * sizeof(double));
+	double* alpha = malloc((steps + 1) * sizeof(double));
+	double* beta = malloc((steps + 1) * sizeof(double));
+
+	if (!v || !v_prev || !w || !alpha || !beta) {
+		die("malloc error (lanczos)");
+	}
+
+	double norm = 0.0;
+
+	for (size_t i = 0; i < m; i++) {
+		v[i] = rng_uniform_or_rand(rng) - 0.5;
+		norm += v[i] * v[i];
+	}
+
+	norm = sqrt(norm);
+
+	for (size_t i = 0; i < m; i++) {
+		v[i] /= norm;
+	}
+
+	size_t k = 0;
+	double b = 0.0;
+
+	while (k < steps) {
+		normalized_mult(r, v, w, 1);
+		double a = 0.0;
+
+		for (size_t i = 0; i < m; i++) {
+			w[i] -= b * v_prev[i];
+			a += w[i] * v[i];
+		}
+
+		b = 0.0;
+
+		for (size_t i = 0; i < m; i++) {
+			w[i] -= a * v[i];
+			b += w[i] * w[i];
+		}
+
+		b = sqrt(b);
+		alpha[k] = a;
+		beta[k++] = b;
+
+		/*subespaço invariante: os valores de Ritz já são exatos*/
+		if (b < 1e-12) {
+			break;
+		}
+
+		for (size_t i = 0; i < m; i++) {
+			v_prev[i] = v[i];
+			v[i] = w[i] / b;
+		}
+	}
+
+	double theta = alpha[0];
+
+	if (LAPACKE_dstev(LAPACK_ROW_MAJOR, 'N', (int) k, alpha, beta, NULL, 1)
+		== 0) {
+		theta = alpha[0];
+	}
+
+	free(v);
+	free(v_prev);
+	free(w);
+	free(alpha);
+	free(beta);
+
+	return theta;
+}
+
+static bool csr_connected(const GraphCSR* c) {
+	size_t n = c->n;
+	size_t* queue = malloc((n + 1) * sizeof(size_t));
+	bool* seen = calloc(n + 1, sizeof(bool));
+
+	if (!queue || !seen) {
+		die("malloc error (queue || seen)");
+	}
+
+	size_t head = 0, tail = 0;
+	queue[tail++] = 0;
+	seen[0] = true;
+
+	while (head < tail) {
+		size_t u = queue[head++];
+
+		for (size_t e = c->rowptr[u]; e < c->rowptr[u + 1]; e++) {
+			if (!seen[c->col[e]]) {
+				seen[c->col[e]] = true;
+				queue[tail++] = c->col[e];
+			}
+		}
+	}
+
+	free(queue);
+	free(seen);
+
+	return tail == n;
+}
+
+int graph_log_spanning_trees_approx(const GraphCSR* g, size_t degree,
+	size_t probes, double* logt, double* stderr_out) {
+	return graph_log_spanning_trees_approx_r(g, degree, probes, logt,
+		stderr_out, NULL);
+}
+
+int graph_log_spanning_trees_approx_r(const GraphCSR* g, size_t degree,
+	size_t probes, double* logt, double* stderr_out, Rng* rng) {
+	size_t n = g->n;
+
+	if (g->directed) {
+		return -1;
+	}
+
+	if (g->w) {
+		for (size_t e = 0; e < g->rowptr[n]; e++) {
+			if (g->w[e] < 0.0) {
+				return -1;
+			}
+		}
+	}
+
+	if (stderr_out) {
+		*stderr_out = 0.0;
+	}
+
+	if (n <= 1) {
+		*logt = 0.0;
+		return 0;
+	}
+
+	if (!csr_connected(g)) {
+		*logt = -INFINITY;
+		return 0;
+	}
+
+	size_t m = n - 1;
+	Reduced r = {g, m, malloc(m * sizeof(double))};
+
+	if (!r.isd) {
+		die("malloc error (isd)");
+	}
+
+	/*log det L₀ = Σ log d_u + log det N*/
+	double logd = 0.0;
+
+	for (size_t u = 0; u < m; u++) {
+		double d = 0.0;
+
+		for (size_t e = g->rowptr[u]; e < g->rowptr[u + 1]; e++) {
+			if (g->col[e] != u) {
+				d += CSR_W(g, e);
+			}
+		}
+
+		r.isd[u] = 1.0 / sqrt(d);
+		logd += log(d);
+	}
+
+	/*intervalo [a, b] do polinômio: b = 2 é cota exata; a vem do
+	Lanczos com folga, já que o valor de Ritz superestima λ_min*/
+	double a = 0.5 * lanczos_min(&r, m < 40 ? m : 40, rng);
+	double b = 2.0;
+
+	if (a <= 0.0) {
+		a = 1e-6;
+	}
+
+	if (degree == 0) {
+		degree = (size_t) ceil(sqrt(b / a) * log(1e8) / 2.0);
+		degree = degree < 10 ? 10 : (degree > 2000 ? 2000 : degree);
+	}
+
+	if (probes == 0) {
+		probes = 30;
+	}
+
+	/*coeficientes de Chebyshev de log nos nós de [a, b]*/
+	double* coef = malloc((degree + 1) * sizeof(double));
+
+	if (!coef) {
+		die("malloc error (coef)");
+	}
+
+	for (size_t j = 0; j <= degree; j++) {
+		double s = 0.0;
+
+		for (size_t i = 0; i <= degree; i++) {
+			double th = M_PI * (i + 0.5) / (degree + 1);
+			double x = 0.5 * (b - a) * cos(th) + 0.5 * (b + a);
+			s += log(x) * cos(j * th);
+		}
+
+		coef[j] = 2.0 * s / (degree + 1);
+	}
+
+	coef[0] /= 2.0;
+
+	/*T_j(N̂) Z pela recorrência de três termos, N̂ = (2N - (a+b)I)/(b-a),
+	para todas as sondas juntas (m x probes)*/
+	size_t k = probes, mk = m * k;
+	double* Z = malloc(mk * sizeof(double));
+	double* W0 = malloc(mk * sizeof(double));
+	double* W1 = malloc(mk * sizeof(double));
+	double* W2 = malloc(mk * sizeof(double));
+	double* acc = calloc(k, sizeof(double));
+
+	if (!Z || !W0 || !W1 || !W2 || !acc) {
+		die("malloc error (hutchinson)");
+	}
+
+	for (size_t i = 0; i < mk; i++) {
+		Z[i] = rng_uniform_or_rand(rng) < 0.5 ? 1.0 : -1.0;
+	}
+
+	double s1 = 2.0 / (b - a), s0 = -(b + a) / (b - a);
+
+	memcpy(W0, Z, mk * sizeof(double));
+	normalized_mult(&r, Z, W1, k);
+
+	for (size_t i = 0; i < mk; i++) {
+		W1[i] = s1 * W1[i] + s0 * Z[i];
+	}
+
+	for (size_t i = 0; i < mk; i++) {
+		acc[i % k] += Z[i] * (coef[0] * W0[i] + coef[1] * W1[i]);
+	}
+
+	for (size_t j = 2; j <= degree; j++) {
+		normalized_mult(&r, W1, W2, k);
+
+		for (size_t i = 0; i < mk; i++) {
+			W2[i] = 2.0 * (s1 * W2[i] + s0 * W1[i]) - W0[i];
+			acc[i % k] += coef[j] * Z[i] * W2[i];
+		}
+
+		double* t = W0;
+		W0 = W1;
+		W1 = W2;
+		W2 = t;
+	}
+
+	/*média e erro padrão das sondas*/
+	double mean = 0.0, var = 0.0;
+
+	for (size_t j = 0; j < k; j++) {
+		mean += acc[j] / k;
+	}
+
+	for (size_t j = 0; j < k; j++) {
+		var += (acc[j] - mean) * (acc[j] - mean);
+	}
+
+	*logt = logd + mean;
+
+	if (stderr_out) {
+		*stderr_out = k > 1 ? sqrt(var / (k - 1) / k) : 0.0;
+	}
+
+	free(coef);
+	free(Z);
+	free(W0);
+	free(W1);
+	free(W2);
+	free(acc);
+	free(r.isd);
+
+	return 0;
+}
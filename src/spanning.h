@@ -0,0 +1,54 @@
+#ifndef SPANNING_H
+#define SPANNING_H
+
+/* --- Número de árvores geradoras --- */
+
+/*
+Pelo teorema da matriz-árvore, o número de árvores geradoras de um
+grafo não direcionado é qualquer cofator da laplaciana, por exemplo o
+determinante da laplaciana reduzida L₀ (sem a última linha e coluna).
+Com pesos, é a soma, sobre as árvores, do produto dos pesos.
+
+Mesmo para n moderado esse número estoura o double (K_n tem n^(n-2)
+árvores), então a função principal devolve o logaritmo:
+
+- graph_log_spanning_trees: Cholesky (dpotrf) de L₀, cerca de 6x mais
+  barato que o dsyev usado por graph_spec_lap; log det = 2 Σ log r_ii;
+- graph_spanning_trees_exact: o valor exato (BigInt), pelo
+  determinante modular + CRT de charpoly.h, para pesos inteiros;
+- graph_log_spanning_trees_approx: estimador estocástico para grafos
+  grandes e esparsos (GraphCSR): log det L₀ = tr log L₀, com log
+  aproximado por um polinômio de Chebyshev e o traço por Hutchinson
+  (vetores aleatórios ±1). Custa (grau x sondas) produtos matriz-vetor
+  esparsos.
+*/
+
+#include "graphs.h"
+#include "charpoly.h"
+
+
+/*log do número (ponderado) de árvores geradoras; -INFINITY se g for
+desconexo e NAN se for direcionado. Pesos devem ser > 0*/
+double graph_log_spanning_trees(const Graph* g);
+
+
+/*Número exato de árvores geradoras em *count (libere com bigint_free).
+Os pesos devem ser inteiros (senão a função chama die). Retorna -1 se
+g for direcionado*/
+int graph_spanning_trees_exact(const Graph* g, BigInt* count);
+
+
+/*Estima log det L₀ e coloca em *logt (e o erro padrão do estimador de
+Hutchinson em *stderr_out, se não for NULL). degree = 0 e probes = 0
+escolhem valores padrão. O intervalo do polinômio vem de um Lanczos
+curto em D^(-1/2) L₀ D^(-1/2), cujo espectro fica em (0, 2].
+Retorna -1 se g for direcionado ou tiver peso negativo. Usa rand()*/
+int graph_log_spanning_trees_approx(const GraphCSR* g, size_t degree,
+	size_t probes, double* logt, double* stderr_out);
+
+
+/*O mesmo sorteando com rng (NULL usa rand())*/
+int graph_log_spanning_trees_approx_r(const GraphCSR* g, size_t degree,
+	size_t probes, double* logt, double* stderr_out, Rng* rng);
+
+#endif
@@ -0,0 +1,644 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "tiled.h"
+
+#define TILED_MAGIC "AGTILED1"
+#define TILED_VERSION 1
+#define TILED_HEADER_BYTES 4096
+
+typedef struct {
+	char magic[8];
+	uint32_t version;
+	uint32_t directed;
+	uint64_t n;
+	uint64_t tile;
+} TiledHeader;
+
+
+static inline void tiled_bounds_check(const TiledGraph* g, size_t u, size_t v) {
+	if (u >= g->n || v >= g->n) {
+		die("vértice fora do intervalo");
+	}
+}
+
+static inline size_t tile_doubles(const TiledGraph* g) {
+	return g->tile * g->tile;
+}
+
+static inline double* tile_ptr(const TiledGraph* g, size_t bi, size_t bj) {
+	return g->tiles + (bi * g->nt + bj) * tile_doubles(g);
+}
+
+/*N° de linhas (ou colunas) válidas no bloco b*/
+static inline size_t tile_extent(const TiledGraph* g, size_t b) {
+	size_t start = b * g->tile;
+	return (g->n - start < g->tile) ? g->n - start : g->tile;
+}
+
+static inline double* entry_ptr(const TiledGraph* g, size_t u, size_t v) {
+	size_t t = g->tile;
+	return tile_ptr(g, u / t, v / t) + (u % t) * t + (v % t);
+}
+
+/*Dicas para o kernel antes de ler o bloco (bi, bj): lê o bloco
+inteiro de uma vez e já começa a trazer o próximo na ordem do arquivo*/
+static void tile_begin(const TiledGraph* g, size_t bi, size_t bj) {
+	size_t bytes = tile_doubles(g) * sizeof(double);
+	double* t = tile_ptr(g, bi, bj);
+
+	madvise(t, bytes, MADV_WILLNEED);
+
+	if (bi * g->nt + bj + 1 < g->nt * g->nt) {
+		madvise(t + tile_doubles(g), bytes, MADV_WILLNEED);
+	}
+}
+
+/*Se o arquivo não cabe na RAM, devolve as páginas do bloco já lido*/
+static void tile_end(const TiledGraph* g, size_t bi, size_t bj) {
+	if (g->evict && !g->writable) {
+		madvise(tile_ptr(g, bi, bj), tile_doubles(g) * sizeof(double),
+			MADV_DONTNEED);
+	}
+}
+
+static TiledGraph* tiled_map(int fd, size_t n, bool directed, size_t tile,
+	bool writable) {
+	TiledGraph* g = calloc(1, sizeof(TiledGraph));
+
+	if (!g) {
+		die("malloc error (TiledGraph)");
+	}
+
+	g->n = n;
+	g->directed = directed;
+	g->tile = tile;
+	g->nt = (n + tile - 1) / tile;
+	g->writable = writable;
+	g->fd = fd;
+	g->map_len = TILED_HEADER_BYTES + g->nt * g->nt * tile * tile
+		* sizeof(double);
+
+	int prot = PROT_READ | (writable ? PROT_WRITE : 0);
+	g->map = mmap(NULL, g->map_len, prot, MAP_SHARED, fd, 0);
+
+	if (g->map == MAP_FAILED) {
+		die("mmap error (TiledGraph)");
+	}
+
+	g->tiles = (double*) ((char*) g->map + TILED_HEADER_BYTES);
+	madvise(g->map, g->map_len, MADV_SEQUENTIAL);
+
+	long pages = sysconf(_SC_PHYS_PAGES);
+	long page = sysconf(_SC_PAGESIZE);
+
+	if (pages > 0 && page > 0) {
+		g->evict = g->map_len > (size_t) pages * (size_t) page / 2;
+	}
+
+	return g;
+}
+
+TiledGraph* tiled_graph_create(const char* path, size_t n, bool directed,
+	size_t tile) {
+	if (tile == 0) {
+		tile = TILED_DEFAULT_TILE;
+	}
+
+	/*blocos de 32 x 32 doubles = 8 KB, então todo bloco começa numa
+	página e madvise pode ser usado bloco a bloco*/
+	if (tile % 32 != 0) {
+		die("tile deve ser múltiplo de 32");
+	}
+
+	int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+	if (fd < 0) {
+		die("não consegui criar o arquivo");
+	}
+
+	size_t nt = (n + tile - 1) / tile;
+	size_t len = TILED_HEADER_BYTES + nt * nt * tile * tile * sizeof(double);
+
+	if (ftruncate(fd, (off_t) len) != 0) {
+		close(fd);
+		die("ftruncate error (TiledGraph)");
+	}
+
+	TiledGraph* g = tiled_map(fd, n, directed, tile, true);
+	TiledHeader* h = (TiledHeader*) g->map;
+
+	memcpy(h->magic, TILED_MAGIC, 8);
+	h->version = TILED_VERSION;
+	h->directed = directed;
+	h->n = n;
+	h->tile = tile;
+
+	return g;
+}
+
+TiledGraph* tiled_graph_open(const char* path, bool writable) {
+	int fd = open(path, writable ? O_RDWR : O_RDONLY);
+
+	if (fd < 0) {
+		die("não consegui abrir o arquivo");
+	}
+
+	TiledHeader h;
+
+	if (pread(fd, &h, sizeof(h), 0) != (ssize_t) sizeof(h)
+		|| memcmp(h.magic, TILED_MAGIC, 8) != 0
+		|| h.version != TILED_VERSION
+		|| h.tile == 0 || h.tile % 32 != 0) {
+		close(fd);
+		die("cabeçalho inválido (TiledGraph)");
+	}
+
+	struct stat st;
+	size_t nt = (h.n + h.tile - 1) / h.tile;
+
+	if (fstat(fd, &st) != 0 || (size_t) st.st_size
+		< TILED_HEADER_BYTES + nt * nt * h.tile * h.tile * sizeof(double)) {
+		close(fd);
+		die("arquivo truncado (TiledGraph)");
+	}
+
+	return tiled_map(fd, h.n, h.directed != 0, h.tile, writable);
+}
+
+TiledGraph* tiled_graph_from_graph(const Graph* g, const char* path,
+	size_t tile) {
+	size_t n = g->n;
+	TiledGraph* t = tiled_graph_create(path, n, g->directed, tile);
+
+	/*escreve bloco a bloco para que o arquivo seja preenchido em ordem*/
+	for (size_t bi = 0; bi < t->nt; bi++) {
+		for (size_t bj = 0; bj < t->nt; bj++) {
+			double* T = tile_ptr(t, bi, bj);
+			size_t r0 = bi * t->tile, c0 = bj * t->tile;
+			size_t rows = tile_extent(t, bi), cols = tile_extent(t, bj);
+
+			for (size_t i = 0; i < rows; i++) {
+				const double* row = &g->A[IDX(r0 + i, c0, n)];
+
+				for (size_t j = 0; j < cols; j++) {
+					if (row[j] != 0.0) {
+						T[i * t->tile + j] = row[j];
+					}
+				}
+			}
+		}
+	}
+
+	return t;
+}
+
+TiledGraph* tiled_graph_read_from_file(const char* edges_path,
+	const char* path, size_t tile) {
+	FILE* f = fopen(edges_path, "r");
+
+	if (!f) {
+		die("não consegui abrir o arquivo");
+	}
+
+	size_t n, m;
+	int dir;
+
+	if (fscanf(f, "%zu %d", &n, &dir) != 2) {
+		die("cabeçalho inválido");
+	}
+
+	if (fscanf(f, "%zu", &m) != 1) {
+		die("m inválido");
+	}
+
+	TiledGraph* g = tiled_graph_create(path, n, dir != 0, tile);
+
+	for (size_t k = 0; k < m; k++) {
+		size_t u, v;
+		double w;
+
+		if (fscanf(f, "%zu %zu %lf", &u, &v, &w) != 3) {
+			die("linha de aresta inválida");
+		}
+
+		tiled_graph_add_edge(g, u, v, w);
+	}
+
+	fclose(f);
+	return g;
+}
+
+void tiled_graph_close(TiledGraph* g) {
+	if (!g) {
+		return;
+	}
+
+	if (g->writable) {
+		msync(g->map, g->map_len, MS_SYNC);
+	}
+
+	munmap(g->map, g->map_len);
+	close(g->fd);
+	free(g);
+}
+
+void tiled_graph_add_edge(TiledGraph* g, size_t u, size_t v, double w) {
+	tiled_bounds_check(g, u, v);
+
+	if (!g->writable) {
+		die("grafo aberto somente para leitura");
+	}
+
+	*entry_ptr(g, u, v) = w;
+
+	if (!g->directed && u != v) {
+		*entry_ptr(g, v, u) = w;
+	}
+}
+
+void tiled_graph_remove_edge(TiledGraph* g, size_t u, size_t v) {
+	tiled_graph_add_edge(g, u, v, 0.0);
+}
+
+double tiled_graph_get(const TiledGraph* g, size_t u, size_t v) {
+	tiled_bounds_check(g, u, v);
+
+	return *entry_ptr(g, u, v);
+}
+
+/*Percorre os blocos na ordem do arquivo; sem direção só o triângulo
+superior de blocos (bj >= bi). fn recebe o bloco já com as dicas de
+madvise aplicadas*/
+typedef void (*tile_fn)(const TiledGraph* g, size_t bi, size_t bj,
+	const double* T, void* ctx);
+
+static void tiled_stream(const TiledGraph* g, tile_fn fn, void* ctx) {
+	for (size_t bi = 0; bi < g->nt; bi++) {
+		for (size_t bj = (g->directed ? 0 : bi); bj < g->nt; bj++) {
+			tile_begin(g, bi, bj);
+			fn(g, bi, bj, tile_ptr(g, bi, bj), ctx);
+			tile_end(g, bi, bj);
+		}
+	}
+}
+
+typedef struct {
+	double* out;
+	double* in;
+} DegreeCtx;
+
+/*Sem direção, o bloco (bi, bj) com bj > bi também é o transposto do
+bloco (bj, bi), então suas somas de coluna são graus de bj*/
+static void degree_tile(const TiledGraph* g, size_t bi, size_t bj,
+	const double* T, void* ctx) {
+	DegreeCtx* c = ctx;
+	size_t t = g->tile, r0 = bi * t, c0 = bj * t;
+	size_t rows = tile_extent(g, bi), cols = tile_extent(g, bj);
+	bool mirror = !g->directed && bj != bi;
+	double* row_sum = g->directed ? c->out : (c->out ? c->out : c->in);
+	double* col_sum = g->directed ? c->in : row_sum;
+
+	for (size_t i = 0; i < rows; i++) {
+		const double* row = &T[i * t];
+		double s = 0.0;
+
+		for (size_t j = 0; j < cols; j++) {
+			s += row[j];
+		}
+
+		if (row_sum) {
+			row_sum[r0 + i] += s;
+		}
+
+		if (col_sum && (g->directed || mirror)) {
+			for (size_t j = 0; j < cols; j++) {
+				col_sum[c0 + j] += row[j];
+			}
+		}
+	}
+}
+
+void tiled_graph_degree(const TiledGraph* g, double* deg_out, double* deg_in) {
+	size_t n = g->n;
+
+	if (deg_out) {
+		memset(deg_out, 0, n * sizeof(double));
+	}
+
+	if (deg_in) {
+		memset(deg_in, 0, n * sizeof(double));
+	}
+
+	if (!deg_out && !deg_in) {
+		return;
+	}
+
+	DegreeCtx c = {deg_out, deg_in};
+	tiled_stream(g, degree_tile, &c);
+
+	if (!g->directed && deg_out && deg_in) {
+		memcpy(deg_in, deg_out, n * sizeof(double));
+	}
+}
+
+static void edges_tile(const TiledGraph* g, size_t bi, size_t bj,
+	const double* T, void* ctx) {
+	size_t* count = ctx;
+	size_t t = g->tile, rows = tile_extent(g, bi), cols = tile_extent(g, bj);
+	size_t c = 0;
+
+	for (size_t i = 0; i < rows; i++) {
+		for (size_t j = 0; j < cols; j++) {
+			if (T[i * t + j] != 0.0) {
+				c++;
+			}
+		}
+	}
+
+	/*o bloco espelhado (bj, bi) tem o mesmo número de entradas*/
+	*count += (!g->directed && bj != bi) ? 2 * c : c;
+}
+
+size_t tiled_graph_num_edges(const TiledGraph* g) {
+	size_t count = 0;
+	tiled_stream(g, edges_tile, &count);
+
+	if (!g->directed) {
+		count /= 2;
+	}
+
+	return count;
+}
+
+typedef struct {
+	const double* x;
+	double* y;
+	bool transpose;
+} AxCtx;
+
+static void ax_tile(const TiledGraph* g, size_t bi, size_t bj,
+	const double* T, void* ctx) {
+	AxCtx* c = ctx;
+	size_t t = g->tile, r0 = bi * t, c0 = bj * t;
+	size_t rows = tile_extent(g, bi), cols = tile_extent(g, bj);
+	bool fwd = !c->transpose || !g->directed;
+	bool bwd = g->directed ? c->transpose : bj != bi;
+
+	for (size_t i = 0; i < rows; i++) {
+		const double* row = &T[i * t];
+
+		if (fwd) {
+			double s = 0.0;
+
+			for (size_t j = 0; j < cols; j++) {
+				s += row[j] * c->x[c0 + j];
+			}
+
+			c->y[r0 + i] += s;
+		}
+
+		if (bwd) {
+			double xi = c->x[r0 + i];
+
+			if (xi != 0.0) {
+				for (size_t j = 0; j < cols; j++) {
+					c->y[c0 + j] += row[j] * xi;
+				}
+			}
+		}
+	}
+}
+
+void tiled_graph_ax(const TiledGraph* g, const double* x, double* y) {
+	memset(y, 0, g->n * sizeof(double));
+	AxCtx c = {x, y, false};
+	tiled_stream(g, ax_tile, &c);
+}
+
+void tiled_graph_atx(const TiledGraph* g, const double* x, double* y) {
+	memset(y, 0, g->n * sizeof(double));
+	AxCtx c = {x, y, true};
+	tiled_stream(g, ax_tile, &c);
+}
+
+size_t tiled_graph_bfs(const TiledGraph* g, size_t src, int* dist) {
+	size_t n = g->n, t = g->tile, nt = g->nt;
+	tiled_bounds_check(g, src, src);
+
+	/*fronteira como lista por bloco, para varrer só as linhas certas*/
+	size_t* frontier = malloc(n * sizeof(size_t));
+	size_t* next = malloc(n * sizeof(size_t));
+	size_t* fcount = calloc(nt + 1, sizeof(size_t));
+	size_t* fstart = calloc(nt + 1, sizeof(size_t));
+	size_t* unvisited = malloc(nt * sizeof(size_t));
+
+	if (!frontier || !next || !fcount || !fstart || !unvisited) {
+		die("malloc error (tiled_graph_bfs)");
+	}
+
+	for (size_t v = 0; v < n; v++) {
+		dist[v] = -1;
+	}
+
+	for (size_t b = 0; b < nt; b++) {
+		unvisited[b] = tile_extent(g, b);
+	}
+
+	dist[src] = 0;
+	unvisited[src / t]--;
+	frontier[0] = src;
+	size_t fsize = 1, reached = 1;
+	int level = 0;
+
+	while (fsize > 0) {
+		/*agrupa a fronteira por bloco (counting sort)*/
+		memset(fcount, 0, (nt + 1) * sizeof(size_t));
+
+		for (size_t i = 0; i < fsize; i++) {
+			fcount[frontier[i] / t + 1]++;
+		}
+
+		for (size_t b = 0; b < nt; b++) {
+			fcount[b + 1] += fcount[b];
+		}
+
+		memcpy(fstart, fcount, (nt + 1) * sizeof(size_t));
+
+		for (size_t i = 0; i < fsize; i++) {
+			next[fcount[frontier[i] / t]++] = frontier[i];
+		}
+
+		size_t* swap = frontier;
+		frontier = next;
+		next = swap;
+		size_t nsize = 0;
+
+		for (size_t bi = 0; bi < nt; bi++) {
+			for (size_t bj = (g->directed ? 0 : bi); bj < nt; bj++) {
+				bool rows = fstart[bi + 1] > fstart[bi] && unvisited[bj] > 0;
+				bool cols = !g->directed && bj != bi
+					&& fstart[bj + 1] > fstart[bj] && unvisited[bi] > 0;
+
+				if (!rows && !cols) {
+					continue;
+				}
+
+				tile_begin(g, bi, bj);
+				const double* T = tile_ptr(g, bi, bj);
+
+				if (rows) {
+					size_t c0 = bj * t, ncols = tile_extent(g, bj);
+
+					for (size_t k = fstart[bi]; k < fstart[bi + 1]; k++) {
+						const double* row = &T[(frontier[k] - bi * t) * t];
+
+						for (size_t j = 0; j < ncols; j++) {
+							if (row[j] != 0.0 && dist[c0 + j] < 0) {
+								dist[c0 + j] = level + 1;
+								unvisited[bj]--;
+								next[nsize++] = c0 + j;
+							}
+						}
+					}
+				}
+
+				if (cols) {
+					/*bloco (bj, bi) = transposto de (bi, bj)*/
+					size_t r0 = bi * t, nrows = tile_extent(g, bi);
+
+					for (size_t k = fstart[bj]; k < fstart[bj + 1]; k++) {
+						size_t j = frontier[k] - bj * t;
+
+						for (size_t i = 0; i < nrows; i++) {
+							if (T[i * t + j] != 0.0 && dist[r0 + i] < 0) {
+								dist[r0 + i] = level + 1;
+								unvisited[bi]--;
+								next[nsize++] = r0 + i;
+							}
+						}
+					}
+				}
+
+				tile_end(g, bi, bj);
+			}
+		}
+
+		swap = frontier;
+		frontier = next;
+		next = swap;
+		fsize = nsize;
+		reached += nsize;
+		level++;
+	}
+
+	free(frontier);
+	free(next);
+	free(fcount);
+	free(fstart);
+	free(unvisited);
+
+	return reached;
+}
+
+bool tiled_graph_is_connected(const TiledGraph* g) {
+	if (g->n <= 1) {
+		return true;
+	}
+
+	int* dist = malloc(g->n * sizeof(int));
+
+	if (!dist) {
+		die("malloc error (dist)");
+	}
+
+	size_t reached = tiled_graph_bfs(g, 0, dist);
+	free(dist);
+
+	return reached == g->n;
+}
+
+void tiled_graph_walk_counts(const TiledGraph* g, size_t v, unsigned int k,
+	double* w) {
+	tiled_bounds_check(g, v, v);
+	double* tmp = malloc(g->n * sizeof(double));
+
+	if (!tmp) {
+		die("malloc error (tmp)");
+	}
+
+	/*e_v^T A^k = ((A^T)^k e_v)^T*/
+	memset(w, 0, g->n * sizeof(double));
+	w[v] = 1.0;
+
+	for (unsigned int i = 0; i < k; i++) {
+		tiled_graph_atx(g, w, tmp);
+		memcpy(w, tmp, g->n * sizeof(double));
+	}
+
+	free(tmp);
+}
+
+double tiled_graph_spectral_radius(const TiledGraph* g, unsigned int maxit,
+	double tol) {
+	size_t n = g->n;
+
+	if (n == 0) {
+		return 0.0;
+	}
+
+	double* x = malloc(n * sizeof(double));
+	double* y = malloc(n * sizeof(double));
+
+	if (!x || !y) {
+		die("malloc error (x || y)");
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		x[i] = 1.0 / sqrt((double) n);
+	}
+
+	/*o deslocamento A + I evita a oscilação entre λ1 e -λ1 de grafos
+	bipartidos; λ é o quociente de Rayleigh x^T A x*/
+	double lambda = 0.0;
+
+	for (unsigned int it = 0; it < maxit; it++) {
+		tiled_graph_ax(g, x, y);
+
+		double rq = 0.0, norm = 0.0;
+
+		for (size_t i = 0; i < n; i++) {
+			rq += x[i] * y[i];
+			y[i] += x[i];
+			norm += y[i] * y[i];
+		}
+
+		norm = sqrt(norm);
+
+		if (norm == 0.0) {
+			break;
+		}
+
+		for (size_t i = 0; i < n; i++) {
+			x[i] = y[i] / norm;
+		}
+
+		bool done = it > 0 && fabs(rq - lambda) <= tol * fabs(rq);
+		lambda = rq;
+
+		if (done) {
+			break;
+		}
+	}
+
+	free(x);
+	free(y);
+
+	return lambda;
+}
@@ -0,0 +1,122 @@
+#ifndef TILED_H
+#define TILED_H
+
+/* --- Grafos densos em disco (out-of-core) --- */
+
+/*
+Para grafos densos que não cabem na RAM (n = 200k já dá 320 GB de
+double), a matriz de adjacência fica num arquivo mapeado com mmap,
+guardada em blocos (tiles) quadrados de lado `tile`:
+
+[cabeçalho de 4096 bytes][bloco (0,0)][bloco (0,1)]...[bloco (nt-1,nt-1)]
+
+Cada bloco tem tile * tile doubles em row-major order (os blocos da
+borda são completados com zeros), e os blocos aparecem em row-major
+order. Assim um bloco é um trecho contíguo do arquivo, e as funções
+abaixo percorrem a matriz bloco a bloco, na ordem do arquivo, dando
+dicas ao kernel com madvise (leitura sequencial, prefetch do bloco
+seguinte e, se o arquivo for maior que a RAM, descarte do bloco já
+lido). Para grafos não direcionados só os blocos (bi, bj) com
+bj >= bi são lidos, o que corta o I/O pela metade.
+
+Um TiledGraph não é um Graph: as funções de graphs.h e eig.h que
+acessam g->A diretamente não se aplicam. Use as versões tiled_*
+daqui para grau, arestas, produto Ax, BFS/conectividade, contagem
+de passeios e estimativa do raio espectral.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "graphs.h"
+
+typedef struct {
+	size_t n;			/* N° de vértices*/
+	bool directed;		/* Grafo direcionado?*/
+	size_t tile;		/* Lado de cada bloco (múltiplo de 32)*/
+	size_t nt;			/* N° de blocos por lado = ceil(n / tile)*/
+	bool writable;		/* Mapeado com PROT_WRITE?*/
+	bool evict;			/* Descartar blocos já lidos (arquivo > RAM)?*/
+	int fd;
+	void* map;			/* Início do mapeamento (cabeçalho)*/
+	size_t map_len;
+	double* tiles;		/* Início dos blocos*/
+} TiledGraph;
+
+
+/*Lado padrão dos blocos: 1024 x 1024 doubles = 8 MB por bloco*/
+#define TILED_DEFAULT_TILE 1024
+
+
+/*Cria (ou sobrescreve) o arquivo path com um grafo vazio de n
+vértices e o mapeia para escrita. O arquivo é criado esparso, então
+só os blocos com alguma aresta ocupam espaço em disco.
+tile = 0 usa TILED_DEFAULT_TILE*/
+TiledGraph* tiled_graph_create(const char* path, size_t n, bool directed,
+	size_t tile);
+
+
+/*Abre um grafo criado por tiled_graph_create*/
+TiledGraph* tiled_graph_open(const char* path, bool writable);
+
+
+/*Copia g para um arquivo em blocos*/
+TiledGraph* tiled_graph_from_graph(const Graph* g, const char* path,
+	size_t tile);
+
+
+/*Cria o arquivo em blocos lendo as arestas de um arquivo texto no
+formato de graph_read_from_file, sem nunca montar a matriz na RAM*/
+TiledGraph* tiled_graph_read_from_file(const char* edges_path,
+	const char* path, size_t tile);
+
+
+/*Sincroniza (se aberto para escrita), desfaz o mapeamento e libera g*/
+void tiled_graph_close(TiledGraph* g);
+
+
+/*Iguais a graph_add_edge/graph_remove_edge/graph_get*/
+void tiled_graph_add_edge(TiledGraph* g, size_t u, size_t v, double w);
+void tiled_graph_remove_edge(TiledGraph* g, size_t u, size_t v);
+double tiled_graph_get(const TiledGraph* g, size_t u, size_t v);
+
+
+/*Igual a graph_degree, lendo cada bloco uma vez*/
+void tiled_graph_degree(const TiledGraph* g, double* deg_out, double* deg_in);
+
+
+/*Igual a graph_num_edges*/
+size_t tiled_graph_num_edges(const TiledGraph* g);
+
+
+/*y = A * x*/
+void tiled_graph_ax(const TiledGraph* g, const double* x, double* y);
+
+
+/*y = A^T * x (igual a tiled_graph_ax se g não for direcionado)*/
+void tiled_graph_atx(const TiledGraph* g, const double* x, double* y);
+
+
+/*BFS a partir de src. dist[v] recebe a distância (em arestas) de src
+até v, ou -1 se v não for alcançável. Retorna o número de vértices
+alcançados. Cada nível lê só os blocos que têm algum vértice da
+fronteira (e algum vértice ainda não visitado)*/
+size_t tiled_graph_bfs(const TiledGraph* g, size_t src, int* dist);
+
+
+/*Mesma semântica de graph_is_connected*/
+bool tiled_graph_is_connected(const TiledGraph* g);
+
+
+/*w[u] = número de passeios de tamanho k de v até u
+(a linha v de A^k), usando k produtos com A^T*/
+void tiled_graph_walk_counts(const TiledGraph* g, size_t v, unsigned int k,
+	double* w);
+
+
+/*Estima o maior autovalor de A (grafo não direcionado, pesos >= 0)
+por iteração da potência em A + I. Para quando a variação relativa
+for menor que tol ou após maxit produtos*/
+double tiled_graph_spectral_radius(const TiledGraph* g, unsigned int maxit,
+	double tol);
+
+#endif
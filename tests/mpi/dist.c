@@ -0,0 +1,274 @@
+#include "../../src/graphs.h"
+#include "../../src/eig.h"
+#include "../../src/rng.h"
+#include "../../src/dist.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+
+static int rank, size;
+
+/*BFS densa de referência*/
+static void dense_bfs(const Graph* g, size_t src, int* dist) {
+	size_t n = g->n;
+	size_t* queue = malloc(n * sizeof(size_t));
+	size_t head = 0, tail = 0;
+
+	for (size_t v = 0; v < n; v++) {
+		dist[v] = -1;
+	}
+
+	dist[src] = 0;
+	queue[tail++] = src;
+
+	while (head < tail) {
+		size_t u = queue[head++];
+
+		for (size_t v = 0; v < n; v++) {
+			if (g->A[IDX(u, v, n)] != 0.0 && dist[v] < 0) {
+				dist[v] = dist[u] + 1;
+				queue[tail++] = v;
+			}
+		}
+	}
+
+	free(queue);
+}
+
+/*Arestas de g, divididas entre os processos (k ≡ rank)*/
+static size_t my_edges(const Graph* g, size_t* u, size_t* v, double* w) {
+	size_t n = g->n, k = 0, m = 0;
+
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = g->directed ? 0 : i; j < n; j++) {
+			if (g->A[IDX(i, j, n)] != 0.0 && k++ % (size_t) size
+				== (size_t) rank) {
+				u[m] = i;
+				v[m] = j;
+				w[m] = g->A[IDX(i, j, n)];
+				m++;
+			}
+		}
+	}
+
+	return m;
+}
+
+static void write_file(const Graph* g, const char* path) {
+	if (rank == 0) {
+		size_t n = g->n, m = 0;
+
+		for (size_t i = 0; i < n; i++) {
+			for (size_t j = g->directed ? 0 : i; j < n; j++) {
+				m += g->A[IDX(i, j, n)] != 0.0;
+			}
+		}
+
+		FILE* f = fopen(path, "w");
+		fprintf(f, "%zu %d\n%zu\n", n, g->directed, m);
+
+		for (size_t i = 0; i < n; i++) {
+			for (size_t j = g->directed ? 0 : i; j < n; j++) {
+				if (g->A[IDX(i, j, n)] != 0.0) {
+					fprintf(f, "%zu %zu %.17g\n", i, j, g->A[IDX(i, j, n)]);
+				}
+			}
+		}
+
+		fclose(f);
+	}
+
+	MPI_Barrier(MPI_COMM_WORLD);
+}
+
+static void same_matrix(const GraphDistMatrix* a, const GraphDistMatrix* b) {
+	assert(a->mloc == b->mloc && a->nloc == b->nloc);
+
+	for (int k = 0; k < a->mloc * a->nloc; k++) {
+		assert(a->A[k] == b->A[k]);
+	}
+}
+
+static void spectra(const GraphDistGrid* grid, Graph* g, int nb) {
+	size_t n = g->n;
+	double* w = malloc(n * sizeof(double));
+	double* ref = malloc(n * sizeof(double));
+	size_t* u = malloc(n * n * sizeof(size_t));
+	size_t* v = malloc(n * n * sizeof(size_t));
+	double* x = malloc(n * n * sizeof(double));
+
+	GraphDistMatrix A, B, C, L, Z;
+	graph_dist_from_graph(grid, g, nb, &A);
+
+	/*arestas espalhadas e arquivo dão a mesma A*/
+	size_t m = my_edges(g, u, v, x);
+	assert(graph_dist_from_edges(grid, n, g->directed, m, u, v, x, nb, &B)
+		== 0);
+	same_matrix(&A, &B);
+
+	write_file(g, "/tmp/graph_dist_test.txt");
+	assert(graph_dist_read_file(grid, "/tmp/graph_dist_test.txt", nb, &C)
+		== 0);
+	same_matrix(&A, &C);
+
+	graph_dist_laplacian(&A, &L);
+
+	assert(graph_dist_spec(&A, w) == 0);
+	graph_spec_adj(g, ref);
+
+	for (size_t i = 0; i < n; i++) {
+		assert(fabs(w[i] - ref[i]) < 1e-8);
+	}
+
+	assert(graph_dist_spec(&L, w) == 0);
+	graph_spec_lap(g, ref);
+
+	for (size_t i = 0; i < n; i++) {
+		assert(fabs(w[i] - ref[i]) < 1e-8);
+	}
+
+	/*autovetores: mesmos autovalores e colunas de norma 1*/
+	assert(graph_dist_eigvecs(&B, w, &Z) == 0);
+	graph_spec_adj(g, ref);
+	double* norms = calloc(n, sizeof(double));
+
+	for (size_t i = 0; i < n; i++) {
+		assert(fabs(w[i] - ref[i]) < 1e-8);
+	}
+
+	for (int lj = 0; lj < Z.nloc; lj++) {
+		size_t j = ((size_t) (lj / nb) * grid->npcol + grid->mycol) * nb
+			+ lj % nb;
+
+		for (int li = 0; li < Z.mloc; li++) {
+			double z = Z.A[(size_t) lj * Z.desc[8] + li];
+			norms[j] += z * z;
+		}
+	}
+
+	MPI_Allreduce(MPI_IN_PLACE, norms, (int) n, MPI_DOUBLE, MPI_SUM,
+		grid->comm);
+
+	for (size_t j = 0; j < n; j++) {
+		assert(fabs(norms[j] - 1.0) < 1e-8);
+	}
+
+	/*vértice fora do intervalo: todos recebem -1*/
+	u[0] = n;
+	v[0] = 0;
+	assert(graph_dist_from_edges(grid, n, false, rank == 1, u, v, NULL, nb,
+		&B) == -1 || size == 1);
+
+	graph_dist_matrix_free(&A);
+	graph_dist_matrix_free(&B);
+	graph_dist_matrix_free(&C);
+	graph_dist_matrix_free(&L);
+	graph_dist_matrix_free(&Z);
+	free(w);
+	free(ref);
+	free(u);
+	free(v);
+	free(x);
+	free(norms);
+}
+
+static void traversal(Graph* g) {
+	size_t n = g->n;
+	size_t* u = malloc(n * n * sizeof(size_t));
+	size_t* v = malloc(n * n * sizeof(size_t));
+	double* x = malloc(n * n * sizeof(double));
+	int* dist = malloc(n * sizeof(int));
+	int* ref = malloc(n * sizeof(int));
+	GraphDistCSR c[3];
+
+	graph_dist_csr_from_graph(MPI_COMM_WORLD, g, &c[0]);
+	size_t m = my_edges(g, u, v, x);
+	assert(graph_dist_csr_from_edges(MPI_COMM_WORLD, n, g->directed, m, u, v,
+		&c[1]) == 0);
+	write_file(g, "/tmp/graph_dist_test.txt");
+	assert(graph_dist_csr_read_file(MPI_COMM_WORLD,
+		"/tmp/graph_dist_test.txt", &c[2]) == 0);
+
+	bool connected = graph_is_connected(g);
+	int diameter = graph_diameter(g);
+
+	for (int k = 0; k < 3; k++) {
+		assert(c[k].rowptr[c[k].hi - c[k].lo]
+			== c[0].rowptr[c[0].hi - c[0].lo]);
+
+		for (size_t s = 0; s < n; s += 37) {
+			dense_bfs(g, s, ref);
+			int ecc = graph_dist_bfs(&c[k], s, dist);
+			int best = 0;
+
+			for (size_t i = c[k].lo; i < c[k].hi; i++) {
+				assert(dist[i - c[k].lo] == ref[i]);
+			}
+
+			for (size_t i = 0; i < n; i++) {
+				best = ref[i] > best ? ref[i] : best;
+			}
+
+			assert(ecc == best);
+		}
+
+		assert(graph_dist_is_connected(&c[k]) == connected);
+		assert(graph_dist_diameter(&c[k]) == diameter);
+	}
+
+	for (int k = 0; k < 3; k++) {
+		graph_dist_csr_free(&c[k]);
+	}
+
+	free(u);
+	free(v);
+	free(x);
+	free(dist);
+	free(ref);
+}
+
+int main(int argc, char** argv) {
+	MPI_Init(&argc, &argv);
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+	GraphDistGrid grid;
+	graph_dist_grid_init(&grid, MPI_COMM_WORLD);
+	assert(grid.nprow * grid.npcol == size && grid.nprow <= grid.npcol);
+
+	/*mesma semente em todos os processos: mesmo grafo*/
+	Rng rng;
+	rng_seed(&rng, 21);
+
+	Graph* g = graph_random_r(150, 0.05, &rng);
+	spectra(&grid, g, 16);
+	traversal(g);
+	graph_free(g);
+
+	g = graph_random_connected_r(97, 0.04, &rng);
+	graph_add_edge(g, 3, 60, 2.5);
+	spectra(&grid, g, GRAPH_DIST_NB);
+	traversal(g);
+	graph_free(g);
+
+	/*direcionado: só a travessia (espectro é complexo)*/
+	g = graph_new(130, true);
+
+	for (size_t k = 0; k < 300; k++) {
+		graph_add_edge(g, rng_below(&rng, 130), rng_below(&rng, 130), 1.0);
+	}
+
+	traversal(g);
+	graph_free(g);
+
+	graph_dist_grid_free(&grid);
+
+	if (rank == 0) {
+		printf("testes passaram!\n");
+	}
+
+	MPI_Finalize();
+
+	return 0;
+}
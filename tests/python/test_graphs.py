@@ -0,0 +1,237 @@
+import math
+import struct
+import threading
+import unittest
+
+import graphs
+
+try:
+    import numpy as np
+except ImportError:
+    np = None
+
+
+def matrix(rows):
+    """Buffer float64 n x n (C-contíguo) sem numpy"""
+    n = len(rows)
+    buf = bytearray(struct.pack("%dd" % (n * n), *[x for r in rows for x in r]))
+
+    return memoryview(buf).cast("B").cast("d", (n, n))
+
+
+class TestBuffers(unittest.TestCase):
+    def test_graph_is_view_of_A(self):
+        g = graphs.Graph(4)
+        a = memoryview(g)
+        self.assertEqual(a.shape, (4, 4))
+        self.assertEqual(a.format, "d")
+        self.assertTrue(a.readonly)
+
+        g.add_edge(0, 1)
+        self.assertEqual(a[0, 1], 1.0)
+        self.assertEqual(a[1, 0], 1.0)
+
+        with self.assertRaises(TypeError):
+            a[2, 3] = 5.0
+
+    def test_writable_view_invalidates(self):
+        g = graphs.Graph(4)
+        g.add_edge(0, 1)
+        self.assertEqual(g.num_edges(), 1)
+        before = g.spec_adj().tolist()
+        version = g.version
+
+        with memoryview(g.writable()) as w:
+            self.assertFalse(w.readonly)
+            w[2, 3] = w[3, 2] = 5.0
+
+        self.assertGreater(g.version, version)
+        self.assertEqual(g.get(3, 2), 5.0)
+        self.assertEqual(g.num_edges(), 2)
+        self.assertNotEqual(g.spec_adj().tolist(), before)
+
+    def test_results_are_arrays(self):
+        x = graphs.complete(5).spec_adj()
+        v = memoryview(x)
+        self.assertEqual(v.format, "d")
+        self.assertEqual(x.shape, (5,))
+        self.assertEqual(len(x), 5)
+
+        for got, want in zip(x.tolist(), [-1, -1, -1, -1, 4]):
+            self.assertAlmostEqual(got, want)
+
+        c, label = graphs.Graph(3).components()
+        self.assertEqual(c, 3)
+        self.assertEqual(memoryview(label).format, "N")
+        self.assertEqual(label.tolist(), [0, 1, 2])
+
+    def test_from_array(self):
+        g = graphs.Graph.from_array(matrix([[0, 1, 0], [1, 0, 1], [0, 1, 0]]))
+        self.assertFalse(g.directed)
+        self.assertEqual(g.num_edges(), 2)
+
+        for got, want in zip(g.spec_adj().tolist(), [-math.sqrt(2), 0, math.sqrt(2)]):
+            self.assertAlmostEqual(got, want)
+
+        d = graphs.Graph.from_array(matrix([[0, 1], [0, 0]]))
+        self.assertTrue(d.directed)
+
+        with self.assertRaises(TypeError):
+            graphs.Graph.from_array(b"abc")
+
+    @unittest.skipIf(np is None, "sem numpy")
+    def test_numpy_zero_copy(self):
+        g = graphs.random(50, 0.3, seed=1)
+        A = np.asarray(g)
+        self.assertEqual(A.shape, (50, 50))
+        g.add_edge(0, 49, 7.0)
+        self.assertEqual(A[49, 0], 7.0)
+
+        x = g.spec_adj()
+        self.assertTrue(np.shares_memory(np.asarray(x), np.asarray(x)))
+        self.assertTrue(np.allclose(np.asarray(x), np.linalg.eigvalsh(A)))
+
+        h = graphs.Graph.from_array(np.eye(3))
+        self.assertEqual(h.get(1, 1), 1.0)
+
+        L = np.asarray(g.laplacian())
+        self.assertTrue(np.allclose(L.sum(axis=1), 0.0))
+
+
+class TestFunctions(unittest.TestCase):
+    def test_generators(self):
+        self.assertEqual(graphs.random(30, 0.2, seed=7).spec_adj().tolist(),
+                         graphs.random(30, 0.2, seed=7).spec_adj().tolist())
+        self.assertTrue(graphs.random_connected(20, 0.1, seed=1).is_connected())
+        self.assertEqual(graphs.random_regular(10, 3, seed=2).degree().tolist(),
+                         [3.0] * 10)
+        self.assertEqual(graphs.hypercube(3).n, 8)
+        self.assertEqual(graphs.circulant(6, [1]).num_edges(), 6)
+        self.assertEqual(graphs.complete_bipartite(2, 3).num_edges(), 6)
+
+        with self.assertRaises(ValueError):
+            graphs.cycle(2)
+
+        with self.assertRaises(ValueError):
+            graphs.random(10, 1.5)
+
+        with self.assertRaises(ValueError):
+            graphs.random_regular(5, 3)
+
+    def test_structure(self):
+        g = graphs.cycle(6)
+        self.assertEqual(g.diameter(), 3)
+        self.assertEqual(g.wiener_index(), 27.0)
+        self.assertEqual(g.transmission().tolist(), [9.0] * 6)
+        self.assertAlmostEqual(g.log_spanning_trees(), math.log(6))
+        self.assertAlmostEqual(g.effective_resistance(0, 3), 1.5)
+
+        with self.assertRaises(IndexError):
+            g.add_edge(0, 6)
+
+        d = graphs.Graph(3, directed=True)
+        d.add_edge(0, 1)
+        self.assertEqual(d.degree().tolist(), [1.0, 0.0, 0.0])
+        self.assertEqual(d.in_degree().tolist(), [0.0, 1.0, 0.0])
+
+        with self.assertRaises(ValueError):
+            d.spec_adj()
+
+    def test_csr(self):
+        c = graphs.cycle(5).csr()
+        self.assertEqual(c.rowptr.tolist(), [0, 2, 4, 6, 8, 10])
+        self.assertIsNone(c.weights)
+        self.assertEqual(c.sssp(0).tolist(), [0, 1, 2, 2, 1])
+
+        self.assertTrue(memoryview(c.col).readonly)
+
+        b = graphs.ba(1000, 3, seed=1)
+        self.assertEqual(len(b.rowptr), 1001)
+
+        s, label = graphs.sbm([10, 20], matrix([[0.5, 0.1], [0.1, 0.5]]), seed=3)
+        self.assertEqual(s.n, 30)
+        self.assertEqual(label.tolist(), [0] * 10 + [1] * 20)
+
+        h = graphs.random(200, 0.5, seed=4).sparsify(0.5, "degree", seed=5)
+        self.assertEqual(h.n, 200)
+        self.assertIsNotNone(h.weights)
+
+    def test_batches(self):
+        for n in (12, 40):
+            gs = [graphs.random(n, 0.4, seed=k) for k in range(10)]
+            w = graphs.spec_adj_batch(gs)
+            wl = graphs.spec_lap_batch(gs)
+            self.assertEqual(w.shape, (10, n))
+
+            for k, g in enumerate(gs):
+                for got, want in zip(w.tolist()[k], g.spec_adj().tolist()):
+                    self.assertAlmostEqual(got, want, places=9)
+
+                for got, want in zip(wl.tolist()[k], g.spec_lap().tolist()):
+                    self.assertAlmostEqual(got, want, places=9)
+
+        with self.assertRaises(ValueError):
+            graphs.spec_adj_batch([graphs.Graph(3), graphs.Graph(4)])
+
+        m = graphs.complete(4)
+        x = graphs.matrix_spec(memoryview(m))
+        y = graphs.matrix_spec_batch(memoryview(bytes(memoryview(m).cast("B")) * 2)
+                                     .cast("d", (2, 4, 4)))
+        self.assertEqual(y.shape, (2, 4))
+
+        for row in y.tolist():
+            for got, want in zip(row, x.tolist()):
+                self.assertAlmostEqual(got, want)
+
+
+class TestThreads(unittest.TestCase):
+    def test_concurrent_batches(self):
+        gs = [graphs.random(16, 0.5, seed=k) for k in range(2000)]
+        want = graphs.spec_adj_batch(gs).tolist()
+        out = [None] * 4
+
+        def run(i):
+            out[i] = graphs.spec_adj_batch(gs).tolist()
+
+        ts = [threading.Thread(target=run, args=(i,)) for i in range(4)]
+
+        for t in ts:
+            t.start()
+
+        for t in ts:
+            t.join()
+
+        self.assertEqual(out, [want] * 4)
+
+    def test_busy_graph(self):
+        g = graphs.random(600, 0.5, seed=1)
+        t = threading.Thread(target=g.spec_lap)
+        t.start()
+        seen = False
+
+        while t.is_alive() and not seen:
+            try:
+                g.remove_edge(0, 0)
+            except RuntimeError:
+                seen = True
+
+        t.join()
+        self.assertTrue(seen)
+
+        w = g.writable()
+        t = threading.Thread(target=g.spec_lap)
+        t.start()
+        seen = False
+
+        while t.is_alive() and not seen:
+            try:
+                memoryview(w).release()
+            except BufferError:
+                seen = True
+
+        t.join()
+        self.assertTrue(seen)
+
+
+if __name__ == "__main__":
+    unittest.main(verbosity=2)
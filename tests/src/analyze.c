@@ -0,0 +1,167 @@
+#include "../../src/graphs.h"
+#include "../../src/eig.h"
+#include "../../src/components.h"
+#include "../../src/bipartite.h"
+#include "../../src/analyze.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+
+/*Cópia sem cache compartilhado, para comparar com as funções avulsas*/
+static Graph* copy(const Graph* g) {
+	Graph* h = graph_new(g->n, g->directed);
+	memcpy(h->A, g->A, g->n * g->n * sizeof(double));
+
+	return h;
+}
+
+static void check(Graph* g) {
+	size_t n = g->n;
+	GraphReport r;
+	Graph* h = copy(g);
+	bool sym = true;
+
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = 0; j < n; j++) {
+			sym = sym && g->A[IDX(i, j, n)] == g->A[IDX(j, i, n)];
+		}
+	}
+
+	/*direcionado não simétrico: espectro complexo (digraph.h)*/
+	if (g->directed && !sym) {
+		assert(graph_analyze(g, GRAPH_ANALYZE_ALL, &r) == -1);
+		assert(!r.spec_adj && !r.spec_lap);
+	} else {
+		assert(graph_analyze(g, GRAPH_ANALYZE_ALL, &r) == 0);
+	}
+
+	assert(r.n == n);
+	assert(r.num_edges == graph_num_edges(h));
+	assert(r.diameter == graph_diameter(h));
+
+	if (!g->directed) {
+		assert(r.connected == graph_is_connected(h));
+	}
+
+	double* deg_out = malloc((n + 1) * sizeof(double));
+	double* deg_in = malloc((n + 1) * sizeof(double));
+	graph_degree(h, deg_out, deg_in);
+
+	for (size_t v = 0; v < n; v++) {
+		assert(fabs(r.deg_out[v] - deg_out[v]) < 1e-12);
+		assert(fabs(r.deg_in[v] - deg_in[v]) < 1e-12);
+	}
+
+	size_t* label = malloc((n + 1) * sizeof(size_t));
+	assert(graph_components(h, label) == r.ncomponents);
+
+	for (size_t v = 0; v < n; v++) {
+		assert(label[v] == r.component[v]);
+	}
+
+	bool* side = malloc((n + 1) * sizeof(bool));
+	assert(graph_bipartition(h, side) == r.bipartite);
+
+	if (r.bipartite) {
+		for (size_t v = 0; v < n; v++) {
+			assert(side[v] == r.side[v]);
+		}
+	}
+
+	double* L = malloc((n * n + 1) * sizeof(double));
+	graph_laplacian(h, L);
+
+	for (size_t i = 0; i < n * n; i++) {
+		assert(fabs(L[i] - r.L[i]) < 1e-12);
+	}
+
+	double* x = malloc((n + 1) * sizeof(double));
+
+	if (!g->directed && n > 0) {
+		assert(graph_spec_adj(h, x) == 0);
+
+		for (size_t i = 0; i < n; i++) {
+			assert(fabs(x[i] - r.spec_adj[i]) < 1e-8);
+		}
+
+		assert(graph_spec_lap(h, x) == 0);
+
+		for (size_t i = 0; i < n; i++) {
+			assert(fabs(x[i] - r.spec_lap[i]) < 1e-8);
+		}
+
+		/*os espectros ficaram no cache de g*/
+		assert(graph_spec_adj(g, x) == 0);
+		assert(memcmp(x, r.spec_adj, n * sizeof(double)) == 0);
+	}
+
+	assert(sym == r.symmetric);
+
+	graph_report_free(&r);
+
+	/*só escalares: nenhum vetor alocado*/
+	assert(graph_analyze(g, 0, &r) == 0);
+	assert(!r.deg_out && !r.component && !r.L && !r.spec_adj);
+	assert(r.diameter == -1);
+	graph_report_free(&r);
+
+	free(deg_out);
+	free(deg_in);
+	free(label);
+	free(side);
+	free(L);
+	free(x);
+	graph_free(h);
+}
+
+int main() {
+	srand(3);
+
+	for (int t = 0; t < 10; t++) {
+		Graph* g = graph_random(40 + t * 7, 0.03 * (t + 1));
+		check(g);
+		graph_free(g);
+	}
+
+	for (int t = 0; t < 5; t++) {
+		Graph* g = graph_random_bipartite(20 + t, 15 + 2 * t, 0.2);
+		check(g);
+		graph_free(g);
+	}
+
+	/*laço e peso*/
+	Graph* g = graph_random(50, 0.1);
+	graph_add_edge(g, 7, 7, 2.0);
+	graph_add_edge(g, 3, 9, 2.5);
+	check(g);
+	graph_free(g);
+
+	/*direcionado, com arestas de mão única*/
+	g = graph_new(70, true);
+
+	for (size_t i = 0; i < 70; i++) {
+		for (size_t j = 0; j < 70; j++) {
+			if (i != j && rand() % 25 == 0) {
+				graph_add_edge(g, i, j, 1.0);
+			}
+		}
+	}
+
+	check(g);
+	graph_free(g);
+
+	/*família: espectro pela fórmula*/
+	g = graph_kn(9);
+	check(g);
+	graph_free(g);
+
+	g = graph_new(0, false);
+	check(g);
+	graph_free(g);
+
+	printf("testes passaram!\n");
+
+	return 0;
+}
@@ -0,0 +1,176 @@
+#include "../../src/graphs.h"
+#include "../../src/eig.h"
+#include "../../src/batch.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <assert.h>
+
+static double now(void) {
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+
+	return (double) t.tv_sec + 1e-9 * (double) t.tv_nsec;
+}
+
+/*count matrizes simétricas aleatórias em sequência*/
+static double* random_symmetric(size_t n, size_t count, Rng* rng) {
+	double* A = malloc((count * n * n + 1) * sizeof(double));
+
+	for (size_t k = 0; k < count; k++) {
+		double* M = &A[k * n * n];
+
+		for (size_t i = 0; i < n; i++) {
+			for (size_t j = i; j < n; j++) {
+				M[IDX(i, j, n)] = M[IDX(j, i, n)] = 2.0 * rng_uniform(rng) - 1.0;
+			}
+		}
+	}
+
+	return A;
+}
+
+static void check_matrices(size_t n, size_t count, Rng* rng) {
+	double* A = random_symmetric(n, count, rng);
+	double* w = malloc((count * n + 1) * sizeof(double));
+	double x[BATCH_MAX_N];
+	assert(matrix_spec_batch(A, n, count, w) == 0);
+
+	for (size_t k = 0; k < count; k++) {
+		assert(matrix_spec(&A[k * n * n], n, x) == 0);
+
+		for (size_t i = 0; i < n; i++) {
+			assert(fabs(w[k * n + i] - x[i]) < 1e-10);
+		}
+	}
+
+	free(A);
+	free(w);
+}
+
+static void correctness(void) {
+	Rng rng;
+	rng_seed(&rng, 1);
+
+	/*n de 1 a 32, com grupos incompletos no fim*/
+	for (size_t n = 1; n <= BATCH_MAX_N; n++) {
+		check_matrices(n, 24 + n % 8, &rng);
+	}
+
+	/*NaN na matriz 5 nunca deflaciona: o lote aponta a primeira que não
+	convergiu e as outras linhas saem certas*/
+	size_t n = 6, count = 11;
+	double* A = random_symmetric(n, count, &rng);
+	double* w = malloc(count * n * sizeof(double));
+	double x6[6];
+	A[5 * n * n + IDX(1, 2, n)] = A[5 * n * n + IDX(2, 1, n)] = NAN;
+	A[8 * n * n + IDX(0, 3, n)] = A[8 * n * n + IDX(3, 0, n)] = NAN;
+	assert(matrix_spec_batch(A, n, count, w) == 6);
+
+	for (size_t k = 0; k < count; k++) {
+		if (k == 5 || k == 8) {
+			continue;
+		}
+
+		assert(matrix_spec(&A[k * n * n], n, x6) == 0);
+
+		for (size_t i = 0; i < n; i++) {
+			assert(fabs(w[k * n + i] - x6[i]) < 1e-10);
+		}
+	}
+
+	free(A);
+	free(w);
+
+	/*grafos: espectros de A e de L; pistas com muitos a_pq = 0*/
+	Graph* g[21];
+
+	for (size_t k = 0; k < 21; k++) {
+		g[k] = graph_random_r(12, k / 20.0, &rng);
+	}
+
+	double wa[21 * 12], wl[21 * 12], x[12];
+	assert(graph_spec_adj_batch(g, 21, wa) == 0);
+	assert(graph_spec_lap_batch(g, 21, wl) == 0);
+
+	for (size_t k = 0; k < 21; k++) {
+		graph_spec_adj(g[k], x);
+
+		for (size_t i = 0; i < 12; i++) {
+			assert(fabs(wa[k * 12 + i] - x[i]) < 1e-10);
+		}
+
+		graph_spec_lap(g[k], x);
+
+		for (size_t i = 0; i < 12; i++) {
+			assert(fabs(wl[k * 12 + i] - x[i]) < 1e-10);
+		}
+	}
+
+	/*n diferentes, direcionado não simétrico, n grande demais*/
+	Graph* other = graph_new(5, false);
+	Graph* mixed[] = {g[0], other};
+	assert(graph_spec_adj_batch(mixed, 2, wa) == -1);
+
+	Graph* dir = graph_new(12, true);
+	graph_add_edge(dir, 0, 1, 1.0);
+	Graph* with_dir[] = {g[0], dir};
+	assert(graph_spec_adj_batch(with_dir, 2, wa) == -1);
+
+	Graph* big = graph_new(BATCH_MAX_N + 1, false);
+	assert(graph_spec_adj_batch(&big, 1, wa) == -1);
+
+	for (size_t k = 0; k < 21; k++) {
+		graph_free(g[k]);
+	}
+
+	graph_free(other);
+	graph_free(dir);
+	graph_free(big);
+}
+
+/*count matrizes de adjacência de G(n, 1/2), as mesmas em cada
+medida: laço de matrix_spec e o lote*/
+static void bench(size_t n, size_t count) {
+	Rng rng;
+	rng_seed(&rng, n);
+	double* A = malloc(count * n * n * sizeof(double));
+	double* w = malloc(count * n * sizeof(double));
+
+	for (size_t k = 0; k < count; k++) {
+		Graph* g = graph_random_r(n, 0.5, &rng);
+		memcpy(&A[k * n * n], g->A, n * n * sizeof(double));
+		graph_free(g);
+	}
+
+	double t0 = now();
+
+	for (size_t k = 0; k < count; k++) {
+		matrix_spec(&A[k * n * n], n, &w[k * n]);
+	}
+
+	double t_lapack = now() - t0;
+	t0 = now();
+	assert(matrix_spec_batch(A, n, count, w) == 0);
+	double t_batch = now() - t0;
+
+	printf("n = %2zu, %zu matrizes: matrix_spec %.3fs, lote %.3fs (%.1fx)\n",
+		n, count, t_lapack, t_batch, t_lapack / t_batch);
+
+	free(A);
+	free(w);
+}
+
+int main() {
+	correctness();
+
+	bench(8, 100000);
+	bench(16, 20000);
+	bench(32, 4000);
+
+	printf("testes passaram!\n");
+
+	return 0;
+}
@@ -0,0 +1,96 @@
+#include "../../src/graphs.h"
+#include "../../src/eig.h"
+#include "../../src/bipartite.h"
+#include "../../src/families.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <math.h>
+#include <assert.h>
+
+static void check(const Graph* g) {
+	size_t n = g->n;
+	double* x = malloc(n * sizeof(double));
+	double* y = malloc(n * sizeof(double));
+
+	assert(graph_spec_adj(g, x) == 0);
+	assert(matrix_spec(g->A, n, y) == 0);
+
+	for (size_t i = 0; i < n; i++) {
+		assert(fabs(x[i] - y[i]) < 1e-8);
+	}
+
+	free(x);
+	free(y);
+}
+
+int main() {
+	srand(time(NULL));
+
+	bool side[64];
+
+	/*partição vinda do gerador*/
+	Graph* g = graph_random_bipartite(20, 30, 0.3);
+	assert(graph_family(g) == GRAPH_FAMILY_BIPARTITE);
+	assert(graph_bipartition(g, side));
+
+	for (size_t v = 0; v < 50; v++) {
+		assert(side[v] == (v >= 20));
+	}
+
+	check(g);
+	graph_free(g);
+
+	Graph* u = graph_random_bipartite(5, 2, 0.9);
+	check(u);
+	graph_free(u);
+
+	/*sem marca: 2-coloração, com pesos e vértices misturados*/
+	size_t n = 40;
+	Graph* h = graph_new(n, false);
+
+	for (size_t i = 0; i < 120; i++) {
+		size_t a = 2 * (rand() % 20), b = 2 * (rand() % 20) + 1;
+		graph_add_edge(h, a, b, 0.5 + rand() % 4);
+	}
+
+	assert(graph_family(h) == GRAPH_FAMILY_NONE);
+	assert(graph_bipartition(h, side));
+
+	for (size_t a = 0; a < n; a++) {
+		for (size_t b = 0; b < n; b++) {
+			if (graph_get(h, a, b) != 0.0) {
+				assert(side[a] != side[b]);
+			}
+		}
+	}
+
+	check(h);
+
+	/*um triângulo estraga a bipartição*/
+	graph_add_edge(h, 0, 2, 1.0);
+	graph_add_edge(h, 2, 1, 1.0);
+	graph_add_edge(h, 1, 0, 1.0);
+	assert(!graph_bipartition(h, side));
+	check(h);
+
+	/*partição errada é rejeitada*/
+	for (size_t v = 0; v < n; v++) {
+		side[v] = v % 2;
+	}
+
+	double x[40];
+	assert(graph_spec_bipartite(h, side, x) == -1);
+	graph_free(h);
+
+	/*laço também*/
+	Graph* l = graph_new(3, false);
+	graph_add_edge(l, 0, 1, 1.0);
+	graph_add_edge(l, 2, 2, 1.0);
+	assert(!graph_bipartition(l, side));
+	graph_free(l);
+
+	printf("testes passaram!\n");
+
+	return 0;
+}
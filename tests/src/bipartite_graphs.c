@@ -20,7 +20,7 @@ void simulate(size_t n1, size_t n2, double p, size_t maxit) {
 		eigenvalues_print(w, g->n, "Autovalores");
 
 		free(w);
-		free(g);
+		graph_free(g);
 	}
 }
 
@@ -0,0 +1,124 @@
+#include "../../src/graphs.h"
+#include "../../src/eig.h"
+#include "../../src/charpoly.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include <assert.h>
+#include <string.h>
+
+static long long count_triangles(const Graph* g) {
+	size_t n = g->n;
+	long long cnt = 0;
+
+	for (size_t i = 0; i + 2 < n; i++)
+		for (size_t j = i + 1; j + 1 < n; j++) if (g->A[IDX(i, j, n)])
+			for (size_t k = j + 1; k < n; k++)
+				if (g->A[IDX(i, k, n)] && g->A[IDX(j, k, n)]) cnt++;
+
+	return cnt;
+}
+
+static long long binom(long long n, long long k) {
+	long long r = 1;
+
+	for (long long i = 1; i <= k; i++) {
+		r = r * (n - k + i) / i;
+	}
+
+	return r;
+}
+
+/*det(xI - A(Kn)) = (x - (n - 1)) (x + 1)^(n - 1)*/
+static void test_kn(size_t n) {
+	Graph* g = graph_kn(n);
+	BigInt* c = malloc((n + 1) * sizeof(BigInt));
+
+	matrix_char_coeffs_exact(g->A, n, n, c);
+
+	for (size_t j = 0; j <= n; j++) {
+		long long expected = (j < n) ? binom(n - 1, j) : 0;
+
+		if (j >= 1) {
+			expected -= (long long) (n - 1) * binom(n - 1, j - 1);
+		}
+
+		int64_t got;
+		assert(bigint_to_int64(&c[j], &got));
+		assert(got == expected);
+		bigint_free(&c[j]);
+	}
+
+	free(c);
+	graph_free(g);
+}
+
+static void test_random(size_t n, size_t n_times, double p) {
+	for (size_t i = 0; i < n_times; i++) {
+		Graph* g = graph_random(n, p);
+		BigInt all[n + 1], first[4];
+		int64_t c1, c2, c3;
+
+		matrix_char_coeffs_exact(g->A, n, n, all);
+		matrix_char_coeffs_exact(g->A, n, 3, first);
+
+		assert(bigint_to_int64(&first[1], &c1) && c1 == 0);
+		assert(bigint_to_int64(&first[2], &c2));
+		assert(bigint_to_int64(&first[3], &c3));
+		assert(-c2 == (int64_t) graph_num_edges(g));
+		assert(-c3 == 2 * count_triangles(g));
+
+		for (size_t j = 0; j <= 3; j++) {
+			char* a = bigint_to_string(&all[j]);
+			char* b = bigint_to_string(&first[j]);
+			assert(strcmp(a, b) == 0);
+			free(a);
+			free(b);
+			bigint_free(&first[j]);
+		}
+
+		/*o termo constante é det(-A) = (-1)^n det(A); compara com o módulo*/
+		uint64_t mod[n + 1];
+		uint64_t q = 1000000007;
+		matrix_char_coeffs_mod(g->A, n, n, q, mod);
+		char* s = bigint_to_string(&all[n]);
+		long long r = 0;
+
+		for (char* d = s; *d; d++) {
+			if (*d != '-') {
+				r = (r * 10 + (*d - '0')) % (long long) q;
+			}
+		}
+
+		if (s[0] == '-') {
+			r = (r == 0) ? 0 : (long long) q - r;
+		}
+
+		assert((uint64_t) r == mod[n]);
+
+		if (i == 0) {
+			printf("n = %zu, det(-A) = %s\n", n, s);
+		}
+
+		free(s);
+
+		for (size_t j = 0; j <= n; j++) {
+			bigint_free(&all[j]);
+		}
+
+		graph_free(g);
+	}
+}
+
+int main() {
+	srand(time(NULL));
+
+	for (size_t n = 1; n <= 30; n++) {
+		test_kn(n);
+	}
+
+	test_random(80, 20, 0.5);
+	printf("testes passaram!\n");
+
+	return 0;
+}
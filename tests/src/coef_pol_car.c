@@ -37,7 +37,7 @@ void simulate(size_t n, size_t n_times, double p) {
 		assert(-w[3] / 2.0 == (double)graph_count_triangles_naive(g));
 
 		free(w);
-        free(g);
+        graph_free(g);
 	}
 
     printf("testes passaram!\n");
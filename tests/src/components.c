@@ -0,0 +1,173 @@
+#include "../../src/graphs.h"
+#include "../../src/eig.h"
+#include "../../src/components.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <math.h>
+#include <assert.h>
+
+/*Grafo com várias componentes aleatórias, vértices embaralhados*/
+static Graph* random_components(size_t c, size_t maxsz, size_t* ncomp) {
+	size_t n = 0;
+	size_t* sz = malloc(c * sizeof(size_t));
+
+	for (size_t i = 0; i < c; i++) {
+		sz[i] = 1 + rand() % maxsz;
+		n += sz[i];
+	}
+
+	size_t* p = malloc(n * sizeof(size_t));
+
+	for (size_t i = 0; i < n; i++) {
+		p[i] = i;
+	}
+
+	for (size_t i = n - 1; i > 0; i--) {
+		size_t j = rand() % (i + 1), t = p[i];
+		p[i] = p[j];
+		p[j] = t;
+	}
+
+	Graph* g = graph_new(n, false);
+	size_t base = 0;
+
+	/*cada componente é um caminho mais arestas aleatórias (conexa)*/
+	for (size_t i = 0; i < c; i++) {
+		for (size_t u = 1; u < sz[i]; u++) {
+			graph_add_edge(g, p[base + u - 1], p[base + u], 1.0);
+
+			size_t v = rand() % sz[i];
+
+			if (v != u) {
+				graph_add_edge(g, p[base + u], p[base + v], 1.0 + rand() % 3);
+			}
+		}
+
+		base += sz[i];
+	}
+
+	*ncomp = c;
+	free(sz);
+	free(p);
+
+	return g;
+}
+
+static void check_spec(const Graph* g) {
+	size_t n = g->n;
+	double* x = malloc(n * sizeof(double));
+	double* y = malloc(n * sizeof(double));
+	double* l = calloc(n * n, sizeof(double));
+
+	assert(graph_spec_adj(g, x) == 0);
+	assert(matrix_spec(g->A, n, y) == 0);
+
+	for (size_t i = 0; i < n; i++) {
+		assert(fabs(x[i] - y[i]) < 1e-8);
+	}
+
+	graph_laplacian(g, l);
+	assert(graph_spec_lap(g, x) == 0);
+	assert(matrix_spec(l, n, y) == 0);
+
+	for (size_t i = 0; i < n; i++) {
+		assert(fabs(x[i] - y[i]) < 1e-8);
+	}
+
+	free(x);
+	free(y);
+	free(l);
+}
+
+static void check_strong(const Graph* g) {
+	size_t n = g->n;
+	bool* R = malloc(n * n * sizeof(bool));
+	size_t* label = malloc(n * sizeof(size_t));
+	size_t* perm = malloc(n * sizeof(size_t));
+	size_t* start = malloc((n + 1) * sizeof(size_t));
+
+	/*fecho transitivo (Warshall)*/
+	for (size_t i = 0; i < n; i++)
+		for (size_t j = 0; j < n; j++)
+			R[IDX(i, j, n)] = (i == j) || g->A[IDX(i, j, n)] != 0.0;
+
+	for (size_t k = 0; k < n; k++)
+		for (size_t i = 0; i < n; i++)
+			for (size_t j = 0; j < n; j++)
+				R[IDX(i, j, n)] |= R[IDX(i, k, n)] && R[IDX(k, j, n)];
+
+	size_t c = graph_strong_components(g, label);
+
+	for (size_t u = 0; u < n; u++) {
+		assert(label[u] < c);
+
+		for (size_t v = 0; v < n; v++) {
+			bool same = R[IDX(u, v, n)] && R[IDX(v, u, n)];
+			assert(same == (label[u] == label[v]));
+
+			if (g->A[IDX(u, v, n)] != 0.0) {
+				assert(label[u] <= label[v]);
+			}
+		}
+	}
+
+	/*P A Pᵀ é bloco-triangular superior*/
+	assert(graph_block_triangular_order(g, perm, start) == c);
+	assert(start[0] == 0 && start[c] == n);
+
+	for (size_t b = 0; b < c; b++) {
+		for (size_t i = start[b]; i < start[b + 1]; i++) {
+			assert(label[perm[i]] == b);
+
+			for (size_t j = 0; j < start[b]; j++) {
+				assert(g->A[IDX(perm[i], perm[j], n)] == 0.0);
+			}
+		}
+	}
+
+	free(R);
+	free(label);
+	free(perm);
+	free(start);
+}
+
+int main() {
+	srand(time(NULL));
+
+	size_t c;
+	Graph* g = random_components(40, 25, &c);
+	size_t* label = malloc(g->n * sizeof(size_t));
+
+	assert(graph_components(g, label) == c);
+	assert(!graph_is_connected(g));
+	check_spec(g);
+
+	/*vértices isolados e grafo conexo*/
+	Graph* e = graph_new(7, false);
+	check_spec(e);
+	graph_free(e);
+
+	Graph* k = graph_random_connected(30, 0.2);
+	assert(graph_components(k, label) == 1);
+	check_spec(k);
+	graph_free(k);
+
+	free(label);
+	graph_free(g);
+
+	for (size_t t = 0; t < 5; t++) {
+		Graph* d = graph_new(60, true);
+
+		for (size_t i = 0; i < 90; i++) {
+			graph_add_edge(d, rand() % 60, rand() % 60, 1.0);
+		}
+
+		check_strong(d);
+		graph_free(d);
+	}
+
+	printf("testes passaram!\n");
+
+	return 0;
+}
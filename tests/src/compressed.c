@@ -0,0 +1,368 @@
+#include "../../src/graphs.h"
+#include "../../src/rng.h"
+#include "../../src/reorder.h"
+#include "../../src/compressed.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <assert.h>
+
+static double elapsed(clock_t t0) {
+	return (double) (clock() - t0) / CLOCKS_PER_SEC;
+}
+
+static int cmp_size(const void* a, const void* b) {
+	size_t x = *(const size_t*) a, y = *(const size_t*) b;
+
+	return (x > y) - (x < y);
+}
+
+/*CSR não direcionado a partir de m arestas (u[k], v[k]); repetidas e
+laços são descartados*/
+static GraphCSR* csr_from_edges(size_t n, size_t m, const size_t* us,
+	const size_t* vs) {
+	GraphCSR* c = calloc(1, sizeof(GraphCSR));
+	size_t* fill = calloc(n + 1, sizeof(size_t));
+	c->n = n;
+	c->rowptr = calloc(n + 1, sizeof(size_t));
+
+	for (size_t k = 0; k < m; k++) {
+		if (us[k] != vs[k]) {
+			c->rowptr[us[k] + 1]++;
+			c->rowptr[vs[k] + 1]++;
+		}
+	}
+
+	for (size_t u = 0; u < n; u++) {
+		c->rowptr[u + 1] += c->rowptr[u];
+		fill[u] = c->rowptr[u];
+	}
+
+	c->col = malloc((c->rowptr[n] + 1) * sizeof(size_t));
+
+	for (size_t k = 0; k < m; k++) {
+		if (us[k] != vs[k]) {
+			c->col[fill[us[k]]++] = vs[k];
+			c->col[fill[vs[k]]++] = us[k];
+		}
+	}
+
+	size_t nnz = 0;
+
+	for (size_t u = 0; u < n; u++) {
+		size_t b = c->rowptr[u], e = c->rowptr[u + 1];
+		qsort(&c->col[b], e - b, sizeof(size_t), cmp_size);
+		c->rowptr[u] = nnz;
+
+		for (size_t i = b; i < e; i++) {
+			if (i == b || c->col[i] != c->col[i - 1]) {
+				c->col[nnz++] = c->col[i];
+			}
+		}
+	}
+
+	c->rowptr[n] = nnz;
+	free(fill);
+
+	return c;
+}
+
+static size_t csr_bytes(const GraphCSR* g) {
+	return sizeof(GraphCSR) + (g->n + 1) * sizeof(size_t)
+		+ g->rowptr[g->n] * sizeof(size_t);
+}
+
+static void same_lists(const GraphCompressed* c, const GraphCSR* g) {
+	uint32_t* nb = malloc((c->max_degree + 1) * sizeof(uint32_t));
+
+	for (size_t u = 0; u < g->n; u++) {
+		size_t d = graph_compressed_neighbors(c, u, nb);
+		assert(d == g->rowptr[u + 1] - g->rowptr[u]);
+		assert(graph_compressed_degree(c, u) == d);
+
+		for (size_t i = 0; i < d; i++) {
+			assert(nb[i] == g->col[g->rowptr[u] + i]);
+		}
+	}
+
+	free(nb);
+}
+
+/*Os kernels contra as versões densas de graphs.h*/
+static void check_graph(Graph* g) {
+	size_t n = g->n;
+	GraphCSR* csr = graph_csr_from_graph(g);
+	double* x = malloc(n * sizeof(double));
+	double* y1 = malloc(n * sizeof(double));
+	double* y2 = malloc(n * sizeof(double));
+	int* dist = malloc(n * sizeof(int));
+
+	for (size_t i = 0; i < n; i++) {
+		x[i] = (double) (i % 7) - 3.0;
+	}
+
+	graph_ax(g, x, y1);
+
+	for (int codec = 0; codec < 2; codec++) {
+		for (int share = 0; share < 2; share++) {
+			for (int simd = 0; simd < 2; simd++) {
+				graph_compressed_set_simd(simd);
+				GraphCompressed* c = graph_compress(csr, codec, share);
+
+				same_lists(c, csr);
+				assert(graph_compressed_num_edges(c) == graph_num_edges(g));
+				assert(graph_compressed_is_connected(c)
+					== graph_is_connected(g));
+				assert(graph_compressed_diameter(c) == graph_diameter(g));
+
+				graph_compressed_ax(c, x, y2);
+
+				for (size_t i = 0; i < n; i++) {
+					assert(fabs(y1[i] - y2[i]) < 1e-12);
+				}
+
+				int ecc = graph_compressed_bfs(c, 0, dist);
+				int best = 0;
+
+				for (size_t v = 0; v < n; v++) {
+					best = dist[v] > best ? dist[v] : best;
+				}
+
+				assert(ecc == best && dist[0] == 0);
+				graph_compressed_free(c);
+			}
+		}
+	}
+
+	graph_compressed_set_simd(true);
+	graph_csr_free(csr);
+	free(x);
+	free(y1);
+	free(y2);
+	free(dist);
+}
+
+/*Diferenças de 1, 2, 3 e 4 bytes e listas com e sem grupos completos*/
+static void wide_gaps(void) {
+	size_t n = (1u << 24) + 100;
+	size_t us[] = {0, 1, 1, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 0};
+	size_t vs[] = {n - 1, 300, 66000, 16777300, 255, 256, 65535, 65536,
+		16777215, 16777216, 70000, 16777250, 5, 6};
+	size_t m = sizeof(us) / sizeof(us[0]);
+	GraphCSR* g = csr_from_edges(n, m, us, vs);
+
+	for (int codec = 0; codec < 2; codec++) {
+		for (int simd = 0; simd < 2; simd++) {
+			graph_compressed_set_simd(simd);
+			GraphCompressed* c = graph_compress(g, codec, true);
+			same_lists(c, g);
+
+			/*quase todos os vértices são isolados: uma lista só*/
+			assert(c->shared >= n - 2 * m);
+			assert(graph_compressed_bytes(c) < csr_bytes(g));
+			graph_compressed_free(c);
+		}
+	}
+
+	graph_compressed_set_simd(true);
+	graph_csr_free(g);
+}
+
+static void small_graphs(void) {
+	Rng rng;
+	rng_seed(&rng, 3);
+
+	Graph* g = graph_random_r(150, 0.04, &rng);
+	check_graph(g);
+	graph_free(g);
+
+	/*conexo, com laço e threads*/
+	setenv("GRAPH_NUM_THREADS", "3", 1);
+	g = graph_random_connected_r(90, 0.1, &rng);
+	graph_add_edge(g, 5, 5, 1.0);
+	check_graph(g);
+	graph_free(g);
+	unsetenv("GRAPH_NUM_THREADS");
+
+	/*direcionado*/
+	g = graph_new(40, true);
+
+	for (size_t k = 0; k < 120; k++) {
+		graph_add_edge(g, rng_below(&rng, 40), rng_below(&rng, 40), 1.0);
+	}
+
+	check_graph(g);
+	graph_free(g);
+
+	/*estrela: as folhas têm a mesma lista {0}*/
+	g = graph_new(64, false);
+
+	for (size_t v = 1; v < 64; v++) {
+		graph_add_edge(g, 0, v, 1.0);
+	}
+
+	check_graph(g);
+	GraphCSR* csr = graph_csr_from_graph(g);
+	GraphCompressed* c = graph_compress(csr, GRAPH_CODEC_STREAMVBYTE, true);
+	assert(c->shared == 62 && c->max_degree == 63);
+	graph_compressed_free(c);
+	graph_csr_free(csr);
+	graph_free(g);
+
+	/*vazio*/
+	g = graph_new(0, false);
+	csr = graph_csr_from_graph(g);
+	c = graph_compress(csr, GRAPH_CODEC_VARINT, true);
+	assert(graph_compressed_num_edges(c) == 0);
+	assert(graph_compressed_is_connected(c));
+	assert(graph_compressed_diameter(c) == 0);
+	graph_compressed_free(c);
+	graph_csr_free(csr);
+	graph_free(g);
+}
+
+static void csr_ax(const GraphCSR* g, const double* x, double* y) {
+	for (size_t u = 0; u < g->n; u++) {
+		double s = 0.0;
+
+		for (size_t e = g->rowptr[u]; e < g->rowptr[u + 1]; e++) {
+			s += x[g->col[e]];
+		}
+
+		y[u] = s;
+	}
+}
+
+static void csr_bfs(const GraphCSR* g, size_t src, int* dist, size_t* queue) {
+	for (size_t v = 0; v < g->n; v++) {
+		dist[v] = -1;
+	}
+
+	size_t head = 0, tail = 0;
+	dist[src] = 0;
+	queue[tail++] = src;
+
+	while (head < tail) {
+		size_t u = queue[head++];
+
+		for (size_t e = g->rowptr[u]; e < g->rowptr[u + 1]; e++) {
+			if (dist[g->col[e]] < 0) {
+				dist[g->col[e]] = dist[u] + 1;
+				queue[tail++] = g->col[e];
+			}
+		}
+	}
+}
+
+static void bench_one(const GraphCSR* g, const char* name) {
+	size_t n = g->n;
+	double* x = malloc(n * sizeof(double));
+	double* y1 = malloc(n * sizeof(double));
+	double* y2 = malloc(n * sizeof(double));
+	int* d1 = malloc(n * sizeof(int));
+	int* d2 = malloc(n * sizeof(int));
+	size_t* queue = malloc(n * sizeof(size_t));
+
+	for (size_t i = 0; i < n; i++) {
+		x[i] = 1.0 / (double) (i + 1);
+	}
+
+	clock_t t0 = clock();
+	csr_ax(g, x, y1);
+	double t_ax = elapsed(t0);
+	t0 = clock();
+	csr_bfs(g, 0, d1, queue);
+	double t_bfs = elapsed(t0);
+
+	printf("%-10s csr          %9zu bytes        ax %.4fs bfs %.4fs\n", name,
+		csr_bytes(g), t_ax, t_bfs);
+
+	const char* codecs[] = {"varint", "streamvbyte"};
+
+	for (int codec = 0; codec < 2; codec++) {
+		GraphCompressed* c = graph_compress(g, codec, true);
+		size_t bytes = graph_compressed_bytes(c);
+
+		t0 = clock();
+		graph_compressed_ax(c, x, y2);
+		t_ax = elapsed(t0);
+		t0 = clock();
+		graph_compressed_bfs(c, 0, d2);
+		t_bfs = elapsed(t0);
+
+		for (size_t i = 0; i < n; i++) {
+			assert(fabs(y1[i] - y2[i]) < 1e-9 && d1[i] == d2[i]);
+		}
+
+		printf("%-10s %-12s %9zu bytes (%4.1f%%) ax %.4fs bfs %.4fs\n", name,
+			codecs[codec], bytes, 100.0 * (double) bytes / (double) csr_bytes(g),
+			t_ax, t_bfs);
+
+		assert(bytes < csr_bytes(g) / 2);
+		graph_compressed_free(c);
+	}
+
+	free(x);
+	free(y1);
+	free(y2);
+	free(d1);
+	free(d2);
+	free(queue);
+}
+
+/*Arestas locais (janela de 64) e algumas longas, numeração embaralhada*/
+static void bench(size_t n) {
+	Rng rng;
+	rng_seed(&rng, 9);
+	size_t per = 8, m = per * n;
+	size_t* us = malloc(m * sizeof(size_t));
+	size_t* vs = malloc(m * sizeof(size_t));
+	size_t* label = malloc(n * sizeof(size_t));
+
+	for (size_t i = 0; i < n; i++) {
+		label[i] = i;
+	}
+
+	for (size_t i = n; i-- > 1;) {
+		size_t j = rng_below(&rng, i + 1);
+		size_t t = label[i];
+		label[i] = label[j];
+		label[j] = t;
+	}
+
+	for (size_t u = 0, k = 0; u < n; u++) {
+		for (size_t e = 0; e < per; e++, k++) {
+			size_t v = e < 6 ? (u + 1 + rng_below(&rng, 64)) % n
+				: rng_below(&rng, n);
+			us[k] = label[u];
+			vs[k] = label[v];
+		}
+	}
+
+	GraphCSR* g = csr_from_edges(n, m, us, vs);
+	bench_one(g, "embaralhado");
+
+	size_t* perm = malloc(n * sizeof(size_t));
+	assert(graph_csr_order(g, GRAPH_ORDER_RCM, perm) == 0);
+	GraphCSR* r = graph_csr_permute(g, perm);
+	bench_one(r, "rcm");
+
+	graph_csr_free(g);
+	graph_csr_free(r);
+	free(us);
+	free(vs);
+	free(label);
+	free(perm);
+}
+
+int main() {
+	small_graphs();
+	wide_gaps();
+	bench(200000);
+
+	printf("testes passaram!\n");
+
+	return 0;
+}
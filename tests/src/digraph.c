@@ -0,0 +1,242 @@
+#include "../../src/graphs.h"
+#include "../../src/eig.h"
+#include "../../src/digraph.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+
+/*Os dois conjuntos são iguais (como multiconjuntos), a menos de tol.
+Autovalores defeituosos (blocos de Jordan, comuns em digrafos
+aleatórios) só têm precisão de ε^(1/k), por isso a soma, que não
+sofre com isso, é comparada com tolerância bem menor*/
+static void same_set(const double complex* a, const double complex* b,
+	size_t n, double tol) {
+	bool* used = calloc(n + 1, sizeof(bool));
+	double complex sa = 0.0, sb = 0.0;
+
+	for (size_t i = 0; i < n; i++) {
+		sa += a[i];
+		sb += b[i];
+	}
+
+	assert(cabs(sa - sb) < 1e-8 * (1.0 + cabs(sa)));
+
+	for (size_t i = 0; i < n; i++) {
+		size_t best = n;
+		double dist = INFINITY;
+
+		for (size_t j = 0; j < n; j++) {
+			if (!used[j] && cabs(a[i] - b[j]) < dist) {
+				dist = cabs(a[i] - b[j]);
+				best = j;
+			}
+		}
+
+		assert(dist < tol);
+		used[best] = true;
+	}
+
+	free(used);
+}
+
+static Graph* random_digraph(size_t n, size_t m, bool cycle) {
+	Graph* g = graph_new(n, true);
+
+	for (size_t i = 0; i < m; i++) {
+		size_t u = rand() % n, v = rand() % n;
+
+		if (u != v) {
+			graph_add_edge(g, u, v, 1.0);
+		}
+	}
+
+	/*ciclo hamiltoniano: fortemente conexo*/
+	for (size_t i = 0; cycle && i < n; i++) {
+		graph_add_edge(g, i, (i + 1) % n, 1.0);
+	}
+
+	return g;
+}
+
+static int cmp_modulus(const void* a, const void* b) {
+	double x = cabs(*(const double complex*) a);
+	double y = cabs(*(const double complex*) b);
+
+	return (x < y) - (x > y);
+}
+
+static int cmp_real(const void* a, const void* b) {
+	double x = creal(*(const double complex*) a);
+	double y = creal(*(const double complex*) b);
+
+	return (x < y) - (x > y);
+}
+
+int main() {
+	srand(11);
+
+	/*ciclo direcionado: raízes n-ésimas da unidade*/
+	size_t n = 12;
+	Graph* c = graph_new(n, true);
+
+	for (size_t i = 0; i < n; i++) {
+		graph_add_edge(c, i, (i + 1) % n, 1.0);
+	}
+
+	double x[12];
+	double complex z[12], w[12];
+	assert(graph_spec_adj(c, x) == -1);
+	assert(graph_spec_lap(c, x) == -1);
+	assert(graph_spec_adj_complex(c, z) == 0);
+
+	for (size_t k = 0; k < n; k++) {
+		w[k] = cexp(2.0 * M_PI * I * k / n);
+	}
+
+	same_set(z, w, n, 1e-9);
+
+	/*laplaciana: 1 - raízes*/
+	assert(graph_spec_lap_complex(c, z) == 0);
+
+	for (size_t k = 0; k < n; k++) {
+		w[k] = 1.0 - w[k];
+	}
+
+	same_set(z, w, n, 1e-9);
+	graph_free(c);
+
+	/*DAG: tudo zero, sem LAPACK*/
+	Graph* d = graph_new(30, true);
+
+	for (size_t i = 0; i < 100; i++) {
+		size_t u = rand() % 30, v = rand() % 30;
+
+		if (u < v) {
+			graph_add_edge(d, u, v, 1.0);
+		}
+	}
+
+	double complex zd[30];
+	assert(graph_spec_adj_complex(d, zd) == 0);
+
+	for (size_t i = 0; i < 30; i++) {
+		assert(zd[i] == 0.0);
+	}
+
+	graph_free(d);
+
+	/*blocos das componentes fortes contra o dgeev na matriz inteira*/
+	for (int t = 0; t < 5; t++) {
+		size_t m = 60;
+		Graph* g = random_digraph(m, 90 + 20 * t, false);
+		double complex* a = malloc(m * sizeof(double complex));
+		double complex* b = malloc(m * sizeof(double complex));
+
+		assert(graph_spec_adj_complex(g, a) == 0);
+		assert(matrix_spec_complex(g->A, m, b) == 0);
+		same_set(a, b, m, 1e-3);
+
+		double* L = malloc(m * m * sizeof(double));
+		graph_laplacian(g, L);
+		assert(graph_spec_lap_complex(g, a) == 0);
+		assert(matrix_spec_complex(L, m, b) == 0);
+		same_set(a, b, m, 1e-3);
+
+		free(L);
+		free(a);
+		free(b);
+		graph_free(g);
+	}
+
+	/*não direcionado: igual ao caminho real*/
+	Graph* u = graph_random(25, 0.3);
+	double xu[25];
+	double complex zu[25];
+	assert(graph_spec_adj(u, xu) == 0);
+	assert(graph_spec_adj_complex(u, zu) == 0);
+
+	for (size_t i = 0; i < 25; i++) {
+		assert(cimag(zu[i]) == 0.0 && fabs(creal(zu[i]) - xu[i]) < 1e-12);
+	}
+
+	graph_free(u);
+
+	/*Arnoldi contra o denso*/
+	size_t N = 400;
+	Graph* g = random_digraph(N, 1600, true);
+
+	for (size_t i = 0; i < 200; i++) {
+		graph_add_edge(g, rand() % N, rand() % N, 0.5 + (rand() % 4));
+	}
+
+	GraphCSR* csr = graph_csr_from_graph(g);
+	double complex* all = malloc(N * sizeof(double complex));
+	assert(matrix_spec_complex(g->A, N, all) == 0);
+
+	double rho;
+	qsort(all, N, sizeof(double complex), cmp_modulus);
+	assert(graph_perron_root(csr, &rho) == 0);
+	assert(fabs(rho - cabs(all[0])) < 1e-8 * cabs(all[0]));
+
+	double complex top[4];
+	assert(graph_csr_eigs(csr, 4, ARNOLDI_LARGEST_MODULUS, top) == 0);
+
+	for (size_t i = 0; i < 4; i++) {
+		assert(fabs(cabs(top[i]) - cabs(all[i])) < 1e-7);
+	}
+
+	qsort(all, N, sizeof(double complex), cmp_real);
+	assert(graph_csr_eigs(csr, 3, ARNOLDI_LARGEST_REAL, top) == 0);
+
+	for (size_t i = 0; i < 3; i++) {
+		assert(fabs(creal(top[i]) - creal(all[i])) < 1e-7);
+	}
+
+	/*gap do passeio aleatório contra P = D⁻¹ A densa*/
+	double* P = malloc(N * N * sizeof(double));
+	double* deg = malloc(N * sizeof(double));
+	graph_degree(g, deg, NULL);
+
+	for (size_t i = 0; i < N; i++) {
+		for (size_t j = 0; j < N; j++) {
+			P[IDX(i, j, N)] = g->A[IDX(i, j, N)] / deg[i];
+		}
+	}
+
+	assert(matrix_spec_complex(P, N, all) == 0);
+	qsort(all, N, sizeof(double complex), cmp_modulus);
+
+	double gap;
+	assert(graph_random_walk_gap(csr, &gap) == 0);
+	assert(fabs(cabs(all[0]) - 1.0) < 1e-9);
+	assert(fabs(gap - (cabs(all[0]) - cabs(all[1]))) < 1e-7);
+
+	/*k inválido; n pequeno cai no denso*/
+	assert(graph_csr_eigs(csr, 0, ARNOLDI_LARGEST_MODULUS, top) == -1);
+
+	free(P);
+	free(deg);
+	free(all);
+	graph_csr_free(csr);
+	graph_free(g);
+
+	Graph* s = random_digraph(10, 20, true);
+	csr = graph_csr_from_graph(s);
+	double complex zs[10], ts[3];
+	assert(matrix_spec_complex(s->A, 10, zs) == 0);
+	qsort(zs, 10, sizeof(double complex), cmp_modulus);
+	assert(graph_csr_eigs(csr, 3, ARNOLDI_LARGEST_MODULUS, ts) == 0);
+
+	for (size_t i = 0; i < 3; i++) {
+		assert(fabs(cabs(ts[i]) - cabs(zs[i])) < 1e-9);
+	}
+
+	graph_csr_free(csr);
+	graph_free(s);
+
+	printf("testes passaram!\n");
+
+	return 0;
+}
@@ -0,0 +1,121 @@
+#include "../../src/graphs.h"
+#include "../../src/eig.h"
+#include "../../src/distance.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <math.h>
+#include <assert.h>
+
+/*Floyd-Warshall, só para conferir*/
+static void floyd(const Graph* g, double* D) {
+	size_t n = g->n;
+
+	for (size_t i = 0; i < n; i++)
+		for (size_t j = 0; j < n; j++)
+			D[IDX(i, j, n)] = (i == j) ? 0.0 : (g->A[IDX(i, j, n)] ? 1.0 : INFINITY);
+
+	for (size_t k = 0; k < n; k++)
+		for (size_t i = 0; i < n; i++)
+			for (size_t j = 0; j < n; j++)
+				if (D[IDX(i, k, n)] + D[IDX(k, j, n)] < D[IDX(i, j, n)])
+					D[IDX(i, j, n)] = D[IDX(i, k, n)] + D[IDX(k, j, n)];
+}
+
+static void compare(const Graph* g) {
+	size_t n = g->n;
+	double* D1 = malloc(n * n * sizeof(double));
+	double* D2 = malloc(n * n * sizeof(double));
+
+	graph_distance_matrix(g, D1);
+	floyd(g, D2);
+
+	for (size_t i = 0; i < n * n; i++) {
+		assert(D1[i] == D2[i]);
+	}
+
+	free(D1);
+	free(D2);
+}
+
+int main() {
+	srand(time(NULL));
+
+	Graph* g = graph_random(150, 0.03);
+	compare(g);
+	graph_free(g);
+
+	Graph* d = graph_new(130, true);
+
+	for (size_t i = 0; i < 300; i++) {
+		graph_add_edge(d, rand() % 130, rand() % 130, 1.0);
+	}
+
+	compare(d);
+	graph_free(d);
+
+	/*caminho P_n: W = n(n² - 1)/6*/
+	size_t n = 100;
+	Graph* p = graph_new(n, false);
+
+	for (size_t i = 0; i + 1 < n; i++) {
+		graph_add_edge(p, i, i + 1, 1.0);
+	}
+
+	assert(graph_wiener_index(p) == (double) (n * (n * n - 1) / 6));
+	graph_free(p);
+
+	/*Kn: D = J - I, espectro {n - 1, -1 (n - 1 vezes)};
+	laplaciana de distâncias = laplaciana: {0, n (n - 1 vezes)}*/
+	Graph* kn = graph_kn(n);
+	double* x = malloc(n * sizeof(double));
+
+	assert(graph_spec_distance(kn, x) == 0);
+	assert(fabs(x[n - 1] - (double) (n - 1)) < 1e-9 && fabs(x[0] + 1.0) < 1e-9);
+	assert(graph_spec_distance_laplacian(kn, x) == 0);
+	assert(fabs(x[0]) < 1e-9 && fabs(x[1] - (double) n) < 1e-9);
+	graph_free(kn);
+
+	/*a soma dos autovalores da laplaciana de distâncias é 2W*/
+	g = graph_random_connected(80, 0.05);
+	assert(graph_spec_distance_laplacian(g, x) == 0);
+	double s = 0.0;
+
+	for (size_t i = 0; i < 80; i++) {
+		s += x[i];
+	}
+
+	printf("W = %.0f, soma dos autovalores/2 = %.6f\n", graph_wiener_index(g), s / 2);
+	assert(fabs(s - 2.0 * graph_wiener_index(g)) < 1e-6 * s);
+
+	/*com a D que o chamador já tem: mesmos espectros*/
+	double* D = malloc(80 * 80 * sizeof(double));
+	double* y = malloc(80 * sizeof(double));
+	graph_distance_matrix(g, D);
+	assert(matrix_spec_distance_laplacian(D, 80, y) == 0);
+
+	for (size_t i = 0; i < 80; i++) {
+		assert(fabs(x[i] - y[i]) < 1e-9);
+	}
+
+	assert(graph_spec_distance(g, x) == 0);
+	assert(matrix_spec_distance(D, 80, y) == 0);
+
+	for (size_t i = 0; i < 80; i++) {
+		assert(fabs(x[i] - y[i]) < 1e-9);
+	}
+
+	free(y);
+	graph_free(g);
+
+	g = graph_random(50, 0.0);
+	assert(graph_spec_distance(g, x) == -1);
+	graph_distance_matrix(g, D);
+	assert(matrix_spec_distance(D, 50, x) == -1);
+	graph_free(g);
+	free(D);
+	free(x);
+
+	printf("testes passaram!\n");
+	return 0;
+}
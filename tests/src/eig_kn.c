@@ -51,7 +51,7 @@ void simulate(size_t maxit) {
 		printf("\n");
 
 		free(w);
-		free(g);
+		graph_free(g);
 	}
 }
 
@@ -0,0 +1,94 @@
+#include "../../src/graphs.h"
+#include "../../src/eig.h"
+#include "../../src/enumerate.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+
+/*Número de grafos não isomorfos com n vértices (OEIS A000088)*/
+static const uint64_t classes[] = {1, 1, 2, 4, 11, 34, 156, 1044};
+
+typedef struct {
+	double lambda_max;
+	size_t checked;
+} Acc;
+
+static void visit(const EnumGraph* eg, size_t thread, void* ctx) {
+	Acc* acc = &((Acc*) ctx)[thread];
+	size_t n = eg->n;
+
+	/*tr(A^2) = 2m e tr(A^3) = 6t*/
+	double s2 = 0.0, s3 = 0.0;
+
+	for (size_t i = 0; i < n; i++) {
+		s2 += eg->spec[i] * eg->spec[i];
+		s3 += eg->spec[i] * eg->spec[i] * eg->spec[i];
+	}
+
+	assert(fabs(s2 - 2.0 * (double) eg->edges) < 1e-8);
+	assert(fabs(s3 - 6.0 * (double) eg->triangles) < 1e-8);
+
+	if (eg->spec[n - 1] > acc->lambda_max) {
+		acc->lambda_max = eg->spec[n - 1];
+	}
+
+	/*compara alguns espectros com o LAPACK*/
+	if (eg->mask % 97 == 0) {
+		Graph* g = enum_graph_to_graph(eg);
+		double w[ENUM_MAX_N];
+		graph_spec_adj(g, w);
+
+		for (size_t i = 0; i < n; i++) {
+			assert(fabs(w[i] - eg->spec[i]) < 1e-9);
+		}
+
+		graph_free(g);
+		acc->checked++;
+	}
+}
+
+static void count(const EnumGraph* eg, size_t thread, void* ctx) {
+	(void) eg;
+	((uint64_t*) ctx)[thread]++;
+}
+
+int main() {
+	size_t nt = graph_num_threads();
+
+	for (size_t n = 1; n <= 7; n++) {
+		Acc* acc = calloc(nt, sizeof(Acc));
+		uint64_t c = graph_enumerate(n, ENUM_ISOMORPH_PRUNE | ENUM_SPECTRUM,
+			visit, acc);
+		double lmax = 0.0;
+
+		for (size_t t = 0; t < nt; t++) {
+			lmax = fmax(lmax, acc[t].lambda_max);
+		}
+
+		printf("n = %zu: %llu classes, max λ1 = %f\n", n,
+			(unsigned long long) c, lmax);
+		assert(c == classes[n]);
+		assert(fabs(lmax - (double) (n - 1)) < 1e-9);
+		free(acc);
+	}
+
+	/*sem poda: vários lotes de espectros por thread*/
+	Acc* acc = calloc(nt, sizeof(Acc));
+	assert(graph_enumerate(6, ENUM_SPECTRUM, visit, acc) == (UINT64_C(1) << 15));
+	free(acc);
+
+	uint64_t* per_thread = calloc(nt, sizeof(uint64_t));
+	uint64_t total = graph_enumerate(6, 0, count, per_thread);
+	uint64_t sum = 0;
+
+	for (size_t t = 0; t < nt; t++) {
+		sum += per_thread[t];
+	}
+
+	assert(total == (UINT64_C(1) << 15) && sum == total);
+	free(per_thread);
+
+	printf("testes passaram!\n");
+	return 0;
+}
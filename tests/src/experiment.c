@@ -0,0 +1,234 @@
+#include "../../src/graphs.h"
+#include "../../src/eig.h"
+#include "../../src/experiment.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+
+static Graph* gen_gnp(size_t trial, Rng* rng, void* ctx) {
+	(void) trial;
+	return graph_random_r(30, *(double*) ctx, rng);
+}
+
+/*Falha de propósito em 1 de cada 10 tentativas*/
+static Graph* gen_some_fail(size_t trial, Rng* rng, void* ctx) {
+	if (trial % 10 == 3) {
+		return NULL;
+	}
+
+	return gen_gnp(trial, rng, ctx);
+}
+
+/*Extra: grau máximo*/
+static void max_degree(const Graph* g, const double* spec_adj,
+	const double* spec_lap, double* out, void* ctx) {
+	(void) spec_adj;
+	(void) spec_lap;
+	(void) ctx;
+	double best = 0.0;
+
+	for (size_t i = 0; i < g->n; i++) {
+		double d = 0.0;
+
+		for (size_t j = 0; j < g->n; j++) {
+			d += g->A[IDX(i, j, g->n)];
+		}
+
+		best = d > best ? d : best;
+	}
+
+	out[0] = best;
+}
+
+/*Extra: quais espectros measure recebeu (1 = adjacência, 2 = laplaciana)*/
+static void got_spectra(const Graph* g, const double* spec_adj,
+	const double* spec_lap, double* out, void* ctx) {
+	(void) g;
+	(void) ctx;
+	out[0] = (spec_adj != NULL) + 2.0 * (spec_lap != NULL);
+}
+
+static void same_result(const ExpResult* a, const ExpResult* b) {
+	assert(a->trials == b->trials && a->failed == b->failed);
+
+	for (size_t v = 0; v < a->nvalues; v++) {
+		assert(a->stats[v].count == b->stats[v].count);
+		assert(a->stats[v].mean == b->stats[v].mean);
+		assert(a->stats[v].m2 == b->stats[v].m2);
+
+		for (size_t j = 0; j < EXP_NQUANTILES; j++) {
+			assert(p2_value(&a->quantiles[IDX(v, j, EXP_NQUANTILES)])
+				== p2_value(&b->quantiles[IDX(v, j, EXP_NQUANTILES)]));
+		}
+	}
+
+	for (size_t b_ = 0; b_ < a->adj.bins; b_++) {
+		assert(a->adj.counts[b_] == b->adj.counts[b_]);
+	}
+}
+
+int main() {
+	/*Welford contra a fórmula direta*/
+	RunningStats s;
+	stats_init(&s);
+	double xs[] = {3.0, 1.5, -2.0, 7.25, 0.0, 4.0};
+	double sum = 0.0, sq = 0.0;
+
+	for (size_t i = 0; i < 6; i++) {
+		stats_push(&s, xs[i]);
+		sum += xs[i];
+	}
+
+	for (size_t i = 0; i < 6; i++) {
+		sq += (xs[i] - sum / 6) * (xs[i] - sum / 6);
+	}
+
+	assert(fabs(s.mean - sum / 6) < 1e-12);
+	assert(fabs(stats_variance(&s) - sq / 5) < 1e-12);
+	assert(s.min == -2.0 && s.max == 7.25);
+
+	/*P² numa uniforme*/
+	Rng rng;
+	rng_seed(&rng, 7);
+	P2Quantile q[3];
+	double ps[] = {0.05, 0.5, 0.95};
+
+	for (size_t j = 0; j < 3; j++) {
+		p2_init(&q[j], ps[j]);
+	}
+
+	for (size_t i = 0; i < 100000; i++) {
+		double x = rng_uniform(&rng);
+
+		for (size_t j = 0; j < 3; j++) {
+			p2_push(&q[j], x);
+		}
+	}
+
+	for (size_t j = 0; j < 3; j++) {
+		assert(fabs(p2_value(&q[j]) - ps[j]) < 0.01);
+	}
+
+	/*poucas observações: quantil exato*/
+	P2Quantile few;
+	p2_init(&few, 0.5);
+	p2_push(&few, 3.0);
+	p2_push(&few, 1.0);
+	p2_push(&few, 2.0);
+	assert(p2_value(&few) == 2.0);
+
+	/*experimento: mesmo resultado com qualquer número de threads*/
+	double p = 0.2;
+	ExpConfig cfg = {.gen = gen_gnp, .ctx = &p, .trials = 150, .seed = 42,
+		.invariants = EXP_BIT(EXP_NUM_EDGES) | EXP_BIT(EXP_CONNECTED)
+		| EXP_BIT(EXP_DIAMETER) | EXP_BIT(EXP_SPECTRAL_RADIUS)
+		| EXP_BIT(EXP_ENERGY) | EXP_BIT(EXP_ALGEBRAIC_CONNECTIVITY)
+		| EXP_BIT(EXP_LAP_SPECTRAL_RADIUS),
+		.measure = max_degree, .nextra = 1,
+		.hist_adj = true, .hist_lo = -8.0, .hist_hi = 10.0, .hist_bins = 36,
+		.nthreads = 1};
+
+	ExpResult r1, r4;
+	assert(experiment_run(&cfg, &r1) == 0);
+	cfg.nthreads = 4;
+	assert(experiment_run(&cfg, &r4) == 0);
+	same_result(&r1, &r4);
+
+	assert(r1.trials == 150 && r1.failed == 0);
+	assert(r1.nvalues == EXP_NINVARIANTS + 1);
+	assert(r1.stats[EXP_NUM_EDGES].count == 150);
+	assert(r1.lap.counts == NULL);
+
+	/*média de arestas contra as mesmas tentativas refeitas à mão*/
+	double edges = 0.0, radius = 0.0;
+	double spec[30];
+
+	for (size_t t = 0; t < 150; t++) {
+		rng_seed_stream(&rng, 42, t);
+		Graph* g = graph_random_r(30, p, &rng);
+		edges += (double) graph_num_edges(g);
+		graph_spec_adj(g, spec);
+		radius += spec[29];
+		graph_free(g);
+	}
+
+	assert(fabs(r1.stats[EXP_NUM_EDGES].mean - edges / 150) < 1e-9);
+	assert(fabs(r1.stats[EXP_SPECTRAL_RADIUS].mean - radius / 150) < 1e-9);
+	assert(fabs(r1.stats[EXP_NUM_EDGES].mean - 0.2 * 435) < 10.0);
+
+	/*histograma: cada autovalor cai em alguma caixa*/
+	uint64_t total = r1.adj.under + r1.adj.over;
+
+	for (size_t b = 0; b < r1.adj.bins; b++) {
+		total += r1.adj.counts[b];
+	}
+
+	assert(total == 150 * 30);
+
+	/*grau máximo >= raio espectral >= grau médio*/
+	assert(r1.stats[EXP_NINVARIANTS].mean
+		>= r1.stats[EXP_SPECTRAL_RADIUS].mean);
+	assert(r1.stats[EXP_SPECTRAL_RADIUS].mean
+		>= 2.0 * r1.stats[EXP_NUM_EDGES].mean / 30 - 1e-9);
+
+	/*quantis ordenados*/
+	const P2Quantile* qr = &r1.quantiles[IDX(EXP_ENERGY, 0, EXP_NQUANTILES)];
+	assert(p2_value(&qr[0]) <= p2_value(&qr[1]));
+	assert(p2_value(&qr[1]) <= p2_value(&qr[2]));
+
+	assert(experiment_write_csv(&r1, "/tmp/graph_experiment.csv") == 0);
+	assert(experiment_write_binary(&r1, "/tmp/graph_experiment.bin") == 0);
+
+	FILE* f = fopen("/tmp/graph_experiment.bin", "rb");
+	char magic[4];
+	uint32_t version;
+	uint64_t header[3];
+	assert(fread(magic, 1, 4, f) == 4 && memcmp(magic, "GEXP", 4) == 0);
+	assert(fread(&version, sizeof(uint32_t), 1, f) == 1 && version == 1);
+	assert(fread(header, sizeof(uint64_t), 3, f) == 3);
+	assert(header[0] == 150 && header[2] == r1.nvalues);
+	fclose(f);
+
+	experiment_result_free(&r1);
+	experiment_result_free(&r4);
+
+	/*tentativas falhas*/
+	cfg.gen = gen_some_fail;
+	cfg.nthreads = 3;
+	cfg.trials = 95;
+	assert(experiment_run(&cfg, &r1) == 0);
+	assert(r1.trials == 95 && r1.failed == 10);
+	assert(r1.stats[EXP_NUM_EDGES].count == 85);
+	experiment_result_free(&r1);
+
+	/*measure só recebe os espectros que pedir*/
+	ExpConfig cheap = {.gen = gen_gnp, .ctx = &p, .trials = 20, .seed = 1,
+		.invariants = EXP_BIT(EXP_NUM_EDGES), .measure = got_spectra,
+		.nextra = 1};
+	assert(experiment_run(&cheap, &r1) == 0);
+	assert(r1.stats[EXP_NINVARIANTS].max == 0.0);
+	experiment_result_free(&r1);
+	cheap.measure_spec_lap = true;
+	assert(experiment_run(&cheap, &r1) == 0);
+	assert(r1.stats[EXP_NINVARIANTS].min == 2.0);
+	assert(r1.stats[EXP_NINVARIANTS].max == 2.0);
+
+	/*escrita curta*/
+	assert(experiment_write_binary(&r1, "/dev/full") == -1);
+	experiment_result_free(&r1);
+
+	/*configurações inválidas*/
+	cfg.hist_bins = 0;
+	assert(experiment_run(&cfg, &r1) == -1);
+	experiment_result_free(&r1);
+	cfg.hist_bins = 36;
+	cfg.measure = NULL;
+	assert(experiment_run(&cfg, &r1) == -1);
+	experiment_result_free(&r1);
+
+	printf("testes passaram!\n");
+
+	return 0;
+}
@@ -0,0 +1,86 @@
+#include "../../src/graphs.h"
+#include "../../src/eig.h"
+#include "../../src/families.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+
+/*Compara o espectro da família com o dsyev em cima da matriz*/
+static void check(Graph* g, GraphFamilyKind kind) {
+	size_t n = g->n;
+	double* x = malloc(n * sizeof(double));
+	double* y = malloc(n * sizeof(double));
+	double* l = calloc(n * n, sizeof(double));
+
+	assert(graph_family(g) == kind);
+
+	assert(graph_spec_adj(g, x) == 0);
+	assert(matrix_spec(g->A, n, y) == 0);
+
+	for (size_t i = 0; i < n; i++) {
+		assert(fabs(x[i] - y[i]) < 1e-8);
+	}
+
+	graph_laplacian(g, l);
+	assert(graph_spec_lap(g, x) == 0);
+	assert(matrix_spec(l, n, y) == 0);
+
+	for (size_t i = 0; i < n; i++) {
+		assert(fabs(x[i] - y[i]) < 1e-8);
+	}
+
+	free(x);
+	free(y);
+	free(l);
+	graph_free(g);
+}
+
+int main() {
+	check(graph_kn(1), GRAPH_FAMILY_COMPLETE);
+	check(graph_kn(17), GRAPH_FAMILY_COMPLETE);
+	check(graph_cycle(3), GRAPH_FAMILY_CYCLE);
+	check(graph_cycle(20), GRAPH_FAMILY_CYCLE);
+	check(graph_path(1), GRAPH_FAMILY_PATH);
+	check(graph_path(23), GRAPH_FAMILY_PATH);
+	check(graph_complete_bipartite(3, 7), GRAPH_FAMILY_COMPLETE_BIPARTITE);
+	check(graph_complete_bipartite(6, 6), GRAPH_FAMILY_COMPLETE_BIPARTITE);
+	check(graph_complete_bipartite(0, 4), GRAPH_FAMILY_COMPLETE_BIPARTITE);
+	check(graph_hypercube(0), GRAPH_FAMILY_HYPERCUBE);
+	check(graph_hypercube(6), GRAPH_FAMILY_HYPERCUBE);
+
+	/*circulantes: potência de 2 (radix-2) e n qualquer (Bluestein)*/
+	size_t S[] = {1, 3, 7};
+	check(graph_circulant(32, S, 3), GRAPH_FAMILY_CIRCULANT);
+	check(graph_circulant(45, S, 3), GRAPH_FAMILY_CIRCULANT);
+
+	/*Paley de ordem 13: S = resíduos quadráticos*/
+	size_t Q[] = {1, 3, 4, 9, 10, 12};
+	check(graph_circulant(13, Q, 6), GRAPH_FAMILY_CIRCULANT);
+
+	/*Z_3 x Z_4 x Z_5 e Z_2^4 (o hipercubo Q_4 como Cayley)*/
+	size_t dims[] = {3, 4, 5};
+	size_t T[] = {1, 0, 0, 0, 1, 0, 0, 0, 2, 1, 1, 1};
+	check(graph_cayley_abelian(dims, 3, T, 4), GRAPH_FAMILY_CAYLEY_ABELIAN);
+
+	size_t dims2[] = {2, 2, 2, 2};
+	size_t E[] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+	Graph* cq = graph_cayley_abelian(dims2, 4, E, 4);
+	Graph* q4 = graph_hypercube(4);
+
+	for (size_t i = 0; i < 16 * 16; i++) {
+		assert(cq->A[i] == q4->A[i]);
+	}
+
+	graph_free(q4);
+	check(cq, GRAPH_FAMILY_CAYLEY_ABELIAN);
+
+	/*depois de mexer no grafo a marca não vale mais*/
+	Graph* c = graph_cycle(10);
+	graph_add_edge(c, 0, 5, 1.0);
+	check(c, GRAPH_FAMILY_NONE);
+
+	printf("testes passaram!\n");
+
+	return 0;
+}
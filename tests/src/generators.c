@@ -0,0 +1,216 @@
+#include "../../src/graphs.h"
+#include "../../src/eig.h"
+#include "../../src/generators.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <assert.h>
+
+static double now(void) {
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+
+	return (double) t.tv_sec + 1e-9 * (double) t.tv_nsec;
+}
+
+static bool has_edge(const GraphCSR* g, size_t u, size_t v) {
+	size_t lo = g->rowptr[u], hi = g->rowptr[u + 1];
+
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+
+		if (g->col[mid] < v) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo < g->rowptr[u + 1] && g->col[lo] == v;
+}
+
+/*Listas crescentes, sem laços nem repetidas, e simétricas*/
+static void check_csr(const GraphCSR* g) {
+	assert(!g->directed && g->w == NULL);
+
+	for (size_t u = 0; u < g->n; u++) {
+		for (size_t e = g->rowptr[u]; e < g->rowptr[u + 1]; e++) {
+			assert(g->col[e] < g->n && g->col[e] != u);
+			assert(e == g->rowptr[u] || g->col[e - 1] < g->col[e]);
+			assert(has_edge(g, g->col[e], u));
+		}
+	}
+}
+
+static void same_csr(const GraphCSR* a, const GraphCSR* b) {
+	assert(a->n == b->n && a->rowptr[a->n] == b->rowptr[b->n]);
+	assert(memcmp(a->rowptr, b->rowptr, (a->n + 1) * sizeof(size_t)) == 0);
+	assert(memcmp(a->col, b->col, a->rowptr[a->n] * sizeof(size_t)) == 0);
+}
+
+static size_t max_degree(const GraphCSR* g) {
+	size_t best = 0;
+
+	for (size_t u = 0; u < g->n; u++) {
+		size_t d = g->rowptr[u + 1] - g->rowptr[u];
+		best = d > best ? d : best;
+	}
+
+	return best;
+}
+
+/*Mesmo grafo com 1 e com 4 threads*/
+static GraphCSR* threads_agree(GraphCSR* (*gen)(void)) {
+	setenv("GRAPH_NUM_THREADS", "1", 1);
+	GraphCSR* a = gen();
+	setenv("GRAPH_NUM_THREADS", "4", 1);
+	GraphCSR* b = gen();
+	unsetenv("GRAPH_NUM_THREADS");
+
+	check_csr(a);
+	same_csr(a, b);
+	graph_csr_free(b);
+
+	return a;
+}
+
+static GraphCSR* gen_ba(void) {
+	return graph_csr_random_ba(20000, 5, 1);
+}
+
+static GraphCSR* gen_cl(void) {
+	static double w[50000];
+	graph_powerlaw_weights(50000, 2.5, 10.0, w);
+
+	return graph_csr_random_chung_lu(50000, w, 2);
+}
+
+static GraphCSR* gen_rmat(void) {
+	return graph_csr_random_rmat(14, 16, 0.57, 0.19, 0.19, 3);
+}
+
+static size_t sbm_labels[400];
+
+static GraphCSR* gen_sbm(void) {
+	size_t sizes[] = {200, 200};
+	double P[] = {0.2, 0.02, 0.02, 0.2};
+
+	return graph_csr_random_sbm(2, sizes, P, 4, sbm_labels);
+}
+
+static void models(void) {
+	/*BA: ~m arestas por vértice novo, cauda pesada*/
+	GraphCSR* g = threads_agree(gen_ba);
+	double m = (double) g->rowptr[g->n] / 2;
+	assert(m > 0.95 * 5 * 19999 && m <= 5 * 19999);
+
+	for (size_t u = 0; u < g->n; u++) {
+		assert(g->rowptr[u + 1] > g->rowptr[u]);
+	}
+
+	printf("ba:       n = %zu, m = %.0f, grau máximo %zu\n", g->n, m,
+		max_degree(g));
+	assert(max_degree(g) > 100);
+	graph_csr_free(g);
+
+	/*Chung–Lu: grau médio perto do pedido*/
+	g = threads_agree(gen_cl);
+	double avg = (double) g->rowptr[g->n] / (double) g->n;
+	printf("chung-lu: grau médio %.2f (pedido 10), grau máximo %zu\n", avg,
+		max_degree(g));
+	assert(fabs(avg - 10.0) < 1.0 && max_degree(g) > 200);
+	graph_csr_free(g);
+
+	/*R-MAT*/
+	g = threads_agree(gen_rmat);
+	m = (double) g->rowptr[g->n] / 2;
+	printf("r-mat:    n = %zu, m = %.0f, grau máximo %zu\n", g->n, m,
+		max_degree(g));
+	assert(m > 0.5 * 16 * 16384 && m <= 16 * 16384);
+	assert(max_degree(g) > 500);
+	graph_csr_free(g);
+
+	/*SBM: arestas dentro/entre blocos e o segundo autovalor*/
+	g = threads_agree(gen_sbm);
+	size_t in = 0, out = 0;
+
+	for (size_t v = 0; v < 400; v++) {
+		assert(sbm_labels[v] == v / 200);
+
+		for (size_t e = g->rowptr[v]; e < g->rowptr[v + 1]; e++) {
+			if (sbm_labels[v] == sbm_labels[g->col[e]]) {
+				in++;
+			} else {
+				out++;
+			}
+		}
+	}
+
+	/*esperado: 2 * 0.2 * C(200, 2) = 7960 e 0.02 * 200² = 800*/
+	assert(fabs((double) in / 2 - 7960.0) < 5 * sqrt(7960.0));
+	assert(fabs((double) out / 2 - 800.0) < 5 * sqrt(800.0));
+
+	Graph* d = graph_new(400, false);
+
+	for (size_t v = 0; v < 400; v++) {
+		for (size_t e = g->rowptr[v]; e < g->rowptr[v + 1]; e++) {
+			d->A[IDX(v, g->col[e], 400)] = 1.0;
+		}
+	}
+
+	/*λ2 ≈ 200 (0.2 - 0.02) = 36, bem acima do ruído (~13)*/
+	double w[400];
+	graph_spec_adj(d, w);
+	printf("sbm:      λ1 = %.2f, λ2 = %.2f, λ3 = %.2f\n", w[399], w[398],
+		w[397]);
+	assert(w[398] > 25.0 && w[397] < 20.0);
+	graph_free(d);
+	graph_csr_free(g);
+
+	/*p = 1: completo; p = 0: vazio*/
+	size_t sizes[] = {5, 0, 7};
+	double P[] = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+	g = graph_csr_random_sbm(3, sizes, P, 5, NULL);
+	check_csr(g);
+	assert(g->n == 12 && g->rowptr[12] == 2 * (10 + 21));
+	graph_csr_free(g);
+
+	/*parâmetros inválidos*/
+	double bad[] = {0.5, 0.1, 0.2, 0.5};
+	assert(graph_csr_random_sbm(2, sizes, bad, 1, NULL) == NULL);
+	assert(graph_csr_random_rmat(14, 16, 0.6, 0.3, 0.3, 1) == NULL);
+	assert(graph_csr_random_rmat(32, 1, 0.25, 0.25, 0.25, 1) == NULL);
+	double neg[] = {1.0, -1.0};
+	assert(graph_csr_random_chung_lu(2, neg, 1) == NULL);
+
+	g = graph_csr_random_ba(1, 3, 1);
+	assert(g->n == 1 && g->rowptr[1] == 0);
+	graph_csr_free(g);
+}
+
+static void bench(void) {
+	double t0 = now();
+	GraphCSR* g = graph_csr_random_ba(1000000, 8, 7);
+	double t = now() - t0;
+	printf("ba 10^6 x 8:     %.2fs, %.1f M arestas/s (%zu threads)\n", t,
+		(double) g->rowptr[g->n] / 2 / t / 1e6, graph_num_threads());
+	graph_csr_free(g);
+
+	t0 = now();
+	g = graph_csr_random_rmat(20, 8, 0.57, 0.19, 0.19, 7);
+	t = now() - t0;
+	printf("r-mat 2^20 x 8:  %.2fs, %.1f M arestas/s\n", t,
+		(double) g->rowptr[g->n] / 2 / t / 1e6);
+	graph_csr_free(g);
+}
+
+int main() {
+	models();
+	bench();
+
+	printf("testes passaram!\n");
+
+	return 0;
+}
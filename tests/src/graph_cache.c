@@ -0,0 +1,112 @@
+#include "../../src/graphs.h"
+#include "../../src/eig.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <math.h>
+#include <assert.h>
+
+static double elapsed(clock_t t0) {
+	return (double) (clock() - t0) / CLOCKS_PER_SEC;
+}
+
+/*Espectros de A e de L de g e h iguais (w1, w2: n doubles)*/
+static void assert_same_spectra(Graph* g, Graph* h, double* w1, double* w2) {
+	size_t n = g->n;
+
+	graph_spec_adj(g, w1);
+	graph_spec_adj(h, w2);
+
+	for (size_t i = 0; i < n; i++) {
+		assert(fabs(w1[i] - w2[i]) < 1e-9);
+	}
+
+	graph_spec_lap(g, w1);
+	graph_spec_lap(h, w2);
+
+	for (size_t i = 0; i < n; i++) {
+		assert(fabs(w1[i] - w2[i]) < 1e-9);
+	}
+}
+
+static Graph* copy_of(const Graph* g) {
+	Graph* h = graph_new(g->n, g->directed);
+
+	for (size_t i = 0; i < g->n * g->n; i++) {
+		h->A[i] = g->A[i];
+	}
+
+	return h;
+}
+
+void simulate(size_t n, double p) {
+	srand(time(NULL));
+
+	Graph* g = graph_random(n, p);
+	double* w1 = malloc(n * sizeof(double));
+	double* w2 = malloc(n * sizeof(double));
+
+	clock_t t0 = clock();
+	graph_spec_adj(g, w1);
+	double first = elapsed(t0);
+
+	t0 = clock();
+	graph_spec_adj(g, w2);
+	double second = elapsed(t0);
+
+	printf("graph_spec_adj: %.4fs, de novo (cache): %.6fs\n", first, second);
+
+	for (size_t i = 0; i < n; i++) {
+		assert(w1[i] == w2[i]);
+	}
+
+	size_t m = graph_num_edges(g);
+	int d = graph_diameter(g);
+	assert(graph_num_edges(g) == m && graph_diameter(g) == d);
+
+	/*mudar o grafo invalida tudo*/
+	uint64_t v = graph_version(g);
+	graph_add_edge(g, 0, 1, 1.0);
+	graph_add_edge(g, 0, 2, 1.0);
+	graph_remove_edge(g, 0, 3);
+	assert(graph_version(g) > v);
+
+	Graph* h = copy_of(g);
+	assert(graph_num_edges(g) == graph_num_edges(h));
+	assert_same_spectra(g, h, w1, w2);
+
+	/*escrita direta em g->A e h->A (com os espectros em cache): precisa
+	de graph_invalidate. fresh nunca teve cache*/
+	g->A[IDX(4, 5, n)] = g->A[IDX(5, 4, n)] = 1.0 - g->A[IDX(4, 5, n)];
+	graph_invalidate(g);
+	h->A[IDX(4, 5, n)] = h->A[IDX(5, 4, n)] = g->A[IDX(4, 5, n)];
+	graph_invalidate(h);
+
+	Graph* fresh = copy_of(g);
+	assert(graph_num_edges(g) == graph_num_edges(fresh));
+	assert(graph_num_edges(h) == graph_num_edges(fresh));
+	assert_same_spectra(g, fresh, w1, w2);
+	assert_same_spectra(h, fresh, w1, w2);
+	graph_free(fresh);
+
+	/*com limite 0 nenhum vetor fica em cache*/
+	graph_free(h);
+	graph_free(g);
+	assert(graph_cache_usage() == 0);
+	graph_cache_set_limit(0);
+	g = graph_random(n, p);
+	graph_spec_adj(g, w1);
+	assert(graph_cache_usage() == 0);
+	graph_free(g);
+	graph_cache_set_limit(GRAPH_CACHE_DEFAULT_LIMIT);
+
+	free(w1);
+	free(w2);
+	printf("testes passaram!\n");
+}
+
+int main() {
+	simulate(400, 0.3);
+
+	return 0;
+}
@@ -22,7 +22,7 @@ void simulate() {
 		0, 0, 0, 0, 1, 0
 	};
 
-	Graph g = {6, true, A};
+	Graph g = {.n = 6, .directed = true, .A = A};
 
 	double* B = graph_incidence_matrix(&g);
 	print_matrix(B, g.n, graph_num_edges(&g));
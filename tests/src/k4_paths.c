@@ -12,6 +12,6 @@ int main() {
 
 	printf("\n");
 
-	free(g);
+	graph_free(g);
 	return 0;
 }
\ No newline at end of file
@@ -47,7 +47,7 @@ void simulate(size_t n, size_t maxit, double p) {
 		unsigned int count_zero = count_mult(x, 0.0, g->n, rtol, atol);
 		printf("número de componentes conexas: %d\n", count_zero);
 
-		free(g);
+		graph_free(g);
 		free(x);
 	}
 }
@@ -0,0 +1,287 @@
+#include "../../src/graphs.h"
+#include "../../src/lapsolve.h"
+#include "../../src/eig.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <math.h>
+#include <assert.h>
+
+/*Grafo conexo com pesos variados*/
+static Graph* random_weighted(size_t n, double p) {
+	Graph* g = graph_random_connected((int) n, p);
+
+	for (size_t u = 0; u < n; u++) {
+		for (size_t v = u + 1; v < n; v++) {
+			if (graph_get(g, u, v) != 0.0) {
+				graph_add_edge(g, u, v, 0.01 + (rand() % 1000) / 10.0);
+			}
+		}
+	}
+
+	return g;
+}
+
+/*Confere L X = B projetado e soma zero em X (uma componente)*/
+static void check_solution(const Graph* g, const double* B, const double* X,
+	size_t k) {
+	size_t n = g->n;
+	double* L = malloc(n * n * sizeof(double));
+	graph_laplacian(g, L);
+
+	for (size_t j = 0; j < k; j++) {
+		double mean = 0.0, sx = 0.0, err = 0.0, nb = 0.0;
+
+		for (size_t v = 0; v < n; v++) {
+			mean += B[IDX(v, j, k)] / n;
+			sx += X[IDX(v, j, k)];
+		}
+
+		for (size_t u = 0; u < n; u++) {
+			double y = 0.0;
+
+			for (size_t v = 0; v < n; v++) {
+				y += L[IDX(u, v, n)] * X[IDX(v, j, k)];
+			}
+
+			double b = B[IDX(u, j, k)] - mean;
+			err += (y - b) * (y - b);
+			nb += b * b;
+		}
+
+		assert(sqrt(err) <= 1e-8 * sqrt(nb));
+		assert(fabs(sx) < 1e-8);
+	}
+
+	free(L);
+}
+
+/*Razões R_H(u, v) / R_G(u, v) em [lo, hi] para k pares sorteados,
+resolvidos em lote direto nos CSR. Se H aproxima G a (1 ± eps), as
+razões ficam em [1/(1 + eps), 1/(1 - eps)]*/
+static void res_ratios(const GraphCSR* g, const GraphCSR* h, size_t k,
+	Rng* rng, double* lo, double* hi) {
+	size_t n = g->n;
+	size_t* pu = malloc(k * sizeof(size_t));
+	size_t* pv = malloc(k * sizeof(size_t));
+	double* B = calloc(n * k, sizeof(double));
+	double* XG = malloc(n * k * sizeof(double));
+	double* XH = malloc(n * k * sizeof(double));
+
+	for (size_t j = 0; j < k; j++) {
+		pu[j] = rng_below(rng, n);
+
+		do {
+			pv[j] = rng_below(rng, n);
+		} while (pv[j] == pu[j]);
+
+		B[IDX(pu[j], j, k)] = 1.0;
+		B[IDX(pv[j], j, k)] = -1.0;
+	}
+
+	assert(graph_csr_laplacian_solve_batch(g, B, k, XG, GRAPH_PRECOND_JACOBI,
+		1e-8) == 0);
+	assert(graph_csr_laplacian_solve_batch(h, B, k, XH, GRAPH_PRECOND_JACOBI,
+		1e-8) == 0);
+	*lo = INFINITY;
+	*hi = 0.0;
+
+	for (size_t j = 0; j < k; j++) {
+		double rg = XG[IDX(pu[j], j, k)] - XG[IDX(pv[j], j, k)];
+		double rh = XH[IDX(pu[j], j, k)] - XH[IDX(pv[j], j, k)];
+		*lo = fmin(*lo, rh / rg);
+		*hi = fmax(*hi, rh / rg);
+	}
+
+	free(pu);
+	free(pv);
+	free(B);
+	free(XG);
+	free(XH);
+}
+
+int main() {
+	srand(time(NULL));
+
+	size_t n = 80, k = 5;
+	Graph* g = random_weighted(n, 0.08);
+	double* B = malloc(n * k * sizeof(double));
+	double* X = malloc(n * k * sizeof(double));
+
+	for (size_t i = 0; i < n * k; i++) {
+		B[i] = (double) rand() / RAND_MAX - 0.5;
+	}
+
+	GraphPrecond pcs[] = {GRAPH_PRECOND_NONE, GRAPH_PRECOND_JACOBI,
+		GRAPH_PRECOND_TREE};
+
+	for (size_t i = 0; i < 3; i++) {
+		assert(graph_laplacian_solve_batch(g, B, k, X, pcs[i], 1e-12) == 0);
+		check_solution(g, B, X, k);
+	}
+
+	assert(graph_laplacian_solve(g, B, X) == 0);
+
+	/*o mesmo direto do CSR*/
+	GraphCSR* gc = graph_csr_from_graph(g);
+
+	for (size_t i = 0; i < 3; i++) {
+		assert(graph_csr_laplacian_solve_batch(gc, B, k, X, pcs[i], 1e-12)
+			== 0);
+		check_solution(g, B, X, k);
+	}
+
+	assert(graph_csr_laplacian_solve(gc, B, X) == 0);
+	assert(fabs(graph_csr_effective_resistance(gc, 3, 7)
+		- graph_effective_resistance(g, 3, 7)) < 1e-9);
+
+	/*distorção: H = 2 G dá exatamente lo = hi = 2*/
+	GraphCSR* g2 = graph_csr_from_graph(g);
+	double lo2, hi2;
+
+	for (size_t e = 0; e < g2->rowptr[n]; e++) {
+		g2->w[e] *= 2.0;
+	}
+
+	assert(graph_csr_spectral_distortion(gc, g2, 30, NULL, &lo2, &hi2) == 0);
+	assert(fabs(lo2 - 2.0) < 1e-8 && fabs(hi2 - 2.0) < 1e-8);
+	graph_csr_free(g2);
+	graph_csr_free(gc);
+
+	/*resistências de todas as arestas: exata vs sketch*/
+	size_t m = graph_num_nonloop_edges(g);
+	double* r = malloc(m * sizeof(double));
+	double eps = 0.5;
+	assert(graph_edge_resistances_approx(g, eps, r) == 0);
+
+	for (size_t u = 0, e = 0; u < n; u++) {
+		for (size_t v = u + 1; v < n; v++) {
+			if (graph_get(g, u, v) != 0.0) {
+				double exact = graph_effective_resistance(g, u, v);
+				assert(exact > 0.0 && exact <= 1.0 / graph_get(g, u, v) + 1e-9);
+				assert(fabs(r[e] - exact) <= eps * exact);
+				e++;
+			}
+		}
+	}
+
+	free(r);
+
+	/*caminho com pesos: resistências em série*/
+	Graph* p = graph_new(10, false);
+	double series = 0.0;
+
+	for (size_t i = 0; i + 1 < 10; i++) {
+		double w = 1.0 + i;
+		graph_add_edge(p, i, i + 1, w);
+		series += 1.0 / w;
+	}
+
+	assert(fabs(graph_effective_resistance(p, 0, 9) - series) < 1e-9);
+	assert(graph_effective_resistance(p, 3, 3) == 0.0);
+
+	/*ciclo: R(0, j) = j(n - j)/n; Kf(C_n) = (n³ - n)/12*/
+	Graph* c = graph_new(12, false);
+
+	for (size_t i = 0; i < 12; i++) {
+		graph_add_edge(c, i, (i + 1) % 12, 1.0);
+	}
+
+	for (size_t j = 1; j < 12; j++) {
+		double expect = j * (12.0 - j) / 12.0;
+		assert(fabs(graph_effective_resistance(c, 0, j) - expect) < 1e-9);
+	}
+
+	assert(fabs(graph_kirchhoff_index(c) - (1728.0 - 12.0) / 12.0) < 1e-8);
+
+	/*Kf(K_n) = n - 1*/
+	Graph* kn = graph_kn(9);
+	assert(fabs(graph_kirchhoff_index(kn) - 8.0) < 1e-9);
+
+	/*desconexo: cada componente resolvida separadamente*/
+	Graph* d = graph_new(6, false);
+	graph_add_edge(d, 0, 1, 2.0);
+	graph_add_edge(d, 1, 2, 1.0);
+	graph_add_edge(d, 3, 4, 1.0);
+	assert(isinf(graph_effective_resistance(d, 0, 4)));
+	assert(isinf(graph_kirchhoff_index(d)));
+	assert(fabs(graph_effective_resistance(d, 0, 2) - 1.5) < 1e-9);
+
+	double b6[6] = {1, 0, -1, 2, -2, 0}, x6[6];
+	assert(graph_laplacian_solve(d, b6, x6) == 0);
+	assert(fabs(x6[0] + x6[1] + x6[2]) < 1e-12 && fabs(x6[3] + x6[4]) < 1e-12);
+	assert(fabs(x6[3] - x6[4] - 2.0) < 1e-9 && x6[5] == 0.0);
+
+	/*direcionado não vale*/
+	Graph* dir = graph_new(3, true);
+	assert(graph_laplacian_solve(dir, b6, x6) == LAPSOLVE_INVALID);
+	GraphCSR* dirc = graph_csr_from_graph(dir);
+	assert(graph_csr_laplacian_solve(dirc, b6, x6) == LAPSOLVE_INVALID);
+	assert(isnan(graph_csr_effective_resistance(dirc, 0, 1)));
+	graph_csr_free(dirc);
+
+	/*esparsificação: G(1500, 1/2) com ~560 mil arestas*/
+	Rng rng;
+	rng_seed(&rng, 11);
+	Graph* dense = graph_random_r(1500, 0.5, &rng);
+	GraphCSR* densec = graph_csr_from_graph(dense);
+	size_t md = graph_num_edges(dense);
+
+	for (int how = 0; how < 2; how++) {
+		GraphCSR* h = graph_sparsify_r(dense, 0.5, (GraphSparsifier) how,
+			&rng);
+		double lo, hi, rlo, rhi;
+		assert(graph_csr_spectral_distortion(densec, h, 30, &rng, &lo, &hi)
+			== 0);
+		res_ratios(densec, h, 32, &rng, &rlo, &rhi);
+		printf("sparsify (%s): %zu -> %zu arestas, distorção [%.3f, %.3f], "
+			"R_H / R_G em [%.3f, %.3f]\n",
+			how == GRAPH_SPARSIFY_RESISTANCE ? "resistência" : "graus", md,
+			h->rowptr[h->n] / 2, lo, hi, rlo, rhi);
+		assert(h->rowptr[h->n] / 2 < md / 3);
+		assert(lo > 0.5 && hi < 1.5);
+
+		/*R_H / R_G fica em [1/hi, 1/lo] (folga para o Lanczos truncado)*/
+		assert(rlo > 0.98 / hi && rhi < 1.02 / lo);
+		graph_csr_free(h);
+	}
+
+	/*dois K_60 ligados por uma ponte: R = 1, a ponte fica com peso 1*/
+	Graph* bar = graph_new(120, false);
+
+	for (size_t u = 0; u < 120; u++) {
+		for (size_t v = u + 1; v < 120; v++) {
+			if (u / 60 == v / 60) {
+				graph_add_edge(bar, u, v, 1.0);
+			}
+		}
+	}
+
+	graph_add_edge(bar, 59, 60, 1.0);
+	GraphCSR* hb = graph_sparsify(bar, 0.9, GRAPH_SPARSIFY_RESISTANCE);
+	bool bridge = false;
+
+	for (size_t e = hb->rowptr[59]; e < hb->rowptr[60]; e++) {
+		bridge |= hb->col[e] == 60 && fabs(hb->w[e] - 1.0) < 1e-12;
+	}
+
+	assert(bridge);
+	assert(graph_sparsify(dir, 0.5, GRAPH_SPARSIFY_DEGREE) == NULL);
+	graph_csr_free(hb);
+	graph_free(bar);
+	graph_csr_free(densec);
+	graph_free(dense);
+
+	graph_free(g);
+	graph_free(p);
+	graph_free(c);
+	graph_free(kn);
+	graph_free(d);
+	graph_free(dir);
+	free(B);
+	free(X);
+
+	printf("testes passaram!\n");
+
+	return 0;
+}
@@ -0,0 +1,372 @@
+#include "../../src/graphs.h"
+#include "../../src/eig.h"
+#include "../../src/generators.h"
+#include "../../src/matfun.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <assert.h>
+
+static double now(void) {
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+
+	return (double) t.tv_sec + 1e-9 * (double) t.tv_nsec;
+}
+
+/*exp(A) por escala e quadrado: Taylor em A / 2^s e s quadrados*/
+static double* matrix_exp(const double* A, size_t n) {
+	double norm = 0.0;
+
+	for (size_t i = 0; i < n; i++) {
+		double s = 0.0;
+
+		for (size_t j = 0; j < n; j++) {
+			s += fabs(A[IDX(i, j, n)]);
+		}
+
+		norm = fmax(norm, s);
+	}
+
+	int s = 0;
+
+	while (norm > 0.25) {
+		norm /= 2.0;
+		s++;
+	}
+
+	double scale = ldexp(1.0, -s);
+	double* E = calloc(n * n, sizeof(double));
+	double* T = calloc(n * n, sizeof(double));
+	double* B = malloc(n * n * sizeof(double));
+	double* X = malloc(n * n * sizeof(double));
+
+	for (size_t i = 0; i < n; i++) {
+		E[IDX(i, i, n)] = T[IDX(i, i, n)] = 1.0;
+	}
+
+	for (size_t i = 0; i < n * n; i++) {
+		B[i] = scale * A[i];
+	}
+
+	for (int k = 1; k <= 20; k++) {
+		matrix_mult(T, B, X, n);
+
+		for (size_t i = 0; i < n * n; i++) {
+			T[i] = X[i] / k;
+			E[i] += T[i];
+		}
+	}
+
+	for (int k = 0; k < s; k++) {
+		matrix_mult(E, E, X, n);
+		memcpy(E, X, n * n * sizeof(double));
+	}
+
+	free(T);
+	free(B);
+	free(X);
+
+	return E;
+}
+
+static bool close_rel(double x, double y, double tol) {
+	return fabs(x - y) <= tol * fmax(fabs(x), fabs(y));
+}
+
+/*exact ∈ [lower, upper], com folga de arredondamento*/
+static bool brackets(const MatfunBounds* b, double exact) {
+	double slack = 1e-12 * fabs(exact);
+
+	return b->lower - slack <= exact && exact <= b->upper + slack;
+}
+
+/*O nó em 0 pode sair levemente negativo*/
+static double sqrt0(double x) {
+	return x > 0.0 ? sqrt(x) : 0.0;
+}
+
+/*Matriz diagonal: uᵀ f(D) u é conhecido*/
+typedef struct {
+	const double* d;
+	size_t n;
+} Diag;
+
+static void diag_matvec(const double* x, double* y, void* ctx) {
+	const Diag* D = ctx;
+
+	for (size_t i = 0; i < D->n; i++) {
+		y[i] = D->d[i] * x[i];
+	}
+}
+
+static void forms(void) {
+	size_t n = 500;
+	double* d = malloc(n * sizeof(double));
+	double* u = malloc(n * sizeof(double));
+	double* v = malloc(n * sizeof(double));
+	Diag D = {d, n};
+
+	for (size_t i = 0; i < n; i++) {
+		d[i] = -3.0 + 8.0 * i / (n - 1);
+		u[i] = sin(i + 1.0);
+		v[i] = cos(3.0 * i);
+	}
+
+	double want = 0.0, want_uv = 0.0, want_sqrt = 0.0;
+
+	for (size_t i = 0; i < n; i++) {
+		want += u[i] * u[i] * exp(d[i]);
+		want_uv += u[i] * v[i] * exp(d[i]);
+		want_sqrt += u[i] * u[i] * sqrt(d[i] + 3.0);
+	}
+
+	MatfunBounds b;
+	assert(matfun_quadratic(diag_matvec, &D, n, u, exp, -3.0, 5.0, 0.0,
+		&b) == 0);
+	assert(close_rel(b.value, want, 1e-9) && brackets(&b, want));
+	assert(b.steps < 40);
+
+	/*cotas folgadas e tol maior: ainda cercam*/
+	assert(matfun_quadratic(diag_matvec, &D, n, u, exp, -10.0, 10.0, 1e-3,
+		&b) == 0);
+	assert(brackets(&b, want) && b.upper - b.lower > 0.0);
+
+	assert(matfun_bilinear(diag_matvec, &D, n, u, v, exp, -3.0, 5.0, 0.0,
+		&b) == 0);
+	assert(fabs(b.value - want_uv) <= 1e-8 * want && brackets(&b, want_uv));
+
+	/*raiz de D + 3I (com autovalor 0): a cota em 0 converge devagar,
+	mas cerca*/
+	for (size_t i = 0; i < n; i++) {
+		d[i] += 3.0;
+	}
+
+	assert(matfun_quadratic(diag_matvec, &D, n, u, sqrt0, 0.0, 8.0, 1e-4,
+		&b) == 0);
+	assert(brackets(&b, want_sqrt));
+
+	double lo, hi;
+	matfun_interval(diag_matvec, &D, n, &lo, &hi);
+	assert(lo <= 0.0 && hi >= 8.0 && lo > -0.1 && hi < 8.1);
+
+	assert(matfun_quadratic(diag_matvec, &D, n, u, exp, 1.0, 0.0, 0.0,
+		&b) == -1);
+
+	free(d);
+	free(u);
+	free(v);
+}
+
+/*Entradas de exp(A) contra a matriz exponencial, denso e CSR*/
+static void entries(const Graph* g) {
+	size_t n = g->n;
+	double* E = matrix_exp(g->A, n);
+	GraphCSR* c = graph_csr_from_graph(g);
+	MatfunBounds* sc = malloc(n * sizeof(MatfunBounds));
+	MatfunBounds* sc2 = malloc(n * sizeof(MatfunBounds));
+
+	assert(graph_subgraph_centrality(g, NULL, 0, sc) == 0);
+	assert(graph_csr_subgraph_centrality(c, NULL, 0, sc2) == 0);
+
+	for (size_t v = 0; v < n; v++) {
+		double want = E[IDX(v, v, n)];
+		assert(close_rel(sc[v].value, want, 1e-8) && brackets(&sc[v], want));
+		assert(close_rel(sc2[v].value, want, 1e-8));
+	}
+
+	size_t vs[] = {n - 1, 0, n / 2};
+	assert(graph_subgraph_centrality(g, vs, 3, sc) == 0);
+	assert(close_rel(sc[0].value, E[IDX(n - 1, n - 1, n)], 1e-8));
+	assert(close_rel(sc[2].value, E[IDX(n / 2, n / 2, n)], 1e-8));
+
+	for (size_t k = 0; k < 20; k++) {
+		size_t p = rand() % n, q = rand() % n;
+		double want = E[IDX(p, q, n)], scale = E[IDX(p, p, n)] + E[IDX(q, q, n)];
+		MatfunBounds b;
+
+		assert(graph_communicability(g, p, q, &b) == 0);
+		assert(fabs(b.value - want) <= 1e-8 * scale);
+		assert(b.lower - 1e-12 * scale <= want && want <= b.upper + 1e-12 * scale);
+
+		assert(graph_csr_communicability(c, p, q, &b) == 0);
+		assert(fabs(b.value - want) <= 1e-8 * scale);
+	}
+
+	MatfunBounds b;
+	assert(graph_communicability(g, 0, n, &b) == -1);
+	vs[1] = n;
+	assert(graph_subgraph_centrality(g, vs, 3, sc) == -1);
+
+	free(E);
+	free(sc);
+	free(sc2);
+	graph_csr_free(c);
+}
+
+/*Estrada e energia: Hutchinson contra o espectro*/
+static void traces(const Graph* g) {
+	size_t n = g->n;
+	double* x = malloc(n * sizeof(double));
+	assert(graph_spec_adj(g, x) == 0);
+
+	double estrada = 0.0, energy = 0.0;
+
+	for (size_t i = 0; i < n; i++) {
+		estrada += exp(x[i]);
+		energy += fabs(x[i]);
+	}
+
+	MatfunTrace t, t2;
+	assert(graph_estrada_index(g, 300, 7, &t) == 0);
+	assert(t.probes == 300);
+	assert(fabs(t.value - estrada) <= 4.0 * t.std_error + (t.upper - t.lower));
+	assert(t.lower <= t.value * (1 + 1e-12) && t.value <= t.upper * (1 + 1e-12));
+
+	/*mesma semente, mesmo resultado (sondas independem das threads)*/
+	assert(graph_estrada_index(g, 300, 7, &t2) == 0);
+	assert(t.value == t2.value && t.std_error == t2.std_error);
+
+	GraphCSR* c = graph_csr_from_graph(g);
+	assert(graph_csr_estrada_index(c, 300, 7, &t2) == 0);
+	assert(close_rel(t.value, t2.value, 1e-8));
+	MatfunTrace e = t;
+
+	assert(graph_energy(g, 300, 3, &t) == 0);
+	assert(fabs(t.value - energy) <= 4.0 * t.std_error + (t.upper - t.lower));
+	assert(graph_csr_energy(c, 300, 3, &t2) == 0);
+	assert(fabs(t2.value - energy) <= 4.0 * t2.std_error + (t2.upper - t2.lower));
+
+	printf("n = %zu: Estrada %.6g ± %.2g (exato %.6g), energia %.6g ± %.2g "
+		"(exata %.6g)\n", n, e.value, e.std_error, estrada, t.value,
+		t.std_error, energy);
+
+	free(x);
+	graph_csr_free(c);
+}
+
+static void special_cases(void) {
+	/*grafo vazio: A = 0, exp(A) = I*/
+	Graph* e = graph_new(10, false);
+	MatfunTrace t;
+	MatfunBounds b;
+	assert(graph_estrada_index(e, 0, 1, &t) == 0);
+	assert(fabs(t.value - 10.0) <= 4.0 * t.std_error + 1e-12);
+	assert(t.probes == MATFUN_PROBES);
+	assert(graph_energy(e, 0, 1, &t) == 0 && t.value == 0.0);
+	assert(graph_communicability(e, 2, 3, &b) == 0 && fabs(b.value) < 1e-12);
+	graph_free(e);
+
+	Graph* z = graph_new(0, false);
+	assert(graph_estrada_index(z, 0, 1, &t) == 0 && t.value == 0.0);
+	graph_free(z);
+
+	Graph* d = graph_new(4, true);
+	graph_add_edge(d, 0, 1, 1.0);
+	assert(graph_estrada_index(d, 0, 1, &t) == -1);
+	assert(graph_energy(d, 0, 1, &t) == -1);
+	assert(graph_communicability(d, 0, 1, &b) == -1);
+	graph_free(d);
+
+	/*K_n: energia exata 2(n - 1), Estrada e^(n-1) + (n - 1)/e*/
+	Graph* k = graph_kn(30);
+	assert(graph_estrada_index(k, 100, 2, &t) == 0);
+	double want = exp(29.0) + 29.0 * exp(-1.0);
+	assert(fabs(t.value - want) <= 4.0 * t.std_error + 1e-8 * want);
+	assert(graph_energy(k, 100, 2, &t) == 0);
+	assert(fabs(t.value - 58.0) <= 4.0 * t.std_error + 1e-4 * 58.0);
+	graph_free(k);
+}
+
+static void bench_dense(size_t n) {
+	Graph* g = graph_random(n, 0.05);
+	double* x = malloc(n * sizeof(double));
+
+	double t0 = now();
+	graph_spec_adj(g, x);
+	double estrada = 0.0;
+
+	for (size_t i = 0; i < n; i++) {
+		estrada += exp(x[i]);
+	}
+
+	double t_spec = now() - t0;
+
+	MatfunTrace t;
+	t0 = now();
+	graph_estrada_index(g, 0, 1, &t);
+	double t_quad = now() - t0;
+
+	MatfunBounds b;
+	t0 = now();
+	graph_communicability(g, 0, 1, &b);
+	double t_pq = now() - t0;
+
+	printf("denso n = %zu: espectro %.3fs; Estrada %.3fs (erro relativo "
+		"%.1e, erro padrão %.1e); exp(A)_01 %.4fs (%zu passos)\n", n,
+		t_spec, t_quad, fabs(t.value - estrada) / estrada,
+		t.std_error / estrada, t_pq, b.steps);
+
+	free(x);
+	graph_free(g);
+}
+
+static void bench_sparse(size_t n) {
+	GraphCSR* c = graph_csr_random_ba(n, 3, 1);
+	MatfunTrace t;
+	MatfunBounds sc[20];
+	size_t vs[20];
+
+	for (size_t i = 0; i < 20; i++) {
+		vs[i] = i * (n / 20);
+	}
+
+	double t0 = now();
+	graph_csr_estrada_index(c, 0, 1, &t);
+	double t_estrada = now() - t0;
+
+	t0 = now();
+	graph_csr_subgraph_centrality(c, vs, 20, sc);
+	double t_sc = now() - t0;
+
+	MatfunTrace en;
+	t0 = now();
+	graph_csr_energy(c, 0, 1, &en);
+	double t_energy = now() - t0;
+
+	printf("BA n = %zu: Estrada %.4g ± %.1e em %.3fs; 20 centralidades "
+		"%.3fs; energia %.6g ± %.1e em %.3fs\n", n, t.value,
+		t.std_error / t.value, t_estrada, t_sc, en.value,
+		en.std_error / en.value, t_energy);
+
+	graph_csr_free(c);
+}
+
+int main() {
+	srand(time(NULL));
+
+	forms();
+	special_cases();
+
+	Graph* g = graph_random(80, 0.1);
+	entries(g);
+	traces(g);
+	graph_free(g);
+
+	/*pesos, inclusive negativos*/
+	g = graph_random(60, 0.2);
+	graph_add_edge(g, 0, 1, -2.5);
+	graph_add_edge(g, 5, 9, 0.3);
+	entries(g);
+	traces(g);
+	graph_free(g);
+
+	bench_dense(1500);
+	bench_sparse(50000);
+
+	printf("testes passaram!\n");
+
+	return 0;
+}
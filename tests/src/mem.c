@@ -0,0 +1,112 @@
+#include "../../src/graphs.h"
+#include "../../src/eig.h"
+#include "../../src/mem.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <assert.h>
+
+typedef struct {
+	size_t allocs, frees, live;
+} Counter;
+
+static void* count_alloc(size_t size, size_t align, void* ctx) {
+	Counter* c = ctx;
+	void* p = NULL;
+
+	if (posix_memalign(&p, align, size) != 0) {
+		return NULL;
+	}
+
+	c->allocs++;
+	c->live += size;
+
+	return p;
+}
+
+static void count_free(void* p, size_t size, void* ctx) {
+	Counter* c = ctx;
+	c->frees++;
+	c->live -= size;
+	free(p);
+}
+
+/*Matriz grande (passa de GRAPH_MEM_HUGE_MIN e do limite do first touch)*/
+static void big_matrix(void) {
+	size_t rows = 1000, cols = 1100;
+	double* src = malloc(rows * cols * sizeof(double));
+
+	for (size_t i = 0; i < rows * cols; i++) {
+		src[i] = (double) i;
+	}
+
+	double* Z = graph_mem_matrix(rows, cols, NULL);
+	double* C = graph_mem_matrix(rows, cols, src);
+	assert((uintptr_t) Z % GRAPH_MEM_ALIGN == 0);
+	assert((uintptr_t) C % GRAPH_MEM_ALIGN == 0);
+
+	for (size_t i = 0; i < rows * cols; i++) {
+		assert(Z[i] == 0.0 && C[i] == src[i]);
+	}
+
+	graph_mem_free(Z);
+	graph_mem_free(C);
+	free(src);
+}
+
+int main() {
+	/*alinhamento e zeros, inclusive em tamanhos pequenos e 0*/
+	for (size_t n = 0; n < 20; n++) {
+		double* M = graph_mem_matrix(n, n + 1, NULL);
+		assert((uintptr_t) M % GRAPH_MEM_ALIGN == 0);
+
+		for (size_t i = 0; i < n * (n + 1); i++) {
+			assert(M[i] == 0.0);
+		}
+
+		graph_mem_free(M);
+	}
+
+	graph_mem_free(NULL);
+
+	/*os três modos de huge pages, com e sem first touch*/
+	GraphHugePages modes[] = {GRAPH_HUGE_OFF, GRAPH_HUGE_TRANSPARENT,
+		GRAPH_HUGE_EXPLICIT};
+
+	for (size_t m = 0; m < 3; m++) {
+		graph_mem_set_huge_pages(modes[m]);
+		graph_mem_set_first_touch(m != 1);
+		big_matrix();
+	}
+
+	graph_mem_set_huge_pages(GRAPH_HUGE_TRANSPARENT);
+	graph_mem_set_first_touch(true);
+
+	/*alocador do usuário: graph_new/graph_spec_lap passam por ele*/
+	Counter c = {0, 0, 0};
+	GraphAllocator a = {count_alloc, count_free, &c};
+	graph_mem_set_allocator(&a);
+
+	Graph* g = graph_kn(12);
+	double x[12];
+	assert(graph_spec_adj(g, x) == 0);
+	assert(fabs(x[11] - 11.0) < 1e-9);
+	assert(c.allocs >= 1);
+
+	graph_mem_set_allocator(NULL);
+
+	/*blocos do usuário voltam para o usuário mesmo depois da troca*/
+	Graph* h = graph_random(40, 0.3);
+	graph_free(g);
+	assert(c.allocs == c.frees && c.live == 0);
+
+	double y[40];
+	assert(graph_spec_lap(h, y) == 0);
+	assert(fabs(y[0]) < 1e-9);
+	graph_free(h);
+
+	printf("testes passaram!\n");
+
+	return 0;
+}
@@ -0,0 +1,139 @@
+#include "../../src/graphs.h"
+#include "../../src/eig.h"
+#include "../../src/products.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <math.h>
+#include <assert.h>
+
+static void assert_close(const double* x, const double* y, size_t n) {
+	for (size_t i = 0; i < n; i++) {
+		assert(fabs(x[i] - y[i]) < 1e-8);
+	}
+}
+
+/*Espectro derivado == eigensolve do grafo montado*/
+static void check(Graph* P, const double* derived) {
+	double* x = malloc((P->n + 1) * sizeof(double));
+
+	assert(graph_spec_adj(P, x) == 0);
+	assert_close(x, derived, P->n);
+
+	free(x);
+	graph_free(P);
+}
+
+int main() {
+	srand(time(NULL));
+
+	Graph* G = graph_random(7, 0.5);
+	Graph* H = graph_random(9, 0.4);
+	double* x = malloc(7 * 9 * sizeof(double));
+
+	assert(graph_spec_cartesian_product(G, H, x) == 0);
+	check(graph_cartesian_product(G, H), x);
+
+	assert(graph_spec_tensor_product(G, H, x) == 0);
+	check(graph_tensor_product(G, H), x);
+
+	assert(graph_spec_strong_product(G, H, x) == 0);
+	check(graph_strong_product(G, H), x);
+
+	/*K_2 □ K_2 = C_4*/
+	Graph* k2 = graph_kn(2);
+	Graph* c4 = graph_cartesian_product(k2, k2);
+	assert(graph_num_edges(c4) == 4);
+	assert(graph_get(c4, 0, 3) == 0.0 && graph_get(c4, 0, 1) == 1.0);
+	graph_free(c4);
+	graph_free(k2);
+
+	/*complemento: regular (fórmula) e não regular (eigensolver)*/
+	Graph* R = graph_random_regular(12, 3);
+	double y[12];
+	assert(graph_spec_complement(R, y) == 0);
+	check(graph_complement(R), y);
+	graph_free(R);
+
+	assert(graph_spec_complement(G, x) == 0);
+	check(graph_complement(G), x);
+
+	/*grafo linha com m > n e com m < n*/
+	Graph* D = graph_random(8, 0.7);
+	double* z = malloc((graph_num_edges(D) + 1) * sizeof(double));
+	assert(graph_spec_line_graph(D, z) == 0);
+	Graph* L = graph_line_graph(D);
+	assert(L->n == graph_num_edges(D));
+	check(L, z);
+	free(z);
+	graph_free(D);
+
+	Graph* S = graph_new(10, false);
+	graph_add_edge(S, 0, 1, 1.0);
+	graph_add_edge(S, 1, 2, 1.0);
+	graph_add_edge(S, 2, 0, 1.0);
+	graph_add_edge(S, 5, 6, 1.0);
+	double w[4];
+	assert(graph_spec_line_graph(S, w) == 0);
+	check(graph_line_graph(S), w);
+	graph_free(S);
+
+	/*com pesos: o espectro é o de graph_line_graph, que ignora os pesos
+	(o mesmo do triângulo com pendente sem pesos)*/
+	Graph* W = graph_new(4, false);
+	Graph* U = graph_new(4, false);
+	graph_add_edge(W, 0, 1, 2.5);
+	graph_add_edge(W, 1, 2, 0.5);
+	graph_add_edge(W, 2, 0, 3.0);
+	graph_add_edge(W, 2, 3, 7.0);
+	graph_add_edge(U, 0, 1, 1.0);
+	graph_add_edge(U, 1, 2, 1.0);
+	graph_add_edge(U, 2, 0, 1.0);
+	graph_add_edge(U, 2, 3, 1.0);
+	double wu[4], ww[4];
+	assert(graph_spec_line_graph(W, ww) == 0);
+	assert(graph_spec_line_graph(U, wu) == 0);
+	assert_close(ww, wu, 4);
+	check(graph_line_graph(W), ww);
+	graph_free(W);
+	graph_free(U);
+
+	/*laços não entram em L(G): 2 laços e nenhuma aresta dão L(G) vazio;
+	com um triângulo, L(G) é o triângulo*/
+	Graph* P = graph_new(4, false);
+	graph_add_edge(P, 0, 0, 1.0);
+	graph_add_edge(P, 3, 3, 1.0);
+	assert(graph_num_nonloop_edges(P) == 0);
+	Graph* LP = graph_line_graph(P);
+	assert(LP->n == 0);
+	graph_free(LP);
+	graph_add_edge(P, 0, 1, 1.0);
+	graph_add_edge(P, 1, 2, 1.0);
+	graph_add_edge(P, 2, 0, 1.0);
+	double wp[3];
+	assert(graph_num_nonloop_edges(P) == 3);
+	assert(graph_spec_line_graph(P, wp) == 0);
+	check(graph_line_graph(P), wp);
+	graph_free(P);
+
+	/*L(K_4) tem 6 vértices e é 4-regular*/
+	Graph* k4 = graph_kn(4);
+	Graph* lk4 = graph_line_graph(k4);
+	double deg[6];
+	graph_degree(lk4, deg, NULL);
+
+	for (size_t i = 0; i < 6; i++) {
+		assert(deg[i] == 4.0);
+	}
+
+	graph_free(lk4);
+	graph_free(k4);
+
+	free(x);
+	graph_free(G);
+	graph_free(H);
+
+	printf("testes passaram!\n");
+
+	return 0;
+}
@@ -22,7 +22,7 @@ void simulate(size_t n) {
 		printf("%s\n", graph_is_connected(g)? "CONEXO" : "DISCONEXO");
 		eigenvalues_print(w, n, NULL);
 		free(w);
-		free(g);
+		graph_free(g);
 	}
 }
 
@@ -0,0 +1,366 @@
+#include "../../src/graphs.h"
+#include "../../src/eig.h"
+#include "../../src/rng.h"
+#include "../../src/reorder.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <math.h>
+#include <assert.h>
+
+static double elapsed(clock_t t0) {
+	return (double) (clock() - t0) / CLOCKS_PER_SEC;
+}
+
+static void shuffle(size_t* p, size_t n, Rng* rng) {
+	for (size_t i = 0; i < n; i++) {
+		p[i] = i;
+	}
+
+	for (size_t i = n; i-- > 1;) {
+		size_t j = rng_below(rng, i + 1);
+		size_t t = p[i];
+		p[i] = p[j];
+		p[j] = t;
+	}
+}
+
+static void spmv(const GraphCSR* g, const double* x, double* y) {
+	for (size_t u = 0; u < g->n; u++) {
+		double s = 0.0;
+
+		for (size_t e = g->rowptr[u]; e < g->rowptr[u + 1]; e++) {
+			s += CSR_W(g, e) * x[g->col[e]];
+		}
+
+		y[u] = s;
+	}
+}
+
+static void bfs(const GraphCSR* g, size_t src, double* dist, size_t* queue) {
+	for (size_t v = 0; v < g->n; v++) {
+		dist[v] = -1.0;
+	}
+
+	size_t head = 0, tail = 0;
+	queue[tail++] = src;
+	dist[src] = 0.0;
+
+	while (head < tail) {
+		size_t u = queue[head++];
+
+		for (size_t e = g->rowptr[u]; e < g->rowptr[u + 1]; e++) {
+			size_t v = g->col[e];
+
+			if (dist[v] < 0.0) {
+				dist[v] = dist[u] + 1.0;
+				queue[tail++] = v;
+			}
+		}
+	}
+}
+
+/*Malha side x side, com vértices embaralhados*/
+static GraphCSR* shuffled_grid(size_t side, Rng* rng) {
+	size_t n = side * side;
+	GraphCSR* c = calloc(1, sizeof(GraphCSR));
+	size_t* label = malloc(n * sizeof(size_t));
+	size_t* deg = calloc(n + 1, sizeof(size_t));
+	shuffle(label, n, rng);
+
+	c->n = n;
+	c->rowptr = malloc((n + 1) * sizeof(size_t));
+
+	for (size_t r = 0; r < side; r++) {
+		for (size_t s = 0; s < side; s++) {
+			deg[label[r * side + s]] = (r > 0) + (r + 1 < side) + (s > 0)
+				+ (s + 1 < side);
+		}
+	}
+
+	c->rowptr[0] = 0;
+
+	for (size_t u = 0; u < n; u++) {
+		c->rowptr[u + 1] = c->rowptr[u] + deg[u];
+		deg[u] = c->rowptr[u];
+	}
+
+	c->col = malloc(c->rowptr[n] * sizeof(size_t));
+
+	for (size_t r = 0; r < side; r++) {
+		for (size_t s = 0; s < side; s++) {
+			size_t u = label[r * side + s];
+
+			if (r > 0) c->col[deg[u]++] = label[(r - 1) * side + s];
+			if (r + 1 < side) c->col[deg[u]++] = label[(r + 1) * side + s];
+			if (s > 0) c->col[deg[u]++] = label[r * side + s - 1];
+			if (s + 1 < side) c->col[deg[u]++] = label[r * side + s + 1];
+		}
+	}
+
+	/*a identidade só ordena as listas de vizinhos*/
+	for (size_t u = 0; u < n; u++) {
+		label[u] = u;
+	}
+
+	GraphCSR* sorted = graph_csr_permute(c, label);
+	graph_csr_free(c);
+	free(label);
+	free(deg);
+
+	return sorted;
+}
+
+static bool is_perm(const size_t* p, size_t n) {
+	bool* seen = calloc(n + 1, sizeof(bool));
+	bool ok = true;
+
+	for (size_t i = 0; i < n && ok; i++) {
+		ok = p[i] < n && !seen[p[i]];
+		seen[p[i] < n ? p[i] : n] = true;
+	}
+
+	free(seen);
+
+	return ok;
+}
+
+static void small_graphs(void) {
+	Rng rng;
+	rng_seed(&rng, 11);
+	size_t n = 60;
+	Graph* g = graph_random_r(n, 0.08, &rng);
+	graph_add_edge(g, 3, 3, 1.0);
+	Graph* h = graph_new(n, false);
+
+	for (size_t i = 0; i < n * n; i++) {
+		h->A[i] = g->A[i];
+	}
+
+	double w1[60], w2[60], l1[60], l2[60];
+	size_t m = graph_num_edges(g);
+	int d = graph_diameter(g);
+	graph_spec_adj(g, w1);
+	graph_spec_lap(g, l1);
+
+	GraphOrder methods[] = {GRAPH_ORDER_RCM, GRAPH_ORDER_DEGREE,
+		GRAPH_ORDER_GORDER};
+	size_t perm[60];
+
+	for (size_t k = 0; k < 3; k++) {
+		assert(graph_order(g, methods[k], perm) == 0);
+		assert(is_perm(perm, n));
+
+		/*CSR e densa dão a mesma ordem*/
+		GraphCSR* c = graph_csr_from_graph(g);
+		size_t pc[60];
+		assert(graph_csr_order(c, methods[k], pc) == 0);
+
+		for (size_t i = 0; i < n; i++) {
+			assert(pc[i] == perm[i]);
+		}
+
+		graph_csr_free(c);
+	}
+
+	/*invariantes em cache continuam valendo e batem com o recalculo*/
+	uint64_t v = graph_version(g);
+	assert(graph_reorder(g, GRAPH_ORDER_RCM, perm) == 0);
+	assert(graph_version(g) > v);
+	assert(graph_num_edges(g) == m && graph_diameter(g) == d);
+	graph_spec_adj(g, w2);
+	graph_spec_lap(g, l2);
+
+	for (size_t i = 0; i < n; i++) {
+		assert(w1[i] == w2[i] && l1[i] == l2[i]);
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = 0; j < n; j++) {
+			assert(g->A[IDX(i, j, n)] == h->A[IDX(perm[i], perm[j], n)]);
+		}
+	}
+
+	GraphBandwidth before, after;
+	graph_bandwidth(h, &before);
+	graph_bandwidth(g, &after);
+	assert(after.bandwidth <= before.bandwidth);
+
+	/*graus no grafo novo, de volta aos ids originais*/
+	double deg[60];
+
+	for (size_t i = 0; i < n; i++) {
+		deg[i] = 0.0;
+
+		for (size_t j = 0; j < n; j++) {
+			deg[i] += g->A[IDX(i, j, n)];
+		}
+	}
+
+	vector_unpermute(deg, perm, n);
+
+	for (size_t i = 0; i < n; i++) {
+		double dh = 0.0;
+
+		for (size_t j = 0; j < n; j++) {
+			dh += h->A[IDX(i, j, n)];
+		}
+
+		assert(deg[i] == dh);
+	}
+
+	vector_permute(deg, perm, n);
+	vector_unpermute(deg, perm, n);
+	vector_permute(deg, perm, n);
+
+	for (size_t i = 0; i < n; i++) {
+		double dg = 0.0;
+
+		for (size_t j = 0; j < n; j++) {
+			dg += g->A[IDX(i, j, n)];
+		}
+
+		assert(deg[i] == dg);
+	}
+
+	assert(graph_order(g, (GraphOrder) 7, perm) == -1);
+
+	/*direcionado: padrão simetrizado*/
+	Graph* dg = graph_new(4, true);
+	graph_add_edge(dg, 0, 2, 1.0);
+	graph_add_edge(dg, 2, 1, 1.0);
+	graph_add_edge(dg, 3, 1, 1.0);
+	size_t p4[4], q4[4];
+	assert(graph_order(dg, GRAPH_ORDER_RCM, p4) == 0 && is_perm(p4, 4));
+	GraphCSR* dc = graph_csr_from_graph(dg);
+	assert(graph_csr_order(dc, GRAPH_ORDER_RCM, q4) == 0);
+
+	for (size_t i = 0; i < 4; i++) {
+		assert(p4[i] == q4[i]);
+	}
+
+	/*caminho 0 - 2 - 1 - 3: RCM deixa banda 1*/
+	graph_permute(dg, p4);
+	GraphBandwidth b;
+	graph_bandwidth(dg, &b);
+	assert(b.bandwidth == 1);
+
+	graph_csr_free(dc);
+	graph_free(dg);
+	graph_free(g);
+	graph_free(h);
+}
+
+static void bench(size_t side) {
+	Rng rng;
+	rng_seed(&rng, 5);
+	GraphCSR* g = shuffled_grid(side, &rng);
+	size_t n = g->n;
+	double* x = calloc(n, sizeof(double));
+	double* y = malloc(n * sizeof(double));
+	double* ref = malloc(n * sizeof(double));
+	double* dist = malloc(n * sizeof(double));
+	double* dref = malloc(n * sizeof(double));
+	size_t* queue = malloc(n * sizeof(size_t));
+	size_t* perm = malloc(n * sizeof(size_t));
+
+	for (size_t i = 0; i < n; i++) {
+		x[i] = rng_uniform(&rng);
+	}
+
+	spmv(g, x, ref);
+	bfs(g, 0, dref, queue);
+
+	const char* names[] = {"original", "rcm", "grau", "gorder"};
+	GraphOrder methods[] = {GRAPH_ORDER_RCM, GRAPH_ORDER_DEGREE,
+		GRAPH_ORDER_GORDER};
+	GraphBandwidth b0;
+	graph_csr_bandwidth(g, &b0);
+
+	for (size_t k = 0; k < 4; k++) {
+		GraphCSR* r = g;
+		double t_order = 0.0;
+
+		for (size_t i = 0; i < n; i++) {
+			perm[i] = i;
+		}
+
+		if (k > 0) {
+			clock_t t0 = clock();
+			assert(graph_csr_order(g, methods[k - 1], perm) == 0);
+			t_order = elapsed(t0);
+			assert(is_perm(perm, n));
+			r = graph_csr_permute(g, perm);
+		}
+
+		GraphBandwidth b;
+		graph_csr_bandwidth(r, &b);
+
+		/*mesmo y = Ax e mesma BFS, de volta aos ids originais*/
+		double* xp = malloc(n * sizeof(double));
+
+		for (size_t i = 0; i < n; i++) {
+			xp[i] = x[i];
+		}
+
+		vector_permute(xp, perm, n);
+		clock_t t0 = clock();
+
+		for (int it = 0; it < 20; it++) {
+			spmv(r, xp, y);
+		}
+
+		double t_spmv = elapsed(t0) / 20;
+
+		size_t src = 0;
+
+		while (perm[src] != 0) {
+			src++;
+		}
+
+		t0 = clock();
+		bfs(r, src, dist, queue);
+		double t_bfs = elapsed(t0);
+
+		vector_unpermute(y, perm, n);
+		vector_unpermute(dist, perm, n);
+
+		for (size_t i = 0; i < n; i++) {
+			assert(fabs(y[i] - ref[i]) < 1e-12);
+			assert(dist[i] == dref[i]);
+		}
+
+		printf("%-8s banda %7zu perfil %11zu ordem %.4fs spmv %.5fs bfs "
+			"%.5fs\n", names[k], b.bandwidth, b.profile, t_order, t_spmv,
+			t_bfs);
+
+		if (k == 1) {
+			assert(b.bandwidth < b0.bandwidth / 10);
+			assert(b.profile < b0.profile / 10);
+		}
+
+		free(xp);
+
+		if (r != g) {
+			graph_csr_free(r);
+		}
+	}
+
+	graph_csr_free(g);
+	free(x);
+	free(y);
+	free(ref);
+	free(dist);
+	free(dref);
+	free(queue);
+	free(perm);
+}
+
+int main() {
+	small_graphs();
+	bench(400);
+
+	printf("testes passaram!\n");
+
+	return 0;
+}
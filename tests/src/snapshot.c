@@ -0,0 +1,329 @@
+#include "../../src/graphs.h"
+#include "../../src/eig.h"
+#include "../../src/generators.h"
+#include "../../src/snapshot.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <math.h>
+#include <assert.h>
+#include <unistd.h>
+
+static double now(void) {
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+
+	return (double) t.tv_sec + 1e-9 * (double) t.tv_nsec;
+}
+
+static void temp_path(char* path) {
+	strcpy(path, "/tmp/graph_snapshotXXXXXX");
+	int fd = mkstemp(path);
+	assert(fd >= 0);
+	close(fd);
+}
+
+static bool same_graph(const Graph* a, const Graph* b) {
+	return a->n == b->n && a->directed == b->directed
+		&& memcmp(a->A, b->A, a->n * a->n * sizeof(double)) == 0;
+}
+
+static bool same_csr(const GraphCSR* a, const GraphCSR* b) {
+	size_t nnz = a->rowptr[a->n];
+
+	if (a->n != b->n || a->directed != b->directed || !a->w != !b->w
+		|| memcmp(a->rowptr, b->rowptr, (a->n + 1) * sizeof(size_t)) != 0
+		|| memcmp(a->col, b->col, nnz * sizeof(size_t)) != 0) {
+		return false;
+	}
+
+	return !a->w || memcmp(a->w, b->w, nnz * sizeof(double)) == 0;
+}
+
+/*Troca um byte do arquivo na posição pos*/
+static void corrupt(const char* path, long pos) {
+	FILE* f = fopen(path, "r+b");
+	assert(f);
+	fseek(f, pos, SEEK_SET);
+	int c = fgetc(f);
+	fseek(f, pos, SEEK_SET);
+	fputc(c ^ 0x40, f);
+	fclose(f);
+}
+
+static void round_trips(void) {
+	char path[64];
+	temp_path(path);
+
+	/*denso com pesos, direcionado e vazio*/
+	Graph* g = graph_random(40, 0.3);
+	graph_add_edge(g, 3, 7, 2.5);
+	Graph* d = graph_new(9, true);
+	graph_add_edge(d, 0, 8, -1.0);
+	graph_add_edge(d, 8, 1, 0.5);
+	Graph* e = graph_new(0, false);
+	Graph* all[] = {g, d, e};
+
+	for (size_t k = 0; k < 3; k++) {
+		assert(graph_save_binary(all[k], path) == 0);
+		Graph* h = graph_load_binary(path);
+		assert(h && same_graph(all[k], h));
+		graph_free(h);
+	}
+
+	/*CSR sem pesos, CSR com pesos e as conversões*/
+	GraphCSR* c = graph_csr_random_ba(3000, 4, 1);
+	assert(graph_csr_save_binary(c, path) == 0);
+	GraphCSR* c2 = graph_csr_load_binary(path);
+	assert(c2 && same_csr(c, c2));
+	graph_csr_free(c2);
+
+	Graph* dense = graph_load_binary(path);
+	c2 = graph_csr_from_graph(dense);
+	assert(same_csr(c, c2));
+	graph_csr_free(c2);
+	graph_free(dense);
+
+	GraphCSR* cw = graph_csr_from_graph(d);
+	assert(cw->w);
+	assert(graph_csr_save_binary(cw, path) == 0);
+	c2 = graph_csr_load_binary(path);
+	assert(c2 && same_csr(cw, c2));
+	graph_csr_free(c2);
+
+	assert(graph_save_binary(d, path) == 0);
+	c2 = graph_csr_load_binary(path);
+	assert(c2 && same_csr(cw, c2));
+	graph_csr_free(c2);
+
+	assert(graph_load_binary("/tmp/nao/existe.bin") == NULL);
+
+	graph_free(g);
+	graph_free(d);
+	graph_free(e);
+	graph_csr_free(c);
+	graph_csr_free(cw);
+	unlink(path);
+}
+
+static void container(void) {
+	char path[64];
+	temp_path(path);
+
+	size_t count = 300;
+	Rng rng;
+	rng_seed(&rng, 5);
+	Graph** g = malloc(count * sizeof(Graph*));
+	GraphCSR** c = malloc(count * sizeof(GraphCSR*));
+	GraphSnapshotWriter* w = graph_snapshot_create(path);
+
+	/*pares denso, ímpares CSR*/
+	for (size_t k = 0; k < count; k++) {
+		g[k] = graph_random_r(5 + k % 20, 0.4, &rng);
+		c[k] = graph_csr_from_graph(g[k]);
+		assert((k % 2 ? graph_snapshot_add_csr(w, c[k])
+			: graph_snapshot_add(w, g[k])) == 0);
+	}
+
+	assert(graph_snapshot_finish(w) == 0);
+
+	GraphSnapshot* s = graph_snapshot_open(path, true);
+	assert(s && graph_snapshot_count(s) == count);
+	double x[32], y[32];
+
+	for (size_t k = 0; k < count; k++) {
+		if (k % 2) {
+			assert(graph_snapshot_layout(s, k) == GRAPH_LAYOUT_CSR);
+			assert(graph_snapshot_graph(s, k) == NULL);
+			const GraphCSR* v = graph_snapshot_csr(s, k);
+			assert(same_csr(c[k], v));
+			assert((uintptr_t) v->col % 64 == 0);
+		} else {
+			const Graph* v = graph_snapshot_graph(s, k);
+			assert(same_graph(g[k], v));
+			assert((uintptr_t) v->A % 64 == 0);
+
+			/*o const Graph do mapeamento serve direto para as funções*/
+			assert(graph_spec_adj(v, x) == 0);
+			graph_spec_adj(g[k], y);
+			assert(memcmp(x, y, g[k]->n * sizeof(double)) == 0);
+			assert(graph_num_edges(v) == graph_num_edges(g[k]));
+		}
+
+		Graph* h = graph_snapshot_load(s, k);
+		assert(same_graph(g[k], h));
+		graph_free(h);
+	}
+
+	assert(graph_snapshot_graph(s, count) == NULL);
+	assert(graph_snapshot_layout(s, count) == GRAPH_LAYOUT_NONE);
+	graph_snapshot_close(s);
+
+	/*payload corrompido: só verify percebe; índice corrompido: sempre*/
+	FILE* f = fopen(path, "rb");
+	fseek(f, 0, SEEK_END);
+	long size = ftell(f);
+	fclose(f);
+
+	corrupt(path, 64 + 8);
+	assert(graph_snapshot_open(path, true) == NULL);
+	s = graph_snapshot_open(path, false);
+	assert(s && !graph_snapshot_verify(s, 0) && graph_snapshot_verify(s, 1));
+	graph_snapshot_close(s);
+	assert(graph_load_binary(path) == NULL);
+	corrupt(path, 64 + 8);
+
+	Graph* first = graph_load_binary(path);
+	assert(same_graph(g[0], first));
+	graph_free(first);
+
+	corrupt(path, size - 64 + 16);
+	assert(graph_snapshot_open(path, false) == NULL);
+	corrupt(path, size - 64 + 16);
+
+	assert(truncate(path, size - 1) == 0);
+	assert(graph_snapshot_open(path, false) == NULL);
+	unlink(path);
+
+	/*CSR com rowptr[1] corrompido: abre sem verify, mas as cópias
+	recusam em vez de escrever fora da matriz*/
+	Graph* p5 = graph_new(5, false);
+
+	for (size_t u = 0; u + 1 < 5; u++) {
+		graph_add_edge(p5, u, u + 1, 1.0);
+	}
+
+	GraphCSR* c5 = graph_csr_from_graph(p5);
+	assert(graph_csr_save_binary(c5, path) == 0);
+	corrupt(path, 64 + 8);
+	s = graph_snapshot_open(path, false);
+	assert(s && !graph_snapshot_verify(s, 0));
+	assert(graph_snapshot_load(s, 0) == NULL);
+	assert(graph_snapshot_load_csr(s, 0) == NULL);
+	graph_snapshot_close(s);
+	graph_csr_free(c5);
+	graph_free(p5);
+
+	for (size_t k = 0; k < count; k++) {
+		graph_free(g[k]);
+		graph_csr_free(c[k]);
+	}
+
+	free(g);
+	free(c);
+	unlink(path);
+}
+
+/*Texto (graph_read_from_file) x binário (cópia e mmap)*/
+static void bench_single(size_t n, double p) {
+	char text[64], bin[64];
+	temp_path(text);
+	temp_path(bin);
+
+	Graph* g = graph_random(n, p);
+	size_t m = graph_num_edges(g);
+	FILE* f = fopen(text, "w");
+	fprintf(f, "%zu 0\n%zu\n", n, m);
+
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = i + 1; j < n; j++) {
+			if (g->A[IDX(i, j, n)] != 0.0) {
+				fprintf(f, "%zu %zu %g\n", i, j, g->A[IDX(i, j, n)]);
+			}
+		}
+	}
+
+	fclose(f);
+	assert(graph_save_binary(g, bin) == 0);
+
+	double t0 = now();
+	Graph* a = graph_read_from_file(text);
+	double t_text = now() - t0;
+
+	t0 = now();
+	Graph* b = graph_load_binary(bin);
+	double t_load = now() - t0;
+
+	t0 = now();
+	GraphSnapshot* s = graph_snapshot_open(bin, false);
+	double t_map = now() - t0;
+
+	assert(same_graph(g, a) && same_graph(g, b));
+	assert(same_graph(g, graph_snapshot_graph(s, 0)));
+
+	printf("n = %zu, %zu arestas: texto %.3fs, graph_load_binary %.4fs, "
+		"mmap %.6fs\n", n, m, t_text, t_load, t_map);
+
+	graph_snapshot_close(s);
+	graph_free(g);
+	graph_free(a);
+	graph_free(b);
+	unlink(text);
+	unlink(bin);
+}
+
+/*Lote de count grafos pequenos: gravar, abrir e percorrer*/
+static void bench_batch(size_t n, size_t count) {
+	char path[64];
+	temp_path(path);
+
+	Rng rng;
+	rng_seed(&rng, 9);
+	Graph** g = malloc(count * sizeof(Graph*));
+
+	for (size_t k = 0; k < count; k++) {
+		g[k] = graph_random_r(n, 0.5, &rng);
+	}
+
+	double t0 = now();
+	GraphSnapshotWriter* w = graph_snapshot_create(path);
+
+	for (size_t k = 0; k < count; k++) {
+		graph_snapshot_add(w, g[k]);
+	}
+
+	assert(graph_snapshot_finish(w) == 0);
+	double t_write = now() - t0;
+
+	t0 = now();
+	GraphSnapshot* s = graph_snapshot_open(path, false);
+	double t_open = now() - t0;
+	size_t edges = 0, want = 0;
+
+	t0 = now();
+
+	for (size_t k = 0; k < count; k++) {
+		edges += graph_num_edges(graph_snapshot_graph(s, k));
+	}
+
+	double t_scan = now() - t0;
+
+	for (size_t k = 0; k < count; k++) {
+		want += graph_num_edges(g[k]);
+		graph_free(g[k]);
+	}
+
+	assert(edges == want);
+	printf("%zu grafos com n = %zu: gravar %.3fs, abrir %.4fs, "
+		"percorrer %.3fs\n", count, n, t_write, t_open, t_scan);
+
+	graph_snapshot_close(s);
+	free(g);
+	unlink(path);
+}
+
+int main() {
+	srand(time(NULL));
+
+	round_trips();
+	container();
+
+	bench_single(2000, 0.05);
+	bench_batch(16, 100000);
+
+	printf("testes passaram!\n");
+
+	return 0;
+}
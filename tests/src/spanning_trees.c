@@ -0,0 +1,97 @@
+#include "../../src/graphs.h"
+#include "../../src/charpoly.h"
+#include "../../src/families.h"
+#include "../../src/spanning.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <assert.h>
+
+int main() {
+	srand(time(NULL));
+
+	/*Cayley: K_n tem n^(n-2) árvores*/
+	for (size_t n = 2; n <= 12; n++) {
+		Graph* k = graph_kn(n);
+		double expect = (n - 2) * log((double) n);
+		assert(fabs(graph_log_spanning_trees(k) - expect) < 1e-9);
+		graph_free(k);
+	}
+
+	/*K_30: 30^28 não cabe em int64, confere o BigInt*/
+	Graph* k30 = graph_kn(30);
+	BigInt t;
+	assert(graph_spanning_trees_exact(k30, &t) == 0);
+	char* str = bigint_to_string(&t);
+	assert(strcmp(str, "228767924549610000000000000000000000000000") == 0);
+	free(str);
+	bigint_free(&t);
+	graph_free(k30);
+
+	/*C_n tem n árvores; K_{a,b} tem a^(b-1) b^(a-1)*/
+	Graph* c = graph_cycle(17);
+	int64_t v;
+	assert(graph_spanning_trees_exact(c, &t) == 0);
+	assert(bigint_to_int64(&t, &v) && v == 17);
+	bigint_free(&t);
+	assert(fabs(graph_log_spanning_trees(c) - log(17.0)) < 1e-9);
+	graph_free(c);
+
+	Graph* kab = graph_complete_bipartite(4, 6);
+	assert(graph_spanning_trees_exact(kab, &t) == 0);
+	assert(bigint_to_int64(&t, &v) && v == 1024 * 216);
+	bigint_free(&t);
+	graph_free(kab);
+
+	/*com pesos: produto dos pesos somado sobre as árvores*/
+	Graph* w = graph_new(3, false);
+	graph_add_edge(w, 0, 1, 2.0);
+	graph_add_edge(w, 1, 2, 3.0);
+	graph_add_edge(w, 2, 0, 5.0);
+	assert(graph_spanning_trees_exact(w, &t) == 0);
+	assert(bigint_to_int64(&t, &v) && v == 6 + 15 + 10);
+	bigint_free(&t);
+	assert(fabs(graph_log_spanning_trees(w) - log(31.0)) < 1e-9);
+	graph_free(w);
+
+	/*desconexo: nenhuma árvore*/
+	Graph* d = graph_new(4, false);
+	graph_add_edge(d, 0, 1, 1.0);
+	graph_add_edge(d, 2, 3, 1.0);
+	assert(graph_log_spanning_trees(d) == -INFINITY);
+	assert(graph_spanning_trees_exact(d, &t) == 0 && t.sign == 0);
+	bigint_free(&t);
+	graph_free(d);
+
+	/*aleatório: Cholesky vs exato vs estimador*/
+	Graph* g = graph_random_connected(120, 0.05);
+	double lt = graph_log_spanning_trees(g);
+	assert(graph_spanning_trees_exact(g, &t) == 0);
+	double exact = log(bigint_to_double(&t));
+	assert(fabs(lt - exact) < 1e-8 * fabs(exact));
+	bigint_free(&t);
+
+	GraphCSR* csr = graph_csr_from_graph(g);
+	double est, se;
+	assert(graph_log_spanning_trees_approx(csr, 0, 50, &est, &se) == 0);
+	assert(fabs(est - lt) < 0.02 * lt + 5.0 * se);
+
+	/*com Rng: mesma semente, mesma estimativa, com rand() no meio*/
+	Rng r1, r2;
+	double est1, est2;
+	rng_seed(&r1, 7);
+	rng_seed(&r2, 7);
+	assert(graph_log_spanning_trees_approx_r(csr, 0, 20, &est1, NULL, &r1) == 0);
+	(void) rand();
+	assert(graph_log_spanning_trees_approx_r(csr, 0, 20, &est2, NULL, &r2) == 0);
+	assert(est1 == est2);
+	assert(fabs(est1 - lt) < 0.05 * lt);
+	graph_csr_free(csr);
+	graph_free(g);
+
+	printf("testes passaram!\n");
+
+	return 0;
+}
@@ -0,0 +1,90 @@
+#include "../../src/graphs.h"
+#include "../../src/eig.h"
+#include "../../src/tiled.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <math.h>
+#include <assert.h>
+#include <unistd.h>
+
+static void check(const Graph* g, size_t tile) {
+	char path[] = "/tmp/tiled_graphXXXXXX";
+	int fd = mkstemp(path);
+	assert(fd >= 0);
+	close(fd);
+
+	TiledGraph* t = tiled_graph_from_graph(g, path, tile);
+	tiled_graph_close(t);
+	t = tiled_graph_open(path, false);
+
+	size_t n = g->n;
+	double* d1 = malloc(n * sizeof(double));
+	double* d2 = malloc(n * sizeof(double));
+	double* e1 = malloc(n * sizeof(double));
+	double* e2 = malloc(n * sizeof(double));
+	double* x = malloc(n * sizeof(double));
+
+	graph_degree(g, d1, e1);
+	tiled_graph_degree(t, d2, e2);
+
+	for (size_t i = 0; i < n; i++) {
+		assert(d1[i] == d2[i] && e1[i] == e2[i]);
+		x[i] = (double) rand() / RAND_MAX;
+	}
+
+	assert(graph_num_edges(g) == tiled_graph_num_edges(t));
+	assert(graph_is_connected(g) == tiled_graph_is_connected(t));
+
+	graph_ax(g, x, d1);
+	tiled_graph_ax(t, x, d2);
+
+	for (size_t i = 0; i < n; i++) {
+		assert(fabs(d1[i] - d2[i]) < 1e-9);
+	}
+
+	tiled_graph_walk_counts(t, 0, 3, d2);
+
+	for (size_t u = 0; u < n; u += n / 7 + 1) {
+		assert(d2[u] == graph_paths_length(g, 0, u, 3));
+	}
+
+	if (!g->directed) {
+		double* w = malloc(n * sizeof(double));
+		graph_spec_adj(g, w);
+		double r = tiled_graph_spectral_radius(t, 1000, 1e-12);
+		printf("n = %zu, tile = %zu: λ1 = %f, estimado = %f\n",
+			n, tile, w[n - 1], r);
+		assert(fabs(r - w[n - 1]) < 1e-6 * w[n - 1]);
+		free(w);
+	}
+
+	tiled_graph_close(t);
+	unlink(path);
+	free(d1); free(d2); free(e1); free(e2); free(x);
+}
+
+int main() {
+	srand(time(NULL));
+
+	Graph* g = graph_random(150, 0.05);
+	check(g, 32);
+	check(g, 64);
+	graph_free(g);
+
+	g = graph_random_bipartite(40, 70, 0.1);
+	check(g, 32);
+	graph_free(g);
+
+	Graph* d = graph_new(100, true);
+
+	for (size_t i = 0; i < 400; i++) {
+		graph_add_edge(d, rand() % 100, rand() % 100, 1.0);
+	}
+
+	check(d, 32);
+	graph_free(d);
+
+	printf("testes passaram!\n");
+	return 0;
+}
@@ -0,0 +1,144 @@
+#include "../../src/graphs.h"
+#include "../../src/paths.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <math.h>
+#include <assert.h>
+
+static void floyd(const Graph* g, double* D) {
+	size_t n = g->n;
+
+	for (size_t i = 0; i < n; i++)
+		for (size_t j = 0; j < n; j++)
+			D[IDX(i, j, n)] = (i == j) ? 0.0
+				: (g->A[IDX(i, j, n)] != 0.0 ? g->A[IDX(i, j, n)] : INFINITY);
+
+	for (size_t k = 0; k < n; k++)
+		for (size_t i = 0; i < n; i++)
+			for (size_t j = 0; j < n; j++)
+				if (D[IDX(i, k, n)] + D[IDX(k, j, n)] < D[IDX(i, j, n)])
+					D[IDX(i, j, n)] = D[IDX(i, k, n)] + D[IDX(k, j, n)];
+}
+
+static int same(double a, double b) {
+	return (isinf(a) && isinf(b)) || fabs(a - b) <= 1e-9 * fmax(1.0, fabs(a));
+}
+
+static Graph* random_weighted(size_t n, size_t m, bool directed, double wmin) {
+	Graph* g = graph_new(n, directed);
+
+	for (size_t k = 0; k < m; k++) {
+		size_t u = rand() % n, v = rand() % n;
+
+		if (u != v) {
+			graph_add_edge(g, u, v, wmin + 10.0 * rand() / RAND_MAX);
+		}
+	}
+
+	return g;
+}
+
+static void check_nonnegative(bool directed) {
+	size_t n = 120;
+	Graph* g = random_weighted(n, 500, directed, 0.1);
+	GraphCSR* c = graph_csr_from_graph(g);
+	double* F = malloc(n * n * sizeof(double));
+	double* D = malloc(n * n * sizeof(double));
+	double* d1 = malloc(n * sizeof(double));
+	double* d2 = malloc(n * sizeof(double));
+	double* d3 = malloc(n * sizeof(double));
+
+	floyd(g, F);
+	assert(graph_apsp(c, D) == 0);
+
+	for (size_t s = 0; s < n; s += 7) {
+		assert(graph_sssp_dijkstra(c, s, d1) == 0);
+		assert(graph_sssp_delta_stepping(c, s, 0.0, d2) == 0);
+		assert(graph_sssp_bellman_ford(c, s, d3) == 0);
+
+		for (size_t v = 0; v < n; v++) {
+			assert(same(d1[v], F[IDX(s, v, n)]));
+			assert(same(d2[v], F[IDX(s, v, n)]));
+			assert(same(d3[v], F[IDX(s, v, n)]));
+			assert(same(D[IDX(s, v, n)], F[IDX(s, v, n)]));
+		}
+	}
+
+	double diam = 0.0, rad = INFINITY;
+
+	for (size_t i = 0; i < n; i++) {
+		double e = 0.0;
+
+		for (size_t j = 0; j < n; j++) {
+			e = fmax(e, F[IDX(i, j, n)]);
+		}
+
+		diam = fmax(diam, e);
+		rad = fmin(rad, e);
+	}
+
+	assert(same(graph_weighted_diameter(c), diam));
+	assert(same(graph_weighted_radius(c), rad));
+
+	free(F); free(D); free(d1); free(d2); free(d3);
+	graph_csr_free(c);
+	graph_free(g);
+}
+
+/*pesos negativos num DAG (arestas u -> v só com u < v): sem ciclos*/
+static void check_negative(void) {
+	size_t n = 80;
+	Graph* g = graph_new(n, true);
+
+	for (size_t k = 0; k < 400; k++) {
+		size_t u = rand() % n, v = rand() % n;
+
+		if (u < v) {
+			graph_add_edge(g, u, v, -5.0 + 10.0 * rand() / RAND_MAX);
+		}
+	}
+
+	GraphCSR* c = graph_csr_from_graph(g);
+	double* F = malloc(n * n * sizeof(double));
+	double* D = malloc(n * n * sizeof(double));
+	double* d = malloc(n * sizeof(double));
+
+	floyd(g, F);
+	assert(graph_sssp_dijkstra(c, 0, d) == PATHS_NEGATIVE_WEIGHT);
+	assert(graph_sssp(c, 0, d) == 0);
+	assert(graph_apsp(c, D) == 0);
+
+	for (size_t v = 0; v < n; v++) {
+		assert(same(d[v], F[IDX(0, v, n)]));
+	}
+
+	for (size_t i = 0; i < n * n; i++) {
+		assert(same(D[i], F[i]));
+	}
+
+	graph_csr_free(c);
+
+	/*fecha um ciclo negativo*/
+	graph_add_edge(g, 1, 0, -1.0);
+	graph_add_edge(g, 0, 1, -1.0);
+	c = graph_csr_from_graph(g);
+	assert(graph_sssp_bellman_ford(c, 0, d) == PATHS_NEGATIVE_CYCLE);
+	assert(graph_apsp(c, D) == PATHS_NEGATIVE_CYCLE);
+	assert(isnan(graph_weighted_diameter(c)));
+
+	free(F); free(D); free(d);
+	graph_csr_free(c);
+	graph_free(g);
+}
+
+int main() {
+	srand(time(NULL));
+
+	check_nonnegative(false);
+	check_nonnegative(true);
+	check_negative();
+
+	printf("testes passaram!\n");
+	return 0;
+}